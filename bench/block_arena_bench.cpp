@@ -0,0 +1,191 @@
+#include <atomic>
+#include <chrono>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/uentry/UniqueEntryOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <fmt/format.h>
+#include <lookup/UMEntryLookup.hpp>
+#include <lookup/UniqueEntryLookup.hpp>
+#include <lookup/UtilityTokenLookup.hpp>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+using namespace forge::core;
+using forge::lookup::UMEntryLookup;
+using forge::lookup::UniqueEntryLookup;
+using forge::lookup::UtilityTokenLookup;
+
+//every heap allocation of the process is counted,
+//so the benchmark can compare the number of mallocs
+//with and without the per block arena
+namespace {
+std::atomic<std::size_t> number_of_allocations{0};
+} // namespace
+
+auto operator new(std::size_t size)
+    -> void*
+{
+    number_of_allocations++;
+    if(auto* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment)
+    -> void*
+{
+    number_of_allocations++;
+    auto align = static_cast<std::size_t>(alignment);
+    if(auto* ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void* ptr) noexcept
+    -> void
+{
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::align_val_t) noexcept
+    -> void
+{
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+    -> void
+{
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t) noexcept
+    -> void
+{
+    std::free(ptr);
+}
+
+namespace {
+
+constexpr std::size_t OPS_PER_BLOCK = 3000;
+constexpr std::size_t BLOCKS = 50;
+constexpr std::size_t ARENA_SIZE = 256 * 1024;
+
+auto keyHex(std::size_t i)
+    -> std::string
+{
+    return fmt::format("{:08x}", i);
+}
+
+auto owner(std::size_t i)
+    -> std::string
+{
+    return fmt::format("oLupzckPUYtGydsBisL86zcwsBwe{:06}", i % 100);
+}
+
+//a block with um entry, unique entry and utility token creations,
+//every tenth key is created twice to produce conflicts
+auto createBlock()
+    -> std::tuple<std::vector<UMEntryOperation>,
+                  std::vector<UniqueEntryOperation>,
+                  std::vector<UtilityTokenOperation>>
+{
+    std::vector<UMEntryOperation> um_ops;
+    std::vector<UniqueEntryOperation> unique_ops;
+    std::vector<UtilityTokenOperation> token_ops;
+
+    for(std::size_t i = 0; i < OPS_PER_BLOCK; i++) {
+        auto key = i % 10 == 0 ? i - i % 20 : i;
+        auto burn = static_cast<std::int64_t>(1000 + i);
+
+        auto um_meta = stringToByteVec("c6dc75010101aabbccdd01" + keyHex(key)).getValue();
+        um_ops.push_back(
+            parseMetadataToUMEntryOp(um_meta, 10, owner(i), burn).getValue());
+
+        auto unique_meta = stringToByteVec("c6dc75020101aabbccdd02" + keyHex(key)).getValue();
+        unique_ops.push_back(
+            parseMetadataToUniqueEntryOp(unique_meta, 10, owner(i), burn).getValue());
+
+        auto token_meta = stringToByteVec("c6dc7503010000000000000064" + keyHex(key)).getValue();
+        token_ops.push_back(
+            parseMetadataToUtilityTokenOp(token_meta, 10, owner(i), burn).getValue());
+    }
+
+    return {std::move(um_ops),
+            std::move(unique_ops),
+            std::move(token_ops)};
+}
+
+struct Measurement
+{
+    std::size_t allocations;
+    double millis;
+};
+
+template<class Lookup, class Op>
+auto measure(const std::vector<Op>& block, bool use_arena)
+    -> Measurement
+{
+    std::vector<std::byte> arena_buffer(ARENA_SIZE);
+    std::size_t allocations{0};
+    std::chrono::nanoseconds duration{0};
+
+    for(std::size_t i = 0; i < BLOCKS; i++) {
+        Lookup lookup{nullptr, 0};
+        auto ops = block;
+
+        auto alloc_before = number_of_allocations.load();
+        auto start = std::chrono::steady_clock::now();
+        if(use_arena) {
+            std::pmr::monotonic_buffer_resource arena{arena_buffer.data(),
+                                                      arena_buffer.size()};
+            lookup.executeOperations(std::move(ops), &arena);
+        } else {
+            lookup.executeOperations(std::move(ops),
+                                     std::pmr::new_delete_resource());
+        }
+        duration += std::chrono::steady_clock::now() - start;
+        allocations += number_of_allocations.load() - alloc_before;
+    }
+
+    return {allocations / BLOCKS,
+            std::chrono::duration<double, std::milli>(duration).count() / BLOCKS};
+}
+
+template<class Lookup, class Op>
+auto report(const char* name, const std::vector<Op>& block)
+    -> void
+{
+    auto heap = measure<Lookup>(block, false);
+    auto arena = measure<Lookup>(block, true);
+
+    fmt::print("{:<20} heap: {:>7} mallocs/block {:>8.3f} ms/block | "
+               "arena: {:>7} mallocs/block {:>8.3f} ms/block\n",
+               name,
+               heap.allocations,
+               heap.millis,
+               arena.allocations,
+               arena.millis);
+}
+
+} // namespace
+
+auto main() -> int
+{
+    auto [um_ops, unique_ops, token_ops] = createBlock();
+
+    fmt::print("{} operations per block, averaged over {} blocks\n",
+               OPS_PER_BLOCK,
+               BLOCKS);
+
+    report<UMEntryLookup>("UMEntryLookup", um_ops);
+    report<UniqueEntryLookup>("UniqueEntryLookup", unique_ops);
+    report<UtilityTokenLookup>("UtilityTokenLookup", token_ops);
+}
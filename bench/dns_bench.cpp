@@ -0,0 +1,185 @@
+#include <arpa/inet.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <dns/DnsMessage.hpp>
+#include <dns/DnsServer.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <fmt/format.h>
+#include <map>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <utils/Opt.hpp>
+#include <vector>
+
+using namespace forge::core;
+using forge::dns::DnsServer;
+
+namespace {
+
+constexpr std::size_t NUMBER_OF_NAMES = 10000;
+//queries each client keeps in flight
+constexpr std::size_t WINDOW = 32;
+constexpr auto DURATION = std::chrono::seconds{3};
+
+auto nameOf(std::size_t i)
+    -> std::string
+{
+    return fmt::format("name{}.forge", i);
+}
+
+auto buildQuery(const std::string& name, std::uint16_t id)
+    -> std::vector<std::byte>
+{
+    std::vector<std::byte> packet{
+        static_cast<std::byte>(id >> 8),
+        static_cast<std::byte>(id),
+        std::byte{0x01},
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x01},
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x00}};
+
+    auto dot = name.find('.');
+    for(auto label : {name.substr(0, dot), name.substr(dot + 1)}) {
+        packet.push_back(static_cast<std::byte>(label.size()));
+        for(auto c : label) {
+            packet.push_back(static_cast<std::byte>(c));
+        }
+    }
+
+    for(auto byte : {0x00, 0x00, 0x01, 0x00, 0x01}) {
+        packet.push_back(static_cast<std::byte>(byte));
+    }
+
+    return packet;
+}
+
+//sends windows of queries and waits for their answers
+//until the benchmark is over, returns the number of answers
+auto runClient(std::uint16_t port,
+               std::size_t seed,
+               const std::atomic_bool& running)
+    -> std::size_t
+{
+    auto fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    timeval timeout{0, 100000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+
+    std::vector<std::vector<std::byte>> queries;
+    for(std::size_t i = 0; i < 1024; i++) {
+        auto name = nameOf((seed * 7919 + i * 31) % (NUMBER_OF_NAMES * 2));
+        queries.emplace_back(buildQuery(name, static_cast<std::uint16_t>(i)));
+    }
+
+    std::array<std::byte, 512> response;
+    std::size_t answers = 0;
+    std::size_t next = 0;
+
+    while(running.load()) {
+        for(std::size_t i = 0; i < WINDOW; i++) {
+            auto& query = queries[next++ % queries.size()];
+            send(fd, query.data(), query.size(), 0);
+        }
+
+        for(std::size_t i = 0; i < WINDOW; i++) {
+            if(recv(fd, response.data(), response.size(), 0) <= 0) {
+                break;
+            }
+            answers++;
+        }
+    }
+
+    close(fd);
+
+    return answers;
+}
+
+} // namespace
+
+auto main() -> int
+{
+    //half of the queried names exist
+    std::map<EntryKey, UMEntryValue> values;
+    for(std::size_t i = 0; i < NUMBER_OF_NAMES; i++) {
+        values.emplace(stringToASCIIByteVec(nameOf(i)),
+                       IPv4Value{std::byte{10},
+                                 std::byte{0},
+                                 static_cast<std::byte>(i >> 8),
+                                 static_cast<std::byte>(i)});
+    }
+
+    std::atomic_int64_t height{0};
+
+    DnsServer server{
+        [&](const EntryKey& key) -> forge::utils::Opt<UMEntryValue> {
+            auto iter = values.find(key);
+            if(iter == values.end()) {
+                return std::nullopt;
+            }
+            return iter->second;
+        },
+        [&] {
+            return height.load();
+        },
+        60};
+
+    auto workers = std::max(1u, std::thread::hardware_concurrency() / 2);
+    auto res = server.start("127.0.0.1", 0, workers);
+    if(!res) {
+        fmt::print("{}\n", res.getError().what());
+        return -1;
+    }
+
+    for(std::size_t clients : {1, 4, 16}) {
+        std::atomic_bool running{true};
+        std::atomic_size_t answers{0};
+
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < clients; i++) {
+            threads.emplace_back([&, i] {
+                answers += runClient(server.getPort(), i, running);
+            });
+        }
+
+        //a new block every second drops all cached answers
+        auto start = std::chrono::steady_clock::now();
+        while(std::chrono::steady_clock::now() - start < DURATION) {
+            std::this_thread::sleep_for(std::chrono::seconds{1});
+            height++;
+        }
+
+        running.store(false);
+        for(auto& thread : threads) {
+            thread.join();
+        }
+
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        fmt::print("{:>3} clients | {} udp workers | {:>10.0f} queries/s\n",
+                   clients,
+                   workers,
+                   answers.load() / seconds);
+    }
+
+    server.stop();
+}
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <core/Hex.hpp>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace forge::core;
+
+namespace {
+
+constexpr std::size_t KEY_SIZE = 64;
+constexpr std::size_t METADATA_SIZE = 80;
+constexpr std::size_t ITERATIONS = 200000;
+
+//the implementations which were used before the hex codec
+auto legacyToHexString(const std::vector<std::byte>& bytes)
+    -> std::string
+{
+    std::stringstream ss;
+    ss << std::hex;
+    for(auto&& b : bytes) {
+        ss << std::setw(2) << std::setfill('0') << static_cast<int>(b);
+    }
+    return ss.str();
+}
+
+auto legacyStringToByteVec(const std::string& str)
+    -> std::vector<std::byte>
+{
+    if(str.length() % 2 != 0
+       || !std::all_of(std::begin(str),
+                       std::end(str),
+                       [](auto c) {
+                           return std::isxdigit(c);
+                       })) {
+        return {};
+    }
+
+    std::vector<std::byte> data;
+    for(size_t i = 0; i < str.length(); i += 2) {
+        auto byte_string = str.substr(i, 2);
+        data.push_back(static_cast<std::byte>(std::strtol(byte_string.c_str(), nullptr, 16)));
+    }
+    return data;
+}
+
+template<class Func>
+auto nanosPerCall(Func&& func)
+    -> double
+{
+    std::size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < ITERATIONS; i++) {
+        sink += func();
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    //keep the compiler from removing the loop
+    if(sink == 42) {
+        fmt::print("");
+    }
+
+    return std::chrono::duration<double, std::nano>(duration).count() / ITERATIONS;
+}
+
+auto makeBytes(std::size_t size)
+    -> std::vector<std::byte>
+{
+    std::vector<std::byte> bytes(size);
+    for(std::size_t i = 0; i < size; i++) {
+        bytes[i] = static_cast<std::byte>((i * 37 + 11) & 0xFF);
+    }
+    return bytes;
+}
+
+} // namespace
+
+auto main() -> int
+{
+    auto key = makeBytes(KEY_SIZE);
+    auto key_hex = toHexString(key);
+    auto metadata_hex = "6a4c" + toHexString(makeBytes(METADATA_SIZE));
+
+    std::string out(2 * KEY_SIZE, '\0');
+    std::vector<std::byte> decoded(KEY_SIZE);
+
+    fmt::print("{} byte keys, {} byte metadata, {} iterations\n",
+               KEY_SIZE,
+               METADATA_SIZE,
+               ITERATIONS);
+
+    fmt::print("{:<32} {:>9.1f} ns\n", "encode legacy stringstream",
+               nanosPerCall([&] { return legacyToHexString(key).size(); }));
+    fmt::print("{:<32} {:>9.1f} ns\n", "encode toHexString",
+               nanosPerCall([&] { return toHexString(key).size(); }));
+    fmt::print("{:<32} {:>9.1f} ns\n", "encode scalar into buffer",
+               nanosPerCall([&] {
+                   hexEncodeScalar(key.data(), key.size(), out.data());
+                   return static_cast<std::size_t>(out[0]);
+               }));
+    fmt::print("{:<32} {:>9.1f} ns\n", "encode vectorised into buffer",
+               nanosPerCall([&] {
+                   hexEncode(key.data(), key.size(), out.data());
+                   return static_cast<std::size_t>(out[0]);
+               }));
+
+    fmt::print("{:<32} {:>9.1f} ns\n", "decode legacy substr/strtol",
+               nanosPerCall([&] { return legacyStringToByteVec(key_hex).size(); }));
+    fmt::print("{:<32} {:>9.1f} ns\n", "decode stringToByteVec",
+               nanosPerCall([&] { return stringToByteVec(key_hex).getValue().size(); }));
+    fmt::print("{:<32} {:>9.1f} ns\n", "decode scalar into buffer",
+               nanosPerCall([&] {
+                   return static_cast<std::size_t>(hexDecodeScalar(key_hex, decoded.data()));
+               }));
+    fmt::print("{:<32} {:>9.1f} ns\n", "decode vectorised into buffer",
+               nanosPerCall([&] {
+                   return static_cast<std::size_t>(hexDecode(key_hex, decoded.data()));
+               }));
+    fmt::print("{:<32} {:>9.1f} ns\n", "extractMetadata",
+               nanosPerCall([&] { return extractMetadata(metadata_hex).getValue().size(); }));
+}
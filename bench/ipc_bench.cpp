@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <fmt/format.h>
+#include <ipc/BinaryProtocol.hpp>
+#include <ipc/IpcClient.hpp>
+#include <ipc/IpcServer.hpp>
+#include <map>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace forge::core;
+using namespace forge::ipc;
+
+namespace {
+
+constexpr std::size_t NUMBER_OF_KEYS = 10000;
+constexpr std::size_t ITERATIONS = 200000;
+constexpr std::size_t BATCH_SIZE = 64;
+
+auto keyOf(std::size_t i)
+    -> EntryKey
+{
+    return stringToASCIIByteVec(fmt::format("name{}.forge", i));
+}
+
+} // namespace
+
+auto main() -> int
+{
+    std::map<EntryKey, std::string> owners;
+    for(std::size_t i = 0; i < NUMBER_OF_KEYS; i++) {
+        owners.emplace(keyOf(i), fmt::format("owner{}", i));
+    }
+
+    IpcServer server{[&](const Request& request, std::vector<std::byte>& output) {
+        auto iter = owners.find(request.payload.toVector());
+        if(iter == owners.end()) {
+            writeResponse(output, request.id, Status::NotFound, 0, {});
+            return;
+        }
+
+        const auto* owner = reinterpret_cast<const std::byte*>(iter->second.data());
+        writeResponse(output,
+                      request.id,
+                      Status::Ok,
+                      0,
+                      forge::utils::ByteView{owner, iter->second.size()});
+    }};
+
+    auto path = fmt::format("/tmp/forge_ipc_bench_{}.sock", getpid());
+    if(auto res = server.start(path); !res) {
+        fmt::print("{}\n", res.getError().what());
+        return -1;
+    }
+
+    auto client_res = make_ipc_client(path);
+    if(!client_res) {
+        fmt::print("{}\n", client_res.getError().what());
+        return -1;
+    }
+    auto& client = client_res.getValue();
+
+    std::vector<EntryKey> keys;
+    for(std::size_t i = 0; i < ITERATIONS; i++) {
+        keys.emplace_back(keyOf((i * 7919) % NUMBER_OF_KEYS));
+    }
+
+    //one request per round trip
+    std::vector<double> latencies;
+    latencies.reserve(ITERATIONS);
+    for(const auto& key : keys) {
+        auto start = std::chrono::steady_clock::now();
+        auto res = client.lookupOwner(key);
+        auto end = std::chrono::steady_clock::now();
+
+        if(!res) {
+            fmt::print("{}\n", res.getError().what());
+            return -1;
+        }
+
+        latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    std::sort(std::begin(latencies), std::end(latencies));
+    fmt::print("single lookups    | p50 {:>6.2f}us | p99 {:>6.2f}us\n",
+               latencies[latencies.size() / 2],
+               latencies[latencies.size() * 99 / 100]);
+
+    //pipelined batches
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i + BATCH_SIZE <= keys.size(); i += BATCH_SIZE) {
+        std::vector<EntryKey> batch(std::begin(keys) + i,
+                                    std::begin(keys) + i + BATCH_SIZE);
+        if(!client.lookupOwners(batch)) {
+            return -1;
+        }
+    }
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    fmt::print("pipelined by {:>3} | {:>10.0f} lookups/s\n",
+               BATCH_SIZE,
+               keys.size() / seconds);
+
+    server.stop();
+}
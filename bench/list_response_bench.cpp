@@ -0,0 +1,110 @@
+#include <chrono>
+#include <cstddef>
+#include <entrys/umentry/UMEntry.hpp>
+#include <fmt/format.h>
+#include <json/value.h>
+#include <json/writer.h>
+#include <numeric>
+#include <rpc/JsonArray.hpp>
+#include <string>
+#include <utils/Algorithm.hpp>
+#include <vector>
+
+using namespace forge::core;
+using forge::rpc::toJsonArray;
+
+namespace {
+
+//the quadratic version is only measured up to this size
+constexpr std::size_t LEGACY_LIMIT = 1000;
+
+auto createEntrys(std::size_t number)
+    -> std::vector<UMEntry>
+{
+    std::vector<UMEntry> entrys;
+    entrys.reserve(number);
+
+    for(std::size_t i = 0; i < number; i++) {
+        EntryKey key(16);
+        for(std::size_t j = 0; j < key.size(); j++) {
+            key[j] = static_cast<std::byte>((i >> (j % 4 * 8)) + j);
+        }
+
+        IPv4Value ip{std::byte{10},
+                     std::byte{0},
+                     static_cast<std::byte>(i >> 8),
+                     static_cast<std::byte>(i)};
+
+        entrys.emplace_back(std::move(key), ip);
+    }
+
+    return entrys;
+}
+
+auto serialize(const Json::Value& json)
+    -> std::string
+{
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, json);
+}
+
+//the way the list rpcs built their responses before
+auto legacyResponse(std::vector<UMEntry> entrys)
+    -> std::string
+{
+    auto json_entrys =
+        forge::utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
+                                            std::make_move_iterator(std::end(entrys)),
+                                            [](auto entry) {
+                                                return entry.toJson();
+                                            });
+
+    auto ret_json =
+        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
+                        std::make_move_iterator(std::end(json_entrys)),
+                        Json::Value{Json::ValueType::arrayValue},
+                        [](auto init, auto entry) {
+                            init.append(std::move(entry));
+                            return init;
+                        });
+
+    return serialize(ret_json);
+}
+
+template<class Func>
+auto millis(Func&& func)
+    -> std::pair<double, std::size_t>
+{
+    auto start = std::chrono::steady_clock::now();
+    auto response = func();
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    return {std::chrono::duration<double, std::milli>(duration).count(),
+            response.size()};
+}
+
+} // namespace
+
+auto main() -> int
+{
+    for(std::size_t number : {1000, 10000, 100000}) {
+        auto entrys = createEntrys(number);
+
+        auto [dom_ms, dom_size] = millis([&] {
+            return serialize(toJsonArray(entrys));
+        });
+
+        auto legacy = number <= LEGACY_LIMIT
+            ? fmt::format("{:>10.2f} ms", millis([&] {
+                                               return legacyResponse(entrys);
+                                           }).first)
+            : fmt::format("{:>13}", "skipped");
+
+        fmt::print("{:>7} entrys | legacy: {} | linear dom: {:>8.2f} ms | {} bytes\n",
+                   number,
+                   legacy,
+                   dom_ms,
+                   dom_size);
+    }
+}
@@ -1,2 +1,3 @@
 option(USE_CLANG "build application with clang" OFF)
 option(BUILD_TESTS "build test for cppFORGE" ON)
+option(BUILD_BENCHMARKS "build benchmarks for cppFORGE" OFF)
@@ -22,6 +22,11 @@ public:
     virtual auto getTransaction(std::string txid) const
         -> utils::Result<core::Transaction, ClientError> = 0;
 
+    //fetches the transaction but only returns the parts needed
+    //for forge operations, nullopt if it cannot contain one
+    virtual auto getForgeCandidate(std::string txid) const
+        -> utils::Result<utils::Opt<core::ForgeCandidate>, ClientError> = 0;
+
     virtual auto resolveTxIn(core::TxIn vin) const
         -> utils::Result<core::TxOut, ClientError> = 0;
 
@@ -59,11 +64,14 @@ private:
     core::Coin coin_;
 };
 
+//the wallet calls of the client go to the given wallet of the
+//node, or to its only wallet if none is given
 auto make_readonly_client(const std::string& host,
                           const std::string& user,
                           const std::string& password,
                           std::int64_t port,
-                          core::Coin coin)
+                          core::Coin coin,
+                          const utils::Opt<std::string>& node_wallet = std::nullopt)
     -> std::unique_ptr<ReadOnlyClientBase>;
 
 
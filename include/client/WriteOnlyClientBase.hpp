@@ -4,6 +4,7 @@
 #include <entrys/umentry/UMEntryOperation.hpp>
 #include <client/ClientError.hpp>
 #include <client/ReadOnlyClientBase.hpp>
+#include <utils/Opt.hpp>
 #include <utils/Result.hpp>
 
 namespace forge::client {
@@ -50,6 +51,18 @@ public:
     virtual auto decodeTxidOfRawTx(const std::vector<std::byte>& tx) const
         -> utils::Result<std::string, ClientError> = 0;
 
+    //excludes an output from the coin selection of the node
+    //wallet, so the node does not spend an output an operation
+    //of forge is about to spend
+    virtual auto lockOutput(std::string txid,
+                            std::int64_t index) const
+        -> utils::Result<void, ClientError> = 0;
+
+    //gives a locked output back to the coin selection of the node
+    virtual auto unlockOutput(std::string txid,
+                              std::int64_t index) const
+        -> utils::Result<void, ClientError> = 0;
+
     //generate a new address for the wallet
     virtual auto generateNewAddress() const
         -> utils::Result<std::string, ClientError> = 0;
@@ -59,6 +72,14 @@ public:
                                std::string address) const
         -> utils::Result<std::string, ClientError> = 0;
 
+    //sends the given amounts to the given addresses in one
+    //transaction, every address may only appear once
+    virtual auto sendToMany(std::vector<
+                                std::pair<std::string,
+                                          std::int64_t>>
+                                amounts) const
+        -> utils::Result<std::string, ClientError> = 0;
+
     //should check unspent outputs,
     //select an output enought value
     //if value = fee + amount then burn the output completly and write
@@ -94,11 +115,14 @@ public:
         -> utils::Result<std::int64_t, ClientError> = 0;
 };
 
+//the client writes with the given wallet of the node,
+//or with its only wallet if none is given
 auto make_writing_client(const std::string& host,
                          const std::string& user,
                          const std::string& password,
                          std::int64_t port,
-                         core::Coin coin)
+                         core::Coin coin,
+                         const utils::Opt<std::string>& node_wallet = std::nullopt)
     -> std::unique_ptr<WriteOnlyClientBase>;
 
 } // namespace forge::client
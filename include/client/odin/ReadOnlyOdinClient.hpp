@@ -6,19 +6,28 @@
 #include <client/ReadOnlyClientBase.hpp>
 #include <jsonrpccpp/client.h>
 #include <jsonrpccpp/client/connectors/httpclient.h>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <utils/Opt.hpp>
 #include <utils/Result.hpp>
+#include <vector>
 
 namespace forge::client {
 
+//the client can be shared between threads, every call to the node
+//uses a connection of its own which is taken from a pool
 class ReadOnlyOdinClient : public ReadOnlyClientBase
 {
 public:
+    //the wallet calls go to the given wallet of the node, which
+    //is served at /wallet/<name>, or to the only wallet of the node
     ReadOnlyOdinClient(const std::string& host,
                        const std::string& user,
                        const std::string& password,
                        std::int64_t port,
-                       core::Coin coin);
+                       core::Coin coin,
+                       const utils::Opt<std::string>& node_wallet = std::nullopt);
 
     virtual ~ReadOnlyOdinClient() = default;
 
@@ -28,6 +37,9 @@ public:
     auto getTransaction(std::string txid) const
         -> utils::Result<core::Transaction, ClientError> override;
 
+    auto getForgeCandidate(std::string txid) const
+        -> utils::Result<utils::Opt<core::ForgeCandidate>, ClientError> override;
+
     auto resolveTxIn(core::TxIn vin) const
         -> utils::Result<core::TxOut, ClientError> override;
 
@@ -57,14 +69,32 @@ public:
                           ClientError> override;
 
 protected:
+    //can be called from several threads at once
     auto sendcommand(const std::string& command,
                      Json::Value params) const
         -> utils::Result<Json::Value, ClientError>;
 
-
 private:
-    jsonrpc::HttpClient http_client_;
-    mutable jsonrpc::Client client_;
+    //the http client owns a curl handle, which must
+    //not be used by two threads at the same time
+    struct Connection
+    {
+        explicit Connection(const std::string& url);
+
+        jsonrpc::HttpClient http_client;
+        jsonrpc::Client client;
+    };
+
+    //takes an idle connection or opens a new one
+    auto takeConnection() const
+        -> std::unique_ptr<Connection>;
+
+    auto returnConnection(std::unique_ptr<Connection> connection) const
+        -> void;
+
+    std::string url_;
+    mutable std::mutex connections_mtx_;
+    mutable std::vector<std::unique_ptr<Connection>> idle_connections_;
 };
 
 namespace odin {
@@ -73,6 +103,10 @@ auto processGetTransactionResponse(Json::Value&& response,
                                    const Json::Value& params)
     -> utils::Result<core::Transaction, ClientError>;
 
+auto processGetForgeCandidateResponse(Json::Value&& response,
+                                      const Json::Value& params)
+    -> utils::Result<utils::Opt<core::ForgeCandidate>, ClientError>;
+
 auto processGetBlockCountResponse(Json::Value&& response,
                                   const Json::Value& params)
     -> utils::Result<std::int64_t, ClientError>;
@@ -43,6 +43,14 @@ public:
     auto sendRawTx(std::vector<std::byte> tx) const
         -> utils::Result<std::string, ClientError> override;
 
+    auto lockOutput(std::string txid,
+                    std::int64_t index) const
+        -> utils::Result<void, ClientError> override;
+
+    auto unlockOutput(std::string txid,
+                      std::int64_t index) const
+        -> utils::Result<void, ClientError> override;
+
     auto generateNewAddress() const
         -> utils::Result<std::string, ClientError> override;
 
@@ -62,6 +70,12 @@ public:
                        std::string address) const
         -> utils::Result<std::string, ClientError> override;
 
+    auto sendToMany(std::vector<
+                        std::pair<std::string,
+                                  std::int64_t>>
+                        amounts) const
+        -> utils::Result<std::string, ClientError> override;
+
     auto burnAmount(std::string txid,
                     std::int64_t index,
                     std::int64_t amount,
@@ -84,6 +98,11 @@ private:
                                                  std::int64_t>>
                                        outputs) const
         -> Json::Value;
+
+    auto setOutputLock(std::string txid,
+                       std::int64_t index,
+                       bool lock) const
+        -> utils::Result<void, ClientError>;
 };
 
 namespace odin {
@@ -99,6 +118,11 @@ auto processSignRawTxResponse(Json::Value&& response)
 auto processGenerateNewAddressResponse(Json::Value&& response)
     -> utils::Result<std::string, ClientError>;
 
+auto processLockUnspentResponse(Json::Value&& response,
+                                const std::string& txid,
+                                std::int64_t index)
+    -> utils::Result<void, ClientError>;
+
 auto processDecodeTxidOfRawTxResponse(Json::Value&& response)
     -> utils::Result<std::string, ClientError>;
 
@@ -106,6 +130,10 @@ auto processSendToAddressResponse(Json::Value&& response,
                                   const std::string& address)
     -> utils::Result<std::string, ClientError>;
 
+auto processSendManyResponse(Json::Value&& response,
+                             std::size_t number_of_outputs)
+    -> utils::Result<std::string, ClientError>;
+
 auto processGetVOutIdxByAmountAndAddressResponse(Json::Value&& response,
                                                  std::int64_t amount,
                                                  const std::string& address)
@@ -32,4 +32,9 @@ auto getValidityLength(Coin c)
 auto getMinimumTxAmount(Coin c)
     -> std::int64_t;
 
+//version byte of pay to pubkey hash addresses,
+//nullopt if it is not known for the coin
+auto getPubKeyHashPrefix(Coin c)
+    -> utils::Opt<std::uint8_t>;
+
 } // namespace forge::core
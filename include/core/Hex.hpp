@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace forge::core {
+
+//encodes size bytes as lowercase hex characters into out,
+//which needs to be able to hold 2 * size characters
+auto hexEncode(const std::byte* data,
+               std::size_t size,
+               char* out)
+    -> void;
+
+auto hexEncode(const std::byte* data,
+               std::size_t size)
+    -> std::string;
+
+//decodes the hex string into out, which needs to be able
+//to hold hex.size() / 2 bytes. returns false if hex has an odd
+//length or contains characters which are not [0-9a-fA-F],
+//in which case the content of out is unspecified
+auto hexDecode(std::string_view hex,
+               std::byte* out)
+    -> bool;
+
+//scalar versions of the codec, the vectorised versions
+//fall back to those for inputs which do not fill a whole register
+auto hexEncodeScalar(const std::byte* data,
+                     std::size_t size,
+                     char* out)
+    -> void;
+
+auto hexDecodeScalar(std::string_view hex,
+                     std::byte* out)
+    -> bool;
+
+} // namespace forge::core
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <core/Coin.hpp>
+#include <core/RawTransactionError.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <utils/Result.hpp>
+#include <vector>
+
+namespace forge::core {
+
+//decodes a base58 string with a 4 byte checksum, the returned
+//bytes start with the version byte and do not contain the checksum
+auto decodeBase58Check(std::string_view str)
+    -> utils::Opt<std::vector<std::byte>>;
+
+//the script of an output paying to the address,
+//only pay to pubkey hash addresses are supported
+auto addressToOutputScript(std::string_view address, Coin coin)
+    -> utils::Result<std::vector<std::byte>, RawTransactionError>;
+
+//unsigned transaction spending the given output with one output for every
+//(address, value) pair in the given order, followed by an OP_RETURN output
+//holding the metadata and burning burn_value. values are given in satoshis
+auto serializeRawTx(std::string_view input_txid,
+                    std::uint32_t index,
+                    const std::vector<std::byte>& metadata,
+                    std::int64_t burn_value,
+                    const std::vector<std::pair<std::string, std::int64_t>>& outputs,
+                    Coin coin)
+    -> utils::Result<std::vector<std::byte>, RawTransactionError>;
+
+//the txid of a serialized transaction as it is shown by the node
+auto computeTxid(utils::ByteView tx)
+    -> std::string;
+
+} // namespace forge::core
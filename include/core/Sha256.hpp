@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utils/ByteView.hpp>
+
+namespace forge::core {
+
+using Sha256Digest = std::array<std::byte, 32>;
+
+auto sha256(utils::ByteView data)
+    -> Sha256Digest;
+
+//sha256 of the sha256 of the data, as used for txids and checksums
+auto doubleSha256(utils::ByteView data)
+    -> Sha256Digest;
+
+} // namespace forge::core
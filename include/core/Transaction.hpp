@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <json/value.h>
 #include <memory>
+#include <string_view>
 #include <utils/Opt.hpp>
 #include <vector>
 
@@ -183,6 +184,52 @@ private:
     std::string txid_;
 };
 
+//compact record of a transaction which can contain a forge operation,
+//it only keeps what is needed to parse the operation:
+//the single input, the value and decoded metadata of the single
+//OP_RETURN output and the address of the first other output
+class ForgeCandidate
+{
+public:
+    ForgeCandidate(std::string&& txid,
+                   TxIn&& input,
+                   std::int64_t op_return_value,
+                   std::vector<std::byte>&& metadata,
+                   utils::Opt<std::string>&& new_owner);
+
+    ForgeCandidate(ForgeCandidate&&) = default;
+    ForgeCandidate(const ForgeCandidate&) = default;
+
+    auto operator=(ForgeCandidate &&)
+        -> ForgeCandidate& = default;
+    auto operator=(const ForgeCandidate&)
+        -> ForgeCandidate& = default;
+
+    auto getTxid() const
+        -> const std::string&;
+
+    auto getInput() const
+        -> const TxIn&;
+
+    auto getOpReturnValue() const
+        -> std::int64_t;
+
+    auto getMetadata() const
+        -> const std::vector<std::byte>&;
+
+    //address of the first non OP_RETURN output
+    //if it has exactly one address
+    auto getNewOwner() const
+        -> const utils::Opt<std::string>&;
+
+private:
+    std::string txid_;
+    TxIn input_;
+    std::int64_t op_return_value_;
+    std::vector<std::byte> metadata_;
+    utils::Opt<std::string> new_owner_;
+};
+
 auto buildTxIn(Json::Value&& json)
     -> utils::Opt<TxIn>;
 auto buildTxOut(Json::Value&& json)
@@ -190,7 +237,19 @@ auto buildTxOut(Json::Value&& json)
 auto buildTransaction(Json::Value&& json)
     -> utils::Opt<Transaction>;
 
-auto extractMetadata(std::string&& hex)
+//returns the forge candidate of the transaction if it has exactly one
+//input and exactly one OP_RETURN output whose metadata starts with
+//the forge identifier
+auto buildForgeCandidate(const Transaction& tx)
+    -> utils::Opt<ForgeCandidate>;
+
+//decode mode which checks the conditions directly on the json of a
+//transaction, without building a Transaction first. scripts and
+//addresses of other outputs are never copied
+auto buildForgeCandidate(const Json::Value& json)
+    -> utils::Opt<ForgeCandidate>;
+
+auto extractMetadata(std::string_view hex)
     -> utils::Opt<std::vector<std::byte>>;
 
 auto stringToByteVec(const std::string& str)
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <string>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <vector>
+
+namespace forge::dns {
+
+constexpr inline std::size_t DNS_HEADER_SIZE = 12;
+constexpr inline std::size_t MAX_UDP_RESPONSE_SIZE = 512;
+constexpr inline std::size_t MAX_TCP_RESPONSE_SIZE = 65535;
+
+constexpr inline std::uint16_t TYPE_A = 1;
+constexpr inline std::uint16_t TYPE_TXT = 16;
+constexpr inline std::uint16_t TYPE_AAAA = 28;
+constexpr inline std::uint16_t TYPE_ANY = 255;
+
+constexpr inline std::uint16_t CLASS_IN = 1;
+constexpr inline std::uint16_t CLASS_ANY = 255;
+
+enum class ResponseCode : std::uint8_t {
+    NoError = 0,
+    FormatError = 1,
+    NameError = 3,
+    NotImplemented = 4,
+    Refused = 5
+};
+
+//the single question of a standard query
+struct DnsQuery
+{
+    std::uint16_t id;
+    bool recursion_desired;
+    //lowercase name without the trailing root label
+    std::string name;
+    std::uint16_t qtype;
+    std::uint16_t qclass;
+    //offset of the first byte after the question section
+    std::size_t question_end;
+};
+
+//the answer to a name and type, independent of the query
+//it was created for. records refer to the queried name
+//with a compression pointer to the question
+struct DnsAnswer
+{
+    ResponseCode rcode;
+    std::uint16_t answer_count;
+    std::vector<std::byte> records;
+};
+
+//parses a standard query with exactly one question.
+//returns nullopt for everything else
+auto parseDnsQuery(utils::ByteView packet)
+    -> utils::Opt<DnsQuery>;
+
+//creates the answer records for an entry value, values which
+//do not match qtype result in an empty NOERROR answer
+auto buildDnsAnswer(const core::UMEntryValue& value,
+                    std::uint16_t qtype,
+                    std::uint32_t ttl)
+    -> DnsAnswer;
+
+auto buildDnsAnswer(ResponseCode rcode)
+    -> DnsAnswer;
+
+//writes the response to query into out. if the answer
+//does not fit into max_size the answer records are dropped
+//and the truncation flag is set
+auto writeDnsResponse(utils::ByteView packet,
+                      const DnsQuery& query,
+                      const DnsAnswer& answer,
+                      std::size_t max_size,
+                      std::vector<std::byte>& out)
+    -> void;
+
+//writes a response without a question section, used for
+//packets which could not be parsed into a DnsQuery.
+//returns false if the packet is too short to be answered
+auto writeDnsErrorResponse(utils::ByteView packet,
+                           ResponseCode rcode,
+                           std::vector<std::byte>& out)
+    -> bool;
+
+} // namespace forge::dns
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <dns/DnsMessage.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <vector>
+
+namespace forge::dns {
+
+//returns the value of the entry with the given key
+using ValueLookup = std::function<utils::Opt<core::UMEntryValue>(const core::EntryKey&)>;
+
+//answers dns queries from entry values. complete answers are cached
+//in wire format and dropped as soon as the block height changes.
+//a responder is not thread safe, every worker owns its own one
+class DnsResponder final
+{
+public:
+    DnsResponder(ValueLookup lookup,
+                 std::uint32_t ttl,
+                 std::size_t max_cache_size = 1 << 16);
+
+    //writes the response to packet into out,
+    //returns false if the packet should not be answered
+    auto respond(utils::ByteView packet,
+                 std::int64_t block_height,
+                 std::size_t max_size,
+                 std::vector<std::byte>& out)
+        -> bool;
+
+    auto getCacheHits() const
+        -> std::uint64_t;
+
+    auto getCacheMisses() const
+        -> std::uint64_t;
+
+private:
+    auto resolve(const DnsQuery& query)
+        -> DnsAnswer;
+
+private:
+    ValueLookup lookup_;
+    std::uint32_t ttl_;
+    std::size_t max_cache_size_;
+
+    std::int64_t cache_height_ = -1;
+    //keyed by qtype and qclass followed by the queried name
+    std::unordered_map<std::string, DnsAnswer> cache_;
+    std::string cache_key_;
+
+    std::uint64_t cache_hits_ = 0;
+    std::uint64_t cache_misses_ = 0;
+};
+
+} // namespace forge::dns
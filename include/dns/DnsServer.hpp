@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <dns/DnsError.hpp>
+#include <dns/DnsResponder.hpp>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utils/Result.hpp>
+#include <vector>
+
+namespace forge::dns {
+
+//returns the block height the values of the ValueLookup belong to
+using HeightLookup = std::function<std::int64_t()>;
+
+//authoritative dns front-end answering A, AAAA and TXT queries
+//from entry values. every udp worker owns its own SO_REUSEPORT
+//socket and responder and receives and sends in batches.
+//one additional worker answers all tcp connections with epoll
+class DnsServer final
+{
+public:
+    DnsServer(ValueLookup lookup,
+              HeightLookup height,
+              std::uint32_t ttl);
+
+    DnsServer(const DnsServer&) = delete;
+    DnsServer(DnsServer&&) = delete;
+    auto operator=(const DnsServer&) -> DnsServer& = delete;
+    auto operator=(DnsServer&&) -> DnsServer& = delete;
+
+    ~DnsServer();
+
+    //binds all sockets and starts the workers. if port is 0
+    //a free port is chosen, which can be queried with getPort()
+    auto start(const std::string& host,
+               std::uint16_t port,
+               std::size_t number_of_workers)
+        -> utils::Result<void, DnsError>;
+
+    auto stop()
+        -> void;
+
+    auto getPort() const
+        -> std::uint16_t;
+
+private:
+    auto bindSocket(int type,
+                    const std::string& host)
+        -> utils::Result<int, DnsError>;
+
+    auto runUdpWorker(int socket)
+        -> void;
+
+    auto runTcpWorker(int socket)
+        -> void;
+
+    auto closeSockets()
+        -> void;
+
+private:
+    ValueLookup lookup_;
+    HeightLookup height_;
+    std::uint32_t ttl_;
+
+    std::uint16_t port_ = 0;
+    std::atomic_bool running_{false};
+    std::vector<int> sockets_;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace forge::dns
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <json/value.h>
+#include <utils/ByteView.hpp>
 #include <utils/Opt.hpp>
 #include <variant>
 #include <vector>
@@ -47,7 +48,22 @@ private:
     std::uint64_t attached_amount_;
 };
 
-auto parseUtilityToken(const std::vector<std::byte>& metadata)
+//non owning view of the token described by decoded metadata,
+//it is only valid as long as the metadata is alive
+struct UtilityTokenView
+{
+    utils::ByteView id;
+    std::uint64_t amount;
+};
+
+auto parseUtilityTokenView(utils::ByteView metadata)
+    -> utils::Opt<UtilityTokenView>;
+
+//copies the id out of the view
+auto toUtilityToken(const UtilityTokenView& view)
+    -> UtilityToken;
+
+auto parseUtilityToken(utils::ByteView metadata)
     -> utils::Opt<UtilityToken>;
 
 
@@ -10,6 +10,7 @@
 #include <entrys/token/UtilityTokenDeletionOp.hpp>
 #include <entrys/token/UtilityTokenOwnershipTransferOp.hpp>
 #include <json/value.h>
+#include <utils/ByteView.hpp>
 #include <utils/Opt.hpp>
 #include <variant>
 #include <vector>
@@ -47,15 +48,45 @@ auto extractOperationFlag(const UtilityTokenOperation&)
 //checks the metadata of a transaction and parses it into
 //an UtilityTokenOp if it holds the needed information
 //and the metadata has the needed formating
-auto parseTransactionToUtilityTokenOp(core::Transaction tx,
+auto parseTransactionToUtilityTokenOp(const core::Transaction& tx,
                                       std::int64_t block,
                                       const client::ReadOnlyClientBase* client)
     -> utils::Result<utils::Opt<UtilityTokenOperation>,
                       client::ClientError>;
 
+//parses the operation of a forge candidate, the input is only
+//resolved if the metadata describes a valid operation
+auto parseForgeCandidateToUtilityTokenOp(const core::ForgeCandidate& candidate,
+                                         std::int64_t block,
+                                         const client::ReadOnlyClientBase* client)
+    -> utils::Result<utils::Opt<UtilityTokenOperation>,
+                      client::ClientError>;
+
+//non owning view of the operation described by decoded metadata,
+//it is only valid as long as the metadata is alive
+struct UtilityTokenOperationView
+{
+    std::byte operation_flag;
+    UtilityTokenView token;
+};
+
+//validates the given metadata and returns a view of the
+//operation it describes without copying anything
+auto parseMetadataToUtilityTokenOpView(utils::ByteView metadata)
+    -> utils::Opt<UtilityTokenOperationView>;
+
+//creates the owning operation from a validated view,
+//ownership transfers need a new owner
+auto toUtilityTokenOp(const UtilityTokenOperationView& view,
+                      std::int64_t block,
+                      std::string&& owner,
+                      std::int64_t value,
+                      utils::Opt<std::string>&& new_owner = std::nullopt)
+    -> utils::Opt<UtilityTokenOperation>;
+
 //parses given metadata and constructs a UtilityTokenOp from
 //the given information if possible
-auto parseMetadataToUtilityTokenOp(const std::vector<std::byte>& metadata,
+auto parseMetadataToUtilityTokenOp(utils::ByteView metadata,
                                    std::int64_t block,
                                    std::string&& owner,
                                    std::int64_t value,
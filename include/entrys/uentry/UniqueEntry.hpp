@@ -48,15 +48,19 @@ private:
     UniqueEntryValue value_;
 };
 
-auto parseUniqueValue(const std::vector<std::byte>& data)
+auto parseUniqueValue(utils::ByteView data)
     -> utils::Opt<UniqueEntryValue>;
 
-auto parseUniqueKey(const std::vector<std::byte>& data)
-    -> utils::Opt<EntryKey>;
+auto parseUniqueKey(utils::ByteView data)
+    -> utils::Opt<utils::ByteView>;
 
-auto parseUniqueEntry(const std::vector<std::byte>& data)
+auto parseUniqueEntry(utils::ByteView data)
     -> utils::Opt<UniqueEntry>;
 
+//creates the owning entry from a validated view
+auto toUniqueEntry(const EntryView& view)
+    -> UniqueEntry;
+
 auto extractUniqueValueFlag(const UniqueEntryValue& value)
     -> std::byte;
 
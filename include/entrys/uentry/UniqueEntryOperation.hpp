@@ -10,6 +10,7 @@
 #include <entrys/uentry/UniqueEntryOwnershipTransferOp.hpp>
 #include <entrys/uentry/UniqueEntryRenewalOp.hpp>
 #include <memory>
+#include <utils/ByteView.hpp>
 #include <vector>
 
 
@@ -57,14 +58,43 @@ auto extractOperationFlag(const UniqueEntryOperation&)
 //checks the metadata of a transaction and parses it into
 //an UniqueEntryOperation if it holds the needed information
 //and the metadata has the needed formating
-auto parseTransactionToUniqueEntry(core::Transaction tx,
+auto parseTransactionToUniqueEntry(const core::Transaction& tx,
                                    std::int64_t block,
                                    const client::ReadOnlyClientBase* client)
     -> utils::Result<utils::Opt<UniqueEntryOperation>, client::ClientError>;
 
+//parses the operation of a forge candidate, the input is only
+//resolved if the metadata describes a valid operation
+auto parseForgeCandidateToUniqueEntry(const core::ForgeCandidate& candidate,
+                                      std::int64_t block,
+                                      const client::ReadOnlyClientBase* client)
+    -> utils::Result<utils::Opt<UniqueEntryOperation>, client::ClientError>;
+
+//non owning view of the operation described by decoded metadata,
+//it is only valid as long as the metadata is alive
+struct UniqueEntryOperationView
+{
+    std::byte operation_flag;
+    EntryView entry;
+};
+
+//validates the given metadata and returns a view of the
+//operation it describes without copying anything
+auto parseMetadataToUniqueEntryOpView(utils::ByteView metadata)
+    -> utils::Opt<UniqueEntryOperationView>;
+
+//creates the owning operation from a validated view,
+//ownership transfers need a new owner
+auto toUniqueEntryOp(const UniqueEntryOperationView& view,
+                     std::int64_t block,
+                     std::string&& owner,
+                     std::int64_t value,
+                     utils::Opt<std::string>&& new_owner = std::nullopt)
+    -> utils::Opt<UniqueEntryOperation>;
+
 //parses given metadata and constructs a UniqueEntryOperation from
 //the given information if possible
-auto parseMetadataToUniqueEntryOp(const std::vector<std::byte>& metadata,
+auto parseMetadataToUniqueEntryOp(utils::ByteView metadata,
                                   std::int64_t block,
                                   std::string&& owner,
                                   std::int64_t value,
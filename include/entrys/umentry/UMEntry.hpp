@@ -3,6 +3,7 @@
 #include <array>
 #include <cstddef>
 #include <json/value.h>
+#include <utils/ByteView.hpp>
 #include <utils/Opt.hpp>
 #include <variant>
 #include <vector>
@@ -73,15 +74,36 @@ private:
 };
 
 
-auto parseUMValue(const std::vector<std::byte>& data)
+//non owning view of the key and value of an entry
+//inside of decoded metadata
+struct EntryView
+{
+    utils::ByteView key;
+    std::byte value_flag;
+    utils::ByteView value;
+};
+
+auto parseUMValue(utils::ByteView data)
     -> utils::Opt<UMEntryValue>;
 
-auto parseUMKey(const std::vector<std::byte>& data)
-    -> utils::Opt<EntryKey>;
+auto parseUMKey(utils::ByteView data)
+    -> utils::Opt<utils::ByteView>;
 
-auto parseUMEntry(const std::vector<std::byte>& data)
+//validates the value and key part of the metadata
+//and returns views of them without copying anything
+auto parseEntryView(utils::ByteView data)
+    -> utils::Opt<EntryView>;
+
+auto parseUMEntry(utils::ByteView data)
     -> utils::Opt<UMEntry>;
 
+//creates the owning value from a validated view
+auto toUMEntryValue(const EntryView& view)
+    -> UMEntryValue;
+
+auto toUMEntry(const EntryView& view)
+    -> UMEntry;
+
 auto extractValueFlag(const UMEntryValue& value)
     -> std::byte;
 
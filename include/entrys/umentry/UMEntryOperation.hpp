@@ -11,6 +11,7 @@
 #include <entrys/umentry/UMEntryRenewalOp.hpp>
 #include <entrys/umentry/UMEntryUpdateOp.hpp>
 #include <memory>
+#include <utils/ByteView.hpp>
 #include <vector>
 
 
@@ -60,14 +61,43 @@ auto extractOperationFlag(const UMEntryOperation&)
 //checks the metadata of a transaction and parses it into
 //an UMEntryOperation if it holds the needed information
 //and the metadata has the needed formating
-auto parseTransactionToUMEntry(core::Transaction tx,
+auto parseTransactionToUMEntry(const core::Transaction& tx,
                                std::int64_t block,
                                const client::ReadOnlyClientBase* client)
     -> utils::Result<utils::Opt<UMEntryOperation>, client::ClientError>;
 
+//parses the operation of a forge candidate, the input is only
+//resolved if the metadata describes a valid operation
+auto parseForgeCandidateToUMEntry(const core::ForgeCandidate& candidate,
+                                  std::int64_t block,
+                                  const client::ReadOnlyClientBase* client)
+    -> utils::Result<utils::Opt<UMEntryOperation>, client::ClientError>;
+
+//non owning view of the operation described by decoded metadata,
+//it is only valid as long as the metadata is alive
+struct UMEntryOperationView
+{
+    std::byte operation_flag;
+    EntryView entry;
+};
+
+//validates the given metadata and returns a view of the
+//operation it describes without copying anything
+auto parseMetadataToUMEntryOpView(utils::ByteView metadata)
+    -> utils::Opt<UMEntryOperationView>;
+
+//creates the owning operation from a validated view,
+//ownership transfers need a new owner
+auto toUMEntryOp(const UMEntryOperationView& view,
+                 std::int64_t block,
+                 std::string&& owner,
+                 std::int64_t value,
+                 utils::Opt<std::string>&& new_owner = std::nullopt)
+    -> utils::Opt<UMEntryOperation>;
+
 //parses given metadata and constructs a UNEntryOperation from
 //the given information if possible
-auto parseMetadataToUMEntryOp(const std::vector<std::byte>& metadata,
+auto parseMetadataToUMEntryOp(utils::ByteView metadata,
                               std::int64_t block,
                               std::string&& owner,
                               std::int64_t value,
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <core/Coin.hpp>
+#include <map>
+#include <rpc/AdmissionControl.hpp>
 #include <string>
 #include <utils/Opt.hpp>
+#include <wallet/OutputPool.hpp>
 
 
 namespace forge::env {
@@ -16,14 +19,59 @@ constexpr static inline auto DEFAULT_CONFIG_FILE =
     "[rpc]\n"
     "user = \"\"\n"
     "password = \"\"\n"
-    "port = 6969\n\n"
+    "port = 6969\n"
+    "#\"httpserver\" or \"epoll\"\n"
+    "transport = \"httpserver\"\n\n"
 
     "[coin]\n"
     "coin = \"odin\"\n"
     "user = \"user\"\n"
     "password = \"password\"\n"
     "host = \"localhost\"\n"
-    "port = 22101\n";
+    "port = 22101\n\n"
+
+    "[dns]\n"
+    "#a port other than 0 answers dns queries for entrys\n"
+    "host = \"0.0.0.0\"\n"
+    "port = 0\n\n"
+
+    "[ipc]\n"
+    "#a unix socket path answers binary lookup requests of local services\n"
+    "path = \"\"\n\n"
+
+    "[metrics]\n"
+    "#a port other than 0 serves prometheus metrics on localhost\n"
+    "port = 0\n\n"
+
+    "[wallet]\n"
+    "#outputs of pool_burn_amount kept ready for new entrys, 0 for no pool\n"
+    "pool_size = 0\n"
+    "pool_burn_amount = 0\n\n"
+
+    "[wallets]\n"
+    "#more wallets served at /wallet/<name> next to the default one,\n"
+    "#they share its index, so only in readonly and readwrite mode.\n"
+    "#every wallet uses the node wallet of the same name, which has to\n"
+    "#be loaded in the node, the default one the default node wallet\n"
+    "#name = \"readonly\" or \"readwrite\"\n\n"
+
+    "[admission]\n"
+    "#limits of rpc requests executed at once, 0 for no limit\n"
+    "max_concurrent = 10\n"
+    "lookup_concurrent = 0\n"
+    "wallet_read_concurrent = 0\n"
+    "wallet_write_concurrent = 2\n"
+    "#requests waiting for a slot, and how long they wait\n"
+    "max_queued = 40\n"
+    "queue_timeout_ms = 1000\n"
+    "#workers running submitted jobs, and jobs waiting for them\n"
+    "job_workers = 2\n"
+    "max_queued_jobs = 10000\n\n"
+
+    "[admission.methods]\n"
+    "#limits of single methods executed at once\n"
+    "rebuildlookup = 1\n"
+    "updatelookup = 1\n";
 
 
 enum class Mode {
@@ -32,6 +80,13 @@ enum class Mode {
     ReadWrite
 };
 
+enum class RpcTransport {
+    //libmicrohttpd, one thread per request
+    HttpServer,
+    //event loop with a bounded worker pool
+    Epoll
+};
+
 class ProgramOptions
 {
 public:
@@ -46,7 +101,15 @@ public:
                    std::string&& coin_password,
                    std::int64_t rpc_port,
                    std::string&& rpc_user,
-                   std::string&& rpc_password);
+                   std::string&& rpc_password,
+                   RpcTransport rpc_transport,
+                   std::string&& dns_host,
+                   std::int64_t dns_port,
+                   std::string&& ipc_path,
+                   std::int64_t metrics_port,
+                   wallet::OutputPoolConfig output_pool,
+                   std::map<std::string, Mode>&& wallets,
+                   rpc::AdmissionLimits&& admission_limits);
 
     auto getLogFolder() const
         -> const std::string&;
@@ -83,6 +146,32 @@ public:
         -> const std::string&;
     auto getRpcPassword() const
         -> const std::string&;
+    auto getRpcTransport() const
+        -> RpcTransport;
+
+    auto getDnsHost() const
+        -> const std::string&;
+    //0 if no dns server should be started
+    auto getDnsPort() const
+        -> std::int64_t;
+
+    //empty if no ipc server should be started
+    auto getIpcPath() const
+        -> const std::string&;
+
+    //0 if no metrics server should be started
+    auto getMetricsPort() const
+        -> std::int64_t;
+
+    auto getOutputPoolConfig() const
+        -> const wallet::OutputPoolConfig&;
+
+    //named wallets and whether they are readonly or readwrite
+    auto getWallets() const
+        -> const std::map<std::string, Mode>&;
+
+    auto getAdmissionLimits() const
+        -> const rpc::AdmissionLimits&;
 
 private:
     std::string logfolder_;
@@ -102,6 +191,19 @@ private:
     std::int64_t rpc_port_;
     std::string rpc_user_;
     std::string rpc_password_;
+    RpcTransport rpc_transport_;
+
+    std::string dns_host_;
+    std::int64_t dns_port_;
+
+    std::string ipc_path_;
+
+    std::int64_t metrics_port_;
+
+    wallet::OutputPoolConfig output_pool_;
+    std::map<std::string, Mode> wallets_;
+
+    rpc::AdmissionLimits admission_limits_;
 };
 
 auto parseOptions(int argc, char* argv[])
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <vector>
+
+namespace forge::ipc {
+
+//every frame starts with the big endian size of the rest of the frame.
+//requests:  u32 id | u8 opcode | payload
+//responses: u32 id | u8 status | i64 block height | payload
+//responses are sent in the order of the requests, the id lets
+//clients check that they match
+constexpr std::size_t LENGTH_PREFIX_SIZE = 4;
+constexpr std::size_t REQUEST_HEADER_SIZE = 5;
+constexpr std::size_t RESPONSE_HEADER_SIZE = 13;
+constexpr std::size_t MAX_FRAME_SIZE = 64 * 1024;
+
+//the lookup methods of the json-rpc interface
+enum class Opcode : std::uint8_t {
+    //payload: key, answer: value flag | raw value
+    LookupUMValue = 1,
+    //payload: key, answer: value flag | raw value
+    LookupUniqueValue = 2,
+    //payload: key, answer: owner
+    LookupOwner = 3,
+    //payload: key, answer: i64 activation block
+    LookupActivationBlock = 4,
+    //payload: u8 owner size | owner | token, answer: u64 balance
+    GetBalanceOf = 5,
+    //payload: token, answer: u64 supply
+    GetSupplyOfUtilityToken = 6
+};
+
+enum class Status : std::uint8_t {
+    Ok = 0,
+    NotFound = 1,
+    BadRequest = 2,
+    UnknownOpcode = 3
+};
+
+//payload views point into the parsed frame
+struct Request
+{
+    std::uint32_t id;
+    Opcode opcode;
+    utils::ByteView payload;
+};
+
+struct Response
+{
+    std::uint32_t id;
+    Status status;
+    std::int64_t block_height;
+    utils::ByteView payload;
+};
+
+//size of the first frame of the buffer including its length prefix,
+//nullopt if the length prefix was not received completely
+auto peekFrameSize(utils::ByteView buffer)
+    -> utils::Opt<std::size_t>;
+
+//the frames are passed without their length prefix
+auto parseRequest(utils::ByteView frame)
+    -> utils::Opt<Request>;
+
+auto parseResponse(utils::ByteView frame)
+    -> utils::Opt<Response>;
+
+auto writeRequest(std::vector<std::byte>& output,
+                  std::uint32_t id,
+                  Opcode opcode,
+                  utils::ByteView payload)
+    -> void;
+
+auto writeResponse(std::vector<std::byte>& output,
+                   std::uint32_t id,
+                   Status status,
+                   std::int64_t block_height,
+                   utils::ByteView payload)
+    -> void;
+
+//returns nullopt if the owner is longer than 255 bytes
+auto encodeBalanceRequest(std::string_view owner,
+                          utils::ByteView token)
+    -> utils::Opt<std::vector<std::byte>>;
+
+auto parseBalanceRequest(utils::ByteView payload)
+    -> utils::Opt<std::pair<std::string_view, utils::ByteView>>;
+
+auto encodeValue(const core::UMEntryValue& value)
+    -> std::vector<std::byte>;
+
+auto parseValue(utils::ByteView payload)
+    -> utils::Opt<core::UMEntryValue>;
+
+auto encodeInteger(std::uint64_t value)
+    -> std::vector<std::byte>;
+
+auto parseInteger(utils::ByteView payload)
+    -> utils::Opt<std::uint64_t>;
+
+} // namespace forge::ipc
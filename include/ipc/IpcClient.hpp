@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entrys/uentry/UniqueEntry.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <ipc/BinaryProtocol.hpp>
+#include <ipc/IpcError.hpp>
+#include <string>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <utils/Result.hpp>
+#include <vector>
+
+namespace forge::ipc {
+
+//client of the binary protocol served by the IpcServer. lookups of
+//missing keys return nullopt, failed connections and malformed
+//answers an IpcError. a client must not be shared between threads
+class IpcClient final
+{
+public:
+    //takes ownership of the connected socket
+    explicit IpcClient(int socket);
+
+    IpcClient(const IpcClient&) = delete;
+    IpcClient(IpcClient&&) noexcept;
+    auto operator=(const IpcClient&) -> IpcClient& = delete;
+    auto operator=(IpcClient&&) noexcept -> IpcClient&;
+
+    ~IpcClient();
+
+    auto lookupUMValue(const core::EntryKey& key)
+        -> utils::Result<utils::Opt<core::UMEntryValue>, IpcError>;
+
+    auto lookupUniqueValue(const core::EntryKey& key)
+        -> utils::Result<utils::Opt<core::UniqueEntryValue>, IpcError>;
+
+    auto lookupOwner(const core::EntryKey& key)
+        -> utils::Result<utils::Opt<std::string>, IpcError>;
+
+    auto lookupActivationBlock(const core::EntryKey& key)
+        -> utils::Result<utils::Opt<std::int64_t>, IpcError>;
+
+    auto getBalanceOf(const std::string& owner,
+                      const core::EntryKey& token)
+        -> utils::Result<std::uint64_t, IpcError>;
+
+    auto getSupplyOfUtilityToken(const core::EntryKey& token)
+        -> utils::Result<std::uint64_t, IpcError>;
+
+    //the batch versions pipeline the requests, so the
+    //round trip is only paid once for many keys
+    auto lookupUMValues(const std::vector<core::EntryKey>& keys)
+        -> utils::Result<std::vector<utils::Opt<core::UMEntryValue>>, IpcError>;
+
+    auto lookupOwners(const std::vector<core::EntryKey>& keys)
+        -> utils::Result<std::vector<utils::Opt<std::string>>, IpcError>;
+
+    //block height of the lookup when the last response was created
+    auto getBlockHeight() const
+        -> std::int64_t;
+
+private:
+    //sends one request per payload and decodes the answers,
+    //the decoder returns nullopt for malformed answers
+    template<class T, class Decoder>
+    auto pipeline(Opcode opcode,
+                  const std::vector<utils::ByteView>& payloads,
+                  Decoder&& decode)
+        -> utils::Result<std::vector<utils::Opt<T>>, IpcError>;
+
+    auto sendAll(const std::vector<std::byte>& data)
+        -> utils::Result<void, IpcError>;
+
+    //the returned response points into the input buffer
+    //and is valid until the next call
+    auto receiveResponse()
+        -> utils::Result<Response, IpcError>;
+
+private:
+    int socket_;
+    std::uint32_t next_id_ = 0;
+    std::int64_t block_height_ = 0;
+    std::vector<std::byte> output_;
+    std::vector<std::byte> input_;
+    //bytes of the input which belong to the last response
+    std::size_t consumed_ = 0;
+};
+
+auto make_ipc_client(const std::string& path)
+    -> utils::Result<IpcClient, IpcError>;
+
+} // namespace forge::ipc
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdexcept>
+
+namespace forge::ipc {
+
+class IpcError final : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+} // namespace forge::ipc
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <ipc/BinaryProtocol.hpp>
+#include <ipc/IpcError.hpp>
+#include <list>
+#include <lookup/LookupManager.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utils/Result.hpp>
+#include <vector>
+
+namespace forge::ipc {
+
+//answers a request by appending exactly one response to output
+using RequestHandler = std::function<void(const Request& request,
+                                          std::vector<std::byte>& output)>;
+
+//answers all opcodes from the given lookup, which needs
+//to outlive the handler
+auto makeLookupHandler(const lookup::LookupManager& lookup)
+    -> RequestHandler;
+
+//serves the binary protocol on a unix domain socket for co-located
+//services. every connection gets its own thread doing blocking reads,
+//which has the lowest latency for the few long lived connections local
+//clients open. all requests of a read are answered with a single write,
+//so clients can pipeline requests
+class IpcServer final
+{
+public:
+    IpcServer(RequestHandler handler,
+              std::size_t max_connections = 64);
+
+    IpcServer(const IpcServer&) = delete;
+    IpcServer(IpcServer&&) = delete;
+    auto operator=(const IpcServer&) -> IpcServer& = delete;
+    auto operator=(IpcServer&&) -> IpcServer& = delete;
+
+    ~IpcServer();
+
+    //a stale socket file at the path is replaced
+    auto start(const std::string& path)
+        -> utils::Result<void, IpcError>;
+
+    auto stop()
+        -> void;
+
+private:
+    struct Session
+    {
+        std::thread thread;
+        std::atomic_bool done{false};
+    };
+
+    auto acceptConnections()
+        -> void;
+
+    auto handleConnection(int connection)
+        -> void;
+
+    //joins the sessions whose connections are closed
+    auto reapSessions()
+        -> void;
+
+private:
+    RequestHandler handler_;
+    std::size_t max_connections_;
+
+    std::string path_;
+    int socket_ = -1;
+    std::atomic_bool running_{false};
+    std::thread acceptor_;
+    //only used by the acceptor
+    std::list<std::unique_ptr<Session>> sessions_;
+};
+
+} // namespace forge::ipc
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <entrys/Entry.hpp>
+#include <mutex>
+#include <string>
+#include <utils/Opt.hpp>
+#include <vector>
+
+namespace forge::lookup {
+
+//balance of an owner before and after a block
+struct BalanceChange
+{
+    std::string owner;
+    core::EntryKey token;
+    std::uint64_t old_balance;
+    std::uint64_t new_balance;
+};
+
+//keys of the entrys a block changed, a key is only listed
+//once, with the first of created, deleted, transferred,
+//updated and renewed which describes the whole block
+struct BlockChanges
+{
+    std::int64_t block_height;
+    std::vector<core::EntryKey> created;
+    std::vector<core::EntryKey> updated;
+    std::vector<core::EntryKey> transferred;
+    std::vector<core::EntryKey> renewed;
+    std::vector<core::EntryKey> deleted;
+    std::vector<BalanceChange> balance_changes;
+
+    auto empty() const
+        -> bool;
+};
+
+//changes of all blocks up to block_height, blocks
+//without any changes are left out
+struct ChangesSince
+{
+    std::int64_t block_height;
+    std::vector<BlockChanges> blocks;
+};
+
+//keeps the changes of the last blocks which changed anything.
+//it has its own lock, so waiting consumers never hold the
+//lock of the lookup
+class ChangeFeed final
+{
+public:
+    ChangeFeed(std::int64_t block_height,
+               std::size_t capacity = 1024);
+
+    //adds the changes of the next block, the oldest block
+    //is dropped if the feed is full
+    auto push(BlockChanges&& changes)
+        -> void;
+
+    //forgets all changes, consumers have to resync
+    //because their state does not follow from the feed
+    auto reset(std::int64_t block_height)
+        -> void;
+
+    //changes of all blocks after the given height, nullopt
+    //if some of them were already dropped
+    auto getChangesSince(std::int64_t block_height) const
+        -> utils::Opt<ChangesSince>;
+
+    //like getChangesSince but waits until a block after the
+    //given height arrived or the timeout elapsed
+    auto waitForChangesSince(std::int64_t block_height,
+                             std::chrono::milliseconds timeout) const
+        -> utils::Opt<ChangesSince>;
+
+    //all changes after this height are still available
+    auto getRetainedSince() const
+        -> std::int64_t;
+
+private:
+    //does not lock, the caller needs to hold the lock
+    auto collectSince(std::int64_t block_height) const
+        -> utils::Opt<ChangesSince>;
+
+private:
+    std::size_t capacity_;
+    std::deque<BlockChanges> blocks_;
+    std::int64_t block_height_;
+    std::int64_t retained_since_;
+
+    mutable std::mutex mtx_;
+    mutable std::condition_variable block_arrived_;
+};
+
+} // namespace forge::lookup
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utils/Opt.hpp>
+#include <vector>
+
+namespace forge::lookup {
+
+//describes in which lookup a reserved key lives
+enum class EntryKind {
+    UMEntry,
+    UniqueEntry,
+    UtilityToken
+};
+
+//maps every reserved key to the lookup it lives in.
+//a bloom filter in front of the map answers most
+//"key does not exist" queries without touching the map
+class KeyDirectory final
+{
+public:
+    KeyDirectory(std::size_t expected_keys = 1024);
+
+    //sets the kind of a key, or removes the key
+    //if an empty opt is given
+    auto update(const std::vector<std::byte>& key,
+                utils::Opt<EntryKind> kind)
+        -> void;
+
+    auto find(const std::vector<std::byte>& key) const
+        -> utils::Opt<EntryKind>;
+
+    auto contains(const std::vector<std::byte>& key) const
+        -> bool;
+
+    //returns false if the key is definitely not in the directory
+    auto mayContain(const std::vector<std::byte>& key) const
+        -> bool;
+
+    //removes all keys of a given kind
+    auto eraseKind(EntryKind kind)
+        -> void;
+
+    auto clear()
+        -> void;
+
+    auto size() const
+        -> std::size_t;
+
+private:
+    auto setBits(const std::vector<std::byte>& key)
+        -> void;
+
+    //recreates the bloom filter from the keys currently in the
+    //directory, dropping bits of erased keys
+    auto rebuildFilter(std::size_t expected_keys)
+        -> void;
+
+private:
+    std::map<std::vector<std::byte>, EntryKind> directory_;
+    std::vector<std::uint64_t> filter_;
+    std::size_t filter_mask_;
+    //number of keys whose bits are still set in the filter
+    std::size_t filter_keys_;
+};
+
+} // namespace forge::lookup
@@ -9,9 +9,13 @@
 #include <entrys/token/UtilityToken.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
 #include <functional>
+#include <lookup/ChangeFeed.hpp>
+#include <lookup/KeyDirectory.hpp>
 #include <lookup/UMEntryLookup.hpp>
 #include <lookup/UniqueEntryLookup.hpp>
 #include <lookup/UtilityTokenLookup.hpp>
+#include <memory_resource>
+#include <mutex>
 #include <set>
 #include <shared_mutex>
 #include <utils/Opt.hpp>
@@ -25,6 +29,40 @@ using ManagerError = std::variant<LookupError,
 auto generateMessage(ManagerError&& error)
     -> std::string;
 
+//everything known about a single entry
+struct EntryInfo
+{
+    core::Entry entry;
+    std::string owner;
+    std::int64_t activation_block;
+};
+
+//results of a batch request, all of them were
+//looked up at the same block height
+template<class T>
+struct BatchResult
+{
+    std::int64_t block_height;
+    std::vector<T> results;
+};
+
+//position after which a listing continues
+struct ListPosition
+{
+    std::string owner;
+    std::vector<std::byte> key;
+};
+
+//one page of a listing of entrys or tokens ordered by owner
+//and key, next is set if more results follow
+template<class T>
+struct Page
+{
+    std::int64_t block_height;
+    std::vector<T> results;
+    utils::Opt<ListPosition> next;
+};
+
 class LookupManager final
 {
 public:
@@ -52,12 +90,35 @@ public:
     auto lookupActivationBlock(const core::EntryKey& key) const
         -> utils::Opt<std::reference_wrapper<const std::int64_t>>;
 
+    //looks up all keys under one lock, so all results
+    //belong to the same block height
+    auto lookupMany(const std::vector<core::EntryKey>& keys) const
+        -> BatchResult<utils::Opt<EntryInfo>>;
+
+    //owners of all keys, looked up under one lock
+    auto lookupOwners(const std::vector<core::EntryKey>& keys) const
+        -> BatchResult<utils::Opt<std::string>>;
+
+    //balances of the given owner token pairs, all
+    //computed under one lock at the same block height
+    auto getBalances(const std::vector<std::pair<std::string, core::EntryKey>>& owner_token_pairs) const
+        -> BatchResult<std::uint64_t>;
+
     auto lookupIsValid() const
         -> utils::Result<bool, client::ClientError>;
 
     auto getLastValidBlockHeight() const
         -> utils::Result<int64_t, client::ClientError>;
 
+    //height of the last block processed by the lookup
+    auto getLookupBlockHeight() const
+        -> std::int64_t;
+
+    //returns all entry and token keys which were touched by
+    //operations of the blocks processed since the last call
+    auto takeTouchedKeys()
+        -> std::vector<core::EntryKey>;
+
     auto getUtilityTokenCreditOf(const std::string& owner,
                                  const std::vector<std::byte>& token) const
         -> std::uint64_t;
@@ -80,6 +141,33 @@ public:
     auto getEntrysOfOwner(const std::string& owner) const
         -> std::vector<core::Entry>;
 
+    //results of all given owners, collected under one lock
+    auto getUMEntrysOfOwners(const std::set<std::string>& owners) const
+        -> std::vector<core::UMEntry>;
+
+    auto getUniqueEntrysOfOwners(const std::set<std::string>& owners) const
+        -> std::vector<core::UniqueEntry>;
+
+    auto getUtilityTokensOfOwners(const std::set<std::string>& owners) const
+        -> std::vector<core::UtilityToken>;
+
+    //at most limit results of the given owners, starting after
+    //the given position. the lock is only held for one page
+    auto getUMEntrysOfOwners(std::vector<std::string> owners,
+                             const utils::Opt<ListPosition>& after,
+                             std::size_t limit) const
+        -> Page<core::UMEntry>;
+
+    auto getUniqueEntrysOfOwners(std::vector<std::string> owners,
+                                 const utils::Opt<ListPosition>& after,
+                                 std::size_t limit) const
+        -> Page<core::UniqueEntry>;
+
+    auto getUtilityTokensOfOwners(std::vector<std::string> owners,
+                                  const utils::Opt<ListPosition>& after,
+                                  std::size_t limit) const
+        -> Page<core::UtilityToken>;
+
     //checks if a given key is already used as any entry key
     //or if it is free to be used  for any entry
     auto isReserverdEntryKey(const std::vector<std::byte>& key) const
@@ -88,13 +176,46 @@ public:
     auto getCoin() const
         -> core::Coin;
 
+    //changes of the last processed blocks, it can be
+    //used without holding the lock of the lookup
+    auto getChangeFeed() const
+        -> const ChangeFeed&;
+
     auto getClient() const
         -> const client::ReadOnlyClientBase&;
 
 private:
+    //take the lock and record how long they had
+    //to wait for it if it was held by another thread
+    auto readLock() const
+        -> std::shared_lock<std::shared_mutex>;
+    auto writeLock()
+        -> std::unique_lock<std::shared_mutex>;
+
+    //publishes the sizes of the lookups,
+    //the caller needs to hold the lock
+    auto updateSizeMetrics() const
+        -> void;
+
+    //does not lock, the caller needs to hold the lock
+    auto lookupEntryInfo(const core::EntryKey& key) const
+        -> utils::Opt<EntryInfo>;
+
     auto processBlock(core::Block&& block)
         -> utils::Result<void, ManagerError>;
 
+    //classifies the changes of the given keys by comparing
+    //their state before the block with the current one
+    auto collectEntryChanges(const std::vector<core::EntryKey>& keys,
+                             const std::vector<utils::Opt<EntryInfo>>& before,
+                             BlockChanges& changes) const
+        -> void;
+
+    //reclassifies the given keys after their operations
+    //were executed and updates the key directory
+    auto refreshKeyDirectory(const std::vector<core::EntryKey>& keys)
+        -> void;
+
     auto processUMEntrys(const std::vector<core::Transaction>& txs,
                          std::int64_t block_height)
         -> void;
@@ -105,8 +226,9 @@ private:
                               std::int64_t block_height)
         -> void;
 
-    auto parseAndFilter(std::vector<core::Transaction>&& txs,
-                        std::int64_t block_height)
+    auto parseAndFilter(std::vector<core::ForgeCandidate>&& candidates,
+                        std::int64_t block_height,
+                        std::pmr::memory_resource* resource)
         -> std::tuple<std::vector<core::UMEntryOperation>,
                       std::vector<core::UniqueEntryOperation>,
                       std::vector<core::UtilityTokenOperation>>;
@@ -117,17 +239,20 @@ private:
                       std::vector<core::UniqueEntryOperation>,
                       std::vector<core::UtilityTokenOperation>>;
 
-    auto extractUMEntryOperations(const std::vector<core::Transaction>& txs,
-                                  std::int64_t block_height)
-        -> std::vector<core::UMEntryOperation>;
+    auto extractUMEntryOperations(const std::vector<core::ForgeCandidate>& candidates,
+                                  std::int64_t block_height,
+                                  std::pmr::memory_resource* resource)
+        -> std::pmr::vector<core::UMEntryOperation>;
 
-    auto extractUniqueEntryOperations(const std::vector<core::Transaction>& txs,
-                                      std::int64_t block_height)
-        -> std::vector<core::UniqueEntryOperation>;
+    auto extractUniqueEntryOperations(const std::vector<core::ForgeCandidate>& candidates,
+                                      std::int64_t block_height,
+                                      std::pmr::memory_resource* resource)
+        -> std::pmr::vector<core::UniqueEntryOperation>;
 
-    auto extractUtilityTokenOperations(const std::vector<core::Transaction>& txs,
-                                       std::int64_t block_height)
-        -> std::vector<core::UtilityTokenOperation>;
+    auto extractUtilityTokenOperations(const std::vector<core::ForgeCandidate>& candidates,
+                                       std::int64_t block_height,
+                                       std::pmr::memory_resource* resource)
+        -> std::pmr::vector<core::UtilityTokenOperation>;
 
 private:
     std::unique_ptr<client::ReadOnlyClientBase> client_;
@@ -136,8 +261,16 @@ private:
     UMEntryLookup um_entry_lookup_;
     UniqueEntryLookup unique_entry_lookup_;
     UtilityTokenLookup utility_token_lookup_;
+    KeyDirectory key_directory_;
     std::int64_t lookup_block_height_;
     std::vector<std::string> block_hashes_;
+    std::vector<core::EntryKey> touched_keys_;
+    std::unique_ptr<ChangeFeed> change_feed_;
+
+    //backing storage of the per block arena, it is reused
+    //for every block so most blocks do not allocate any
+    //temporaries from the heap while being filtered
+    std::vector<std::byte> block_arena_buffer_;
 };
 
 } // namespace forge::lookup
@@ -4,6 +4,10 @@
 #include <entrys/uentry/UniqueEntryOperation.hpp>
 #include <lookup/LookupError.hpp>
 #include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <utility>
 #include <utils/Opt.hpp>
 #include <utils/Result.hpp>
 
@@ -17,7 +21,10 @@ public:
     UniqueEntryLookup(const LookupManager* const manager,
                       std::int64_t start_block = 0);
 
-    auto executeOperations(std::vector<core::UniqueEntryOperation>&& ops)
+    //temporaries needed to filter the operations are
+    //allocated from the given memory resource
+    auto executeOperations(std::vector<core::UniqueEntryOperation>&& ops,
+                           std::pmr::memory_resource* resource = std::pmr::get_default_resource())
         -> void;
 
     auto lookup(const core::EntryKey& key) const
@@ -62,15 +69,31 @@ public:
     auto isCurrentlyValid(const core::UniqueEntryOperation& op) const
         -> bool;
 
-    auto filterNonRelevantOperations(std::vector<core::UniqueEntryOperation>&& ops) const
+    auto filterNonRelevantOperations(std::vector<core::UniqueEntryOperation>&& ops,
+                                     std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const
         -> std::vector<core::UniqueEntryOperation>;
 
     auto clear()
         -> void;
 
+    //number of entrys in the lookup
+    auto size() const
+        -> std::size_t;
+
     auto getUniqueEntrysOfOwner(const std::string& owner) const
         -> std::vector<core::UniqueEntry>;
 
+    //entrys of all given owners, ordered by owner and key
+    auto getUniqueEntrysOfOwners(const std::set<std::string>& owners) const
+        -> std::vector<core::UniqueEntry>;
+
+    //at most limit entrys of the owner ordered by key,
+    //starting with the first key greater than after
+    auto getUniqueEntrysOfOwner(const std::string& owner,
+                                const utils::Opt<core::EntryKey>& after,
+                                std::size_t limit) const
+        -> std::vector<core::UniqueEntry>;
+
     auto operator()(core::UniqueEntryCreationOp&& op)
         -> void;
 
@@ -89,6 +112,8 @@ private:
                                         std::string, //owner
                                         std::int64_t>>; //block
     MapType lookup_map_;
+    //keys of the entrys ordered by owner and key
+    std::set<std::pair<std::string, core::EntryKey>> owner_index_;
     const LookupManager* const manager_;
     std::int64_t block_height_;
     std::int64_t start_block_;
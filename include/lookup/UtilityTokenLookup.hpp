@@ -6,7 +6,11 @@
 #include <entrys/token/UtilityTokenCreationOp.hpp>
 #include <entrys/token/UtilityTokenOperation.hpp>
 #include <lookup/LookupError.hpp>
+#include <functional>
 #include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <utils/Opt.hpp>
@@ -22,8 +26,10 @@ class UtilityTokenLookup final
 public:
     UtilityTokenLookup(const LookupManager* const manager, std::int64_t start_block = 0);
 
-    //filters out operations which would be illegal and then executes them
-    auto executeOperations(std::vector<core::UtilityTokenOperation>&& ops)
+    //filters out operations which would be illegal and then executes them,
+    //temporaries of the filtering are allocated from the given memory resource
+    auto executeOperations(std::vector<core::UtilityTokenOperation>&& ops,
+                           std::pmr::memory_resource* resource = std::pmr::get_default_resource())
         -> void;
 
     auto setBlockHeight(std::int64_t height)
@@ -45,6 +51,18 @@ public:
     auto getUtilityTokensOfOwner(std::string_view owner) const
         -> std::vector<core::UtilityToken>;
 
+    //tokens of all given owners ordered by token id, with
+    //one pair for every owner holding a token
+    auto getUtilityTokensOfOwners(const std::set<std::string>& owners) const
+        -> std::vector<core::UtilityToken>;
+
+    //at most limit tokens of the owner ordered by token id,
+    //starting with the first id greater than after
+    auto getUtilityTokensOfOwner(std::string_view owner,
+                                 const utils::Opt<std::vector<std::byte>>& after,
+                                 std::size_t limit) const
+        -> std::vector<core::UtilityToken>;
+
     auto getNumberOfTokens() const
         -> std::int64_t;
 
@@ -64,9 +82,15 @@ public:
         -> void;
 
 private:
-    //throws away operations which would be illegal
-    auto filterNonRelevantOperations(std::vector<core::UtilityTokenOperation>&& ops) const
-        -> std::vector<core::UtilityTokenOperation>;
+    //indices into the operations given to filterNonRelevantOperations,
+    //the operations are only moved after all of them were filtered
+    using OperationIndices = std::pmr::vector<std::size_t>;
+
+    //throws away operations which would be illegal and returns
+    //the indices of the operations which should be executed
+    auto filterNonRelevantOperations(const std::vector<core::UtilityTokenOperation>& ops,
+                                     std::pmr::memory_resource* resource) const
+        -> OperationIndices;
 
     //expects operations of exactly one token
     //filters out operations which would be illegal
@@ -75,30 +99,34 @@ private:
     //or transfers/deletions which would spend more than
     //the sender ownes
     auto filterOperationsPerToken(const std::vector<std::byte>& token_id,
-                                  std::vector<core::UtilityTokenOperation>&& ops) const
-        -> std::vector<core::UtilityTokenOperation>;
+                                  const std::vector<core::UtilityTokenOperation>& ops,
+                                  const OperationIndices& indices) const
+        -> OperationIndices;
 
     //returns true if a token with a given id exists, false otherwise
     auto checkIfTokenExists(const std::vector<std::byte>& token_id) const
         -> bool;
 
     //groups the transactions according to which token they refer
-    auto groupOperationsByToken(std::vector<core::UtilityTokenOperation>&& ops) const
-        -> std::map<std::vector<std::byte>,
-                    std::vector<core::UtilityTokenOperation>>;
+    auto groupOperationsByToken(const std::vector<core::UtilityTokenOperation>& ops,
+                                std::pmr::memory_resource* resource) const
+        -> std::pmr::map<std::reference_wrapper<const std::vector<std::byte>>,
+                         OperationIndices,
+                         std::less<std::vector<std::byte>>>;
 
-    auto groupOperationsByCreator(std::vector<core::UtilityTokenOperation>&& ops) const
-        -> std::unordered_map<std::string,
-                              std::vector<
-                                  core::UtilityTokenOperation>>;
+    auto groupOperationsByCreator(const std::vector<core::UtilityTokenOperation>& ops,
+                                  const OperationIndices& indices) const
+        -> std::pmr::unordered_map<std::string_view,
+                                   OperationIndices>;
 
     //extracts the relevant operations for a user based on his balance
     //it is assumed that all operations are transfers or deletions
     //and that all operations have the same creator
     auto extractRelevantOperations(const std::string& creator,
                                    const std::vector<std::byte>& token,
-                                   std::vector<core::UtilityTokenOperation>&& ops) const
-        -> std::vector<core::UtilityTokenOperation>;
+                                   const std::vector<core::UtilityTokenOperation>& ops,
+                                   OperationIndices&& indices) const
+        -> OperationIndices;
 
 
 
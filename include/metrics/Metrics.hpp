@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace forge::metrics {
+
+//label names and values of one time series
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+class Counter final
+{
+public:
+    auto increment(std::uint64_t value = 1)
+        -> void;
+
+    auto get() const
+        -> std::uint64_t;
+
+private:
+    std::atomic_uint64_t value_{0};
+};
+
+class Gauge final
+{
+public:
+    auto set(std::int64_t value)
+        -> void;
+
+    auto add(std::int64_t value)
+        -> void;
+
+    auto get() const
+        -> std::int64_t;
+
+private:
+    std::atomic_int64_t value_{0};
+};
+
+//histogram of durations, the bounds of the
+//buckets are given in seconds
+class Histogram final
+{
+public:
+    explicit Histogram(std::vector<double> bounds);
+
+    auto observe(std::chrono::nanoseconds duration)
+        -> void;
+
+    auto getBounds() const
+        -> const std::vector<double>&;
+
+    //number of observations per bucket, the last one
+    //counts the observations above all bounds
+    auto getBucketCounts() const
+        -> std::vector<std::uint64_t>;
+
+    auto getCount() const
+        -> std::uint64_t;
+
+    //sum of all observations in seconds
+    auto getSum() const
+        -> double;
+
+private:
+    std::vector<double> bounds_;
+    std::vector<std::int64_t> bounds_ns_;
+    std::unique_ptr<std::atomic_uint64_t[]> buckets_;
+    std::atomic_uint64_t count_{0};
+    std::atomic_uint64_t sum_ns_{0};
+};
+
+//observes the lifetime of the timer
+class ScopedTimer final
+{
+public:
+    explicit ScopedTimer(Histogram& histogram);
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer(ScopedTimer&&) = delete;
+    auto operator=(const ScopedTimer&) -> ScopedTimer& = delete;
+    auto operator=(ScopedTimer&&) -> ScopedTimer& = delete;
+
+    ~ScopedTimer();
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+//buckets from 50us to 10s
+auto defaultLatencyBounds()
+    -> std::vector<double>;
+
+//holds all metrics of the process. getting a metric registers it on
+//first use, the returned references stay valid for the lifetime of the
+//registry. updating a metric never locks, so hot paths should keep the
+//reference instead of looking it up again
+class Registry final
+{
+public:
+    auto counter(const std::string& name,
+                 const std::string& help,
+                 const Labels& labels = {})
+        -> Counter&;
+
+    auto gauge(const std::string& name,
+               const std::string& help,
+               const Labels& labels = {})
+        -> Gauge&;
+
+    //the bounds are only used when the histogram is registered
+    auto histogram(const std::string& name,
+                   const std::string& help,
+                   const Labels& labels = {},
+                   std::vector<double> bounds = defaultLatencyBounds())
+        -> Histogram&;
+
+    //all metrics in the prometheus text exposition format
+    auto render() const
+        -> std::string;
+
+private:
+    template<class T>
+    struct Family
+    {
+        std::string help;
+        std::map<Labels, std::unique_ptr<T>> series;
+    };
+
+    template<class T, class Factory>
+    static auto getOrCreate(std::map<std::string, Family<T>>& families,
+                            std::shared_mutex& mtx,
+                            const std::string& name,
+                            const std::string& help,
+                            const Labels& labels,
+                            Factory&& create)
+        -> T&;
+
+private:
+    mutable std::shared_mutex mtx_;
+    std::map<std::string, Family<Counter>> counters_;
+    std::map<std::string, Family<Gauge>> gauges_;
+    std::map<std::string, Family<Histogram>> histograms_;
+};
+
+//registry of the process
+auto getRegistry()
+    -> Registry&;
+
+} // namespace forge::metrics
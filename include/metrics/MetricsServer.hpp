@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <metrics/Metrics.hpp>
+#include <metrics/MetricsError.hpp>
+#include <thread>
+#include <utils/Result.hpp>
+
+namespace forge::metrics {
+
+//serves the metrics of a registry on GET /metrics. it only
+//listens on the loopback interface and answers one scrape
+//at a time, which is all a scraper needs
+class MetricsServer final
+{
+public:
+    explicit MetricsServer(const Registry& registry);
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer(MetricsServer&&) = delete;
+    auto operator=(const MetricsServer&) -> MetricsServer& = delete;
+    auto operator=(MetricsServer&&) -> MetricsServer& = delete;
+
+    ~MetricsServer();
+
+    //port 0 binds to a free port, see getPort
+    auto start(std::uint16_t port)
+        -> utils::Result<void, MetricsError>;
+
+    auto stop()
+        -> void;
+
+    auto getPort() const
+        -> std::uint16_t;
+
+private:
+    auto acceptConnections()
+        -> void;
+
+    auto handleConnection(int connection)
+        -> void;
+
+private:
+    const Registry& registry_;
+    int socket_ = -1;
+    std::uint16_t port_ = 0;
+    std::atomic_bool running_{false};
+    std::thread acceptor_;
+};
+
+} // namespace forge::metrics
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace forge::rpc {
+
+//classes of rpc methods, a class is preferred
+//over all classes following it
+enum class Priority : std::size_t {
+    Lookup = 0,
+    WalletRead = 1,
+    WalletWrite = 2
+};
+
+constexpr inline std::size_t NUMBER_OF_PRIORITIES = 3;
+
+auto priorityToString(Priority priority)
+    -> std::string_view;
+
+//unknown methods are treated as wallet writes
+auto priorityOf(std::string_view method)
+    -> Priority;
+
+//methods which never take a slot, because they only read
+//stats and have to work under load
+auto isAdmissionExempt(std::string_view method)
+    -> bool;
+
+//methods which hold their thread while they wait for changes or a job.
+//they do not take a slot, but only a limited number waits at once
+auto isLongPoll(std::string_view method)
+    -> bool;
+
+struct AdmissionLimits
+{
+    //requests executed at once over all classes, 0 for no limit
+    std::size_t max_concurrent = 10;
+    //requests of one class executed at once, 0 for no limit
+    std::array<std::size_t, NUMBER_OF_PRIORITIES> class_limits{0, 0, 2};
+    //requests of one method executed at once
+    std::map<std::string, std::size_t, std::less<>> method_limits{
+        {"rebuildlookup", 1},
+        {"updatelookup", 1}};
+    //requests waiting for a slot, more are shed or rejected
+    std::size_t max_queued = 40;
+    //time a request waits for a slot before it is rejected
+    std::chrono::milliseconds queue_timeout{1000};
+    //long-polls waiting at once, more are rejected, 0 for no limit
+    std::size_t max_long_polls = 4;
+    //workers executing submitted jobs
+    std::size_t job_workers = 2;
+    //submitted jobs waiting for a worker, more are rejected
+    std::size_t max_queued_jobs = 10000;
+};
+
+class AdmissionRejected final : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+//while a scope lives, requests of its thread are rejected at once
+//instead of waiting for a slot. used on threads which must not block,
+//like the io threads of the EpollHttpServer
+class NoWaitScope final
+{
+public:
+    NoWaitScope();
+
+    NoWaitScope(const NoWaitScope&) = delete;
+    NoWaitScope(NoWaitScope&&) = delete;
+    auto operator=(const NoWaitScope&) -> NoWaitScope& = delete;
+    auto operator=(NoWaitScope&&) -> NoWaitScope& = delete;
+
+    ~NoWaitScope();
+
+    //true if the calling thread is in a scope
+    static auto isActive()
+        -> bool;
+
+private:
+    bool was_active_;
+};
+
+struct PriorityStats
+{
+    std::size_t in_flight = 0;
+    std::size_t queued = 0;
+    std::uint64_t admitted = 0;
+    //rejected because the queue was full of requests
+    //of the same or a higher priority
+    std::uint64_t rejected = 0;
+    //dropped from the queue for a request of a higher priority
+    std::uint64_t shed = 0;
+    std::uint64_t timed_out = 0;
+};
+
+//limits the requests executed at once. requests which do not get a
+//slot wait in a bounded queue, from which the highest priority is
+//served first. a full queue drops its newest request of the lowest
+//priority for a more important one, and requests still waiting when
+//their deadline passes are rejected, so under load some requests fail
+//fast instead of all of them getting slow
+class AdmissionController final
+{
+public:
+    //a slot, which is given back when the permit is destroyed
+    class Permit final
+    {
+    public:
+        Permit(AdmissionController* controller,
+               Priority priority,
+               std::string method);
+
+        Permit(const Permit&) = delete;
+        Permit(Permit&&) noexcept;
+        auto operator=(const Permit&) -> Permit& = delete;
+        auto operator=(Permit&&) -> Permit& = delete;
+
+        ~Permit();
+
+    private:
+        AdmissionController* controller_;
+        Priority priority_;
+        std::string method_;
+    };
+
+    explicit AdmissionController(AdmissionLimits limits = {});
+
+    //waits for a slot for the method, throws AdmissionRejected if the
+    //request is not admitted. inside a NoWaitScope it does not wait
+    auto admit(std::string_view method)
+        -> Permit;
+
+    //waits for a slot for a job without a deadline. the job does not take
+    //a place in the queue, so it is never shed, and it only starts when no
+    //queued request could, because the job queue already bounds the jobs
+    auto admitJob(std::string_view method)
+        -> Permit;
+
+    auto getStats() const
+        -> std::array<PriorityStats, NUMBER_OF_PRIORITIES>;
+
+    //number of long-polls which are currently waiting
+    auto getLongPolls() const
+        -> std::size_t;
+
+    auto getLimits() const
+        -> const AdmissionLimits&;
+
+private:
+    //lives on the stack of the waiting thread
+    struct Waiter
+    {
+        Priority priority;
+        std::string_view method;
+        bool shed;
+    };
+
+    //does not lock, the caller needs to hold the lock
+    auto canStart(Priority priority,
+                  std::string_view method) const
+        -> bool;
+
+    //true if no waiter which could start is queued before the given one
+    auto isNext(std::list<Waiter*>::const_iterator waiter) const
+        -> bool;
+
+    //long-polls never queue, they are rejected at once if the limit is reached
+    auto admitLongPoll(std::string_view method)
+        -> Permit;
+
+    //drops the newest waiter with a lower priority than the
+    //given one, returns false if there is none
+    auto shedFor(Priority priority)
+        -> bool;
+
+    auto start(Priority priority,
+               std::string_view method)
+        -> Permit;
+
+    auto release(Priority priority,
+                 const std::string& method)
+        -> void;
+
+private:
+    AdmissionLimits limits_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable slot_freed_;
+    //ordered by priority, then by arrival
+    std::list<Waiter*> queue_;
+    std::size_t in_flight_ = 0;
+    std::size_t long_polls_ = 0;
+    std::map<std::string, std::size_t, std::less<>> method_in_flight_;
+    std::array<PriorityStats, NUMBER_OF_PRIORITIES> stats_;
+};
+
+} // namespace forge::rpc
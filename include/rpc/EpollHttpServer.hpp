@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <jsonrpccpp/server/abstractserverconnector.h>
+#include <jsonrpccpp/server/iclientconnectionhandler.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <utils/Opt.hpp>
+#include <utils/WorkerPool.hpp>
+#include <vector>
+
+namespace forge::rpc {
+
+enum class HttpParseStatus {
+    Complete,
+    Incomplete,
+    BadRequest,
+    MethodNotAllowed,
+    PayloadTooLarge,
+    NotImplemented
+};
+
+//a request parsed from a connection buffer, body
+//points into the buffer which was parsed
+struct HttpRequest
+{
+    HttpParseStatus status;
+    //the url of the request line
+    std::string_view target;
+    std::string_view body;
+    bool keep_alive;
+    //number of bytes of the buffer the request occupies
+    std::size_t size;
+};
+
+//parses the first http request from the buffer,
+//only POST requests with a Content-Length are supported
+auto parseHttpRequest(std::string_view buffer,
+                      std::size_t max_body_size)
+    -> HttpRequest;
+
+//finds the value of the "method" member of a json-rpc request
+//without parsing the whole request. returns nullopt for batches
+//and requests without a method
+auto extractRpcMethod(std::string_view body)
+    -> utils::Opt<std::string_view>;
+
+//returns true for methods which only read the in memory lookup or
+//wallet and can be answered on the io threads without blocking them
+auto isInlineRpcMethod(std::string_view method)
+    -> bool;
+
+//json-rpc over http/1.1 with keep-alive and pipelining on top of epoll.
+//every io thread owns an epoll instance and the connections it accepted.
+//cheap requests are handled inline on the io threads, all others are
+//handed to a bounded worker pool, so slow wallet operations or indexing
+//cannot occupy the threads which answer lookups
+class EpollHttpServer final : public jsonrpc::AbstractServerConnector
+{
+public:
+    using InlinePredicate = std::function<bool(std::string_view)>;
+
+    EpollHttpServer(std::uint16_t port,
+                    std::size_t number_of_io_threads,
+                    std::size_t number_of_workers,
+                    std::size_t max_queued_requests,
+                    InlinePredicate runs_inline = isInlineRpcMethod);
+
+    EpollHttpServer(const EpollHttpServer&) = delete;
+    EpollHttpServer(EpollHttpServer&&) = delete;
+    auto operator=(const EpollHttpServer&) -> EpollHttpServer& = delete;
+    auto operator=(EpollHttpServer&&) -> EpollHttpServer& = delete;
+
+    ~EpollHttpServer();
+
+    auto StartListening()
+        -> bool override;
+
+    auto StopListening()
+        -> bool override;
+
+    //the bound port, useful if the server was created with port 0
+    auto getPort() const
+        -> std::uint16_t;
+
+    //requests to the url are handled by the given handler instead of the
+    //handler of the connector, like the HttpServer of libjson-rpc-cpp.
+    //not thread safe, urls have to be added before the server is started
+    auto SetUrlHandler(const std::string& url,
+                       jsonrpc::IClientConnectionHandler* handler)
+        -> void;
+
+private:
+    struct Connection
+    {
+        int fd;
+        std::string input;
+        std::string output;
+        std::size_t output_offset = 0;
+        //a request of the connection is processed by the worker pool,
+        //following pipelined requests wait until it is answered and
+        //the connection is not read from in the meantime
+        bool waiting_for_worker = false;
+        bool close_after_write = false;
+        //the peer shut down its sending side
+        bool peer_closed = false;
+        //events the connection is registered for in epoll
+        std::uint32_t events = 0;
+    };
+
+    struct IoThread
+    {
+        int epoll_fd = -1;
+        int wakeup_fd = -1;
+        std::thread thread;
+        std::unordered_map<std::uint64_t, Connection> connections;
+
+        //responses of the worker pool which need to be written
+        std::mutex completed_mtx;
+        std::vector<std::pair<std::uint64_t, std::string>> completed;
+    };
+
+    auto runIoThread(IoThread& io)
+        -> void;
+
+    auto acceptConnections(IoThread& io)
+        -> void;
+
+    auto readFrom(IoThread& io,
+                  std::uint64_t id,
+                  Connection& connection)
+        -> void;
+
+    auto processRequests(IoThread& io,
+                         std::uint64_t id,
+                         Connection& connection)
+        -> void;
+
+    auto processCompletions(IoThread& io)
+        -> void;
+
+    //writes as much of the output as possible and closes
+    //the connection if it is done
+    auto flush(IoThread& io,
+               std::uint64_t id,
+               Connection& connection)
+        -> void;
+
+    auto closeConnection(IoThread& io,
+                         std::uint64_t id)
+        -> void;
+
+    auto closeAll()
+        -> void;
+
+    //passes the request to the handler of its url
+    auto handle(std::string_view target,
+                const std::string& request,
+                std::string& response)
+        -> void;
+
+private:
+    std::uint16_t port_;
+    std::size_t number_of_io_threads_;
+    std::size_t number_of_workers_;
+    std::size_t max_queued_requests_;
+    InlinePredicate runs_inline_;
+    std::unordered_map<std::string, jsonrpc::IClientConnectionHandler*> url_handlers_;
+
+    int listen_fd_ = -1;
+    std::atomic_bool running_{false};
+    std::atomic_uint64_t next_connection_id_{0};
+    std::vector<std::unique_ptr<IoThread>> io_threads_;
+    std::unique_ptr<utils::WorkerPool> workers_;
+};
+
+} // namespace forge::rpc
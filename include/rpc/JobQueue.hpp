@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <json/value.h>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utils/Opt.hpp>
+#include <utils/WorkerPool.hpp>
+
+namespace forge::rpc {
+
+enum class JobState {
+    Queued,
+    Running,
+    Done,
+    Failed
+};
+
+auto jobStateToString(JobState state)
+    -> std::string_view;
+
+struct JobStatus
+{
+    std::string id;
+    std::string method;
+    JobState state;
+    //the response of the method if the job is done
+    Json::Value result;
+    //the reason if the job failed
+    std::string error;
+};
+
+//runs rpc methods in the background, so a client can submit a
+//request, get a job id right away and ask for the result later.
+//the jobs are executed by a fixed number of workers and the number
+//of waiting jobs is bounded. only the newest finished jobs are
+//remembered, older results are dropped
+class JobQueue final
+{
+public:
+    JobQueue(std::size_t number_of_workers,
+             std::size_t max_queued_jobs,
+             std::size_t max_finished_jobs);
+
+    //returns the id of the job, nullopt if the queue is full.
+    //a job which throws fails with the message of the exception
+    auto submit(std::string method,
+                std::function<Json::Value()> job)
+        -> utils::Opt<std::string>;
+
+    //nullopt if the job is unknown or was already dropped
+    auto getStatus(const std::string& id) const
+        -> utils::Opt<JobStatus>;
+
+    //waits until the job is finished or the timeout passed
+    //and returns its status at that point
+    auto waitFor(const std::string& id,
+                 std::chrono::milliseconds timeout) const
+        -> utils::Opt<JobStatus>;
+
+    auto getNumberOfQueuedJobs() const
+        -> std::size_t;
+
+    //finishes the running jobs, queued jobs are not executed anymore
+    auto stop()
+        -> void;
+
+private:
+    auto run(const std::string& id,
+             const std::function<Json::Value()>& job)
+        -> void;
+
+    auto finish(const std::string& id,
+                JobState state,
+                Json::Value result,
+                std::string error)
+        -> void;
+
+    static auto isFinished(const JobStatus& status)
+        -> bool;
+
+private:
+    mutable std::mutex mtx_;
+    mutable std::condition_variable job_finished_;
+    std::unordered_map<std::string, JobStatus> jobs_;
+    //ids of the finished jobs, oldest first
+    std::deque<std::string> finished_;
+    std::uint64_t next_id_ = 0;
+    std::size_t max_finished_jobs_;
+
+    //declared last, so the workers are joined
+    //before the state they use is destroyed
+    utils::WorkerPool pool_;
+};
+
+} // namespace forge::rpc
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <json/value.h>
+#include <utility>
+
+namespace forge::rpc {
+
+//builds a json array in one pass, appending every converted
+//element in place instead of copying the growing array
+template<class Range, class Func>
+auto toJsonArray(Range&& range, Func&& func)
+    -> Json::Value
+{
+    Json::Value json{Json::arrayValue};
+    for(auto&& elem : range) {
+        json.append(func(std::forward<decltype(elem)>(elem)));
+    }
+
+    return json;
+}
+
+template<class Range>
+auto toJsonArray(Range&& range)
+    -> Json::Value
+{
+    return toJsonArray(std::forward<Range>(range),
+                       [](const auto& elem) {
+                           return elem.toJson();
+                       });
+}
+
+} // namespace forge::rpc
@@ -4,10 +4,21 @@
 #include <entrys/token/UtilityToken.hpp>
 #include <json/value.h>
 #include <jsonrpccpp/server/connectors/httpserver.h>
+#include <jsonrpccpp/server/iclientconnectionhandler.h>
 #include <lookup/LookupManager.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <rpc/AdmissionControl.hpp>
+#include <rpc/JobQueue.hpp>
+#include <rpc/ResponseCache.hpp>
 #include <rpc/abstractjsonrpcstubserver.h>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <utils/Opt.hpp>
 #include <variant>
+#include <vector>
 #include <wallet/ReadOnlyWallet.hpp>
 #include <wallet/ReadWriteWallet.hpp>
 
@@ -16,20 +27,37 @@ namespace forge::rpc {
 class JsonRpcServer : public AbstractJsonRpcStubSever
 {
 public:
+    using Wallet = std::variant<wallet::ReadWriteWallet,
+                                wallet::ReadOnlyWallet>;
+
     JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
                   jsonrpc::serverVersion_t type,
-                  wallet::ReadWriteWallet&& wallet);
+                  wallet::ReadWriteWallet&& wallet,
+                  AdmissionLimits admission_limits = {});
 
     JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
                   jsonrpc::serverVersion_t type,
-                  wallet::ReadOnlyWallet&& wallet);
+                  wallet::ReadOnlyWallet&& wallet,
+                  AdmissionLimits admission_limits = {});
 
     JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
                   jsonrpc::serverVersion_t type,
-                  lookup::LookupManager&& lookup);
+                  lookup::LookupManager&& lookup,
+                  AdmissionLimits admission_limits = {});
 
     virtual ~JsonRpcServer();
 
+    //record the latency and the errors of every method, and
+    //admit the method before it is executed
+    auto HandleMethodCall(jsonrpc::Procedure& proc,
+                          const Json::Value& input,
+                          Json::Value& output)
+        -> void override;
+
+    auto HandleNotificationCall(jsonrpc::Procedure& proc,
+                                const Json::Value& input)
+        -> void override;
+
     virtual auto updatelookup()
         -> bool override;
 
@@ -51,23 +79,64 @@ public:
     virtual auto lookupactivationblock(bool isstring, const std::string& key)
         -> int override;
 
+    virtual auto lookupmany(bool isstring, const Json::Value& keys)
+        -> Json::Value override;
+
     virtual auto checkvalidity()
         -> bool override;
 
     virtual auto getlastvalidblockheight()
         -> int override;
 
+    virtual auto getresponsecachestats()
+        -> Json::Value override;
+
+    virtual auto getadmissionstats()
+        -> Json::Value override;
+
+    //validates a wallet write and runs it in the background,
+    //returns the id of the job
+    virtual auto submitjob(const std::string& method,
+                           const Json::Value& params)
+        -> std::string override;
+
+    virtual auto getjobstatus(const std::string& id)
+        -> Json::Value override;
+
+    //long-polls until the job is finished
+    virtual auto waitjob(const std::string& id, int timeout)
+        -> Json::Value override;
+
+    //long-polls for the changes of the blocks after the given height
+    virtual auto getchangessince(int height, int timeout)
+        -> Json::Value override;
+
     virtual auto lookupallentrysof(const std::string& owner)
         -> Json::Value override;
 
     virtual auto getutilitytokensof(const std::string& owner)
         -> Json::Value override;
 
+    //the paged versions return at most limit results and a cursor
+    //which continues the listing, as long as no new block arrived
+    virtual auto lookupallentrysofpaged(const std::string& cursor,
+                                        int limit,
+                                        const std::string& owner)
+        -> Json::Value override;
+
+    virtual auto getutilitytokensofpaged(const std::string& cursor,
+                                         int limit,
+                                         const std::string& owner)
+        -> Json::Value override;
+
     virtual auto getbalanceof(bool isstring,
                               const std::string& owner,
                               const std::string& token)
         -> std::string override;
 
+    virtual auto getbalances(bool isstring, const Json::Value& pairs)
+        -> Json::Value override;
+
     virtual auto getsupplyofutilitytoken(bool isstring,
                                          const std::string& token)
         -> std::string override;
@@ -84,12 +153,18 @@ public:
         -> Json::Value override;
     virtual auto getallwatchedumentrys()
         -> Json::Value override;
+    virtual auto getallwatchedumentryspaged(const std::string& cursor,
+                                            int limit)
+        -> Json::Value override;
     virtual auto getowneduniqueentrys()
         -> Json::Value override;
     virtual auto getwatchonlyuniqueentrys()
         -> Json::Value override;
     virtual auto getallwatcheduniqueentrys()
         -> Json::Value override;
+    virtual auto getallwatcheduniqueentryspaged(const std::string& cursor,
+                                                int limit)
+        -> Json::Value override;
     virtual auto getwatchedaddresses()
         -> Json::Value override;
     virtual auto getownedaddresses()
@@ -102,6 +177,9 @@ public:
         -> Json::Value override;
     virtual auto getallwatchedutilitytokens()
         -> Json::Value override;
+    virtual auto getallwatchedutilitytokenspaged(const std::string& cursor,
+                                                 int limit)
+        -> Json::Value override;
 
     virtual auto createnewumentry(const std::string& address,
                                   int burnvalue,
@@ -165,13 +243,48 @@ public:
                                  const std::string& key)
         -> std::string override;
 
+    //pays the owners of many entrys with a few transactions
+    virtual auto paytoentryowners(bool isstring,
+                                  const Json::Value& payments)
+        -> Json::Value override;
+
     auto hasShutdownRequest() const
         -> bool;
 
-private:
     auto getLookup()
         -> lookup::LookupManager&;
 
+    //hosts another wallet next to the default one, which has to share
+    //the lookup of the server, so all wallets use one index and one
+    //updater. requests given to the returned handler are executed with
+    //the named wallet, so it is meant to be registered for a url of the
+    //connector. wallets have to be added before the server is started,
+    //adding a name twice returns the route of the first wallet
+    auto addWallet(std::string name,
+                   Wallet&& wallet)
+        -> jsonrpc::IClientConnectionHandler&;
+
+private:
+    //forwards the requests of one url to the server
+    //with its wallet selected while they are handled
+    class WalletRoute final : public jsonrpc::IClientConnectionHandler
+    {
+    public:
+        WalletRoute(jsonrpc::IClientConnectionHandler& server,
+                    Wallet&& wallet);
+
+        auto HandleRequest(const std::string& request,
+                           std::string& response)
+            -> void override;
+
+        auto getWallet()
+            -> Wallet&;
+
+    private:
+        jsonrpc::IClientConnectionHandler& server_;
+        Wallet wallet_;
+    };
+
     auto getReadOnlyWallet()
         -> wallet::ReadOnlyWallet&;
 
@@ -184,10 +297,50 @@ private:
     auto startUpdaterThread()
         -> void;
 
+    //tops up the output pools of the read write wallets,
+    //errors are only logged and retried with the next block
+    auto maintainOutputPools()
+        -> void;
+
+    //returns the cached result of the request, or computes
+    //it from the converted key and caches it
+    template<class Func>
+    auto cachedLookup(std::string_view method,
+                      bool isstring,
+                      const std::string& key,
+                      const std::string& extra,
+                      Func&& compute)
+        -> Json::Value;
+
+    //drops the cached results of all keys touched by new blocks
+    auto invalidateCache()
+        -> void;
+
+    //checks the parameters of a job against the lookup and the
+    //wallet, so obviously failing jobs are rejected right away
+    auto validateJob(const std::string& method,
+                     const Json::Value& params)
+        -> void;
+
+    //the queue of the jobs, throws if the server has no
+    //read write wallet which could run them
+    auto getJobQueue()
+        -> JobQueue&;
+
+    //addresses owned or watched by the wallet
+    auto getAllWalletAddresses()
+        -> std::vector<std::string>;
+
     auto extractEntryKey(bool isstring,
                          const std::string& key_str)
         -> core::EntryKey;
 
+    //like extractEntryKey but for single elements of a batch,
+    //returns nullopt instead of throwing
+    auto extractEntryKeyOpt(bool isstring,
+                            const Json::Value& key)
+        -> utils::Opt<core::EntryKey>;
+
 private:
     // wallet::ReadWriteWallet wallet_;
     std::variant<wallet::ReadWriteWallet,
@@ -197,8 +350,22 @@ private:
     // lookup::LookupManager& lookup_;
     std::atomic_bool should_shutdown_{false};
     std::atomic_bool indexing_{false};
+    ResponseCache cache_;
+    AdmissionController admission_;
     std::thread updater_;
     std::condition_variable shutdown_requested_;
+    //handler the connector passes requests to, the wallet routes
+    //forward their requests to it
+    jsonrpc::IClientConnectionHandler* handler_;
+    //guards the map, not the wallets, because the updater
+    //visits the wallets while more of them are added
+    std::mutex wallets_mtx_;
+    std::map<std::string, std::unique_ptr<WalletRoute>, std::less<>> wallets_;
+    //declared last, so running jobs are finished before the
+    //wallet they use is destroyed. only created with the first
+    //read write wallet, before the server listens, and not
+    //changed afterwards, so it is read without a lock
+    std::unique_ptr<JobQueue> jobs_;
 };
 
 auto waitForShutdown(const JsonRpcServer& server)
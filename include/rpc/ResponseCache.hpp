@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <json/value.h>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utils/Opt.hpp>
+#include <vector>
+
+namespace forge::rpc {
+
+//caches rpc results keyed by method and parameters. every result
+//depends on exactly one entry or token key and is dropped as soon as
+//a block touches that key, all other results stay cached
+class ResponseCache final
+{
+public:
+    ResponseCache(std::size_t max_entries = 1 << 16);
+
+    //needs to be read before the result is computed
+    //and handed to insert together with the result
+    auto getEpoch() const
+        -> std::uint64_t;
+
+    auto find(const std::string& request) const
+        -> utils::Opt<Json::Value>;
+
+    //the result is dropped if the cache was invalidated since
+    //epoch was read, because it could be computed from stale data
+    auto insert(const std::string& request,
+                const core::EntryKey& key,
+                Json::Value result,
+                std::uint64_t epoch)
+        -> void;
+
+    //drops all results depending on the given keys
+    auto invalidate(const std::vector<core::EntryKey>& keys)
+        -> void;
+
+    auto clear()
+        -> void;
+
+    auto size() const
+        -> std::size_t;
+
+    auto getHits() const
+        -> std::uint64_t;
+
+    auto getMisses() const
+        -> std::uint64_t;
+
+private:
+    mutable std::shared_mutex mtx_;
+    std::size_t max_entries_;
+    std::uint64_t epoch_ = 0;
+
+    std::unordered_map<std::string, Json::Value> results_;
+    //requests whose results depend on a key
+    std::map<core::EntryKey, std::vector<std::string>> dependencies_;
+
+    mutable std::atomic_uint64_t hits_{0};
+    mutable std::atomic_uint64_t misses_{0};
+};
+
+} // namespace forge::rpc
@@ -21,18 +21,28 @@ namespace forge {
                     this->bindAndAddMethod(jsonrpc::Procedure("lookupuniquevalue", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::lookupuniquevalueI);
                     this->bindAndAddMethod(jsonrpc::Procedure("lookupowner", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, "isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::lookupownerI);
                     this->bindAndAddMethod(jsonrpc::Procedure("lookupactivationblock", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_INTEGER, "isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::lookupactivationblockI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("lookupmany", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "isstring",jsonrpc::JSON_BOOLEAN,"keys",jsonrpc::JSON_ARRAY, NULL), &forge::rpc::AbstractJsonRpcStubSever::lookupmanyI);
                     this->bindAndAddMethod(jsonrpc::Procedure("checkvalidity", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_BOOLEAN,  NULL), &forge::rpc::AbstractJsonRpcStubSever::checkvalidityI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getlastvalidblockheight", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_INTEGER,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getlastvalidblockheightI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getresponsecachestats", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getresponsecachestatsI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getadmissionstats", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getadmissionstatsI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("submitjob", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, "method",jsonrpc::JSON_STRING,"params",jsonrpc::JSON_OBJECT, NULL), &forge::rpc::AbstractJsonRpcStubSever::submitjobI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getjobstatus", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "id",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::getjobstatusI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("waitjob", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "id",jsonrpc::JSON_STRING,"timeout",jsonrpc::JSON_INTEGER, NULL), &forge::rpc::AbstractJsonRpcStubSever::waitjobI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getchangessince", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "height",jsonrpc::JSON_INTEGER,"timeout",jsonrpc::JSON_INTEGER, NULL), &forge::rpc::AbstractJsonRpcStubSever::getchangessinceI);
                     this->bindAndAddMethod(jsonrpc::Procedure("lookupallentrysof", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY, "owner",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::lookupallentrysofI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("lookupallentrysofpaged", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "cursor",jsonrpc::JSON_STRING,"limit",jsonrpc::JSON_INTEGER,"owner",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::lookupallentrysofpagedI);
                     this->bindAndAddNotification(jsonrpc::Procedure("addwatchonlyaddress", jsonrpc::PARAMS_BY_NAME, "address",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::addwatchonlyaddressI);
                     this->bindAndAddNotification(jsonrpc::Procedure("deletewatchonlyaddress", jsonrpc::PARAMS_BY_NAME, "address",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::deletewatchonlyaddressI);
                     this->bindAndAddNotification(jsonrpc::Procedure("addnewownedaddress", jsonrpc::PARAMS_BY_NAME, "address",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::addnewownedaddressI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getownedumentrys", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getownedumentrysI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getwatchonlyumentrys", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getwatchonlyumentrysI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getallwatchedumentrys", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getallwatchedumentrysI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getallwatchedumentryspaged", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "cursor",jsonrpc::JSON_STRING,"limit",jsonrpc::JSON_INTEGER, NULL), &forge::rpc::AbstractJsonRpcStubSever::getallwatchedumentryspagedI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getowneduniqueentrys", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getowneduniqueentrysI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getwatchonlyuniqueentrys", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getwatchonlyuniqueentrysI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getallwatcheduniqueentrys", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getallwatcheduniqueentrysI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getallwatcheduniqueentryspaged", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "cursor",jsonrpc::JSON_STRING,"limit",jsonrpc::JSON_INTEGER, NULL), &forge::rpc::AbstractJsonRpcStubSever::getallwatcheduniqueentryspagedI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getwatchedaddresses", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getwatchedaddressesI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getownedaddresses", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getownedaddressesI);
                     this->bindAndAddMethod(jsonrpc::Procedure("ownesaddress", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_BOOLEAN, "address",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::ownesaddressI);
@@ -43,12 +53,16 @@ namespace forge {
                     this->bindAndAddMethod(jsonrpc::Procedure("deleteentry", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, "burnvalue",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::deleteentryI);
                     this->bindAndAddMethod(jsonrpc::Procedure("transferownership", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, "burnvalue",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING,"newowner",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::transferownershipI);
                     this->bindAndAddMethod(jsonrpc::Procedure("paytoentryowner", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, "amount",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::paytoentryownerI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("paytoentryowners", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY, "isstring",jsonrpc::JSON_BOOLEAN,"payments",jsonrpc::JSON_ARRAY, NULL), &forge::rpc::AbstractJsonRpcStubSever::paytoentryownersI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getbalanceof", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, "isstring",jsonrpc::JSON_BOOLEAN,"owner",jsonrpc::JSON_STRING,"token",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::getbalanceofI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getbalances", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "isstring",jsonrpc::JSON_BOOLEAN,"pairs",jsonrpc::JSON_ARRAY, NULL), &forge::rpc::AbstractJsonRpcStubSever::getbalancesI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getutilitytokensof", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY, "owner",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::getutilitytokensofI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getutilitytokensofpaged", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "cursor",jsonrpc::JSON_STRING,"limit",jsonrpc::JSON_INTEGER,"owner",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::getutilitytokensofpagedI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getsupplyofutilitytoken", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, "isstring",jsonrpc::JSON_BOOLEAN,"token",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::getsupplyofutilitytokenI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getownedutilitytokens", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getownedutilitytokensI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getwatchonlyutilitytokens", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getwatchonlyutilitytokensI);
                     this->bindAndAddMethod(jsonrpc::Procedure("getallwatchedutilitytokens", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY,  NULL), &forge::rpc::AbstractJsonRpcStubSever::getallwatchedutilitytokensI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getallwatchedutilitytokenspaged", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "cursor",jsonrpc::JSON_STRING,"limit",jsonrpc::JSON_INTEGER, NULL), &forge::rpc::AbstractJsonRpcStubSever::getallwatchedutilitytokenspagedI);
                     this->bindAndAddMethod(jsonrpc::Procedure("createnewutilitytoken", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, "address",jsonrpc::JSON_STRING,"burnvalue",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING,"supply",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::createnewutilitytokenI);
                     this->bindAndAddMethod(jsonrpc::Procedure("sendutilitytokens", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY, "amount",jsonrpc::JSON_STRING,"burnvalue",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING,"recipient",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::sendutilitytokensI);
                     this->bindAndAddMethod(jsonrpc::Procedure("burnutilitytokens", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY, "amount",jsonrpc::JSON_STRING,"burnvalue",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::burnutilitytokensI);
@@ -82,6 +96,10 @@ namespace forge {
                 {
                     response = this->lookupactivationblock(request["isstring"].asBool(), request["key"].asString());
                 }
+                inline virtual void lookupmanyI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->lookupmany(request["isstring"].asBool(), request["keys"]);
+                }
                 inline virtual void checkvalidityI(const Json::Value &/*request*/, Json::Value &response)
                 {
                     response = this->checkvalidity();
@@ -90,10 +108,38 @@ namespace forge {
                 {
                     response = this->getlastvalidblockheight();
                 }
+                inline virtual void getresponsecachestatsI(const Json::Value &/*request*/, Json::Value &response)
+                {
+                    response = this->getresponsecachestats();
+                }
+                inline virtual void getadmissionstatsI(const Json::Value &/*request*/, Json::Value &response)
+                {
+                    response = this->getadmissionstats();
+                }
+                inline virtual void submitjobI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->submitjob(request["method"].asString(), request["params"]);
+                }
+                inline virtual void getjobstatusI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->getjobstatus(request["id"].asString());
+                }
+                inline virtual void waitjobI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->waitjob(request["id"].asString(), request["timeout"].asInt());
+                }
+                inline virtual void getchangessinceI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->getchangessince(request["height"].asInt(), request["timeout"].asInt());
+                }
                 inline virtual void lookupallentrysofI(const Json::Value &request, Json::Value &response)
                 {
                     response = this->lookupallentrysof(request["owner"].asString());
                 }
+                inline virtual void lookupallentrysofpagedI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->lookupallentrysofpaged(request["cursor"].asString(), request["limit"].asInt(), request["owner"].asString());
+                }
                 inline virtual void addwatchonlyaddressI(const Json::Value &request)
                 {
                     this->addwatchonlyaddress(request["address"].asString());
@@ -118,6 +164,10 @@ namespace forge {
                 {
                     response = this->getallwatchedumentrys();
                 }
+                inline virtual void getallwatchedumentryspagedI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->getallwatchedumentryspaged(request["cursor"].asString(), request["limit"].asInt());
+                }
                 inline virtual void getowneduniqueentrysI(const Json::Value &/*request*/, Json::Value &response)
                 {
                     response = this->getowneduniqueentrys();
@@ -130,6 +180,10 @@ namespace forge {
                 {
                     response = this->getallwatcheduniqueentrys();
                 }
+                inline virtual void getallwatcheduniqueentryspagedI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->getallwatcheduniqueentryspaged(request["cursor"].asString(), request["limit"].asInt());
+                }
                 inline virtual void getwatchedaddressesI(const Json::Value &/*request*/, Json::Value &response)
                 {
                     response = this->getwatchedaddresses();
@@ -170,14 +224,26 @@ namespace forge {
                 {
                     response = this->paytoentryowner(request["amount"].asInt(), request["isstring"].asBool(), request["key"].asString());
                 }
+                inline virtual void paytoentryownersI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->paytoentryowners(request["isstring"].asBool(), request["payments"]);
+                }
                 inline virtual void getbalanceofI(const Json::Value &request, Json::Value &response)
                 {
                     response = this->getbalanceof(request["isstring"].asBool(), request["owner"].asString(), request["token"].asString());
                 }
+                inline virtual void getbalancesI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->getbalances(request["isstring"].asBool(), request["pairs"]);
+                }
                 inline virtual void getutilitytokensofI(const Json::Value &request, Json::Value &response)
                 {
                     response = this->getutilitytokensof(request["owner"].asString());
                 }
+                inline virtual void getutilitytokensofpagedI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->getutilitytokensofpaged(request["cursor"].asString(), request["limit"].asInt(), request["owner"].asString());
+                }
                 inline virtual void getsupplyofutilitytokenI(const Json::Value &request, Json::Value &response)
                 {
                     response = this->getsupplyofutilitytoken(request["isstring"].asBool(), request["token"].asString());
@@ -194,6 +260,10 @@ namespace forge {
                 {
                     response = this->getallwatchedutilitytokens();
                 }
+                inline virtual void getallwatchedutilitytokenspagedI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->getallwatchedutilitytokenspaged(request["cursor"].asString(), request["limit"].asInt());
+                }
                 inline virtual void createnewutilitytokenI(const Json::Value &request, Json::Value &response)
                 {
                     response = this->createnewutilitytoken(request["address"].asString(), request["burnvalue"].asInt(), request["isstring"].asBool(), request["key"].asString(), request["supply"].asString());
@@ -213,18 +283,28 @@ namespace forge {
                 virtual Json::Value lookupuniquevalue(bool isstring, const std::string& key) = 0;
                 virtual std::string lookupowner(bool isstring, const std::string& key) = 0;
                 virtual int lookupactivationblock(bool isstring, const std::string& key) = 0;
+                virtual Json::Value lookupmany(bool isstring, const Json::Value& keys) = 0;
                 virtual bool checkvalidity() = 0;
                 virtual int getlastvalidblockheight() = 0;
+                virtual Json::Value getresponsecachestats() = 0;
+                virtual Json::Value getadmissionstats() = 0;
+                virtual std::string submitjob(const std::string& method, const Json::Value& params) = 0;
+                virtual Json::Value getjobstatus(const std::string& id) = 0;
+                virtual Json::Value waitjob(const std::string& id, int timeout) = 0;
+                virtual Json::Value getchangessince(int height, int timeout) = 0;
                 virtual Json::Value lookupallentrysof(const std::string& owner) = 0;
+                virtual Json::Value lookupallentrysofpaged(const std::string& cursor, int limit, const std::string& owner) = 0;
                 virtual void addwatchonlyaddress(const std::string& address) = 0;
                 virtual void deletewatchonlyaddress(const std::string& address) = 0;
                 virtual void addnewownedaddress(const std::string& address) = 0;
                 virtual Json::Value getownedumentrys() = 0;
                 virtual Json::Value getwatchonlyumentrys() = 0;
                 virtual Json::Value getallwatchedumentrys() = 0;
+                virtual Json::Value getallwatchedumentryspaged(const std::string& cursor, int limit) = 0;
                 virtual Json::Value getowneduniqueentrys() = 0;
                 virtual Json::Value getwatchonlyuniqueentrys() = 0;
                 virtual Json::Value getallwatcheduniqueentrys() = 0;
+                virtual Json::Value getallwatcheduniqueentryspaged(const std::string& cursor, int limit) = 0;
                 virtual Json::Value getwatchedaddresses() = 0;
                 virtual Json::Value getownedaddresses() = 0;
                 virtual bool ownesaddress(const std::string& address) = 0;
@@ -235,12 +315,16 @@ namespace forge {
                 virtual std::string deleteentry(int burnvalue, bool isstring, const std::string& key) = 0;
                 virtual std::string transferownership(int burnvalue, bool isstring, const std::string& key, const std::string& newowner) = 0;
                 virtual std::string paytoentryowner(int amount, bool isstring, const std::string& key) = 0;
+                virtual Json::Value paytoentryowners(bool isstring, const Json::Value& payments) = 0;
                 virtual std::string getbalanceof(bool isstring, const std::string& owner, const std::string& token) = 0;
+                virtual Json::Value getbalances(bool isstring, const Json::Value& pairs) = 0;
                 virtual Json::Value getutilitytokensof(const std::string& owner) = 0;
+                virtual Json::Value getutilitytokensofpaged(const std::string& cursor, int limit, const std::string& owner) = 0;
                 virtual std::string getsupplyofutilitytoken(bool isstring, const std::string& token) = 0;
                 virtual Json::Value getownedutilitytokens() = 0;
                 virtual Json::Value getwatchonlyutilitytokens() = 0;
                 virtual Json::Value getallwatchedutilitytokens() = 0;
+                virtual Json::Value getallwatchedutilitytokenspaged(const std::string& cursor, int limit) = 0;
                 virtual std::string createnewutilitytoken(const std::string& address, int burnvalue, bool isstring, const std::string& key, const std::string& supply) = 0;
                 virtual Json::Value sendutilitytokens(const std::string& amount, int burnvalue, bool isstring, const std::string& key, const std::string& recipient) = 0;
                 virtual Json::Value burnutilitytokens(const std::string& amount, int burnvalue, bool isstring, const std::string& key) = 0;
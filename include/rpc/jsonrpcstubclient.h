@@ -80,6 +80,17 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value lookupmany(bool isstring, const Json::Value& keys) 
+                {
+                    Json::Value p;
+                    p["isstring"] = isstring;
+                    p["keys"] = keys;
+                    Json::Value result = this->CallMethod("lookupmany",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
                 bool checkvalidity() 
                 {
                     Json::Value p;
@@ -100,6 +111,69 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value getresponsecachestats() 
+                {
+                    Json::Value p;
+                    p = Json::nullValue;
+                    Json::Value result = this->CallMethod("getresponsecachestats",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value getadmissionstats() 
+                {
+                    Json::Value p;
+                    p = Json::nullValue;
+                    Json::Value result = this->CallMethod("getadmissionstats",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                std::string submitjob(const std::string& method, const Json::Value& params) 
+                {
+                    Json::Value p;
+                    p["method"] = method;
+                    p["params"] = params;
+                    Json::Value result = this->CallMethod("submitjob",p);
+                    if (result.isString())
+                        return result.asString();
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value getjobstatus(const std::string& id) 
+                {
+                    Json::Value p;
+                    p["id"] = id;
+                    Json::Value result = this->CallMethod("getjobstatus",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value waitjob(const std::string& id, int timeout) 
+                {
+                    Json::Value p;
+                    p["id"] = id;
+                    p["timeout"] = timeout;
+                    Json::Value result = this->CallMethod("waitjob",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value getchangessince(int height, int timeout) 
+                {
+                    Json::Value p;
+                    p["height"] = height;
+                    p["timeout"] = timeout;
+                    Json::Value result = this->CallMethod("getchangessince",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
                 Json::Value lookupallentrysof(const std::string& owner) 
                 {
                     Json::Value p;
@@ -110,6 +184,18 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value lookupallentrysofpaged(const std::string& cursor, int limit, const std::string& owner) 
+                {
+                    Json::Value p;
+                    p["cursor"] = cursor;
+                    p["limit"] = limit;
+                    p["owner"] = owner;
+                    Json::Value result = this->CallMethod("lookupallentrysofpaged",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
                 void addwatchonlyaddress(const std::string& address) 
                 {
                     Json::Value p;
@@ -158,6 +244,17 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value getallwatchedumentryspaged(const std::string& cursor, int limit) 
+                {
+                    Json::Value p;
+                    p["cursor"] = cursor;
+                    p["limit"] = limit;
+                    Json::Value result = this->CallMethod("getallwatchedumentryspaged",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
                 Json::Value getowneduniqueentrys() 
                 {
                     Json::Value p;
@@ -188,6 +285,17 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value getallwatcheduniqueentryspaged(const std::string& cursor, int limit) 
+                {
+                    Json::Value p;
+                    p["cursor"] = cursor;
+                    p["limit"] = limit;
+                    Json::Value result = this->CallMethod("getallwatcheduniqueentryspaged",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
                 Json::Value getwatchedaddresses() 
                 {
                     Json::Value p;
@@ -308,6 +416,17 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value paytoentryowners(bool isstring, const Json::Value& payments) 
+                {
+                    Json::Value p;
+                    p["isstring"] = isstring;
+                    p["payments"] = payments;
+                    Json::Value result = this->CallMethod("paytoentryowners",p);
+                    if (result.isArray())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
                 std::string getbalanceof(bool isstring, const std::string& owner, const std::string& token) 
                 {
                     Json::Value p;
@@ -320,6 +439,17 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value getbalances(bool isstring, const Json::Value& pairs) 
+                {
+                    Json::Value p;
+                    p["isstring"] = isstring;
+                    p["pairs"] = pairs;
+                    Json::Value result = this->CallMethod("getbalances",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
                 Json::Value getutilitytokensof(const std::string& owner) 
                 {
                     Json::Value p;
@@ -330,6 +460,18 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value getutilitytokensofpaged(const std::string& cursor, int limit, const std::string& owner) 
+                {
+                    Json::Value p;
+                    p["cursor"] = cursor;
+                    p["limit"] = limit;
+                    p["owner"] = owner;
+                    Json::Value result = this->CallMethod("getutilitytokensofpaged",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
                 std::string getsupplyofutilitytoken(bool isstring, const std::string& token) 
                 {
                     Json::Value p;
@@ -371,6 +513,17 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value getallwatchedutilitytokenspaged(const std::string& cursor, int limit) 
+                {
+                    Json::Value p;
+                    p["cursor"] = cursor;
+                    p["limit"] = limit;
+                    Json::Value result = this->CallMethod("getallwatchedutilitytokenspaged",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
                 std::string createnewutilitytoken(const std::string& address, int burnvalue, bool isstring, const std::string& key, const std::string& supply) 
                 {
                     Json::Value p;
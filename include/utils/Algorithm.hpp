@@ -1,7 +1,11 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
 #include <map>
+#include <optional>
 #include <set>
 #include <type_traits>
 #include <unordered_map>
@@ -83,6 +87,52 @@ auto transform(std::vector<T, Alloc>&& vec,
     return ret_vec;
 }
 
+//like transform, but op is applied by up to max_threads threads at
+//the same time. the results keep the order of the input and an
+//exception thrown by op is rethrown after all threads finished
+template<class T,
+         class Alloc,
+         class UnaryOperation>
+auto parallel_transform(const std::vector<T, Alloc>& vec,
+                        std::size_t max_threads,
+                        UnaryOperation op)
+{
+    using OpReturnType = std::invoke_result_t<UnaryOperation, const T&>;
+
+    std::vector<std::optional<OpReturnType>> results(vec.size());
+    std::atomic_size_t next{0};
+
+    auto work = [&] {
+        for(auto i = next++; i < vec.size(); i = next++) {
+            results[i].emplace(op(vec[i]));
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    auto number_of_workers = std::min(std::max<std::size_t>(max_threads, 1),
+                                      vec.size());
+    for(std::size_t i = 0; i < number_of_workers; i++) {
+        workers.push_back(std::async(std::launch::async, work));
+    }
+
+    //all workers are joined before an exception is rethrown,
+    //because they reference the locals of this function
+    for(auto& worker : workers) {
+        worker.wait();
+    }
+    for(auto& worker : workers) {
+        worker.get();
+    }
+
+    std::vector<OpReturnType> ret_vec;
+    ret_vec.reserve(results.size());
+    for(auto& result : results) {
+        ret_vec.push_back(std::move(result.value()));
+    }
+
+    return ret_vec;
+}
+
 template<class Key,
          class T,
          class Compare,
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace forge::utils {
+
+//non owning view of a contiguous sequence of bytes,
+//the viewed bytes need to outlive the view
+class ByteView
+{
+public:
+    using value_type = std::byte;
+    using const_iterator = const std::byte*;
+    using iterator = const_iterator;
+
+    constexpr ByteView() = default;
+
+    constexpr ByteView(const std::byte* data,
+                       std::size_t size)
+        : data_(data),
+          size_(size) {}
+
+    ByteView(const std::vector<std::byte>& bytes)
+        : ByteView(bytes.data(), bytes.size()) {}
+
+    template<std::size_t N>
+    constexpr ByteView(const std::array<std::byte, N>& bytes)
+        : ByteView(bytes.data(), N) {}
+
+    constexpr auto data() const
+        -> const std::byte*
+    {
+        return data_;
+    }
+
+    constexpr auto size() const
+        -> std::size_t
+    {
+        return size_;
+    }
+
+    constexpr auto empty() const
+        -> bool
+    {
+        return size_ == 0;
+    }
+
+    constexpr auto begin() const
+        -> const_iterator
+    {
+        return data_;
+    }
+
+    constexpr auto end() const
+        -> const_iterator
+    {
+        return data_ + size_;
+    }
+
+    constexpr auto operator[](std::size_t idx) const
+        -> std::byte
+    {
+        return data_[idx];
+    }
+
+    //returns a view of at most count bytes starting at offset,
+    //offset needs to be smaller or equal to size()
+    constexpr auto subview(std::size_t offset,
+                           std::size_t count = static_cast<std::size_t>(-1)) const
+        -> ByteView
+    {
+        return ByteView{data_ + offset,
+                        std::min(count, size_ - offset)};
+    }
+
+    //copies the viewed bytes into an owning vector
+    auto toVector() const
+        -> std::vector<std::byte>
+    {
+        return std::vector<std::byte>(begin(), end());
+    }
+
+private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+inline auto operator==(ByteView lhs, ByteView rhs)
+    -> bool
+{
+    return std::equal(lhs.begin(), lhs.end(),
+                      rhs.begin(), rhs.end());
+}
+
+inline auto operator!=(ByteView lhs, ByteView rhs)
+    -> bool
+{
+    return !(lhs == rhs);
+}
+
+} // namespace forge::utils
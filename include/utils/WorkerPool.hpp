@@ -0,0 +1,116 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace forge::utils {
+
+//fixed number of threads working through a bounded queue of jobs.
+//jobs which do not fit into the queue are rejected instead of
+//piling up, so callers can answer them right away
+class WorkerPool final
+{
+public:
+    WorkerPool(std::size_t number_of_workers,
+               std::size_t max_queued_jobs)
+        : max_queued_jobs_(max_queued_jobs)
+    {
+        for(std::size_t i = 0; i < number_of_workers; i++) {
+            workers_.emplace_back([this] {
+                work();
+            });
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    auto operator=(const WorkerPool&) -> WorkerPool& = delete;
+    auto operator=(WorkerPool&&) -> WorkerPool& = delete;
+
+    ~WorkerPool()
+    {
+        stop();
+    }
+
+    //returns false if the queue is full or the pool was stopped
+    auto trySubmit(std::function<void()> job)
+        -> bool
+    {
+        {
+            std::unique_lock lock{mtx_};
+            if(stopped_ || jobs_.size() >= max_queued_jobs_) {
+                return false;
+            }
+
+            jobs_.push_back(std::move(job));
+        }
+
+        cv_.notify_one();
+        return true;
+    }
+
+    //finishes the running jobs, drops all queued ones
+    //and joins the workers
+    auto stop()
+        -> void
+    {
+        {
+            std::unique_lock lock{mtx_};
+            stopped_ = true;
+            jobs_.clear();
+        }
+        cv_.notify_all();
+
+        for(auto& worker : workers_) {
+            if(worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    auto getNumberOfQueuedJobs() const
+        -> std::size_t
+    {
+        std::unique_lock lock{mtx_};
+        return jobs_.size();
+    }
+
+private:
+    auto work()
+        -> void
+    {
+        while(true) {
+            std::function<void()> job;
+            {
+                std::unique_lock lock{mtx_};
+                cv_.wait(lock, [this] {
+                    return stopped_ || !jobs_.empty();
+                });
+
+                if(stopped_) {
+                    return;
+                }
+
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+
+            job();
+        }
+    }
+
+private:
+    std::size_t max_queued_jobs_;
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    bool stopped_ = false;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace forge::utils
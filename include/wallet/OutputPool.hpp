@@ -0,0 +1,115 @@
+#pragma once
+
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utils/Opt.hpp>
+#include <vector>
+#include <wallet/UtxoSet.hpp>
+
+namespace forge::wallet {
+
+struct OutputPoolConfig
+{
+    //number of outputs kept ready, 0 disables the pool
+    std::size_t target = 0;
+    //burn the outputs are sized for, an operation burning
+    //at most this amount can be paid by a pool output
+    std::int64_t burn_amount = 0;
+};
+
+//addresses of the wallet holding one output each which was split off
+//ahead of time. new entrys are created from these addresses, so an
+//operation does not have to wait until a freshly funded output matured.
+//once the output of an address arrived it is locked in the node wallet,
+//so the node does not spend it to fund other transactions, and the pool
+//keeps it, because listunspent does not report locked outputs.
+//an address stays in the pool until its output is taken by an operation
+class OutputPool final
+{
+public:
+    explicit OutputPool(OutputPoolConfig config);
+
+    auto getConfig() const
+        -> const OutputPoolConfig&;
+
+    //adds addresses which were funded in a transaction
+    //sent at the given block height
+    auto add(const std::vector<std::string>& addresses,
+             std::int64_t block_height)
+        -> void;
+
+    //the outputs of the set which arrived at addresses of
+    //the pool whose output is not held yet
+    auto arrived(const UtxoSet& utxos) const
+        -> std::vector<core::Unspent>;
+
+    //keeps the output, which was locked in the node, for its address
+    auto hold(core::Unspent output)
+        -> void;
+
+    //drops addresses whose output is not held and not in the set even
+    //though it would have matured, because the node spent it or the funding
+    //transaction was never mined. returns the number of dropped addresses
+    auto prune(const UtxoSet& utxos,
+               std::int64_t block_height,
+               std::int64_t maturity)
+        -> std::size_t;
+
+    //reserves the oldest held output which pays the needed value and
+    //leaves either no change or a change of at least min_change for an
+    //operation, and returns its address. the output stays locked in the
+    //pool until the operation takes it when it spends the output
+    auto reserve(std::int64_t needed,
+                 std::int64_t min_change)
+        -> utils::Opt<std::string>;
+
+    //takes the reserved output of the address out of the pool,
+    //the output is still locked in the node
+    auto take(const std::string& address)
+        -> utils::Opt<core::Unspent>;
+
+    //keeps addresses which were generated for outputs whose funding
+    //transaction could not be sent, so they are funded with the next one
+    auto keepUnfunded(std::vector<std::string> addresses)
+        -> void;
+
+    //takes up to count of the kept addresses
+    auto takeUnfunded(std::size_t count)
+        -> std::vector<std::string>;
+
+    //number of outputs which have to be created to reach the target
+    auto missing() const
+        -> std::size_t;
+
+    auto size() const
+        -> std::size_t;
+
+    //number of outputs which arrived and are held
+    auto numberOfHeld() const
+        -> std::size_t;
+
+private:
+    struct Pooled
+    {
+        std::string address;
+        //height the address was funded at
+        std::int64_t funded_at;
+        //the locked output, once it arrived
+        utils::Opt<core::Unspent> output;
+        //an operation is going to spend the output
+        bool reserved = false;
+    };
+
+    OutputPoolConfig config_;
+
+    mutable std::mutex mtx_;
+    //oldest first
+    std::deque<Pooled> pooled_;
+    std::vector<std::string> unfunded_;
+};
+
+} // namespace forge::wallet
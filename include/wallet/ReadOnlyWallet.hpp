@@ -1,8 +1,10 @@
 #pragma once
 
+#include <client/ReadOnlyClientBase.hpp>
 #include <lookup/LookupManager.hpp>
 #include <memory>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -11,7 +13,12 @@ namespace forge::wallet {
 class ReadOnlyWallet
 {
 public:
-    ReadOnlyWallet(std::unique_ptr<lookup::LookupManager>&& lookup);
+    //the lookup can be shared by many wallets, so one
+    //index serves all wallets of the process. the addresses
+    //are read from the node wallet of the given client, or
+    //from the one of the lookup if there is none
+    ReadOnlyWallet(std::shared_ptr<lookup::LookupManager> lookup,
+                   std::unique_ptr<client::ReadOnlyClientBase> reader = nullptr);
 
     auto addWatchOnlyAddress(std::string adr)
         -> void;
@@ -50,10 +57,10 @@ public:
         -> std::vector<core::UtilityToken>;
 
     auto getWatchedAddresses() const
-        -> const std::set<std::string>&;
+        -> std::set<std::string>;
 
     auto getOwnedAddresses() const
-        -> const std::set<std::string>&;
+        -> std::set<std::string>;
 
     auto ownesAddress(const std::string& addr) const
         -> bool;
@@ -64,9 +71,18 @@ public:
         -> lookup::LookupManager&;
 
 protected:
+    //client of the node wallet holding the addresses
+    //and outputs of this wallet
+    auto getReader() const
+        -> const client::ReadOnlyClientBase&;
+
+    //guards the address sets, which are changed by
+    //wallet operations running at the same time
+    std::unique_ptr<std::shared_mutex> addresses_mtx_;
     std::set<std::string> owned_addresses_;
     std::set<std::string> watched_addresses_;
-    std::unique_ptr<lookup::LookupManager> lookup_;
+    std::shared_ptr<lookup::LookupManager> lookup_;
+    std::unique_ptr<client::ReadOnlyClientBase> reader_;
 };
 
 } // namespace forge::wallet
@@ -2,23 +2,43 @@
 
 #include <core/Coin.hpp>
 #include <client/WriteOnlyClientBase.hpp>
+#include <core/Transaction.hpp>
 #include <entrys/Entry.hpp>
 #include <entrys/uentry/UniqueEntry.hpp>
 #include <entrys/umentry/UMEntry.hpp>
+#include <functional>
 #include <lookup/LookupManager.hpp>
 #include <memory>
 #include <string>
+#include <utils/Opt.hpp>
 #include <vector>
+#include <wallet/OutputPool.hpp>
 #include <wallet/ReadOnlyWallet.hpp>
+#include <wallet/UtxoSet.hpp>
 #include <wallet/WalletError.hpp>
 
 namespace forge::wallet {
 
+//result of an operation which is split into one transaction per
+//address, the transactions are independent, so some of them can
+//be sent while others fail
+struct SplitOperationResult
+{
+    //txids of the transactions which were sent
+    std::vector<std::string> txids;
+    //address and error of the transactions which failed
+    std::vector<std::pair<std::string, WalletError>> failures;
+};
+
 class ReadWriteWallet : public ReadOnlyWallet
 {
 public:
-    ReadWriteWallet(std::unique_ptr<lookup::LookupManager>&& lookup,
-                    std::unique_ptr<client::WriteOnlyClientBase>&& client);
+    //the client and the reader need to use the same node wallet,
+    //without a reader the one of the lookup is used
+    ReadWriteWallet(std::shared_ptr<lookup::LookupManager> lookup,
+                    std::unique_ptr<client::WriteOnlyClientBase>&& client,
+                    OutputPoolConfig pool_config = {},
+                    std::unique_ptr<client::ReadOnlyClientBase> reader = nullptr);
     //creates a new entry key value pair on the blockchain
     //using any output of the dameonwallet
     //coins will be send to a new address and this output
@@ -144,19 +164,23 @@ public:
         -> utils::Result<std::string, WalletError>;
 
     //transfers a given *amount* of utility tokens to a *new_owner*
+    //the tokens of the different addresses are sent at the same time,
+    //an error is only returned if the wallet does not own enough tokens
     auto transferUtilityTokens(core::EntryKey id,
                                std::string new_owner,
                                std::uint64_t amount,
                                std::int64_t burn_amount)
-        -> utils::Result<std::vector<std::string>,
+        -> utils::Result<SplitOperationResult,
                           WalletError>;
 
     //delete/burns a given *amount* of utility tokens if they
     //are owned by the wallet
+    //the tokens of the different addresses are burned at the same time,
+    //an error is only returned if the wallet does not own enough tokens
     auto deleteUtilityTokens(core::EntryKey id,
                              std::uint64_t amount,
                              std::int64_t burn_amount)
-        -> utils::Result<std::vector<std::string>,
+        -> utils::Result<SplitOperationResult,
                           WalletError>;
 
     //looks up the owner of a given entry
@@ -169,6 +193,26 @@ public:
                          std::int64_t amount)
         -> utils::Result<std::string, WalletError>;
 
+    //pays the owners of many entrys at once. the owners are looked up
+    //together, the amounts of keys with the same owner are added up and
+    //the owners are paid with a few transactions with many outputs.
+    //a payment which would overflow the total of its owner is not made.
+    //returns for every payment the txid of the transaction which paid
+    //the owner or the reason why the owner was not paid
+    auto payToEntryOwners(const std::vector<std::pair<core::EntryKey, std::int64_t>>& payments)
+        -> std::vector<utils::Result<std::string, WalletError>>;
+
+    //locks the outputs which arrived at addresses of the output pool and
+    //fans coins out to new addresses until the pool reaches its target
+    //again, with one transaction per call. the addresses of a transaction
+    //which could not be sent are reused by the next call. meant to be
+    //called periodically, returns the number of outputs which were created
+    auto maintainOutputPool()
+        -> utils::Result<std::size_t, WalletError>;
+
+    auto getOutputPool() const
+        -> const OutputPool&;
+
 private:
     auto createEntryOwnerPairFromKey(core::EntryKey key)
         -> utils::Result<std::pair<core::Entry,
@@ -190,8 +234,46 @@ private:
                           std::uint64_t>>,
             WalletError>;
 
+    //runs burn_part for every address and amount of the send
+    //vector, with a bounded number of them at the same time
+    auto burnParts(const std::vector<std::pair<std::string, std::uint64_t>>& parts,
+                   const std::function<utils::Result<std::string, WalletError>(const std::string&,
+                                                                               std::uint64_t)>& burn_part)
+        -> SplitOperationResult;
+
+    //an address of the output pool holding a matured output which pays
+    //the burn and is reserved for it, or a new address if the pool has none
+    auto getAddressForNewEntry(std::int64_t burn_amount)
+        -> utils::Result<std::string, WalletError>;
+
+    //reads the unspent outputs from the node if the lookup processed
+    //a new block since they were read, false if the node cannot be asked
+    auto syncUnspent()
+        -> bool;
+
+    //leases a confirmed unspent output of the address which can pay the
+    //needed value and locks it in the node wallet, nullopt if there is
+    //none or the node cannot be asked. the outputs are only read from
+    //the node again after the lookup processed a new block. a reserved
+    //pool output of the address is leased first, it is already locked
+    auto leaseFundingOutput(const std::string& address,
+                            std::int64_t needed)
+        -> utils::Opt<UtxoSet::Lease>;
+
+    //spends the leased and locked output in a transaction with the given
+    //burn and outputs, the lease ends with the output spent on success
+    //and dropped from the set and unlocked on error
+    auto writeLeasedTx(UtxoSet::Lease lease,
+                       std::vector<std::byte> metadata,
+                       std::int64_t burn_value,
+                       std::vector<std::pair<std::string, std::int64_t>> outputs)
+        -> utils::Result<std::string, WalletError>;
+
     //burns a given *burn_amout* from a given *address* while
-    //writeing the given *metadata* into the OP_RETURN transaction
+    //writeing the given *metadata* into the OP_RETURN transaction.
+    //an unspent output of the address is used directly if there is
+    //one, otherwise or if spending it fails, it is funded with a
+    //separate transaction first
     auto burn(const std::string& address,
               std::int64_t burn_amount,
               std::vector<std::byte> metadata)
@@ -209,6 +291,8 @@ private:
 
 private:
     std::unique_ptr<client::WriteOnlyClientBase> client_;
+    std::unique_ptr<UtxoSet> utxos_;
+    std::unique_ptr<OutputPool> pool_;
 };
 
 } // namespace forge::wallet
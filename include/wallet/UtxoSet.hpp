@@ -0,0 +1,131 @@
+#pragma once
+
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <utils/Opt.hpp>
+#include <vector>
+
+namespace forge::wallet {
+
+//unspent outputs of the wallet indexed by address and value, so
+//coin selection is a local query instead of a listunspent call.
+//the set is refilled from the node when the lookup has processed
+//a new block and outputs spent by the wallet are removed right away.
+//outputs can be leased to an operation, which hides them from all
+//other operations until the lease is given back or the output spent,
+//so concurrent operations never try to spend the same output
+class UtxoSet final
+{
+public:
+    //an output leased to one operation, which is given
+    //back to the set when the lease is destroyed
+    class Lease final
+    {
+    public:
+        Lease(UtxoSet* set,
+              core::Unspent unspent);
+
+        Lease(const Lease&) = delete;
+        Lease(Lease&&) noexcept;
+        auto operator=(const Lease&) -> Lease& = delete;
+        auto operator=(Lease&&) -> Lease& = delete;
+
+        ~Lease();
+
+        auto getUnspent() const
+            -> const core::Unspent&;
+
+        //the output was spent, so it is removed
+        //from the set instead of being given back
+        auto spend()
+            -> void;
+
+        //spending the output failed, so it is removed from the set
+        //until the set is read from the node again, instead of being
+        //offered to the next operation
+        auto drop()
+            -> void;
+
+    private:
+        UtxoSet* set_;
+        core::Unspent unspent_;
+    };
+
+    UtxoSet() = default;
+
+    //replaces all outputs with the given ones, which were
+    //read from the node at the given block height
+    auto reset(std::vector<core::Unspent> unspents,
+               std::int64_t block_height)
+        -> void;
+
+    //adds an output the node did not report because it is
+    //locked and leases it to the caller right away
+    auto addLeased(core::Unspent unspent)
+        -> Lease;
+
+    //height the set was filled at, nullopt if it never was
+    auto getBlockHeight() const
+        -> utils::Opt<std::int64_t>;
+
+    //removes an output which was spent by a transaction of the wallet
+    //and ends its lease, returns false if the output was not in the set
+    auto spend(const std::string& txid,
+               std::int64_t vout_idx)
+        -> bool;
+
+    //the smallest output of the address which is not leased, pays the
+    //needed value and leaves either no change or a change of at least
+    //min_change
+    auto select(const std::string& address,
+                std::int64_t needed,
+                std::int64_t min_change) const
+        -> utils::Opt<core::Unspent>;
+
+    //same as select, but the output is leased to the caller
+    auto lease(const std::string& address,
+               std::int64_t needed,
+               std::int64_t min_change)
+        -> utils::Opt<Lease>;
+
+    auto size() const
+        -> std::size_t;
+
+    auto numberOfLeased() const
+        -> std::size_t;
+
+private:
+    using Outpoint = std::pair<std::string, std::int64_t>;
+    using OutputsByValue = std::multimap<std::int64_t, core::Unspent>;
+
+    //does not lock, the caller needs to hold the lock
+    auto insert(core::Unspent unspent)
+        -> void;
+
+    //does not lock, the caller needs to hold the lock
+    auto findFitting(const std::string& address,
+                     std::int64_t needed,
+                     std::int64_t min_change) const
+        -> const core::Unspent*;
+
+    auto release(const core::Unspent& unspent)
+        -> void;
+
+    mutable std::mutex mtx_;
+    //leases survive a reset. listunspent does not report outputs which
+    //are locked in the node, but a set read before a leased output was
+    //locked still contains it and must not offer it again
+    std::set<Outpoint> leased_;
+    utils::Opt<std::int64_t> block_height_;
+    std::unordered_map<std::string, OutputsByValue> by_address_;
+    std::map<Outpoint, std::pair<std::string, OutputsByValue::iterator>> by_outpoint_;
+};
+
+} // namespace forge::wallet
@@ -17,7 +17,8 @@ auto forge::client::make_readonly_client(const std::string& host,
                                          const std::string& user,
                                          const std::string& password,
                                          std::int64_t port,
-                                         core::Coin coin)
+                                         core::Coin coin,
+                                         const utils::Opt<std::string>& node_wallet)
     -> std::unique_ptr<ReadOnlyClientBase>
 {
     switch(coin) {
@@ -27,7 +28,8 @@ auto forge::client::make_readonly_client(const std::string& host,
                                                     user,
                                                     password,
                                                     port,
-                                                    coin);
+                                                    coin,
+                                                    node_wallet);
     default:
         LOG(FATAL) << "entered default case which should never happen";
         return nullptr;
@@ -39,7 +39,8 @@ auto forge::client::make_writing_client(const std::string& host,
                                         const std::string& user,
                                         const std::string& password,
                                         std::int64_t port,
-                                        core::Coin coin)
+                                        core::Coin coin,
+                                        const utils::Opt<std::string>& node_wallet)
     -> std::unique_ptr<WriteOnlyClientBase>
 {
     switch(coin) {
@@ -49,7 +50,8 @@ auto forge::client::make_writing_client(const std::string& host,
                                                      user,
                                                      password,
                                                      port,
-                                                     coin);
+                                                     coin,
+                                                     node_wallet);
 
     default:
         LOG(FATAL) << "entered default case which should never happen";
@@ -6,6 +6,11 @@
 #include <g3log/g3log.hpp>
 #include <jsonrpccpp/client.h>
 #include <jsonrpccpp/client/connectors/httpclient.h>
+#include <memory>
+#include <metrics/Metrics.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utils/Algorithm.hpp>
 #include <utils/Opt.hpp>
 #include <utils/Result.hpp>
@@ -32,38 +37,108 @@ using jsonrpc::HttpClient;
 using jsonrpc::JsonRpcException;
 using namespace std::string_literals;
 
+namespace {
+
+struct CommandMetrics
+{
+    forge::metrics::Histogram& duration;
+    forge::metrics::Counter& errors;
+};
+
+//the metrics are looked up once per thread and command, so a
+//call neither builds labels nor locks the registry
+auto commandMetrics(const std::string& command)
+    -> CommandMetrics&
+{
+    thread_local std::unordered_map<std::string, CommandMetrics> cache;
+
+    auto iter = cache.find(command);
+    if(iter == std::end(cache)) {
+        auto& registry = forge::metrics::getRegistry();
+        CommandMetrics metrics{
+            registry.histogram("forge_node_rpc_duration_seconds",
+                               "Duration of rpc calls to the node",
+                               {{"command", command}}),
+            registry.counter("forge_node_rpc_errors_total",
+                             "Failed rpc calls to the node",
+                             {{"command", command}})};
+        iter = cache.emplace(command, metrics).first;
+    }
+
+    return iter->second;
+}
+
+} // namespace
 
 ReadOnlyOdinClient::ReadOnlyOdinClient(const std::string& host,
                                        const std::string& user,
                                        const std::string& password,
                                        std::int64_t port,
-                                       core::Coin coin)
+                                       core::Coin coin,
+                                       const utils::Opt<std::string>& node_wallet)
     : ReadOnlyClientBase(coin),
-      http_client_("http://"
-                   + user
-                   + ":"
-                   + password
-                   + "@"
-                   + host
-                   + ":"
-                   + std::to_string(port)),
-      client_(http_client_, JSONRPC_CLIENT_V1) {}
+      url_("http://"
+           + user
+           + ":"
+           + password
+           + "@"
+           + host
+           + ":"
+           + std::to_string(port)
+           + node_wallet
+                 .map([](const auto& name) {
+                     return "/wallet/" + name;
+                 })
+                 .valueOr(std::string{})) {}
+
+ReadOnlyOdinClient::Connection::Connection(const std::string& url)
+    : http_client(url),
+      client(http_client, JSONRPC_CLIENT_V1) {}
+
+auto ReadOnlyOdinClient::takeConnection() const
+    -> std::unique_ptr<Connection>
+{
+    {
+        std::unique_lock lock{connections_mtx_};
+        if(!idle_connections_.empty()) {
+            auto connection = std::move(idle_connections_.back());
+            idle_connections_.pop_back();
+            return connection;
+        }
+    }
+
+    return std::make_unique<Connection>(url_);
+}
 
+auto ReadOnlyOdinClient::returnConnection(std::unique_ptr<Connection> connection) const
+    -> void
+{
+    std::unique_lock lock{connections_mtx_};
+    idle_connections_.push_back(std::move(connection));
+}
 
 auto ReadOnlyOdinClient::sendcommand(const std::string& command,
                                      Json::Value params) const
     -> Result<Json::Value, ClientError>
 {
-    return Try<jsonrpc::JsonRpcException>(
-               [this](const auto& command,
-                      auto params) {
-                   return client_.CallMethod(command,
-                                             std::move(params));
-               },
-               command,
-               std::move(params))
+    auto& command_metrics = commandMetrics(command);
+    metrics::ScopedTimer timer{command_metrics.duration};
+
+    auto connection = takeConnection();
+    auto result = Try<jsonrpc::JsonRpcException>(
+        [&](const auto& command,
+            auto params) {
+            return connection->client.CallMethod(command,
+                                                 std::move(params));
+        },
+        command,
+        std::move(params));
+    returnConnection(std::move(connection));
+
+    return std::move(result)
         .mapError([&](auto error) {
             LOG(WARNING) << command << " failed";
+            command_metrics.errors.increment();
             return ClientError{error.what()};
         });
 }
@@ -161,6 +236,22 @@ auto ReadOnlyOdinClient::getTransaction(std::string txid) const
         });
 }
 
+auto ReadOnlyOdinClient::getForgeCandidate(std::string txid) const
+    -> utils::Result<Opt<core::ForgeCandidate>, ClientError>
+{
+    static const auto command = "getrawtransaction";
+
+    Json::Value params;
+    params.append(std::move(txid));
+    params.append(1);
+
+    return sendcommand(command, params)
+        .flatMap([&](auto json) {
+            return odin::processGetForgeCandidateResponse(std::move(json),
+                                                          params);
+        });
+}
+
 auto ReadOnlyOdinClient::getUnspent() const
     -> Result<std::vector<Unspent>,
               ClientError>
@@ -256,6 +347,27 @@ auto forge::client::odin::processGetTransactionResponse(Json::Value&& response,
     return ClientError{std::move(error_str)};
 }
 
+auto forge::client::odin::processGetForgeCandidateResponse(Json::Value&& response,
+                                                           const Json::Value& params)
+    -> utils::Result<Opt<core::ForgeCandidate>, ClientError>
+{
+    //a response which is not a transaction at all is an error,
+    //a transaction which is not a forge candidate is not
+    if(!response.isObject()
+       || !response.isMember("txid")
+       || !response.isMember("vin")
+       || !response.isMember("vout")) {
+        auto error_str =
+            fmt::format("unable to build transaction from result when calling {}, with parameters {}\n",
+                        "getrawtransaction",
+                        params.toStyledString());
+
+        return ClientError{std::move(error_str)};
+    }
+
+    return core::buildForgeCandidate(response);
+}
+
 auto forge::client::odin::processGetBlockCountResponse(Json::Value&& response,
                                                        const Json::Value & /*params*/)
     -> utils::Result<std::int64_t, ClientError>
@@ -1,5 +1,6 @@
 #include <core/Block.hpp>
 #include <core/Coin.hpp>
+#include <core/RawTransaction.hpp>
 #include <core/Transaction.hpp>
 #include <client/ReadOnlyClientBase.hpp>
 #include <client/WriteOnlyClientBase.hpp>
@@ -34,6 +35,20 @@ auto ReadWriteOdinClient::generateRawTx(std::string input_txid,
 {
     static const auto command = "createrawtransaction"s;
 
+    //the transaction is serialized locally with exact amounts, the node
+    //is only asked for outputs to addresses the serializer does not know
+    auto local_res = core::serializeRawTx(input_txid,
+                                          static_cast<std::uint32_t>(index),
+                                          metadata,
+                                          burn_value,
+                                          outputs,
+                                          getCoin());
+    if(local_res) {
+        return std::move(local_res.getValue());
+    }
+
+    LOG(DEBUG) << "using " << command << ", " << local_res.getError().what();
+
     auto params = generateRpcParamsForRawTx(std::move(input_txid),
                                             index,
                                             std::move(metadata),
@@ -135,20 +150,58 @@ auto ReadWriteOdinClient::generateNewAddress() const
         });
 }
 
-auto ReadWriteOdinClient::decodeTxidOfRawTx(const std::vector<std::byte>& tx) const
-    -> utils::Result<std::string, ClientError>
+auto ReadWriteOdinClient::lockOutput(std::string txid,
+                                     std::int64_t index) const
+    -> utils::Result<void, ClientError>
 {
-    static const auto command = "decoderawtransaction"s;
+    return setOutputLock(std::move(txid), index, true);
+}
+
+auto ReadWriteOdinClient::unlockOutput(std::string txid,
+                                       std::int64_t index) const
+    -> utils::Result<void, ClientError>
+{
+    return setOutputLock(std::move(txid), index, false);
+}
+
+auto ReadWriteOdinClient::setOutputLock(std::string txid,
+                                        std::int64_t index,
+                                        bool lock) const
+    -> utils::Result<void, ClientError>
+{
+    static const auto command = "lockunspent"s;
+
+    Json::Value output;
+    output["txid"] = txid;
+    output["vout"] = static_cast<Json::Int64>(index);
 
+    Json::Value outputs;
+    outputs.append(std::move(output));
+
+    //the first parameter of lockunspent is called unlock
     Json::Value params;
-    params.append(toHexString(tx));
+    params.append(!lock);
+    params.append(std::move(outputs));
 
     return sendcommand(command, std::move(params))
-        .flatMap([](auto json) {
-            return odin::processDecodeTxidOfRawTxResponse(std::move(json));
+        .flatMap([&](auto json) {
+            return odin::processLockUnspentResponse(std::move(json),
+                                                    txid,
+                                                    index);
         });
 }
 
+auto ReadWriteOdinClient::decodeTxidOfRawTx(const std::vector<std::byte>& tx) const
+    -> utils::Result<std::string, ClientError>
+{
+    if(tx.empty()) {
+        return ClientError{"unable to compute the txid of an empty transaction"};
+    }
+
+    //odin has no segwit, so the txid is the hash of the whole transaction
+    return core::computeTxid(tx);
+}
+
 auto ReadWriteOdinClient::burnAmount(std::int64_t amount,
                                      std::vector<std::byte> metadata) const
     -> utils::Result<std::string, ClientError>
@@ -176,25 +229,37 @@ auto ReadWriteOdinClient::burnAmount(std::int64_t amount,
             auto value = iter->getValue();
             auto value_back = value - (fees + amount);
 
+            //listunspent does not report locked outputs, so a
+            //concurrent burn does not pick the same output
+            if(auto locked = lockOutput(txid, vout); !locked) {
+                return locked.getError();
+            }
+
+            auto unlock_on_error = [&](const auto& /*unused*/) {
+                unlockOutput(txid, vout);
+            };
+
             //if the fees + burn value eat the whole input,
             //dont use a change address
             if(value_back == 0) {
-                return writeTxToBlockchain(std::move(txid),
+                return writeTxToBlockchain(txid,
                                            vout,
                                            std::move(metadata),
                                            amount,
-                                           {});
+                                           {})
+                    .onError(unlock_on_error);
             }
 
             //if not, generate an new address and use it as output
             return generateNewAddress()
                 .flatMap([&](auto exchange_adrs) {
-                    return writeTxToBlockchain(std::move(txid),
+                    return writeTxToBlockchain(txid,
                                                vout,
                                                std::move(metadata),
                                                amount,
                                                {{std::move(exchange_adrs), value_back}});
-                });
+                })
+                .onError(unlock_on_error);
         });
 }
 
@@ -282,6 +347,31 @@ auto ReadWriteOdinClient::sendToAddress(std::int64_t amount,
         });
 }
 
+auto ReadWriteOdinClient::sendToMany(std::vector<
+                                         std::pair<std::string,
+                                                   std::int64_t>>
+                                         amounts) const
+    -> utils::Result<std::string, ClientError>
+{
+    static const auto command = "sendmany"s;
+
+    Json::Value outputs{Json::objectValue};
+    for(auto&& [address, amount] : amounts) {
+        auto coins = static_cast<double>(amount) / 100000000.;
+        outputs[address] = roundDouble(coins);
+    }
+
+    //the first parameter is the deprecated account
+    Json::Value params;
+    params.append("");
+    params.append(std::move(outputs));
+
+    return sendcommand(command, std::move(params))
+        .flatMap([&](auto json) {
+            return odin::processSendManyResponse(std::move(json),
+                                                 amounts.size());
+        });
+}
 
 auto ReadWriteOdinClient::getVOutIdxByAmountAndAddress(std::string txid,
                                                        std::int64_t amount,
@@ -376,6 +466,21 @@ auto forge::client::odin::processGenerateNewAddressResponse(Json::Value&& respon
     return response.asString();
 }
 
+auto forge::client::odin::processLockUnspentResponse(Json::Value&& response,
+                                                     const std::string& txid,
+                                                     std::int64_t index)
+    -> utils::Result<void, ClientError>
+{
+    if(!response.isBool() || !response.asBool()) {
+        auto error = fmt::format("unable to change the lock of output {}:{}",
+                                 txid,
+                                 index);
+        return ClientError{std::move(error)};
+    }
+
+    return {};
+}
+
 auto forge::client::odin::processDecodeTxidOfRawTxResponse(Json::Value&& response)
     -> utils::Result<std::string, ClientError>
 {
@@ -402,6 +507,18 @@ auto forge::client::odin::processSendToAddressResponse(Json::Value&& response,
     return response.asString();
 }
 
+auto forge::client::odin::processSendManyResponse(Json::Value&& response,
+                                                  std::size_t number_of_outputs)
+    -> utils::Result<std::string, ClientError>
+{
+    if(!response.isString()) {
+        auto error = fmt::format("unknown error sending odin to {} addresses",
+                                 number_of_outputs);
+        return ClientError{std::move(error)};
+    }
+
+    return response.asString();
+}
 
 auto forge::client::odin::processGetVOutIdxByAmountAndAddressResponse(Json::Value&& response,
                                                                       std::int64_t amount,
@@ -100,3 +100,17 @@ auto forge::core::getMinimumTxAmount(Coin c)
         return 0;
     }
 }
+
+auto forge::core::getPubKeyHashPrefix(Coin c)
+    -> utils::Opt<std::uint8_t>
+{
+    switch(c) {
+    case Coin::Odin:
+        return std::uint8_t{115}; //addresses starting with 'o'
+    case Coin::tOdin:
+        return std::nullopt;
+    default:
+        LOG(FATAL) << "entered default case which should never happen";
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,284 @@
+#include <array>
+#include <core/Hex.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr auto HEX_DIGITS = std::string_view{"0123456789abcdef"};
+
+//maps every character to its nibble value or to -1
+//if the character is not a hex digit
+constexpr auto DECODE_TABLE = [] {
+    std::array<std::int8_t, 256> table{};
+    for(auto& entry : table) {
+        entry = -1;
+    }
+    for(int c = '0'; c <= '9'; c++) {
+        table[c] = static_cast<std::int8_t>(c - '0');
+    }
+    for(int c = 'a'; c <= 'f'; c++) {
+        table[c] = static_cast<std::int8_t>(c - 'a' + 10);
+        table[c - 'a' + 'A'] = static_cast<std::int8_t>(c - 'a' + 10);
+    }
+    return table;
+}();
+
+#if defined(__AVX2__)
+
+//number of bytes encoded and decoded per iteration
+constexpr std::size_t BLOCK_SIZE = 32;
+
+auto nibblesToAscii(__m256i nibbles)
+    -> __m256i
+{
+    //'0' + nibble, plus the distance between '9' + 1 and 'a' for nibbles above 9
+    auto above_nine = _mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9));
+    auto ascii = _mm256_add_epi8(nibbles, _mm256_set1_epi8('0'));
+    return _mm256_add_epi8(ascii,
+                           _mm256_and_si256(above_nine,
+                                            _mm256_set1_epi8('a' - '0' - 10)));
+}
+
+auto encodeBlock(const std::byte* data, char* out)
+    -> void
+{
+    auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    auto low_mask = _mm256_set1_epi8(0x0F);
+    auto high = nibblesToAscii(_mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_mask));
+    auto low = nibblesToAscii(_mm256_and_si256(bytes, low_mask));
+
+    //unpack works per 128 bit lane, so the lanes need to be reordered
+    auto mixed_low = _mm256_unpacklo_epi8(high, low);
+    auto mixed_high = _mm256_unpackhi_epi8(high, low);
+    auto first = _mm256_permute2x128_si256(mixed_low, mixed_high, 0x20);
+    auto second = _mm256_permute2x128_si256(mixed_low, mixed_high, 0x31);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), first);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), second);
+}
+
+//converts 32 characters into nibbles, returns false
+//if any character is not a hex digit
+auto asciiToNibbles(__m256i chars, __m256i& nibbles)
+    -> bool
+{
+    auto lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+
+    auto is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+    auto is_alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+
+    auto valid = _mm256_or_si256(is_digit, is_alpha);
+    if(_mm256_movemask_epi8(valid) != -1) {
+        return false;
+    }
+
+    auto digits = _mm256_and_si256(is_digit,
+                                   _mm256_sub_epi8(chars, _mm256_set1_epi8('0')));
+    auto alphas = _mm256_and_si256(is_alpha,
+                                   _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)));
+    nibbles = _mm256_or_si256(digits, alphas);
+    return true;
+}
+
+//merges every pair of nibbles into one byte which
+//ends up in the low byte of each 16 bit lane
+auto mergeNibbles(__m256i nibbles)
+    -> __m256i
+{
+    auto merged = _mm256_or_si256(_mm256_slli_epi16(nibbles, 4),
+                                  _mm256_srli_epi16(nibbles, 8));
+    return _mm256_and_si256(merged, _mm256_set1_epi16(0x00FF));
+}
+
+auto decodeBlock(const char* hex, std::byte* out)
+    -> bool
+{
+    __m256i first;
+    __m256i second;
+    if(!asciiToNibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex)), first)
+       || !asciiToNibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + 32)), second)) {
+        return false;
+    }
+
+    //pack works per 128 bit lane, so the quadwords need to be reordered
+    auto packed = _mm256_packus_epi16(mergeNibbles(first), mergeNibbles(second));
+    auto bytes = _mm256_permute4x64_epi64(packed, 0xD8);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bytes);
+    return true;
+}
+
+#elif defined(__SSE2__)
+
+//number of bytes encoded and decoded per iteration
+constexpr std::size_t BLOCK_SIZE = 16;
+
+auto nibblesToAscii(__m128i nibbles)
+    -> __m128i
+{
+    //'0' + nibble, plus the distance between '9' + 1 and 'a' for nibbles above 9
+    auto above_nine = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    auto ascii = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+    return _mm_add_epi8(ascii,
+                        _mm_and_si128(above_nine,
+                                      _mm_set1_epi8('a' - '0' - 10)));
+}
+
+auto encodeBlock(const std::byte* data, char* out)
+    -> void
+{
+    auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    auto low_mask = _mm_set1_epi8(0x0F);
+    auto high = nibblesToAscii(_mm_and_si128(_mm_srli_epi16(bytes, 4), low_mask));
+    auto low = nibblesToAscii(_mm_and_si128(bytes, low_mask));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(high, low));
+}
+
+//converts 16 characters into nibbles, returns false
+//if any character is not a hex digit
+auto asciiToNibbles(__m128i chars, __m128i& nibbles)
+    -> bool
+{
+    auto lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+    auto is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chars));
+    auto is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                  _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+
+    auto valid = _mm_or_si128(is_digit, is_alpha);
+    if(_mm_movemask_epi8(valid) != 0xFFFF) {
+        return false;
+    }
+
+    auto digits = _mm_and_si128(is_digit,
+                                _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+    auto alphas = _mm_and_si128(is_alpha,
+                                _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+    nibbles = _mm_or_si128(digits, alphas);
+    return true;
+}
+
+//merges every pair of nibbles into one byte which
+//ends up in the low byte of each 16 bit lane
+auto mergeNibbles(__m128i nibbles)
+    -> __m128i
+{
+    auto merged = _mm_or_si128(_mm_slli_epi16(nibbles, 4),
+                               _mm_srli_epi16(nibbles, 8));
+    return _mm_and_si128(merged, _mm_set1_epi16(0x00FF));
+}
+
+auto decodeBlock(const char* hex, std::byte* out)
+    -> bool
+{
+    __m128i first;
+    __m128i second;
+    if(!asciiToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex)), first)
+       || !asciiToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 16)), second)) {
+        return false;
+    }
+
+    auto bytes = _mm_packus_epi16(mergeNibbles(first), mergeNibbles(second));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+    return true;
+}
+
+#endif
+
+} // namespace
+
+
+auto forge::core::hexEncodeScalar(const std::byte* data,
+                                  std::size_t size,
+                                  char* out)
+    -> void
+{
+    for(std::size_t i = 0; i < size; i++) {
+        auto byte = std::to_integer<unsigned>(data[i]);
+        out[2 * i] = HEX_DIGITS[byte >> 4];
+        out[2 * i + 1] = HEX_DIGITS[byte & 0x0F];
+    }
+}
+
+auto forge::core::hexDecodeScalar(std::string_view hex,
+                                  std::byte* out)
+    -> bool
+{
+    if(hex.size() % 2 != 0) {
+        return false;
+    }
+
+    for(std::size_t i = 0; i < hex.size(); i += 2) {
+        auto high = DECODE_TABLE[static_cast<unsigned char>(hex[i])];
+        auto low = DECODE_TABLE[static_cast<unsigned char>(hex[i + 1])];
+        if(high < 0 || low < 0) {
+            return false;
+        }
+
+        out[i / 2] = static_cast<std::byte>((high << 4) | low);
+    }
+
+    return true;
+}
+
+auto forge::core::hexEncode(const std::byte* data,
+                            std::size_t size,
+                            char* out)
+    -> void
+{
+    std::size_t done = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    for(; done + BLOCK_SIZE <= size; done += BLOCK_SIZE) {
+        encodeBlock(data + done, out + 2 * done);
+    }
+#endif
+
+    hexEncodeScalar(data + done,
+                    size - done,
+                    out + 2 * done);
+}
+
+auto forge::core::hexEncode(const std::byte* data,
+                            std::size_t size)
+    -> std::string
+{
+    std::string hex(2 * size, '\0');
+    hexEncode(data, size, hex.data());
+    return hex;
+}
+
+auto forge::core::hexDecode(std::string_view hex,
+                            std::byte* out)
+    -> bool
+{
+    if(hex.size() % 2 != 0) {
+        return false;
+    }
+
+    std::size_t done = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    for(; 2 * (done + BLOCK_SIZE) <= hex.size(); done += BLOCK_SIZE) {
+        if(!decodeBlock(hex.data() + 2 * done, out + done)) {
+            return false;
+        }
+    }
+#endif
+
+    return hexDecodeScalar(hex.substr(2 * done),
+                           out + done);
+}
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <array>
+#include <core/Coin.hpp>
+#include <core/Hex.hpp>
+#include <core/RawTransaction.hpp>
+#include <core/RawTransactionError.hpp>
+#include <core/Sha256.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/core.h>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <utils/Result.hpp>
+#include <vector>
+
+using forge::core::RawTransactionError;
+using forge::utils::Result;
+
+namespace {
+
+constexpr std::string_view BASE58_ALPHABET =
+    "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+constexpr std::uint32_t TX_VERSION = 1;
+constexpr std::uint32_t SEQUENCE_FINAL = 0xffffffff;
+constexpr std::uint32_t LOCKTIME = 0;
+
+constexpr std::byte OP_RETURN{0x6a};
+constexpr std::byte OP_DUP{0x76};
+constexpr std::byte OP_HASH160{0xa9};
+constexpr std::byte OP_EQUALVERIFY{0x88};
+constexpr std::byte OP_CHECKSIG{0xac};
+constexpr std::byte OP_PUSHDATA1{0x4c};
+constexpr std::byte OP_PUSHDATA2{0x4d};
+
+constexpr std::size_t PUBKEY_HASH_SIZE = 20;
+constexpr std::size_t TXID_SIZE = 32;
+
+//little endian, as all integers of a transaction
+template<class T>
+auto appendInt(std::vector<std::byte>& out, T value)
+    -> void
+{
+    for(std::size_t i = 0; i < sizeof(T); i++) {
+        out.push_back(static_cast<std::byte>(
+            static_cast<std::uint64_t>(value) >> (i * 8)));
+    }
+}
+
+auto appendCompactSize(std::vector<std::byte>& out, std::uint64_t size)
+    -> void
+{
+    if(size < 0xfd) {
+        out.push_back(static_cast<std::byte>(size));
+    } else if(size <= 0xffff) {
+        out.push_back(std::byte{0xfd});
+        appendInt(out, static_cast<std::uint16_t>(size));
+    } else if(size <= 0xffffffff) {
+        out.push_back(std::byte{0xfe});
+        appendInt(out, static_cast<std::uint32_t>(size));
+    } else {
+        out.push_back(std::byte{0xff});
+        appendInt(out, size);
+    }
+}
+
+auto appendBytes(std::vector<std::byte>& out, forge::utils::ByteView bytes)
+    -> void
+{
+    out.insert(std::end(out), std::begin(bytes), std::end(bytes));
+}
+
+//OP_RETURN followed by the smallest push of the data
+auto makeOpReturnScript(const std::vector<std::byte>& data)
+    -> std::vector<std::byte>
+{
+    std::vector<std::byte> script{OP_RETURN};
+
+    if(data.size() < static_cast<std::size_t>(OP_PUSHDATA1)) {
+        script.push_back(static_cast<std::byte>(data.size()));
+    } else if(data.size() <= 0xff) {
+        script.push_back(OP_PUSHDATA1);
+        script.push_back(static_cast<std::byte>(data.size()));
+    } else {
+        script.push_back(OP_PUSHDATA2);
+        appendInt(script, static_cast<std::uint16_t>(data.size()));
+    }
+
+    appendBytes(script, data);
+    return script;
+}
+
+auto appendOutput(std::vector<std::byte>& out,
+                  std::int64_t value,
+                  const std::vector<std::byte>& script)
+    -> void
+{
+    appendInt(out, value);
+    appendCompactSize(out, script.size());
+    appendBytes(out, script);
+}
+
+} // namespace
+
+auto forge::core::decodeBase58Check(std::string_view str)
+    -> utils::Opt<std::vector<std::byte>>
+{
+    //big endian base 256 number, every character multiplies
+    //it by 58 and adds the value of the character
+    std::vector<std::uint8_t> number;
+    for(auto c : str) {
+        auto digit = BASE58_ALPHABET.find(c);
+        if(digit == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        auto carry = static_cast<std::uint32_t>(digit);
+        for(auto iter = std::rbegin(number); iter != std::rend(number); ++iter) {
+            carry += static_cast<std::uint32_t>(*iter) * 58;
+            *iter = static_cast<std::uint8_t>(carry);
+            carry >>= 8;
+        }
+        while(carry > 0) {
+            number.insert(std::begin(number), static_cast<std::uint8_t>(carry));
+            carry >>= 8;
+        }
+    }
+
+    //every leading '1' stands for a leading zero byte
+    auto zeros = std::distance(std::begin(str),
+                               std::find_if(std::begin(str),
+                                            std::end(str),
+                                            [](auto c) { return c != '1'; }));
+
+    std::vector<std::byte> decoded(static_cast<std::size_t>(zeros), std::byte{0});
+    std::transform(std::begin(number),
+                   std::end(number),
+                   std::back_inserter(decoded),
+                   [](auto b) { return static_cast<std::byte>(b); });
+
+    if(decoded.size() < 4) {
+        return std::nullopt;
+    }
+
+    auto payload_size = decoded.size() - 4;
+    auto checksum = doubleSha256(utils::ByteView{decoded.data(), payload_size});
+    if(!std::equal(std::begin(decoded) + payload_size,
+                   std::end(decoded),
+                   std::begin(checksum))) {
+        return std::nullopt;
+    }
+
+    decoded.resize(payload_size);
+    return decoded;
+}
+
+auto forge::core::addressToOutputScript(std::string_view address, Coin coin)
+    -> utils::Result<std::vector<std::byte>, RawTransactionError>
+{
+    auto prefix_opt = getPubKeyHashPrefix(coin);
+    if(!prefix_opt) {
+        return RawTransactionError{"address format of the coin is unknown"};
+    }
+
+    auto decoded_opt = decodeBase58Check(address);
+    if(!decoded_opt
+       || decoded_opt.getValue().size() != PUBKEY_HASH_SIZE + 1
+       || decoded_opt.getValue()[0] != static_cast<std::byte>(prefix_opt.getValue())) {
+        return RawTransactionError{
+            fmt::format("{} is not a pay to pubkey hash address", address)};
+    }
+
+    const auto& decoded = decoded_opt.getValue();
+
+    std::vector<std::byte> script{OP_DUP,
+                                  OP_HASH160,
+                                  static_cast<std::byte>(PUBKEY_HASH_SIZE)};
+    script.insert(std::end(script), std::begin(decoded) + 1, std::end(decoded));
+    script.push_back(OP_EQUALVERIFY);
+    script.push_back(OP_CHECKSIG);
+
+    return script;
+}
+
+auto forge::core::serializeRawTx(std::string_view input_txid,
+                                 std::uint32_t index,
+                                 const std::vector<std::byte>& metadata,
+                                 std::int64_t burn_value,
+                                 const std::vector<std::pair<std::string, std::int64_t>>& outputs,
+                                 Coin coin)
+    -> utils::Result<std::vector<std::byte>, RawTransactionError>
+{
+    std::array<std::byte, TXID_SIZE> txid;
+    if(input_txid.size() != TXID_SIZE * 2
+       || !hexDecode(input_txid, txid.data())) {
+        return RawTransactionError{
+            fmt::format("{} is not a valid txid", input_txid)};
+    }
+
+    std::vector<std::byte> tx;
+    appendInt(tx, TX_VERSION);
+
+    //the single input with an empty script, which
+    //is filled when the transaction is signed
+    appendCompactSize(tx, 1);
+    //txids are shown in reverse byte order
+    tx.insert(std::end(tx), std::rbegin(txid), std::rend(txid));
+    appendInt(tx, index);
+    appendCompactSize(tx, 0);
+    appendInt(tx, SEQUENCE_FINAL);
+
+    appendCompactSize(tx, outputs.size() + 1);
+    for(const auto& [address, value] : outputs) {
+        auto script_res = addressToOutputScript(address, coin);
+        if(!script_res) {
+            return script_res.getError();
+        }
+        appendOutput(tx, value, script_res.getValue());
+    }
+    appendOutput(tx, burn_value, makeOpReturnScript(metadata));
+
+    appendInt(tx, LOCKTIME);
+
+    return tx;
+}
+
+auto forge::core::computeTxid(utils::ByteView tx)
+    -> std::string
+{
+    auto hash = doubleSha256(tx);
+    std::reverse(std::begin(hash), std::end(hash));
+
+    return hexEncode(hash.data(), hash.size());
+}
@@ -0,0 +1,127 @@
+#include <array>
+#include <core/Sha256.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utils/ByteView.hpp>
+
+using forge::core::Sha256Digest;
+
+namespace {
+
+constexpr std::array<std::uint32_t, 64> ROUND_CONSTANTS{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr std::array<std::uint32_t, 8> INITIAL_STATE{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+constexpr std::size_t BLOCK_SIZE = 64;
+
+constexpr auto rotr(std::uint32_t x, int n)
+    -> std::uint32_t
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+auto compress(std::array<std::uint32_t, 8>& state,
+              const std::byte* block)
+    -> void
+{
+    std::array<std::uint32_t, 64> w;
+    for(std::size_t i = 0; i < 16; i++) {
+        w[i] = (std::to_integer<std::uint32_t>(block[i * 4]) << 24)
+            | (std::to_integer<std::uint32_t>(block[i * 4 + 1]) << 16)
+            | (std::to_integer<std::uint32_t>(block[i * 4 + 2]) << 8)
+            | std::to_integer<std::uint32_t>(block[i * 4 + 3]);
+    }
+    for(std::size_t i = 16; i < 64; i++) {
+        auto s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        auto s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    auto [a, b, c, d, e, f, g, h] = state;
+
+    for(std::size_t i = 0; i < 64; i++) {
+        auto s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        auto ch = (e & f) ^ (~e & g);
+        auto temp1 = h + s1 + ch + ROUND_CONSTANTS[i] + w[i];
+        auto s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        auto maj = (a & b) ^ (a & c) ^ (b & c);
+        auto temp2 = s0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+} // namespace
+
+auto forge::core::sha256(utils::ByteView data)
+    -> Sha256Digest
+{
+    auto state = INITIAL_STATE;
+
+    auto full_blocks = data.size() / BLOCK_SIZE;
+    for(std::size_t i = 0; i < full_blocks; i++) {
+        compress(state, data.data() + i * BLOCK_SIZE);
+    }
+
+    //the rest of the data, a single 1 bit, zeros and the length
+    //in bits as big endian number fill one or two more blocks
+    std::array<std::byte, BLOCK_SIZE * 2> tail{};
+    auto rest = data.size() - full_blocks * BLOCK_SIZE;
+    if(rest > 0) {
+        std::memcpy(tail.data(), data.data() + full_blocks * BLOCK_SIZE, rest);
+    }
+    tail[rest] = std::byte{0x80};
+
+    auto tail_size = rest + 1 + 8 <= BLOCK_SIZE ? BLOCK_SIZE : BLOCK_SIZE * 2;
+    auto bit_length = static_cast<std::uint64_t>(data.size()) * 8;
+    for(std::size_t i = 0; i < 8; i++) {
+        tail[tail_size - 1 - i] = static_cast<std::byte>(bit_length >> (i * 8));
+    }
+
+    for(std::size_t offset = 0; offset < tail_size; offset += BLOCK_SIZE) {
+        compress(state, tail.data() + offset);
+    }
+
+    Sha256Digest digest;
+    for(std::size_t i = 0; i < state.size(); i++) {
+        digest[i * 4] = static_cast<std::byte>(state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<std::byte>(state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<std::byte>(state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<std::byte>(state[i]);
+    }
+
+    return digest;
+}
+
+auto forge::core::doubleSha256(utils::ByteView data)
+    -> Sha256Digest
+{
+    return sha256(sha256(data));
+}
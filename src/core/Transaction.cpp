@@ -1,12 +1,12 @@
 #include <array>
 #include <core/FlagIndexes.hpp>
+#include <core/Hex.hpp>
 #include <core/Transaction.hpp>
 #include <cstddef>
 #include <client/ReadOnlyClientBase.hpp>
 #include <fmt/core.h>
-#include <iomanip>
 #include <json/value.h>
-#include <sstream>
+#include <string_view>
 #include <utility>
 #include <utils/Opt.hpp>
 #include <vector>
@@ -16,6 +16,7 @@ using forge::core::TxIn;
 using forge::core::TxOut;
 using forge::core::Unspent;
 using forge::core::Transaction;
+using forge::core::ForgeCandidate;
 using forge::utils::Opt;
 using forge::utils::traverse;
 using forge::core::FORGE_IDENTIFIER_MASK;
@@ -312,6 +313,47 @@ auto Unspent::getAddress()
     return address_;
 }
 
+ForgeCandidate::ForgeCandidate(std::string&& txid,
+                               TxIn&& input,
+                               std::int64_t op_return_value,
+                               std::vector<std::byte>&& metadata,
+                               utils::Opt<std::string>&& new_owner)
+    : txid_(std::move(txid)),
+      input_(std::move(input)),
+      op_return_value_(op_return_value),
+      metadata_(std::move(metadata)),
+      new_owner_(std::move(new_owner)) {}
+
+auto ForgeCandidate::getTxid() const
+    -> const std::string&
+{
+    return txid_;
+}
+
+auto ForgeCandidate::getInput() const
+    -> const TxIn&
+{
+    return input_;
+}
+
+auto ForgeCandidate::getOpReturnValue() const
+    -> std::int64_t
+{
+    return op_return_value_;
+}
+
+auto ForgeCandidate::getMetadata() const
+    -> const std::vector<std::byte>&
+{
+    return metadata_;
+}
+
+auto ForgeCandidate::getNewOwner() const
+    -> const utils::Opt<std::string>&
+{
+    return new_owner_;
+}
+
 auto forge::core::buildTxIn(Json::Value&& json)
     -> utils::Opt<TxIn>
 {
@@ -408,7 +450,137 @@ auto forge::core::buildTransaction(Json::Value&& json)
     }
 }
 
-auto forge::core::extractMetadata(std::string&& hex)
+auto forge::core::buildForgeCandidate(const Transaction& tx)
+    -> utils::Opt<ForgeCandidate>
+{
+    if(!tx.hasExactlyOneOpReturnOutput()
+       || !tx.hasExactlyOneInput()) {
+        return std::nullopt;
+    }
+
+    //save, because we checked that the tx has exactly one
+    //op return output
+    const auto& op_return_output =
+        tx.getFirstOpReturnOutput().getValue().get();
+
+    auto metadata_opt = extractMetadata(op_return_output.getHex());
+    if(!metadata_opt
+       || !metadataStartsWithForgeId(metadata_opt.getValue())) {
+        return std::nullopt;
+    }
+
+    auto new_owner =
+        tx.getFirstNonOpReturnOutput()
+            .flatMap([](auto ref)
+                         -> utils::Opt<std::string> {
+                //we only care about outputs with exactly one
+                //address
+                if(ref.get().getAddresses().size() != 1) {
+                    return std::nullopt;
+                }
+                return ref.get().getAddresses()[0];
+            });
+
+    auto txid = tx.getTxid();
+    auto input = tx.getInputs()[0];
+
+    return ForgeCandidate{std::move(txid),
+                          std::move(input),
+                          op_return_output.getValue(),
+                          std::move(metadata_opt.getValue()),
+                          std::move(new_owner)};
+}
+
+auto forge::core::buildForgeCandidate(const Json::Value& json)
+    -> utils::Opt<ForgeCandidate>
+{
+    try {
+        if(!json.isMember("txid")
+           || !json.isMember("vin")
+           || !json.isMember("vout")) {
+            return std::nullopt;
+        }
+
+        //forge operations have exactly one input,
+        //coinbase inputs without txid do not count
+        const auto& vin = json["vin"];
+        if(vin.size() != 1
+           || !vin[0].isMember("txid")
+           || !vin[0].isMember("vout")) {
+            return std::nullopt;
+        }
+
+        const Json::Value* op_return_output = nullptr;
+        const Json::Value* first_other_output = nullptr;
+        std::string_view op_return_hex;
+
+        //only look at the scripts, nothing is copied
+        //until the transaction is known to be a candidate
+        for(const auto& output : json["vout"]) {
+            if(!output.isMember("value")
+               || !output.isMember("scriptPubKey")
+               || !output["scriptPubKey"].isMember("hex")) {
+                return std::nullopt;
+            }
+
+            const char* begin = nullptr;
+            const char* end = nullptr;
+            if(!output["scriptPubKey"]["hex"].getString(&begin, &end)) {
+                return std::nullopt;
+            }
+
+            std::string_view hex{begin,
+                                 static_cast<std::size_t>(end - begin)};
+
+            if(hex.substr(0, 2) != "6a") {
+                if(!first_other_output) {
+                    first_other_output = &output;
+                }
+                continue;
+            }
+
+            //more than one op return output
+            if(op_return_output) {
+                return std::nullopt;
+            }
+
+            op_return_output = &output;
+            op_return_hex = hex;
+        }
+
+        if(!op_return_output) {
+            return std::nullopt;
+        }
+
+        auto metadata_opt = extractMetadata(op_return_hex);
+        if(!metadata_opt
+           || !metadataStartsWithForgeId(metadata_opt.getValue())) {
+            return std::nullopt;
+        }
+
+        utils::Opt<std::string> new_owner;
+        if(first_other_output) {
+            const auto& addresses = (*first_other_output)["scriptPubKey"]["addresses"];
+            if(addresses.size() == 1) {
+                new_owner = addresses[0].asString();
+            }
+        }
+
+        auto value = (*op_return_output)["value"].asDouble();
+        auto conv_value = static_cast<std::int64_t>(value * 100000000.);
+
+        return ForgeCandidate{json["txid"].asString(),
+                              TxIn{vin[0]["txid"].asString(),
+                                   vin[0]["vout"].asUInt()},
+                              conv_value,
+                              std::move(metadata_opt.getValue()),
+                              std::move(new_owner)};
+    } catch(...) {
+        return std::nullopt;
+    }
+}
+
+auto forge::core::extractMetadata(std::string_view hex)
     -> utils::Opt<std::vector<std::byte>>
 {
     if(hex.size() < 4) {
@@ -420,11 +592,19 @@ auto forge::core::extractMetadata(std::string&& hex)
         return std::nullopt;
     }
 
-    //remove the op return Opcode
+    //skip the op return Opcode
     //and the next byte
-    hex.erase(0, 4);
+    auto metadata_hex = hex.substr(4);
+    if(metadata_hex.size() % 2 != 0) {
+        return std::nullopt;
+    }
 
-    return stringToByteVec(hex);
+    std::vector<std::byte> data(metadata_hex.size() / 2);
+    if(!hexDecode(metadata_hex, data.data())) {
+        return std::nullopt;
+    }
+
+    return data;
 }
 
 auto forge::core::stringToByteVec(const std::string& str)
@@ -435,25 +615,12 @@ auto forge::core::stringToByteVec(const std::string& str)
         return std::nullopt;
     }
 
-    //check if all characters are [0-1a-fA-F]
-    auto is_hex = std::all_of(std::begin(str),
-                              std::end(str),
-                              [](auto c) {
-                                  return std::isxdigit(c);
-                              });
-
-    if(!is_hex) {
+    //decoding fails if not all characters are [0-9a-fA-F]
+    std::vector<std::byte> data(str.length() / 2);
+    if(!hexDecode(str, data.data())) {
         return std::nullopt;
     }
 
-    std::vector<std::byte> data;
-
-    for(size_t i = 0; i < str.length(); i += 2) {
-        auto byte_string = str.substr(i, 2);
-        auto byte = static_cast<std::byte>(std::strtol(byte_string.c_str(), nullptr, 16));
-        data.push_back(byte);
-    }
-
     return data;
 }
 
@@ -471,12 +638,7 @@ auto forge::core::metadataStartsWithForgeId(const std::vector<std::byte>& metada
 auto forge::core::toHexString(const std::vector<std::byte>& bytes)
     -> std::string
 {
-    std::stringstream ss;
-    ss << std::hex;
-    for(auto&& b : bytes) {
-        ss << std::setw(2) << std::setfill('0') << static_cast<int>(b);
-    }
-    return ss.str();
+    return hexEncode(bytes.data(), bytes.size());
 }
 
 
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <dns/DnsMessage.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <string>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <utils/Overload.hpp>
+#include <variant>
+#include <vector>
+
+using forge::dns::DnsQuery;
+using forge::dns::DnsAnswer;
+using forge::dns::ResponseCode;
+using forge::core::UMEntryValue;
+using forge::core::IPv4Value;
+using forge::core::IPv6Value;
+using forge::core::ByteArray;
+using forge::core::NoneValue;
+using forge::utils::ByteView;
+
+namespace {
+
+constexpr std::size_t MAX_NAME_LENGTH = 255;
+constexpr std::size_t MAX_CHARACTER_STRING_LENGTH = 255;
+
+constexpr std::byte QR_FLAG{0x80};
+constexpr std::byte AA_FLAG{0x04};
+constexpr std::byte TC_FLAG{0x02};
+constexpr std::byte RD_FLAG{0x01};
+
+//pointer to the name of the question, which always starts
+//directly after the header
+constexpr std::uint16_t QUESTION_NAME_POINTER = 0xC000 | forge::dns::DNS_HEADER_SIZE;
+
+auto readUInt16(ByteView packet, std::size_t offset)
+    -> std::uint16_t
+{
+    return static_cast<std::uint16_t>(
+        (std::to_integer<std::uint16_t>(packet[offset]) << 8)
+        | std::to_integer<std::uint16_t>(packet[offset + 1]));
+}
+
+auto appendUInt16(std::vector<std::byte>& out, std::uint16_t value)
+    -> void
+{
+    out.push_back(static_cast<std::byte>(value >> 8));
+    out.push_back(static_cast<std::byte>(value));
+}
+
+auto appendUInt32(std::vector<std::byte>& out, std::uint32_t value)
+    -> void
+{
+    appendUInt16(out, static_cast<std::uint16_t>(value >> 16));
+    appendUInt16(out, static_cast<std::uint16_t>(value));
+}
+
+auto appendRecord(DnsAnswer& answer,
+                  std::uint16_t type,
+                  std::uint32_t ttl,
+                  ByteView rdata)
+    -> void
+{
+    appendUInt16(answer.records, QUESTION_NAME_POINTER);
+    appendUInt16(answer.records, type);
+    appendUInt16(answer.records, forge::dns::CLASS_IN);
+    appendUInt32(answer.records, ttl);
+    appendUInt16(answer.records, static_cast<std::uint16_t>(rdata.size()));
+    answer.records.insert(std::end(answer.records),
+                          std::begin(rdata),
+                          std::end(rdata));
+    answer.answer_count++;
+}
+
+//txt rdata is a sequence of length prefixed strings
+//of at most 255 bytes each
+auto toTxtRData(const ByteArray& bytes)
+    -> std::vector<std::byte>
+{
+    std::vector<std::byte> rdata;
+    rdata.reserve(bytes.size() + bytes.size() / MAX_CHARACTER_STRING_LENGTH + 1);
+
+    std::size_t offset = 0;
+    do {
+        auto length = std::min(MAX_CHARACTER_STRING_LENGTH,
+                               bytes.size() - offset);
+        rdata.push_back(static_cast<std::byte>(length));
+        rdata.insert(std::end(rdata),
+                     std::begin(bytes) + offset,
+                     std::begin(bytes) + offset + length);
+        offset += length;
+    } while(offset < bytes.size());
+
+    return rdata;
+}
+
+auto matches(std::uint16_t qtype, std::uint16_t type)
+    -> bool
+{
+    return qtype == type || qtype == forge::dns::TYPE_ANY;
+}
+
+auto writeHeader(std::vector<std::byte>& out,
+                 std::uint16_t id,
+                 std::byte flags,
+                 ResponseCode rcode,
+                 std::uint16_t question_count,
+                 std::uint16_t answer_count)
+    -> void
+{
+    appendUInt16(out, id);
+    out.push_back(flags);
+    out.push_back(static_cast<std::byte>(rcode));
+    appendUInt16(out, question_count);
+    appendUInt16(out, answer_count);
+    appendUInt16(out, 0);
+    appendUInt16(out, 0);
+}
+
+} // namespace
+
+auto forge::dns::parseDnsQuery(utils::ByteView packet)
+    -> utils::Opt<DnsQuery>
+{
+    if(packet.size() < DNS_HEADER_SIZE) {
+        return std::nullopt;
+    }
+
+    auto flags = packet[2];
+    auto opcode = std::to_integer<std::uint8_t>(flags >> 3) & 0x0F;
+    if((flags & QR_FLAG) != std::byte{0} || opcode != 0) {
+        return std::nullopt;
+    }
+
+    if(readUInt16(packet, 4) != 1) {
+        return std::nullopt;
+    }
+
+    std::string name;
+    auto offset = DNS_HEADER_SIZE;
+    while(true) {
+        if(offset >= packet.size()) {
+            return std::nullopt;
+        }
+
+        auto length = std::to_integer<std::size_t>(packet[offset++]);
+        if(length == 0) {
+            break;
+        }
+
+        //compression pointers are not used in questions
+        if((length & 0xC0) != 0
+           || offset + length > packet.size()
+           || name.size() + length + 1 > MAX_NAME_LENGTH) {
+            return std::nullopt;
+        }
+
+        if(!name.empty()) {
+            name.push_back('.');
+        }
+
+        for(auto byte : packet.subview(offset, length)) {
+            auto c = std::to_integer<char>(byte);
+            name.push_back(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+        }
+
+        offset += length;
+    }
+
+    if(offset + 4 > packet.size()) {
+        return std::nullopt;
+    }
+
+    return DnsQuery{readUInt16(packet, 0),
+                    (flags & RD_FLAG) != std::byte{0},
+                    std::move(name),
+                    readUInt16(packet, offset),
+                    readUInt16(packet, offset + 2),
+                    offset + 4};
+}
+
+auto forge::dns::buildDnsAnswer(const UMEntryValue& value,
+                                std::uint16_t qtype,
+                                std::uint32_t ttl)
+    -> DnsAnswer
+{
+    auto answer = buildDnsAnswer(ResponseCode::NoError);
+
+    std::visit(
+        utils::overload{
+            [&](const IPv4Value& ipv4) {
+                if(matches(qtype, TYPE_A)) {
+                    appendRecord(answer, TYPE_A, ttl, ipv4);
+                }
+            },
+            [&](const IPv6Value& ipv6) {
+                if(matches(qtype, TYPE_AAAA)) {
+                    appendRecord(answer, TYPE_AAAA, ttl, ipv6);
+                }
+            },
+            [&](const ByteArray& bytes) {
+                if(matches(qtype, TYPE_TXT)) {
+                    appendRecord(answer, TYPE_TXT, ttl, toTxtRData(bytes));
+                }
+            },
+            [](const NoneValue&) {}},
+        value);
+
+    return answer;
+}
+
+auto forge::dns::buildDnsAnswer(ResponseCode rcode)
+    -> DnsAnswer
+{
+    return DnsAnswer{rcode, 0, {}};
+}
+
+auto forge::dns::writeDnsResponse(utils::ByteView packet,
+                                  const DnsQuery& query,
+                                  const DnsAnswer& answer,
+                                  std::size_t max_size,
+                                  std::vector<std::byte>& out)
+    -> void
+{
+    auto question = packet.subview(DNS_HEADER_SIZE,
+                                   query.question_end - DNS_HEADER_SIZE);
+    auto fits = DNS_HEADER_SIZE + question.size() + answer.records.size() <= max_size;
+
+    auto flags = QR_FLAG | AA_FLAG;
+    if(query.recursion_desired) {
+        flags |= RD_FLAG;
+    }
+    if(!fits) {
+        flags |= TC_FLAG;
+    }
+
+    out.clear();
+    writeHeader(out,
+                query.id,
+                flags,
+                answer.rcode,
+                1,
+                fits ? answer.answer_count : 0);
+
+    out.insert(std::end(out),
+               std::begin(question),
+               std::end(question));
+
+    if(fits) {
+        out.insert(std::end(out),
+                   std::begin(answer.records),
+                   std::end(answer.records));
+    }
+}
+
+auto forge::dns::writeDnsErrorResponse(utils::ByteView packet,
+                                       ResponseCode rcode,
+                                       std::vector<std::byte>& out)
+    -> bool
+{
+    //never answer responses, this could create loops
+    if(packet.size() < DNS_HEADER_SIZE
+       || (packet[2] & QR_FLAG) != std::byte{0}) {
+        return false;
+    }
+
+    //keep the opcode and the recursion desired flag of the request
+    auto flags = QR_FLAG | (packet[2] & std::byte{0x79});
+
+    out.clear();
+    writeHeader(out, readUInt16(packet, 0), flags, rcode, 0, 0);
+
+    return true;
+}
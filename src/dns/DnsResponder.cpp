@@ -0,0 +1,99 @@
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <dns/DnsMessage.hpp>
+#include <dns/DnsResponder.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <string>
+#include <utils/ByteView.hpp>
+#include <vector>
+
+using forge::dns::DnsResponder;
+using forge::dns::DnsQuery;
+using forge::dns::DnsAnswer;
+using forge::dns::ResponseCode;
+
+DnsResponder::DnsResponder(ValueLookup lookup,
+                           std::uint32_t ttl,
+                           std::size_t max_cache_size)
+    : lookup_(std::move(lookup)),
+      ttl_(ttl),
+      max_cache_size_(max_cache_size) {}
+
+auto DnsResponder::respond(utils::ByteView packet,
+                           std::int64_t block_height,
+                           std::size_t max_size,
+                           std::vector<std::byte>& out)
+    -> bool
+{
+    auto query_opt = parseDnsQuery(packet);
+    if(!query_opt) {
+        auto opcode = packet.size() > 2
+            ? std::to_integer<std::uint8_t>(packet[2] >> 3) & 0x0F
+            : 0;
+        return writeDnsErrorResponse(packet,
+                                     opcode == 0
+                                         ? ResponseCode::FormatError
+                                         : ResponseCode::NotImplemented,
+                                     out);
+    }
+
+    auto& query = query_opt.getValue();
+
+    //every answer belongs to one block height
+    if(block_height != cache_height_ || cache_.size() >= max_cache_size_) {
+        cache_.clear();
+        cache_height_ = block_height;
+    }
+
+    cache_key_.clear();
+    cache_key_.push_back(static_cast<char>(query.qtype >> 8));
+    cache_key_.push_back(static_cast<char>(query.qtype));
+    cache_key_.push_back(static_cast<char>(query.qclass >> 8));
+    cache_key_.push_back(static_cast<char>(query.qclass));
+    cache_key_ += query.name;
+
+    auto iter = cache_.find(cache_key_);
+    if(iter != std::end(cache_)) {
+        cache_hits_++;
+    } else {
+        cache_misses_++;
+        iter = cache_.emplace(cache_key_, resolve(query)).first;
+    }
+
+    writeDnsResponse(packet, query, iter->second, max_size, out);
+
+    return true;
+}
+
+auto DnsResponder::getCacheHits() const
+    -> std::uint64_t
+{
+    return cache_hits_;
+}
+
+auto DnsResponder::getCacheMisses() const
+    -> std::uint64_t
+{
+    return cache_misses_;
+}
+
+auto DnsResponder::resolve(const DnsQuery& query)
+    -> DnsAnswer
+{
+    if(query.qclass != CLASS_IN && query.qclass != CLASS_ANY) {
+        return buildDnsAnswer(ResponseCode::Refused);
+    }
+
+    if(query.name.empty()) {
+        return buildDnsAnswer(ResponseCode::NameError);
+    }
+
+    auto key = core::stringToASCIIByteVec(query.name);
+
+    return lookup_(key)
+        .map([&](const auto& value) {
+            return buildDnsAnswer(value, query.qtype, ttl_);
+        })
+        .valueOr(buildDnsAnswer(ResponseCode::NameError));
+}
@@ -0,0 +1,490 @@
+#include <algorithm>
+#include <arpa/inet.h>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <dns/DnsError.hpp>
+#include <dns/DnsMessage.hpp>
+#include <dns/DnsResponder.hpp>
+#include <dns/DnsServer.hpp>
+#include <fcntl.h>
+#include <fmt/core.h>
+#include <g3log/g3log.hpp>
+#include <netinet/in.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utils/ByteView.hpp>
+#include <utils/Result.hpp>
+#include <vector>
+
+using forge::dns::DnsServer;
+using forge::dns::DnsError;
+using forge::dns::DnsResponder;
+
+namespace {
+
+//number of datagrams received and sent with one system call
+constexpr std::size_t UDP_BATCH_SIZE = 64;
+//larger queries are truncated, the question is still complete
+constexpr std::size_t MAX_QUERY_SIZE = 1232;
+
+//the udp workers check for a stop request after this timeout
+constexpr timeval SOCKET_TIMEOUT{0, 200000};
+//the tcp worker checks for a stop request and
+//expired connections after this timeout
+constexpr int EPOLL_TIMEOUT_MS = 200;
+//a tcp connection is closed after this time, no matter how much
+//it still sends, so slow peers cannot hold on to their connection
+constexpr auto TCP_CONNECTION_DEADLINE = std::chrono::seconds{5};
+//further connections are closed right after they were accepted
+constexpr std::size_t MAX_TCP_CONNECTIONS = 1024;
+constexpr std::size_t MAX_TCP_EVENTS = 64;
+constexpr std::size_t TCP_READ_SIZE = 16 * 1024;
+
+struct TcpConnection
+{
+    std::chrono::steady_clock::time_point deadline;
+    std::vector<std::byte> input;
+    std::vector<std::byte> output;
+    std::size_t output_offset = 0;
+    //events the connection is registered for in epoll
+    std::uint32_t events = EPOLLIN;
+};
+
+auto isTimeout(int error)
+    -> bool
+{
+    return error == EAGAIN
+        || error == EWOULDBLOCK
+        || error == EINTR;
+}
+
+auto acceptTcpConnections(int socket,
+                          int epoll_fd,
+                          std::unordered_map<int, TcpConnection>& connections)
+    -> void
+{
+    while(true) {
+        auto fd = accept4(socket, nullptr, nullptr, SOCK_NONBLOCK);
+        if(fd < 0) {
+            return;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if(connections.size() >= MAX_TCP_CONNECTIONS
+           || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+
+        TcpConnection connection;
+        connection.deadline = std::chrono::steady_clock::now() + TCP_CONNECTION_DEADLINE;
+        connections.emplace(fd, std::move(connection));
+    }
+}
+
+//answers every complete message of the input,
+//returns false if the connection should be closed
+auto answerTcpQueries(TcpConnection& connection,
+                      DnsResponder& responder,
+                      std::int64_t height,
+                      std::vector<std::byte>& response)
+    -> bool
+{
+    auto& input = connection.input;
+    std::size_t consumed = 0;
+
+    //every message is prefixed by its length
+    while(input.size() - consumed >= 2) {
+        auto length = std::to_integer<std::size_t>(input[consumed]) << 8
+            | std::to_integer<std::size_t>(input[consumed + 1]);
+
+        if(input.size() - consumed - 2 < length) {
+            break;
+        }
+
+        forge::utils::ByteView query{input.data() + consumed + 2, length};
+        consumed += 2 + length;
+
+        if(!responder.respond(query, height, forge::dns::MAX_TCP_RESPONSE_SIZE, response)) {
+            return false;
+        }
+
+        connection.output.push_back(static_cast<std::byte>(response.size() >> 8));
+        connection.output.push_back(static_cast<std::byte>(response.size()));
+        connection.output.insert(std::end(connection.output),
+                                 std::begin(response),
+                                 std::end(response));
+    }
+
+    input.erase(std::begin(input), std::begin(input) + consumed);
+
+    return true;
+}
+
+//reads and answers the queries of the connection and writes as much
+//of the answers as possible, returns false if it should be closed
+auto serveTcpConnection(int fd,
+                        int epoll_fd,
+                        TcpConnection& connection,
+                        DnsResponder& responder,
+                        std::int64_t height,
+                        std::vector<std::byte>& response)
+    -> bool
+{
+    //nothing is read while answers are pending, so a peer which
+    //does not read its answers cannot make the output grow
+    if(connection.output_offset == connection.output.size()) {
+        auto offset = connection.input.size();
+        connection.input.resize(offset + TCP_READ_SIZE);
+
+        auto received = recv(fd, connection.input.data() + offset, TCP_READ_SIZE, 0);
+        if(received <= 0) {
+            connection.input.resize(offset);
+            return received < 0 && isTimeout(errno);
+        }
+
+        connection.input.resize(offset + static_cast<std::size_t>(received));
+
+        if(!answerTcpQueries(connection, responder, height, response)) {
+            return false;
+        }
+    }
+
+    while(connection.output_offset < connection.output.size()) {
+        auto sent = send(fd,
+                         connection.output.data() + connection.output_offset,
+                         connection.output.size() - connection.output_offset,
+                         MSG_NOSIGNAL);
+        if(sent < 0) {
+            if(isTimeout(errno)) {
+                break;
+            }
+            return false;
+        }
+
+        connection.output_offset += static_cast<std::size_t>(sent);
+    }
+
+    auto drained = connection.output_offset == connection.output.size();
+    if(drained) {
+        connection.output.clear();
+        connection.output_offset = 0;
+    }
+
+    std::uint32_t events = drained ? EPOLLIN : EPOLLOUT;
+    if(events != connection.events) {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+        connection.events = events;
+    }
+
+    return true;
+}
+
+} // namespace
+
+DnsServer::DnsServer(ValueLookup lookup,
+                     HeightLookup height,
+                     std::uint32_t ttl)
+    : lookup_(std::move(lookup)),
+      height_(std::move(height)),
+      ttl_(ttl) {}
+
+DnsServer::~DnsServer()
+{
+    stop();
+}
+
+auto DnsServer::start(const std::string& host,
+                      std::uint16_t port,
+                      std::size_t number_of_workers)
+    -> utils::Result<void, DnsError>
+{
+    if(running_.load()) {
+        return DnsError{"dns server is already running"};
+    }
+
+    port_ = port;
+    number_of_workers = std::max<std::size_t>(number_of_workers, 1);
+
+    std::vector<int> udp_sockets;
+    for(std::size_t i = 0; i < number_of_workers; i++) {
+        auto socket_res = bindSocket(SOCK_DGRAM, host);
+        if(!socket_res) {
+            closeSockets();
+            return socket_res.getError();
+        }
+
+        udp_sockets.push_back(socket_res.getValue());
+    }
+
+    auto tcp_res = bindSocket(SOCK_STREAM, host);
+    if(!tcp_res) {
+        closeSockets();
+        return tcp_res.getError();
+    }
+
+    running_.store(true);
+
+    for(auto socket : udp_sockets) {
+        workers_.emplace_back([this, socket] {
+            runUdpWorker(socket);
+        });
+    }
+
+    workers_.emplace_back([this, socket = tcp_res.getValue()] {
+        runTcpWorker(socket);
+    });
+
+    LOG(INFO) << fmt::format("dns server listening on {}:{} with {} udp workers",
+                             host,
+                             port_,
+                             number_of_workers);
+
+    return {};
+}
+
+auto DnsServer::stop()
+    -> void
+{
+    running_.store(false);
+
+    for(auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    closeSockets();
+}
+
+auto DnsServer::getPort() const
+    -> std::uint16_t
+{
+    return port_;
+}
+
+auto DnsServer::bindSocket(int type,
+                           const std::string& host)
+    -> utils::Result<int, DnsError>
+{
+    auto error = [](auto&& what) {
+        return DnsError{fmt::format("{}: {}", what, std::strerror(errno))};
+    };
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port_);
+    if(inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        return DnsError{fmt::format("invalid dns host {}", host)};
+    }
+
+    auto fd = socket(AF_INET, type, 0);
+    if(fd < 0) {
+        return error("unable to create dns socket");
+    }
+    sockets_.push_back(fd);
+
+    //every udp worker binds its own socket to the same port
+    //and the kernel distributes the datagrams between them
+    int enable = 1;
+    if(setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) < 0
+       || setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0
+       || setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &SOCKET_TIMEOUT, sizeof(SOCKET_TIMEOUT)) < 0) {
+        return error("unable to configure dns socket");
+    }
+
+    if(bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        return error(fmt::format("unable to bind dns socket to {}:{}", host, port_));
+    }
+
+    //remember the chosen port, so all other sockets use the same one
+    if(port_ == 0) {
+        socklen_t length = sizeof(address);
+        if(getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) < 0) {
+            return error("unable to get the port of the dns socket");
+        }
+        port_ = ntohs(address.sin_port);
+    }
+
+    if(type == SOCK_STREAM && listen(fd, SOMAXCONN) < 0) {
+        return error("unable to listen on dns socket");
+    }
+
+    return fd;
+}
+
+auto DnsServer::runUdpWorker(int socket)
+    -> void
+{
+    DnsResponder responder{lookup_, ttl_};
+
+    std::vector<std::array<std::byte, MAX_QUERY_SIZE>> queries(UDP_BATCH_SIZE);
+    std::vector<std::vector<std::byte>> responses(UDP_BATCH_SIZE);
+    std::array<sockaddr_storage, UDP_BATCH_SIZE> addresses{};
+    std::array<iovec, UDP_BATCH_SIZE> query_iovecs{};
+    std::array<iovec, UDP_BATCH_SIZE> response_iovecs{};
+    std::array<mmsghdr, UDP_BATCH_SIZE> query_msgs{};
+    std::array<mmsghdr, UDP_BATCH_SIZE> response_msgs{};
+
+    for(std::size_t i = 0; i < UDP_BATCH_SIZE; i++) {
+        responses[i].reserve(MAX_UDP_RESPONSE_SIZE);
+        query_iovecs[i] = iovec{queries[i].data(), queries[i].size()};
+        query_msgs[i].msg_hdr.msg_iov = &query_iovecs[i];
+        query_msgs[i].msg_hdr.msg_iovlen = 1;
+        query_msgs[i].msg_hdr.msg_name = &addresses[i];
+    }
+
+    while(running_.load()) {
+        for(auto& msg : query_msgs) {
+            msg.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        }
+
+        //blocks until the first datagram arrives and then
+        //takes everything else which is already queued
+        auto received = recvmmsg(socket,
+                                 query_msgs.data(),
+                                 UDP_BATCH_SIZE,
+                                 MSG_WAITFORONE,
+                                 nullptr);
+        if(received < 0) {
+            if(isTimeout(errno)) {
+                continue;
+            }
+            LOG(WARNING) << "dns udp worker stopped: " << std::strerror(errno);
+            return;
+        }
+
+        //all answers of one batch belong to the same block height
+        auto height = height_();
+
+        std::size_t number_of_responses = 0;
+        for(int i = 0; i < received; i++) {
+            utils::ByteView packet{queries[i].data(),
+                                   query_msgs[i].msg_len};
+
+            if(!responder.respond(packet, height, MAX_UDP_RESPONSE_SIZE, responses[i])) {
+                continue;
+            }
+
+            auto& response_msg = response_msgs[number_of_responses++];
+            response_iovecs[i] = iovec{responses[i].data(), responses[i].size()};
+            response_msg.msg_hdr.msg_iov = &response_iovecs[i];
+            response_msg.msg_hdr.msg_iovlen = 1;
+            response_msg.msg_hdr.msg_name = &addresses[i];
+            response_msg.msg_hdr.msg_namelen = query_msgs[i].msg_hdr.msg_namelen;
+        }
+
+        std::size_t number_sent = 0;
+        while(number_sent < number_of_responses) {
+            auto sent = sendmmsg(socket,
+                                 response_msgs.data() + number_sent,
+                                 number_of_responses - number_sent,
+                                 0);
+            if(sent < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                LOG(WARNING) << "unable to send dns responses: " << std::strerror(errno);
+                break;
+            }
+
+            number_sent += static_cast<std::size_t>(sent);
+        }
+    }
+}
+
+auto DnsServer::runTcpWorker(int socket)
+    -> void
+{
+    //tcp is only used as fallback for truncated answers, so one
+    //thread multiplexes all connections with epoll
+    DnsResponder responder{lookup_, ttl_};
+    std::vector<std::byte> response;
+    std::unordered_map<int, TcpConnection> connections;
+    std::array<epoll_event, MAX_TCP_EVENTS> events;
+
+    epoll_event listen_event{};
+    listen_event.events = EPOLLIN;
+    listen_event.data.fd = socket;
+
+    auto epoll_fd = epoll_create1(0);
+    if(epoll_fd < 0
+       || fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK) < 0
+       || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, socket, &listen_event) < 0) {
+        LOG(WARNING) << "dns tcp worker stopped: " << std::strerror(errno);
+        if(epoll_fd >= 0) {
+            close(epoll_fd);
+        }
+        return;
+    }
+
+    auto close_connection = [&](int fd) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    };
+
+    while(running_.load()) {
+        auto number_of_events = epoll_wait(epoll_fd,
+                                           events.data(),
+                                           events.size(),
+                                           EPOLL_TIMEOUT_MS);
+
+        //all answers of one batch belong to the same block height
+        auto height = height_();
+
+        for(int i = 0; i < number_of_events; i++) {
+            auto fd = events[i].data.fd;
+
+            if(fd == socket) {
+                acceptTcpConnections(socket, epoll_fd, connections);
+                continue;
+            }
+
+            auto iter = connections.find(fd);
+            if(iter == std::end(connections)) {
+                continue;
+            }
+
+            if((events[i].events & (EPOLLERR | EPOLLHUP)) != 0
+               || !serveTcpConnection(fd, epoll_fd, iter->second, responder, height, response)) {
+                close_connection(fd);
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        for(auto iter = std::begin(connections); iter != std::end(connections);) {
+            auto current = iter++;
+            if(current->second.deadline <= now) {
+                close_connection(current->first);
+            }
+        }
+    }
+
+    for(const auto& [fd, connection] : connections) {
+        close(fd);
+    }
+    close(epoll_fd);
+}
+
+auto DnsServer::closeSockets()
+    -> void
+{
+    for(auto socket : sockets_) {
+        close(socket);
+    }
+    sockets_.clear();
+}
@@ -7,6 +7,7 @@
 #include <entrys/token/UtilityToken.hpp>
 #include <iterator>
 #include <json/value.h>
+#include <utils/ByteView.hpp>
 #include <utils/Opt.hpp>
 #include <variant>
 #include <vector>
@@ -85,8 +86,8 @@ auto UtilityToken::operator!=(const UtilityToken& rhs) const
     return id_ != rhs.id_;
 }
 
-auto forge::core::parseUtilityToken(const std::vector<std::byte>& metadata)
-    -> utils::Opt<UtilityToken>
+auto forge::core::parseUtilityTokenView(utils::ByteView metadata)
+    -> utils::Opt<UtilityTokenView>
 {
     //3 bytes mask
     //1 tokeyn type flag
@@ -102,8 +103,7 @@ auto forge::core::parseUtilityToken(const std::vector<std::byte>& metadata)
         return std::nullopt;
     }
 
-    std::vector id(std::cbegin(metadata) + UTILITY_TOKEN_ID_START_INDEX,
-                   std::cend(metadata));
+    auto id = metadata.subview(UTILITY_TOKEN_ID_START_INDEX);
 
     std::uint64_t amount =
         (static_cast<std::uint64_t>(metadata[5]) << 56)
@@ -115,6 +115,21 @@ auto forge::core::parseUtilityToken(const std::vector<std::byte>& metadata)
         | (static_cast<std::uint64_t>(metadata[11]) << 8)
         | (static_cast<std::uint64_t>(metadata[12]));
 
-    return UtilityToken{std::move(id),
-                        amount};
+    return UtilityTokenView{id, amount};
+}
+
+auto forge::core::toUtilityToken(const UtilityTokenView& view)
+    -> UtilityToken
+{
+    return UtilityToken{view.id.toVector(),
+                        view.amount};
+}
+
+auto forge::core::parseUtilityToken(utils::ByteView metadata)
+    -> utils::Opt<UtilityToken>
+{
+    return parseUtilityTokenView(metadata)
+        .map([](auto view) {
+            return toUtilityToken(view);
+        });
 }
@@ -25,6 +25,7 @@ using forge::core::UTILITY_TOKEN_CREATION_FLAG;
 using forge::core::UTILITY_TOKEN_DELETION_FLAG;
 using forge::core::UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG;
 using forge::core::Transaction;
+using forge::core::ForgeCandidate;
 using forge::core::UtilityTokenOperation;
 using forge::client::ReadOnlyClientBase;
 using forge::client::ClientError;
@@ -107,7 +108,7 @@ auto forge::core::extractOperationFlag(const UtilityTokenOperation& op)
         op);
 }
 
-auto forge::core::parseTransactionToUtilityTokenOp(Transaction tx,
+auto forge::core::parseTransactionToUtilityTokenOp(const Transaction& tx,
                                                    std::int64_t block,
                                                    const ReadOnlyClientBase* client)
     -> utils::Result<utils::Opt<UtilityTokenOperation>,
@@ -116,66 +117,48 @@ auto forge::core::parseTransactionToUtilityTokenOp(Transaction tx,
     using ResultType = utils::Result<utils::Opt<UtilityTokenOperation>,
                                       ClientError>;
 
+    return buildForgeCandidate(tx)
+        .map([&](const auto& candidate) {
+            return parseForgeCandidateToUtilityTokenOp(candidate, block, client);
+        })
+        .valueOr(ResultType{std::nullopt});
+}
+
+auto forge::core::parseForgeCandidateToUtilityTokenOp(const ForgeCandidate& candidate,
+                                                      std::int64_t block,
+                                                      const ReadOnlyClientBase* client)
+    -> utils::Result<utils::Opt<UtilityTokenOperation>,
+                      ClientError>
+{
+    using ResultType = utils::Result<utils::Opt<UtilityTokenOperation>,
+                                      ClientError>;
+
     LOG_IF(FATAL, !client) << "ReadOnlyClientBase pointer is null";
 
-    //check if the transaction has exactly one op return
-    //output and exactly one input
-    //if this is not the case the tx does not repressent a forge op
-    if(!tx.hasExactlyOneOpReturnOutput()
-       || !tx.hasExactlyOneInput()) {
+    //validate the operation on a view of the metadata,
+    //so the input only gets resolved for valid operations
+    auto view_opt = parseMetadataToUtilityTokenOpView(candidate.getMetadata());
+    if(!view_opt) {
         return ResultType{std::nullopt};
     }
 
-    LOG(INFO) << tx.getTxid() << " contains a OP_RETURN output";
-
-    //save, because we checked that the tx has exactly one
-    //op return output
-    const auto& op_return_output =
-        tx.getFirstOpReturnOutput()
-            .getValue()
-            .get();
-
-    //get optional new owner
-    //for ownership transfer
-    auto new_owner_opt =
-        tx.getFirstNonOpReturnOutput()
-            .flatMap([](auto ref)
-                         -> utils::Opt<std::string> {
-                //we only care about outputs with exactly one
-                //address
-                if(ref.get().getAddresses().size() != 1) {
-                    return std::nullopt;
-                }
-                return ref.get().getAddresses()[0];
-            });
-
-    //save, because we have checked that the tx has exactly
-    //one input
-    auto vin = std::move(tx.getInputs()[0]);
-
-    //value of the op return output
-    auto value = op_return_output.getValue();
-
-    //extract the metadata from the output script
-    auto output_script = std::move(op_return_output.getHex());
-    auto metadata_opt = extractMetadata(std::move(output_script));
-
-    if(!metadata_opt) {
-        return ResultType{std::nullopt};
-    }
+    const auto& view = view_opt.getValue();
 
-    //get metadata from the op return output
-    auto metadata = std::move(metadata_opt.getValue());
+    LOG(INFO) << candidate.getTxid() << " contains a utility token operation";
 
-    //check if the metadata starts with a forge id
-    //if not the tx is not a valid forge tx and can be ignored
-    if(!metadataStartsWithForgeId(metadata)) {
+    //ownership transfers need the address of the first
+    //non op return output as new owner
+    auto new_owner_opt = candidate.getNewOwner();
+    if(view.operation_flag == UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG
+       && !new_owner_opt) {
         return ResultType{std::nullopt};
     }
 
+    const auto& vin = candidate.getInput();
+
     LOG(DEBUG) << "resoving vin from " << vin.getTxid();
     return client
-        ->resolveTxIn(std::move(vin))
+        ->resolveTxIn(vin)
         .flatMap([&](auto resolvedVin) {
             //we can only have one input address
             if(resolvedVin.getAddresses().size() != 1) {
@@ -185,66 +168,97 @@ auto forge::core::parseTransactionToUtilityTokenOp(Transaction tx,
             //get owner
             auto owner = std::move(resolvedVin.getAddresses()[0]);
 
-            //parse the metadata nd put it into
-            //the ResultType
+            //create the owning operation from the view
             return ResultType{
-                parseMetadataToUtilityTokenOp(std::move(metadata),
-                                              block,
-                                              std::move(owner),
-                                              value,
-                                              std::move(new_owner_opt))};
+                toUtilityTokenOp(view,
+                                 block,
+                                 std::move(owner),
+                                 candidate.getOpReturnValue(),
+                                 std::move(new_owner_opt))};
         });
 }
 
+auto forge::core::parseMetadataToUtilityTokenOpView(utils::ByteView metadata)
+    -> utils::Opt<UtilityTokenOperationView>
+{
+    const auto flag = metadata.size() > OPERATION_FLAG_INDEX
+        ? metadata[OPERATION_FLAG_INDEX]
+        : std::byte{0};
+
+    if(flag != UTILITY_TOKEN_CREATION_FLAG
+       && flag != UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG
+       && flag != UTILITY_TOKEN_DELETION_FLAG) {
+        return std::nullopt;
+    }
 
-auto forge::core::parseMetadataToUtilityTokenOp(const std::vector<std::byte>& metadata,
+    return parseUtilityTokenView(metadata)
+        .map([&flag](auto token) {
+            return UtilityTokenOperationView{flag, token};
+        });
+}
+
+auto forge::core::toUtilityTokenOp(const UtilityTokenOperationView& view,
+                                   std::int64_t block,
+                                   std::string&& owner,
+                                   std::int64_t burn_value,
+                                   utils::Opt<std::string>&& new_owner_opt)
+    -> utils::Opt<UtilityTokenOperation>
+{
+    //check before the id is copied out of the metadata
+    if(view.operation_flag == UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG
+       && !new_owner_opt) {
+        return std::nullopt;
+    }
+
+    auto amount = view.token.amount;
+    auto token = toUtilityToken(view.token);
+
+    switch(view.operation_flag) {
+
+    case UTILITY_TOKEN_CREATION_FLAG:
+        return UtilityTokenOperation{
+            UtilityTokenCreationOp{std::move(token),
+                                   amount,
+                                   std::move(owner),
+                                   block,
+                                   burn_value}};
+
+    case UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG:
+        return UtilityTokenOperation{
+            UtilityTokenOwnershipTransferOp{std::move(token),
+                                            amount,
+                                            std::move(owner),
+                                            std::move(new_owner_opt.getValue()),
+                                            block,
+                                            burn_value}};
+
+    case UTILITY_TOKEN_DELETION_FLAG:
+        return UtilityTokenOperation{
+            UtilityTokenDeletionOp{std::move(token),
+                                   amount,
+                                   std::move(owner),
+                                   block,
+                                   burn_value}};
+
+    default:
+        return std::nullopt;
+    }
+}
+
+auto forge::core::parseMetadataToUtilityTokenOp(utils::ByteView metadata,
                                                 std::int64_t block,
                                                 std::string&& owner,
                                                 std::int64_t burn_value,
                                                 utils::Opt<std::string>&& new_owner_opt)
     -> utils::Opt<UtilityTokenOperation>
 {
-    if(metadata.size() < 14) {
-        return std::nullopt;
-    }
-
-    return parseUtilityToken(metadata)
-        .flatMap([&](auto entry)
-                     -> utils::Opt<UtilityTokenOperation> {
-            auto amount = entry.getAttachedAmount();
-
-            switch(metadata[OPERATION_FLAG_INDEX]) {
-
-            case UTILITY_TOKEN_CREATION_FLAG:
-                return UtilityTokenOperation{
-                    UtilityTokenCreationOp{std::move(entry),
-                                           amount,
-                                           std::move(owner),
-                                           block,
-                                           burn_value}};
-
-            case UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG:
-                return new_owner_opt
-                    .map([&](auto new_owner) {
-                        return UtilityTokenOperation{
-                            UtilityTokenOwnershipTransferOp{std::move(entry),
-                                                            amount,
-                                                            std::move(owner),
-                                                            std::move(new_owner),
-                                                            block,
-                                                            burn_value}};
-                    });
-            case UTILITY_TOKEN_DELETION_FLAG:
-                return UtilityTokenOperation{
-                    UtilityTokenDeletionOp{std::move(entry),
-                                           amount,
-                                           std::move(owner),
-                                           block,
-                                           burn_value}};
-
-            default:
-                return std::nullopt;
-            }
+    return parseMetadataToUtilityTokenOpView(metadata)
+        .flatMap([&](auto view) {
+            return toUtilityTokenOp(view,
+                                    block,
+                                    std::move(owner),
+                                    burn_value,
+                                    std::move(new_owner_opt));
         });
 }
 
@@ -2,6 +2,7 @@
 #include <core/Transaction.hpp>
 #include <entrys/uentry/UniqueEntry.hpp>
 #include <entrys/umentry/UMEntry.hpp>
+#include <utils/ByteView.hpp>
 #include <utils/Overload.hpp>
 #include <variant>
 #include <vector>
@@ -80,7 +81,7 @@ auto UniqueEntry::getValue()
 }
 
 
-auto forge::core::parseUniqueValue(const std::vector<std::byte>& data)
+auto forge::core::parseUniqueValue(utils::ByteView data)
     -> utils::Opt<UniqueEntryValue>
 {
     return parseUMValue(data)
@@ -93,13 +94,24 @@ auto forge::core::parseUniqueValue(const std::vector<std::byte>& data)
         });
 }
 
-auto forge::core::parseUniqueKey(const std::vector<std::byte>& data)
-    -> utils::Opt<EntryKey>
+auto forge::core::parseUniqueKey(utils::ByteView data)
+    -> utils::Opt<utils::ByteView>
 {
     return parseUMKey(data);
 }
 
-auto forge::core::parseUniqueEntry(const std::vector<std::byte>& data)
+auto forge::core::toUniqueEntry(const EntryView& view)
+    -> UniqueEntry
+{
+    return std::visit(
+        [&view](auto value) {
+            return UniqueEntry{view.key.toVector(),
+                               UniqueEntryValue{std::move(value)}};
+        },
+        toUMEntryValue(view));
+}
+
+auto forge::core::parseUniqueEntry(utils::ByteView data)
     -> utils::Opt<UniqueEntry>
 {
     //3 bytes mask
@@ -117,15 +129,9 @@ auto forge::core::parseUniqueEntry(const std::vector<std::byte>& data)
         return std::nullopt;
     }
 
-    auto value_opt = parseUniqueValue(data);
-    auto key_opt = parseUniqueKey(data);
-
-
-    return combine(std::move(key_opt),
-                   std::move(value_opt))
-        .map([](auto pair) {
-            return UniqueEntry{std::move(pair.first),
-                               std::move(pair.second)};
+    return parseEntryView(data)
+        .map([](auto view) {
+            return toUniqueEntry(view);
         });
 }
 
@@ -1,8 +1,10 @@
 #include <core/FlagIndexes.hpp>
+#include <core/Hex.hpp>
 #include <cstddef>
 #include <entrys/umentry/UMEntry.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
 #include <g3log/g3log.hpp>
+#include <utils/ByteView.hpp>
 #include <utils/Opt.hpp>
 #include <utils/Overload.hpp>
 #include <vector>
@@ -93,101 +95,111 @@ auto UMEntry::operator!=(const UMEntry& rhs) const
 }
 
 
-auto forge::core::parseUMValue(const std::vector<std::byte>& data)
-    -> utils::Opt<UMEntryValue>
+auto forge::core::parseEntryView(utils::ByteView data)
+    -> utils::Opt<EntryView>
 {
-    if(data[ENTRY_VALUE_FLAG_INDEX] == NONE_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 1) {
-        return UMEntryValue{NoneValue{}};
+    if(data.size() <= ENTRY_VALUE_FLAG_INDEX) {
+        return std::nullopt;
     }
 
-    if(data[ENTRY_VALUE_FLAG_INDEX] == BYTE_ARRAY_VALUE_FLAG
-       && static_cast<std::int64_t>(data.size())
-           > ENTRY_VALUE_FLAG_INDEX + 2) {
-        auto value_length = static_cast<std::int64_t>(data[5]);
+    const auto value_flag = data[ENTRY_VALUE_FLAG_INDEX];
+    const std::size_t value_start = ENTRY_VALUE_FLAG_INDEX + 1;
 
-        //check the bounds
-        if(ENTRY_VALUE_FLAG_INDEX + 2 + value_length
-           > static_cast<std::int64_t>(data.size())) {
+    //returns the view if there is at least one byte of key
+    //after a value of the given size
+    auto make_view = [&](std::size_t value_size)
+        -> utils::Opt<EntryView> {
+        if(data.size() <= value_start + value_size) {
             return std::nullopt;
         }
 
-        ByteArray byte_array;
-        std::copy(std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 2,
-                  std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 2 + value_length,
-                  std::begin(byte_array));
+        return EntryView{data.subview(value_start + value_size),
+                         value_flag,
+                         data.subview(value_start, value_size)};
+    };
 
-        return UMEntryValue{std::move(byte_array)};
+    if(value_flag == NONE_VALUE_FLAG) {
+        return make_view(0);
     }
 
-    if(data[ENTRY_VALUE_FLAG_INDEX] == IPv4_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 5) {
-        IPv4Value ipv4;
-        std::copy(std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 1,
-                  std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 5,
-                  std::begin(ipv4));
-        return UMEntryValue{std::move(ipv4)};
+    if(value_flag == IPv4_VALUE_FLAG) {
+        return make_view(std::tuple_size_v<IPv4Value>);
     }
 
+    if(value_flag == IPv6_VALUE_FLAG) {
+        return make_view(std::tuple_size_v<IPv6Value>);
+    }
 
-    if(data[ENTRY_VALUE_FLAG_INDEX] == IPv6_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 17) {
+    if(value_flag == BYTE_ARRAY_VALUE_FLAG
+       && data.size() > value_start + 1) {
+        //the first byte of a byte array value is its length
+        auto value_length = std::to_integer<std::size_t>(data[value_start]);
 
-        IPv6Value ipv6;
-        std::copy(std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 1,
-                  std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 17,
-                  std::begin(ipv6));
+        //check the bounds, at least one byte of key has to follow
+        if(value_start + 1 + value_length >= data.size()) {
+            return std::nullopt;
+        }
 
-        return UMEntryValue{std::move(ipv6)};
+        return EntryView{data.subview(value_start + 1 + value_length),
+                         value_flag,
+                         data.subview(value_start + 1, value_length)};
     }
 
     return std::nullopt;
 }
 
-auto forge::core::parseUMKey(const std::vector<std::byte>& data)
-    -> utils::Opt<EntryKey>
+auto forge::core::toUMEntryValue(const EntryView& view)
+    -> UMEntryValue
 {
-    if(data[ENTRY_VALUE_FLAG_INDEX] == NONE_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 1) {
-
-        return EntryKey{std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 1,
-                        std::end(data)};
+    if(view.value_flag == IPv4_VALUE_FLAG) {
+        IPv4Value ipv4;
+        std::copy(std::begin(view.value),
+                  std::end(view.value),
+                  std::begin(ipv4));
+        return UMEntryValue{std::move(ipv4)};
     }
 
-    if(data[ENTRY_VALUE_FLAG_INDEX] == BYTE_ARRAY_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 2) {
-        auto value_length = static_cast<std::int64_t>(data[ENTRY_VALUE_FLAG_INDEX + 1]);
-
-        //check the bounds
-        if(ENTRY_VALUE_FLAG_INDEX + 2 + value_length
-           > static_cast<std::int64_t>(data.size())) {
-            return std::nullopt;
-        }
-
-        return EntryKey{std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 2 + value_length,
-                        std::end(data)};
+    if(view.value_flag == IPv6_VALUE_FLAG) {
+        IPv6Value ipv6;
+        std::copy(std::begin(view.value),
+                  std::end(view.value),
+                  std::begin(ipv6));
+        return UMEntryValue{std::move(ipv6)};
     }
 
-    if(data[ENTRY_VALUE_FLAG_INDEX] == IPv4_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 5) {
-
-        return EntryKey{std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 5,
-                        std::end(data)};
+    if(view.value_flag == BYTE_ARRAY_VALUE_FLAG) {
+        return UMEntryValue{view.value.toVector()};
     }
 
+    return UMEntryValue{NoneValue{}};
+}
 
+auto forge::core::toUMEntry(const EntryView& view)
+    -> UMEntry
+{
+    return UMEntry{view.key.toVector(),
+                   toUMEntryValue(view)};
+}
 
-    if(data[ENTRY_VALUE_FLAG_INDEX] == IPv6_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 17) {
-
-        return EntryKey{std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 17,
-                        std::end(data)};
-    }
+auto forge::core::parseUMValue(utils::ByteView data)
+    -> utils::Opt<UMEntryValue>
+{
+    return parseEntryView(data)
+        .map([](auto view) {
+            return toUMEntryValue(view);
+        });
+}
 
-    return std::nullopt;
+auto forge::core::parseUMKey(utils::ByteView data)
+    -> utils::Opt<utils::ByteView>
+{
+    return parseEntryView(data)
+        .map([](auto view) {
+            return view.key;
+        });
 }
 
-auto forge::core::parseUMEntry(const std::vector<std::byte>& data)
+auto forge::core::parseUMEntry(utils::ByteView data)
     -> Opt<UMEntry>
 {
     //3 bytes mask
@@ -205,15 +217,9 @@ auto forge::core::parseUMEntry(const std::vector<std::byte>& data)
         return std::nullopt;
     }
 
-    auto value_opt = parseUMValue(data);
-    auto key_opt = parseUMKey(data);
-
-
-    return combine(std::move(key_opt),
-                   std::move(value_opt))
-        .map([](auto pair) {
-            return UMEntry{std::move(pair.first),
-                           std::move(pair.second)};
+    return parseEntryView(data)
+        .map([](auto view) {
+            return toUMEntry(view);
         });
 }
 
@@ -355,10 +361,8 @@ auto forge::core::umentryValueToJson(UMEntryValue value)
                 Json::Value json;
                 json["type"] = "ipv4";
 
-                std::vector<std::byte> helper(std::begin(value),
-                                              std::end(value));
-
-                json["value"] = forge::core::toHexString(helper);
+                json["value"] = forge::core::hexEncode(value.data(),
+                                                       value.size());
 
                 return json;
             },
@@ -366,10 +370,8 @@ auto forge::core::umentryValueToJson(UMEntryValue value)
                 Json::Value json;
                 json["type"] = "ipv6";
 
-                std::vector<std::byte> helper(std::begin(value),
-                                              std::end(value));
-
-                json["value"] = forge::core::toHexString(helper);
+                json["value"] = forge::core::hexEncode(value.data(),
+                                                       value.size());
 
                 return json;
             },
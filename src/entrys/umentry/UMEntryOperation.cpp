@@ -16,6 +16,7 @@ using forge::utils::Result;
 using forge::utils::overload;
 using forge::utils::Opt;
 using forge::core::Transaction;
+using forge::core::ForgeCandidate;
 using forge::client::ReadOnlyClientBase;
 using forge::client::ClientError;
 using forge::core::parseUMEntry;
@@ -110,132 +111,161 @@ auto forge::core::extractOperationFlag(const UMEntryOperation& operation)
 }
 
 
-auto forge::core::parseMetadataToUMEntryOp(const std::vector<std::byte>& metadata,
+auto forge::core::parseMetadataToUMEntryOpView(utils::ByteView metadata)
+    -> Opt<UMEntryOperationView>
+{
+    //3 bytes mask
+    //1 tokeyn type flag
+    //1 op flag
+    //1 value flag
+    //at least 4 value
+    //at least 1 key
+    if(metadata.size() < 11) {
+        return std::nullopt;
+    }
+
+    //check that the metadata actualy refers to a mutable entry
+    if(metadata[TOKEN_TYPE_INDEX] != UMENTRY_IDENTIFICATION_FLAG) {
+        return std::nullopt;
+    }
+
+    const auto flag = metadata[OPERATION_FLAG_INDEX];
+    if(flag != UMENTRY_CREATION_FLAG
+       && flag != UMENTRY_RENEWAL_FLAG
+       && flag != UMENTRY_OWNERSHIP_TRANSFER_FLAG
+       && flag != UMENTRY_UPDATE_FLAG
+       && flag != UMENTRY_DELETION_FLAG) {
+        return std::nullopt;
+    }
+
+    return parseEntryView(metadata)
+        .map([&flag](auto entry) {
+            return UMEntryOperationView{flag, entry};
+        });
+}
+
+auto forge::core::toUMEntryOp(const UMEntryOperationView& view,
+                              std::int64_t block,
+                              std::string&& owner,
+                              std::int64_t value,
+                              utils::Opt<std::string>&& new_owner_opt)
+    -> Opt<UMEntryOperation>
+{
+    //check before the entry is copied out of the metadata
+    if(view.operation_flag == UMENTRY_OWNERSHIP_TRANSFER_FLAG
+       && !new_owner_opt) {
+        return std::nullopt;
+    }
+
+    auto entry = toUMEntry(view.entry);
+
+    switch(view.operation_flag) {
+
+    case UMENTRY_CREATION_FLAG:
+        return UMEntryOperation{
+            UMEntryCreationOp{std::move(entry),
+                              std::move(owner),
+                              block,
+                              value}};
+
+    case UMENTRY_RENEWAL_FLAG:
+        return UMEntryOperation{
+            UMEntryRenewalOp{std::move(entry),
+                             std::move(owner),
+                             block,
+                             value}};
+
+    case UMENTRY_OWNERSHIP_TRANSFER_FLAG:
+        return UMEntryOperation{
+            UMEntryOwnershipTransferOp{std::move(entry),
+                                       std::move(owner),
+                                       std::move(new_owner_opt.getValue()),
+                                       block,
+                                       value}};
+
+    case UMENTRY_UPDATE_FLAG:
+        return UMEntryOperation{
+            UMEntryUpdateOp{std::move(entry),
+                            std::move(owner),
+                            block,
+                            value}};
+
+    case UMENTRY_DELETION_FLAG:
+        return UMEntryOperation{
+            UMEntryDeletionOp{std::move(entry),
+                              std::move(owner),
+                              block,
+                              value}};
+
+    default:
+        return std::nullopt;
+    }
+}
+
+auto forge::core::parseMetadataToUMEntryOp(utils::ByteView metadata,
                                            std::int64_t block,
                                            std::string&& owner,
                                            std::int64_t value,
                                            utils::Opt<std::string>&& new_owner_opt)
     -> Opt<UMEntryOperation>
 {
-    if(metadata.size() < 10) {
-        return std::nullopt;
-    }
-
-    return parseUMEntry(metadata)
-        .flatMap([&](auto entry)
-                     -> utils::Opt<UMEntryOperation> {
-            switch(static_cast<std::byte>(metadata[OPERATION_FLAG_INDEX])) {
-
-            case UMENTRY_CREATION_FLAG:
-                return UMEntryOperation{
-                    UMEntryCreationOp{std::move(entry),
-                                      std::move(owner),
-                                      block,
-                                      value}};
-
-            case UMENTRY_RENEWAL_FLAG:
-                return UMEntryOperation{
-                    UMEntryRenewalOp{std::move(entry),
-                                     std::move(owner),
-                                     block,
-                                     value}};
-
-            case UMENTRY_OWNERSHIP_TRANSFER_FLAG:
-                return new_owner_opt
-                    .map([&](auto new_owner) {
-                        return UMEntryOperation{
-                            UMEntryOwnershipTransferOp{std::move(entry),
-                                                       std::move(owner),
-                                                       std::move(new_owner),
-                                                       block,
-                                                       value}};
-                    });
-
-            case UMENTRY_UPDATE_FLAG:
-                return UMEntryOperation{
-                    UMEntryUpdateOp{std::move(entry),
-                                    std::move(owner),
-                                    block,
-                                    value}};
-
-            case UMENTRY_DELETION_FLAG:
-                return UMEntryOperation{
-                    UMEntryDeletionOp{std::move(entry),
-                                      std::move(owner),
-                                      block,
-                                      value}};
-
-            default:
-                return std::nullopt;
-            }
+    return parseMetadataToUMEntryOpView(metadata)
+        .flatMap([&](auto view) {
+            return toUMEntryOp(view,
+                               block,
+                               std::move(owner),
+                               value,
+                               std::move(new_owner_opt));
         });
 }
 
-auto forge::core::parseTransactionToUMEntry(Transaction tx,
+auto forge::core::parseTransactionToUMEntry(const Transaction& tx,
                                             std::int64_t block,
                                             const client::ReadOnlyClientBase* client)
     -> Result<Opt<UMEntryOperation>, ClientError>
 {
     using ResultType = Result<Opt<UMEntryOperation>, ClientError>;
 
+    return buildForgeCandidate(tx)
+        .map([&](const auto& candidate) {
+            return parseForgeCandidateToUMEntry(candidate, block, client);
+        })
+        .valueOr(ResultType{std::nullopt});
+}
+
+auto forge::core::parseForgeCandidateToUMEntry(const ForgeCandidate& candidate,
+                                               std::int64_t block,
+                                               const client::ReadOnlyClientBase* client)
+    -> Result<Opt<UMEntryOperation>, ClientError>
+{
+    using ResultType = Result<Opt<UMEntryOperation>, ClientError>;
+
     LOG_IF(FATAL, !client) << "ReadOnlyClientBase pointer is null";
 
-    //check if the transaction has exactly one op return
-    //output and exactly one input
-    //if this is not the case the tx does not repressent a forge op
-    if(!tx.hasExactlyOneOpReturnOutput()
-       || !tx.hasExactlyOneInput()) {
+    //validate the operation on a view of the metadata,
+    //so the input only gets resolved for valid operations
+    auto view_opt = parseMetadataToUMEntryOpView(candidate.getMetadata());
+    if(!view_opt) {
         return ResultType{std::nullopt};
     }
 
-    LOG(INFO) << tx.getTxid() << " contains a OP_RETURN output";
-
-    //save, because we checked that the tx has exactly one
-    //op return output
-    const auto& op_return_output =
-        tx.getFirstOpReturnOutput().getValue().get();
-
-    //get optional new owner
-    //for ownership transfer
-    auto new_owner_opt =
-        tx.getFirstNonOpReturnOutput()
-            .flatMap([](auto ref)
-                         -> Opt<std::string> {
-                //we only care about outputs with exactly one
-                //address
-                if(ref.get().getAddresses().size() != 1) {
-                    return std::nullopt;
-                }
-                return ref.get().getAddresses()[0];
-            });
-
-    //save, because we have checked that the tx has exactly
-    //one input
-    auto vin = std::move(tx.getInputs()[0]);
-
-    //value of the op return output
-    auto value = op_return_output.getValue();
-
-    //extract the metadata from the output script
-    auto output_script = std::move(op_return_output.getHex());
-    auto metadata_opt = extractMetadata(std::move(output_script));
-
-    if(!metadata_opt) {
-        return ResultType{std::nullopt};
-    }
+    const auto& view = view_opt.getValue();
 
-    //get metadata from the op return output
-    auto metadata = std::move(metadata_opt.getValue());
+    LOG(INFO) << candidate.getTxid() << " contains a unique modifiable entry operation";
 
-    //check if the metadata starts with a forge id
-    //if not the tx is not a valid forge tx and can be ignored
-    if(!metadataStartsWithForgeId(metadata)) {
+    //ownership transfers need the address of the first
+    //non op return output as new owner
+    auto new_owner_opt = candidate.getNewOwner();
+    if(view.operation_flag == UMENTRY_OWNERSHIP_TRANSFER_FLAG
+       && !new_owner_opt) {
         return ResultType{std::nullopt};
     }
 
+    const auto& vin = candidate.getInput();
+
     LOG(DEBUG) << "resoving vin from " << vin.getTxid();
     return client
-        ->resolveTxIn(std::move(vin))
+        ->resolveTxIn(vin)
         .flatMap([&](auto resolvedVin) {
             //we can only have one input address
             if(resolvedVin.getAddresses().size() != 1) {
@@ -245,14 +275,13 @@ auto forge::core::parseTransactionToUMEntry(Transaction tx,
             //get owner
             auto owner = std::move(resolvedVin.getAddresses()[0]);
 
-            //parse the metadata nd put it into
-            //the ResultType
+            //create the owning operation from the view
             return ResultType{
-                parseMetadataToUMEntryOp(std::move(metadata),
-                                         block,
-                                         std::move(owner),
-                                         value,
-                                         std::move(new_owner_opt))};
+                toUMEntryOp(view,
+                            block,
+                            std::move(owner),
+                            candidate.getOpReturnValue(),
+                            std::move(new_owner_opt))};
         });
 }
 
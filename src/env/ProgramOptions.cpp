@@ -1,13 +1,19 @@
 #include <CLI/CLI.hpp>
 #include <CLI/Validators.hpp>
+#include <algorithm>
+#include <chrono>
 #include <cpptoml.h>
 #include <env/ProgramOptions.hpp>
 #include <filesystem>
 #include <fmt/core.h>
 #include <fstream>
 #include <g3log/g3log.hpp>
+#include <map>
+#include <rpc/AdmissionControl.hpp>
 #include <string>
+#include <string_view>
 #include <utils/Opt.hpp>
+#include <wallet/OutputPool.hpp>
 
 using forge::env::ProgramOptions;
 
@@ -22,7 +28,15 @@ ProgramOptions::ProgramOptions(std::string&& logfolder,
                                std::string&& coin_password,
                                std::int64_t rpc_port,
                                std::string&& rpc_user,
-                               std::string&& rpc_password)
+                               std::string&& rpc_password,
+                               RpcTransport rpc_transport,
+                               std::string&& dns_host,
+                               std::int64_t dns_port,
+                               std::string&& ipc_path,
+                               std::int64_t metrics_port,
+                               wallet::OutputPoolConfig output_pool,
+                               std::map<std::string, Mode>&& wallets,
+                               rpc::AdmissionLimits&& admission_limits)
     : logfolder_(std::move(logfolder)),
       number_of_threads_(number_of_threads),
       mode_(mode),
@@ -34,7 +48,15 @@ ProgramOptions::ProgramOptions(std::string&& logfolder,
       coin_password_(std::move(coin_password)),
       rpc_port_(rpc_port),
       rpc_user_(std::move(rpc_user)),
-      rpc_password_(std::move(rpc_password)) {}
+      rpc_password_(std::move(rpc_password)),
+      rpc_transport_(rpc_transport),
+      dns_host_(std::move(dns_host)),
+      dns_port_(dns_port),
+      ipc_path_(std::move(ipc_path)),
+      metrics_port_(metrics_port),
+      output_pool_(std::move(output_pool)),
+      wallets_(std::move(wallets)),
+      admission_limits_(std::move(admission_limits)) {}
 
 auto ProgramOptions::getLogFolder() const
     -> const std::string&
@@ -116,6 +138,54 @@ auto ProgramOptions::getRpcPassword() const
     return rpc_password_;
 }
 
+auto ProgramOptions::getRpcTransport() const
+    -> RpcTransport
+{
+    return rpc_transport_;
+}
+
+auto ProgramOptions::getDnsHost() const
+    -> const std::string&
+{
+    return dns_host_;
+}
+
+auto ProgramOptions::getDnsPort() const
+    -> std::int64_t
+{
+    return dns_port_;
+}
+
+auto ProgramOptions::getIpcPath() const
+    -> const std::string&
+{
+    return ipc_path_;
+}
+
+auto ProgramOptions::getMetricsPort() const
+    -> std::int64_t
+{
+    return metrics_port_;
+}
+
+auto ProgramOptions::getOutputPoolConfig() const
+    -> const wallet::OutputPoolConfig&
+{
+    return output_pool_;
+}
+
+auto ProgramOptions::getWallets() const
+    -> const std::map<std::string, Mode>&
+{
+    return wallets_;
+}
+
+auto ProgramOptions::getAdmissionLimits() const
+    -> const rpc::AdmissionLimits&
+{
+    return admission_limits_;
+}
+
 auto ProgramOptions::getNumberOfThreads() const
     -> std::int64_t
 {
@@ -224,6 +294,250 @@ auto getRPCPortEnv()
     }
 }
 
+auto getRpcTransportFromEnv()
+    -> std::string
+{
+    auto raw_str = std::getenv("RPC_TRANSPORT");
+    if(raw_str == nullptr) {
+        return "httpserver";
+    }
+
+    return raw_str;
+}
+
+auto rpcTransportFromString(const std::string& transport_str)
+    -> forge::env::RpcTransport
+{
+    if(transport_str == "httpserver") {
+        return forge::env::RpcTransport::HttpServer;
+    }
+    if(transport_str == "epoll") {
+        return forge::env::RpcTransport::Epoll;
+    }
+    fmt::print(R"(invalid value for "rpc.transport", should be "httpserver" or "epoll")");
+    std::exit(-1);
+}
+
+auto getDnsHostFromEnv()
+    -> std::string
+{
+    auto raw_str = std::getenv("DNS_HOST");
+    if(raw_str == nullptr) {
+        return "0.0.0.0";
+    }
+
+    return raw_str;
+}
+
+auto getDnsPortEnv()
+{
+    try {
+        auto raw_str = std::getenv("DNS_PORT");
+        return std::stoi(raw_str);
+    } catch(...) {
+        return 0;
+    }
+}
+
+auto getIpcPathFromEnv()
+    -> std::string
+{
+    auto raw_str = std::getenv("IPC_PATH");
+    if(raw_str == nullptr) {
+        return "";
+    }
+
+    return raw_str;
+}
+
+auto getMetricsPortEnv()
+{
+    try {
+        auto raw_str = std::getenv("METRICS_PORT");
+        return std::stoi(raw_str);
+    } catch(...) {
+        return 0;
+    }
+}
+
+auto getOutputPoolConfigFromEnv()
+    -> forge::wallet::OutputPoolConfig
+{
+    forge::wallet::OutputPoolConfig config;
+
+    try {
+        auto raw_str = std::getenv("OUTPUT_POOL_SIZE");
+        config.target = static_cast<std::size_t>(std::max(std::stoll(raw_str), 0ll));
+    } catch(...) {
+    }
+
+    try {
+        auto raw_str = std::getenv("OUTPUT_POOL_BURN_AMOUNT");
+        config.burn_amount = std::max(std::stoll(raw_str), 0ll);
+    } catch(...) {
+    }
+
+    return config;
+}
+
+auto getOutputPoolConfigFromConfig(const cpptoml::table& config)
+    -> forge::wallet::OutputPoolConfig
+{
+    auto size = config.get_qualified_as<std::int64_t>("wallet.pool_size").value_or(0);
+    auto burn_amount = config.get_qualified_as<std::int64_t>("wallet.pool_burn_amount").value_or(0);
+
+    return forge::wallet::OutputPoolConfig{
+        static_cast<std::size_t>(std::max<std::int64_t>(size, 0)),
+        std::max<std::int64_t>(burn_amount, 0)};
+}
+
+auto walletModeFromString(const std::string& name,
+                          const std::string& mode_str)
+    -> forge::env::Mode
+{
+    if(mode_str == "readonly") {
+        return forge::env::Mode::ReadOnly;
+    }
+    if(mode_str == "readwrite") {
+        return forge::env::Mode::ReadWrite;
+    }
+    fmt::print(R"(invalid mode "{}" of wallet {}, should be "readonly" or "readwrite")", mode_str, name);
+    std::exit(-1);
+}
+
+//a list like "alice:readwrite,bob:readonly"
+auto getWalletsFromEnv()
+    -> std::map<std::string, forge::env::Mode>
+{
+    std::map<std::string, forge::env::Mode> wallets;
+
+    auto raw_str = std::getenv("WALLETS");
+    if(raw_str == nullptr) {
+        return wallets;
+    }
+
+    std::string_view list{raw_str};
+    while(!list.empty()) {
+        auto entry = list.substr(0, list.find(','));
+        list.remove_prefix(std::min(entry.size() + 1, list.size()));
+
+        if(entry.empty()) {
+            continue;
+        }
+
+        auto colon = entry.find(':');
+        std::string name{entry.substr(0, colon)};
+        std::string mode_str{colon == std::string_view::npos
+                                 ? "readonly"
+                                 : entry.substr(colon + 1)};
+
+        wallets.emplace(name, walletModeFromString(name, mode_str));
+    }
+
+    return wallets;
+}
+
+auto getWalletsFromConfig(const cpptoml::table& config)
+    -> std::map<std::string, forge::env::Mode>
+{
+    std::map<std::string, forge::env::Mode> wallets;
+
+    auto table = config.get_table("wallets");
+    if(!table) {
+        return wallets;
+    }
+
+    for(const auto& [name, value] : *table) {
+        auto mode_str = value->as<std::string>();
+        if(!mode_str) {
+            fmt::print("invalid value for \"wallets.{}\", should be a string", name);
+            std::exit(-1);
+        }
+        wallets.emplace(name, walletModeFromString(name, mode_str->get()));
+    }
+
+    return wallets;
+}
+
+//negative values are treated as 0
+auto getAdmissionEnv(const char* name, std::size_t default_value)
+    -> std::size_t
+{
+    try {
+        auto raw_str = std::getenv(name);
+        return static_cast<std::size_t>(std::max(std::stoll(raw_str), 0ll));
+    } catch(...) {
+        return default_value;
+    }
+}
+
+auto getAdmissionLimitsFromEnv()
+    -> forge::rpc::AdmissionLimits
+{
+    forge::rpc::AdmissionLimits limits;
+    const auto& [lookup, wallet_read, wallet_write] = limits.class_limits;
+
+    limits.max_concurrent = getAdmissionEnv("ADMISSION_MAX_CONCURRENT", limits.max_concurrent);
+    limits.class_limits = {getAdmissionEnv("ADMISSION_LOOKUP_CONCURRENT", lookup),
+                           getAdmissionEnv("ADMISSION_WALLET_READ_CONCURRENT", wallet_read),
+                           getAdmissionEnv("ADMISSION_WALLET_WRITE_CONCURRENT", wallet_write)};
+    limits.max_queued = getAdmissionEnv("ADMISSION_MAX_QUEUED", limits.max_queued);
+    limits.queue_timeout = std::chrono::milliseconds{
+        getAdmissionEnv("ADMISSION_QUEUE_TIMEOUT_MS", limits.queue_timeout.count())};
+    limits.max_long_polls = getAdmissionEnv("ADMISSION_MAX_LONG_POLLS", limits.max_long_polls);
+    //without a worker no job would ever run
+    limits.job_workers = std::max<std::size_t>(
+        getAdmissionEnv("ADMISSION_JOB_WORKERS", limits.job_workers),
+        1);
+    limits.max_queued_jobs = getAdmissionEnv("ADMISSION_MAX_QUEUED_JOBS", limits.max_queued_jobs);
+
+    return limits;
+}
+
+auto getAdmissionLimitsFromConfig(const cpptoml::table& config)
+    -> forge::rpc::AdmissionLimits
+{
+    forge::rpc::AdmissionLimits limits;
+
+    auto get = [&](const char* key, std::size_t default_value) {
+        auto value = config.get_qualified_as<std::int64_t>(key)
+                         .value_or(static_cast<std::int64_t>(default_value));
+        return static_cast<std::size_t>(std::max<std::int64_t>(value, 0));
+    };
+
+    const auto& [lookup, wallet_read, wallet_write] = limits.class_limits;
+
+    limits.max_concurrent = get("admission.max_concurrent", limits.max_concurrent);
+    limits.class_limits = {get("admission.lookup_concurrent", lookup),
+                           get("admission.wallet_read_concurrent", wallet_read),
+                           get("admission.wallet_write_concurrent", wallet_write)};
+    limits.max_queued = get("admission.max_queued", limits.max_queued);
+    limits.queue_timeout = std::chrono::milliseconds{
+        get("admission.queue_timeout_ms", limits.queue_timeout.count())};
+    limits.max_long_polls = get("admission.max_long_polls", limits.max_long_polls);
+    //without a worker no job would ever run
+    limits.job_workers = std::max<std::size_t>(
+        get("admission.job_workers", limits.job_workers),
+        1);
+    limits.max_queued_jobs = get("admission.max_queued_jobs", limits.max_queued_jobs);
+
+    //a given methods table replaces the default method limits
+    if(auto methods = config.get_table_qualified("admission.methods")) {
+        limits.method_limits.clear();
+        for(const auto& [method, value] : *methods) {
+            auto limit = value->as<std::int64_t>();
+            if(!limit) {
+                fmt::print("invalid value for \"admission.methods.{}\", should be an integer", method);
+                std::exit(-1);
+            }
+            limits.method_limits.emplace(method,
+                                         static_cast<std::size_t>(std::max<std::int64_t>(limit->get(), 0)));
+        }
+    }
+
+    return limits;
+}
+
 auto getThreadsEnv()
 {
     try {
@@ -319,7 +633,15 @@ auto forge::env::parseConfigFile(const std::string& config_path)
     auto rpc_port = config->get_qualified_as<std::int64_t>("rpc.port").value_or(25000);
     auto rpc_user = config->get_qualified_as<std::string>("rpc.user").value_or("user");
     auto rpc_password = config->get_qualified_as<std::string>("rpc.password").value_or("password");
+    auto rpc_transport_str = config->get_qualified_as<std::string>("rpc.transport").value_or("httpserver");
     auto threads = config->get_qualified_as<std::int64_t>("server.threads").value_or(5);
+    auto dns_host = config->get_qualified_as<std::string>("dns.host").value_or("0.0.0.0");
+    auto dns_port = config->get_qualified_as<std::int64_t>("dns.port").value_or(0);
+    auto ipc_path = config->get_qualified_as<std::string>("ipc.path").value_or("");
+    auto metrics_port = config->get_qualified_as<std::int64_t>("metrics.port").value_or(0);
+    auto output_pool = getOutputPoolConfigFromConfig(*config);
+    auto wallets = getWalletsFromConfig(*config);
+    auto admission_limits = getAdmissionLimitsFromConfig(*config);
 
 
     //create the log folder
@@ -339,6 +661,8 @@ auto forge::env::parseConfigFile(const std::string& config_path)
         }
     }();
 
+    auto rpc_transport = rpcTransportFromString(rpc_transport_str);
+
     //try to get the coind
     auto coin_opt = core::fromString(coin_str);
     if(!coin_opt) {
@@ -357,7 +681,15 @@ auto forge::env::parseConfigFile(const std::string& config_path)
                           std::move(coin_password),
                           rpc_port,
                           std::move(rpc_user),
-                          std::move(rpc_password)};
+                          std::move(rpc_password),
+                          rpc_transport,
+                          std::move(dns_host),
+                          dns_port,
+                          std::move(ipc_path),
+                          metrics_port,
+                          output_pool,
+                          std::move(wallets),
+                          std::move(admission_limits)};
 }
 
 
@@ -378,7 +710,15 @@ auto forge::env::fromEnvironment()
     auto rpc_port = getRPCPortEnv();
     auto rpc_user = "";
     auto rpc_password = "";
+    auto rpc_transport_str = getRpcTransportFromEnv();
     auto threads = getThreadsEnv();
+    auto dns_host = getDnsHostFromEnv();
+    auto dns_port = getDnsPortEnv();
+    auto ipc_path = getIpcPathFromEnv();
+    auto metrics_port = getMetricsPortEnv();
+    auto output_pool = getOutputPoolConfigFromEnv();
+    auto wallets = getWalletsFromEnv();
+    auto admission_limits = getAdmissionLimitsFromEnv();
 
     //create the log folder
     fs::create_directory(log_path);
@@ -398,6 +738,8 @@ auto forge::env::fromEnvironment()
         std::exit(-1);
     }();
 
+    auto rpc_transport = rpcTransportFromString(rpc_transport_str);
+
     //try to get the coind
     auto coin_opt = core::fromString(coin_str);
     if(!coin_opt) {
@@ -416,5 +758,13 @@ auto forge::env::fromEnvironment()
                           std::move(coin_password),
                           rpc_port,
                           std::move(rpc_user),
-                          std::move(rpc_password)};
+                          std::move(rpc_password),
+                          rpc_transport,
+                          std::move(dns_host),
+                          dns_port,
+                          std::move(ipc_path),
+                          metrics_port,
+                          output_pool,
+                          std::move(wallets),
+                          std::move(admission_limits)};
 }
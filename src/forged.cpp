@@ -5,6 +5,9 @@
 #include <cstdlib>
 #include <client/WriteOnlyClientBase.hpp>
 #include <client/odin/ReadOnlyOdinClient.hpp>
+#include <core/Coin.hpp>
+#include <dns/DnsServer.hpp>
+#include <entrys/Entry.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
 #include <env/LoggingSetup.hpp>
 #include <env/ProgramOptions.hpp>
@@ -15,8 +18,13 @@
 #include <g3log/g3log.hpp>
 #include <g3log/logworker.hpp>
 #include <getopt.h>
+#include <ipc/IpcServer.hpp>
 #include <jsonrpccpp/server/connectors/httpserver.h>
 #include <lookup/LookupManager.hpp>
+#include <memory>
+#include <metrics/Metrics.hpp>
+#include <metrics/MetricsServer.hpp>
+#include <rpc/EpollHttpServer.hpp>
 #include <rpc/JsonRpcServer.hpp>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -24,7 +32,9 @@
 #include <thread>
 #include <unistd.h>
 #include <utils/Opt.hpp>
+#include <utils/Overload.hpp>
 #include <utils/Result.hpp>
+#include <variant>
 #include <wallet/ReadOnlyWallet.hpp>
 #include <wallet/ReadWriteWallet.hpp>
 
@@ -37,7 +47,12 @@ using forge::env::initConsoleLogger;
 using forge::env::initFileLogger;
 using forge::env::parseOptions;
 using forge::env::ProgramOptions;
+using forge::env::RpcTransport;
 using forge::rpc::JsonRpcServer;
+using forge::rpc::EpollHttpServer;
+using forge::dns::DnsServer;
+using forge::ipc::IpcServer;
+using forge::metrics::MetricsServer;
 using jsonrpc::HttpServer;
 using jsonrpc::JSONRPC_SERVER_V1V2;
 
@@ -118,8 +133,196 @@ auto assertOnMainnet(const forge::client::ReadOnlyClientBase& client)
     }
 }
 
+auto startDnsServer(const ProgramOptions& params,
+                    const LookupManager& lookup)
+    -> std::unique_ptr<DnsServer>
+{
+    if(params.getDnsPort() == 0) {
+        return nullptr;
+    }
+
+    auto value_lookup = [&lookup](const forge::core::EntryKey& key)
+        -> forge::utils::Opt<forge::core::UMEntryValue> {
+        return lookup.lookup(key).flatMap([](const auto& any_entry) {
+            return std::visit(
+                forge::utils::overload{
+                    [](const forge::core::UtilityToken&)
+                        -> forge::utils::Opt<forge::core::UMEntryValue> {
+                        return std::nullopt;
+                    },
+                    [](const auto& entry)
+                        -> forge::utils::Opt<forge::core::UMEntryValue> {
+                        return entry.getValue();
+                    }},
+                any_entry);
+        });
+    };
+
+    auto height_lookup = [&lookup] {
+        return lookup.getLookupBlockHeight();
+    };
+
+    //answers are valid until the next block arrives
+    auto ttl = forge::core::getBlockTimeInSeconds(lookup.getCoin());
+
+    auto server = std::make_unique<DnsServer>(std::move(value_lookup),
+                                              std::move(height_lookup),
+                                              static_cast<std::uint32_t>(ttl));
+
+    auto res = server->start(params.getDnsHost(),
+                             static_cast<std::uint16_t>(params.getDnsPort()),
+                             std::thread::hardware_concurrency());
+    if(!res) {
+        fmt::print("{}\n", res.getError().what());
+        std::exit(-1);
+    }
+
+    return server;
+}
+
+auto startIpcServer(const ProgramOptions& params,
+                    const LookupManager& lookup)
+    -> std::unique_ptr<IpcServer>
+{
+    if(params.getIpcPath().empty()) {
+        return nullptr;
+    }
+
+    auto server = std::make_unique<IpcServer>(forge::ipc::makeLookupHandler(lookup));
+
+    auto res = server->start(params.getIpcPath());
+    if(!res) {
+        fmt::print("{}\n", res.getError().what());
+        std::exit(-1);
+    }
+
+    return server;
+}
+
+auto startMetricsServer(const ProgramOptions& params)
+    -> std::unique_ptr<MetricsServer>
+{
+    if(params.getMetricsPort() == 0) {
+        return nullptr;
+    }
+
+    auto server = std::make_unique<MetricsServer>(forge::metrics::getRegistry());
+
+    auto res = server->start(static_cast<std::uint16_t>(params.getMetricsPort()));
+    if(!res) {
+        fmt::print("{}\n", res.getError().what());
+        std::exit(-1);
+    }
+
+    return server;
+}
+
+auto makeConnector(const ProgramOptions& params)
+    -> std::unique_ptr<jsonrpc::AbstractServerConnector>
+{
+    auto port = params.getRpcPort();
+    auto threads = params.getNumberOfThreads();
+
+    if(params.getRpcTransport() == RpcTransport::Epoll) {
+        //threads only limits the requests which need the worker pool,
+        //lookups are answered by one io thread per core
+        auto workers = static_cast<std::size_t>(threads);
+        return std::make_unique<EpollHttpServer>(static_cast<std::uint16_t>(port),
+                                                 std::thread::hardware_concurrency(),
+                                                 workers,
+                                                 workers * 4);
+    }
+
+    return std::make_unique<HttpServer>(static_cast<int>(port),
+                                        "",
+                                        "",
+                                        static_cast<int>(threads));
+}
+
+//with named wallets the node runs several wallets, so the
+//default wallet uses the default wallet of the node, which
+//is named "", instead of the only one
+auto defaultNodeWallet(const ProgramOptions& params)
+    -> forge::utils::Opt<std::string>
+{
+    if(params.getWallets().empty()) {
+        return std::nullopt;
+    }
+
+    return std::string{};
+}
+
+//hosts the named wallets of the config at /wallet/<name>, all of them
+//use the lookup of the default wallet. every named wallet uses the node
+//wallet of the same name, so the wallets neither see the addresses nor
+//spend the outputs of each other, and every node wallet has one UtxoSet
+auto addNamedWallets(const ProgramOptions& params,
+                     JsonRpcServer& rpcserver,
+                     jsonrpc::AbstractServerConnector& connector,
+                     const std::shared_ptr<LookupManager>& lookup)
+    -> void
+{
+    if(params.getWallets().empty()) {
+        return;
+    }
+
+    auto* http = dynamic_cast<HttpServer*>(&connector);
+    auto* epoll = dynamic_cast<EpollHttpServer*>(&connector);
+
+    auto route = [&](const std::string& url,
+                     jsonrpc::IClientConnectionHandler* handler) {
+        if(http != nullptr) {
+            http->SetUrlHandler(url, handler);
+        }
+        if(epoll != nullptr) {
+            epoll->SetUrlHandler(url, handler);
+        }
+    };
+
+    //the HttpServer of libjson-rpc-cpp ignores its url handlers while
+    //the connector has a handler, so the default wallet moves to "/"
+    if(http != nullptr) {
+        route("/", connector.GetHandler());
+        connector.SetHandler(nullptr);
+    }
+
+    for(const auto& [name, mode] : params.getWallets()) {
+        auto reader = make_readonly_client(params.getCoinHost(),
+                                           params.getCoinUser(),
+                                           params.getCoinPassword(),
+                                           params.getCoinPort(),
+                                           params.getCoin(),
+                                           name);
+
+        if(mode == forge::env::Mode::ReadWrite) {
+            auto writer = make_writing_client(params.getCoinHost(),
+                                              params.getCoinUser(),
+                                              params.getCoinPassword(),
+                                              params.getCoinPort(),
+                                              params.getCoin(),
+                                              name);
+            auto& handler = rpcserver.addWallet(name,
+                                                ReadWriteWallet{lookup,
+                                                                std::move(writer),
+                                                                params.getOutputPoolConfig(),
+                                                                std::move(reader)});
+            route("/wallet/" + name, &handler);
+        } else {
+            auto& handler = rpcserver.addWallet(name,
+                                                ReadOnlyWallet{lookup,
+                                                               std::move(reader)});
+            route("/wallet/" + name, &handler);
+        }
+
+        LOG(INFO) << fmt::format("serving wallet {} at /wallet/{}", name, name);
+    }
+}
+
 auto runLookupOnlyServer(const ProgramOptions& params)
 {
+    //started first, so the initial indexing can be watched
+    auto metrics_server = startMetricsServer(params);
+
     auto client = make_readonly_client(params.getCoinHost(),
                                        params.getCoinUser(),
                                        params.getCoinPassword(),
@@ -127,22 +330,19 @@ auto runLookupOnlyServer(const ProgramOptions& params)
                                        params.getCoin());
     assertOnMainnet(*client);
 
-    auto port = params.getRpcPort();
-    auto threads = params.getNumberOfThreads();
-
-
-    HttpServer httpserver{static_cast<int>(port),
-                          "",
-                          "",
-                          static_cast<int>(threads)};
+    auto connector = makeConnector(params);
 
     LookupManager lookup{std::move(client)};
 
-    JsonRpcServer rpcserver{httpserver,
+    JsonRpcServer rpcserver{*connector,
                             JSONRPC_SERVER_V1V2,
-                            std::move(lookup)};
+                            std::move(lookup),
+                            params.getAdmissionLimits()};
     rpcserver.StartListening();
 
+    auto dns_server = startDnsServer(params, rpcserver.getLookup());
+    auto ipc_server = startIpcServer(params, rpcserver.getLookup());
+
     forge::rpc::waitForShutdown(rpcserver);
 
     rpcserver.StopListening();
@@ -150,6 +350,9 @@ auto runLookupOnlyServer(const ProgramOptions& params)
 
 auto runReadOnlyWalletServer(const ProgramOptions& params)
 {
+    //started first, so the initial indexing can be watched
+    auto metrics_server = startMetricsServer(params);
+
     auto client = make_readonly_client(params.getCoinHost(),
                                        params.getCoinUser(),
                                        params.getCoinPassword(),
@@ -158,23 +361,29 @@ auto runReadOnlyWalletServer(const ProgramOptions& params)
 
     assertOnMainnet(*client);
 
-    auto lookup = std::make_unique<LookupManager>(std::move(client));
-    ReadOnlyWallet wallet{std::move(lookup)};
-
-    auto port = params.getRpcPort();
-    auto threads = params.getNumberOfThreads();
+    auto wallet_reader = make_readonly_client(params.getCoinHost(),
+                                              params.getCoinUser(),
+                                              params.getCoinPassword(),
+                                              params.getCoinPort(),
+                                              params.getCoin(),
+                                              defaultNodeWallet(params));
 
+    //shared with the named wallets
+    auto lookup = std::make_shared<LookupManager>(std::move(client));
+    ReadOnlyWallet wallet{lookup, std::move(wallet_reader)};
 
-    HttpServer httpserver{static_cast<int>(port),
-                          "",
-                          "",
-                          static_cast<int>(threads)};
+    auto connector = makeConnector(params);
 
-    JsonRpcServer rpcserver{httpserver,
+    JsonRpcServer rpcserver{*connector,
                             JSONRPC_SERVER_V1V2,
-                            std::move(wallet)};
+                            std::move(wallet),
+                            params.getAdmissionLimits()};
+    addNamedWallets(params, rpcserver, *connector, lookup);
     rpcserver.StartListening();
 
+    auto dns_server = startDnsServer(params, rpcserver.getLookup());
+    auto ipc_server = startIpcServer(params, rpcserver.getLookup());
+
     forge::rpc::waitForShutdown(rpcserver);
 
     rpcserver.StopListening();
@@ -182,6 +391,9 @@ auto runReadOnlyWalletServer(const ProgramOptions& params)
 
 auto runReadWriteWalletServer(const ProgramOptions& params)
 {
+    //started first, so the initial indexing can be watched
+    auto metrics_server = startMetricsServer(params);
+
     auto reader = make_readonly_client(params.getCoinHost(),
                                        params.getCoinUser(),
                                        params.getCoinPassword(),
@@ -194,26 +406,35 @@ auto runReadWriteWalletServer(const ProgramOptions& params)
                                       params.getCoinUser(),
                                       params.getCoinPassword(),
                                       params.getCoinPort(),
-                                      params.getCoin());
-
-    auto lookup = std::make_unique<LookupManager>(std::move(reader));
-    ReadWriteWallet wallet{std::move(lookup),
-                           std::move(writer)};
-
-    auto port = params.getRpcPort();
-    auto threads = params.getNumberOfThreads();
-
-
-    HttpServer httpserver{static_cast<int>(port),
-                          "",
-                          "",
-                          static_cast<int>(threads)};
-
-    JsonRpcServer rpcserver{httpserver,
+                                      params.getCoin(),
+                                      defaultNodeWallet(params));
+
+    auto wallet_reader = make_readonly_client(params.getCoinHost(),
+                                              params.getCoinUser(),
+                                              params.getCoinPassword(),
+                                              params.getCoinPort(),
+                                              params.getCoin(),
+                                              defaultNodeWallet(params));
+
+    //shared with the named wallets
+    auto lookup = std::make_shared<LookupManager>(std::move(reader));
+    ReadWriteWallet wallet{lookup,
+                           std::move(writer),
+                           params.getOutputPoolConfig(),
+                           std::move(wallet_reader)};
+
+    auto connector = makeConnector(params);
+
+    JsonRpcServer rpcserver{*connector,
                             JSONRPC_SERVER_V1V2,
-                            std::move(wallet)};
+                            std::move(wallet),
+                            params.getAdmissionLimits()};
+    addNamedWallets(params, rpcserver, *connector, lookup);
     rpcserver.StartListening();
 
+    auto dns_server = startDnsServer(params, rpcserver.getLookup());
+    auto ipc_server = startIpcServer(params, rpcserver.getLookup());
+
     forge::rpc::waitForShutdown(rpcserver);
 
     rpcserver.StopListening();
@@ -0,0 +1,214 @@
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <ipc/BinaryProtocol.hpp>
+#include <string_view>
+#include <utility>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <vector>
+
+using forge::ipc::Opcode;
+using forge::ipc::Status;
+using forge::ipc::Request;
+using forge::ipc::Response;
+using forge::utils::ByteView;
+using forge::core::UMEntryValue;
+
+namespace {
+
+//reads a big endian unsigned integer of the given size
+auto readUInt(ByteView data, std::size_t offset, std::size_t size)
+    -> std::uint64_t
+{
+    std::uint64_t value = 0;
+    for(std::size_t i = 0; i < size; i++) {
+        value = (value << 8) | std::to_integer<std::uint64_t>(data[offset + i]);
+    }
+    return value;
+}
+
+auto appendUInt(std::vector<std::byte>& out, std::uint64_t value, std::size_t size)
+    -> void
+{
+    for(std::size_t i = size; i > 0; i--) {
+        out.push_back(static_cast<std::byte>(value >> ((i - 1) * 8)));
+    }
+}
+
+auto appendBytes(std::vector<std::byte>& out, ByteView bytes)
+    -> void
+{
+    out.insert(std::end(out),
+               std::begin(bytes),
+               std::end(bytes));
+}
+
+auto valueSize(std::byte flag)
+    -> forge::utils::Opt<std::size_t>
+{
+    if(flag == forge::core::IPv4_VALUE_FLAG) {
+        return std::tuple_size_v<forge::core::IPv4Value>;
+    }
+    if(flag == forge::core::IPv6_VALUE_FLAG) {
+        return std::tuple_size_v<forge::core::IPv6Value>;
+    }
+    if(flag == forge::core::NONE_VALUE_FLAG) {
+        return std::size_t{0};
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+auto forge::ipc::peekFrameSize(ByteView buffer)
+    -> utils::Opt<std::size_t>
+{
+    if(buffer.size() < LENGTH_PREFIX_SIZE) {
+        return std::nullopt;
+    }
+
+    return LENGTH_PREFIX_SIZE
+        + static_cast<std::size_t>(readUInt(buffer, 0, LENGTH_PREFIX_SIZE));
+}
+
+auto forge::ipc::parseRequest(ByteView frame)
+    -> utils::Opt<Request>
+{
+    if(frame.size() < REQUEST_HEADER_SIZE) {
+        return std::nullopt;
+    }
+
+    return Request{static_cast<std::uint32_t>(readUInt(frame, 0, 4)),
+                   static_cast<Opcode>(frame[4]),
+                   frame.subview(REQUEST_HEADER_SIZE)};
+}
+
+auto forge::ipc::parseResponse(ByteView frame)
+    -> utils::Opt<Response>
+{
+    if(frame.size() < RESPONSE_HEADER_SIZE) {
+        return std::nullopt;
+    }
+
+    return Response{static_cast<std::uint32_t>(readUInt(frame, 0, 4)),
+                    static_cast<Status>(frame[4]),
+                    static_cast<std::int64_t>(readUInt(frame, 5, 8)),
+                    frame.subview(RESPONSE_HEADER_SIZE)};
+}
+
+auto forge::ipc::writeRequest(std::vector<std::byte>& output,
+                              std::uint32_t id,
+                              Opcode opcode,
+                              ByteView payload)
+    -> void
+{
+    appendUInt(output, REQUEST_HEADER_SIZE + payload.size(), LENGTH_PREFIX_SIZE);
+    appendUInt(output, id, 4);
+    output.push_back(static_cast<std::byte>(opcode));
+    appendBytes(output, payload);
+}
+
+auto forge::ipc::writeResponse(std::vector<std::byte>& output,
+                               std::uint32_t id,
+                               Status status,
+                               std::int64_t block_height,
+                               ByteView payload)
+    -> void
+{
+    appendUInt(output, RESPONSE_HEADER_SIZE + payload.size(), LENGTH_PREFIX_SIZE);
+    appendUInt(output, id, 4);
+    output.push_back(static_cast<std::byte>(status));
+    appendUInt(output, static_cast<std::uint64_t>(block_height), 8);
+    appendBytes(output, payload);
+}
+
+auto forge::ipc::encodeBalanceRequest(std::string_view owner,
+                                      ByteView token)
+    -> utils::Opt<std::vector<std::byte>>
+{
+    if(owner.size() > 255) {
+        return std::nullopt;
+    }
+
+    std::vector<std::byte> payload;
+    payload.reserve(1 + owner.size() + token.size());
+    payload.push_back(static_cast<std::byte>(owner.size()));
+    for(auto c : owner) {
+        payload.push_back(static_cast<std::byte>(c));
+    }
+    appendBytes(payload, token);
+
+    return payload;
+}
+
+auto forge::ipc::parseBalanceRequest(ByteView payload)
+    -> utils::Opt<std::pair<std::string_view, ByteView>>
+{
+    if(payload.empty()) {
+        return std::nullopt;
+    }
+
+    auto owner_size = std::to_integer<std::size_t>(payload[0]);
+    if(payload.size() < 1 + owner_size) {
+        return std::nullopt;
+    }
+
+    std::string_view owner{reinterpret_cast<const char*>(payload.data() + 1),
+                           owner_size};
+
+    return std::pair{owner, payload.subview(1 + owner_size)};
+}
+
+auto forge::ipc::encodeValue(const UMEntryValue& value)
+    -> std::vector<std::byte>
+{
+    auto raw = core::umEntryValueToRawData(value);
+
+    std::vector<std::byte> payload;
+    payload.reserve(1 + raw.size());
+    payload.push_back(core::extractValueFlag(value));
+    appendBytes(payload, raw);
+
+    return payload;
+}
+
+auto forge::ipc::parseValue(ByteView payload)
+    -> utils::Opt<UMEntryValue>
+{
+    if(payload.empty()) {
+        return std::nullopt;
+    }
+
+    auto flag = payload[0];
+    auto raw = payload.subview(1);
+
+    //byte arrays can have any size, all other values a fixed one
+    if(flag != core::BYTE_ARRAY_VALUE_FLAG) {
+        auto size_opt = valueSize(flag);
+        if(!size_opt || size_opt.getValue() != raw.size()) {
+            return std::nullopt;
+        }
+    }
+
+    return core::toUMEntryValue(core::EntryView{{}, flag, raw});
+}
+
+auto forge::ipc::encodeInteger(std::uint64_t value)
+    -> std::vector<std::byte>
+{
+    std::vector<std::byte> payload;
+    payload.reserve(8);
+    appendUInt(payload, value, 8);
+    return payload;
+}
+
+auto forge::ipc::parseInteger(ByteView payload)
+    -> utils::Opt<std::uint64_t>
+{
+    if(payload.size() != 8) {
+        return std::nullopt;
+    }
+
+    return readUInt(payload, 0, 8);
+}
@@ -0,0 +1,340 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <entrys/uentry/UniqueEntry.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <fmt/core.h>
+#include <ipc/BinaryProtocol.hpp>
+#include <ipc/IpcClient.hpp>
+#include <ipc/IpcError.hpp>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <utils/Result.hpp>
+#include <vector>
+
+using forge::ipc::IpcClient;
+using forge::ipc::IpcError;
+using forge::ipc::Opcode;
+using forge::ipc::Status;
+using forge::ipc::Response;
+using forge::utils::ByteView;
+using forge::utils::Opt;
+using forge::utils::Result;
+using forge::core::EntryKey;
+using forge::core::UMEntryValue;
+using forge::core::UniqueEntryValue;
+
+namespace {
+
+//requests sent before the answers are read, so neither side
+//blocks on a full socket buffer while the other one writes
+constexpr std::size_t MAX_PIPELINE_DEPTH = 256;
+constexpr std::size_t READ_SIZE = 64 * 1024;
+
+auto toKeyPayloads(const std::vector<EntryKey>& keys)
+    -> std::vector<ByteView>
+{
+    return std::vector<ByteView>(std::begin(keys), std::end(keys));
+}
+
+auto decodeString(ByteView payload)
+    -> Opt<std::string>
+{
+    return std::string(reinterpret_cast<const char*>(payload.data()),
+                       payload.size());
+}
+
+auto decodeInteger(ByteView payload)
+    -> Opt<std::int64_t>
+{
+    return forge::ipc::parseInteger(payload)
+        .map([](auto value) {
+            return static_cast<std::int64_t>(value);
+        });
+}
+
+//the single key versions only send one request
+template<class T>
+auto front(Result<std::vector<Opt<T>>, IpcError>&& res)
+    -> Result<Opt<T>, IpcError>
+{
+    return std::move(res)
+        .map([](auto results) {
+            return std::move(results.front());
+        });
+}
+
+//for requests which are always answered
+template<class T>
+auto valueOf(Result<Opt<T>, IpcError>&& res)
+    -> Result<T, IpcError>
+{
+    return std::move(res)
+        .flatMap([](auto opt) -> Result<T, IpcError> {
+            if(!opt) {
+                return IpcError{"ipc server answered without a value"};
+            }
+            return std::move(opt.getValue());
+        });
+}
+
+} // namespace
+
+IpcClient::IpcClient(int socket)
+    : socket_(socket) {}
+
+IpcClient::IpcClient(IpcClient&& other) noexcept
+    : socket_(std::exchange(other.socket_, -1)),
+      next_id_(other.next_id_),
+      block_height_(other.block_height_),
+      output_(std::move(other.output_)),
+      input_(std::move(other.input_)),
+      consumed_(other.consumed_) {}
+
+auto IpcClient::operator=(IpcClient&& other) noexcept
+    -> IpcClient&
+{
+    std::swap(socket_, other.socket_);
+    std::swap(next_id_, other.next_id_);
+    std::swap(block_height_, other.block_height_);
+    std::swap(output_, other.output_);
+    std::swap(input_, other.input_);
+    std::swap(consumed_, other.consumed_);
+    return *this;
+}
+
+IpcClient::~IpcClient()
+{
+    if(socket_ >= 0) {
+        close(socket_);
+    }
+}
+
+auto IpcClient::lookupUMValue(const EntryKey& key)
+    -> Result<Opt<UMEntryValue>, IpcError>
+{
+    return front(pipeline<UMEntryValue>(Opcode::LookupUMValue,
+                                        {key},
+                                        parseValue));
+}
+
+auto IpcClient::lookupUniqueValue(const EntryKey& key)
+    -> Result<Opt<UniqueEntryValue>, IpcError>
+{
+    return front(pipeline<UniqueEntryValue>(Opcode::LookupUniqueValue,
+                                            {key},
+                                            parseValue));
+}
+
+auto IpcClient::lookupOwner(const EntryKey& key)
+    -> Result<Opt<std::string>, IpcError>
+{
+    return front(pipeline<std::string>(Opcode::LookupOwner,
+                                       {key},
+                                       decodeString));
+}
+
+auto IpcClient::lookupActivationBlock(const EntryKey& key)
+    -> Result<Opt<std::int64_t>, IpcError>
+{
+    return front(pipeline<std::int64_t>(Opcode::LookupActivationBlock,
+                                        {key},
+                                        decodeInteger));
+}
+
+auto IpcClient::getBalanceOf(const std::string& owner,
+                             const EntryKey& token)
+    -> Result<std::uint64_t, IpcError>
+{
+    auto payload_opt = encodeBalanceRequest(owner, token);
+    if(!payload_opt) {
+        return IpcError{fmt::format("owner {} is too long", owner)};
+    }
+
+    return valueOf(front(pipeline<std::uint64_t>(Opcode::GetBalanceOf,
+                                                 {payload_opt.getValue()},
+                                                 parseInteger)));
+}
+
+auto IpcClient::getSupplyOfUtilityToken(const EntryKey& token)
+    -> Result<std::uint64_t, IpcError>
+{
+    return valueOf(front(pipeline<std::uint64_t>(Opcode::GetSupplyOfUtilityToken,
+                                                 {token},
+                                                 parseInteger)));
+}
+
+auto IpcClient::lookupUMValues(const std::vector<EntryKey>& keys)
+    -> Result<std::vector<Opt<UMEntryValue>>, IpcError>
+{
+    return pipeline<UMEntryValue>(Opcode::LookupUMValue,
+                                  toKeyPayloads(keys),
+                                  parseValue);
+}
+
+auto IpcClient::lookupOwners(const std::vector<EntryKey>& keys)
+    -> Result<std::vector<Opt<std::string>>, IpcError>
+{
+    return pipeline<std::string>(Opcode::LookupOwner,
+                                 toKeyPayloads(keys),
+                                 decodeString);
+}
+
+auto IpcClient::getBlockHeight() const
+    -> std::int64_t
+{
+    return block_height_;
+}
+
+template<class T, class Decoder>
+auto IpcClient::pipeline(Opcode opcode,
+                         const std::vector<ByteView>& payloads,
+                         Decoder&& decode)
+    -> Result<std::vector<Opt<T>>, IpcError>
+{
+    std::vector<Opt<T>> results;
+    results.reserve(payloads.size());
+
+    for(std::size_t start = 0; start < payloads.size(); start += MAX_PIPELINE_DEPTH) {
+        auto end = std::min(start + MAX_PIPELINE_DEPTH, payloads.size());
+        auto first_id = next_id_;
+
+        output_.clear();
+        for(auto i = start; i < end; i++) {
+            writeRequest(output_, next_id_++, opcode, payloads[i]);
+        }
+
+        if(auto res = sendAll(output_); !res) {
+            return res.getError();
+        }
+
+        for(auto i = start; i < end; i++) {
+            auto response_res = receiveResponse();
+            if(!response_res) {
+                return response_res.getError();
+            }
+
+            const auto& response = response_res.getValue();
+            auto expected_id = static_cast<std::uint32_t>(first_id + (i - start));
+            if(response.id != expected_id) {
+                return IpcError{fmt::format("ipc server answered request {} instead of {}",
+                                            response.id,
+                                            expected_id)};
+            }
+
+            block_height_ = response.block_height;
+
+            if(response.status == Status::NotFound) {
+                results.emplace_back(std::nullopt);
+                continue;
+            }
+
+            if(response.status != Status::Ok) {
+                return IpcError{fmt::format("ipc server rejected request {} with status {}",
+                                            response.id,
+                                            static_cast<int>(response.status))};
+            }
+
+            auto value_opt = decode(response.payload);
+            if(!value_opt) {
+                return IpcError{fmt::format("malformed answer to request {}", response.id)};
+            }
+
+            results.emplace_back(T{std::move(value_opt.getValue())});
+        }
+    }
+
+    return results;
+}
+
+auto IpcClient::sendAll(const std::vector<std::byte>& data)
+    -> Result<void, IpcError>
+{
+    std::size_t offset = 0;
+    while(offset < data.size()) {
+        auto sent = send(socket_, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if(sent < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            return IpcError{fmt::format("unable to send to ipc server: {}", std::strerror(errno))};
+        }
+
+        offset += static_cast<std::size_t>(sent);
+    }
+
+    return {};
+}
+
+auto IpcClient::receiveResponse()
+    -> Result<Response, IpcError>
+{
+    //drop the previous response, the rest of the input
+    //can already contain the next ones
+    input_.erase(std::begin(input_), std::begin(input_) + consumed_);
+    consumed_ = 0;
+
+    while(true) {
+        auto size_opt = peekFrameSize(input_);
+        if(size_opt && size_opt.getValue() > MAX_FRAME_SIZE) {
+            return IpcError{"ipc server sent an oversized frame"};
+        }
+
+        if(size_opt && input_.size() >= size_opt.getValue()) {
+            auto frame_size = size_opt.getValue();
+            consumed_ = frame_size;
+
+            auto frame = ByteView{input_}.subview(LENGTH_PREFIX_SIZE,
+                                                  frame_size - LENGTH_PREFIX_SIZE);
+            auto response_opt = parseResponse(frame);
+            if(!response_opt) {
+                return IpcError{"ipc server sent a malformed frame"};
+            }
+
+            return response_opt.getValue();
+        }
+
+        auto offset = input_.size();
+        input_.resize(offset + READ_SIZE);
+        auto received = recv(socket_, input_.data() + offset, READ_SIZE, 0);
+        input_.resize(offset + static_cast<std::size_t>(std::max<ssize_t>(received, 0)));
+
+        if(received < 0 && errno == EINTR) {
+            continue;
+        }
+        if(received <= 0) {
+            return IpcError{"connection to ipc server closed"};
+        }
+    }
+}
+
+auto forge::ipc::make_ipc_client(const std::string& path)
+    -> Result<IpcClient, IpcError>
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return IpcError{fmt::format("invalid ipc socket path {}", path)};
+    }
+    std::copy(std::begin(path), std::end(path), address.sun_path);
+
+    auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0) {
+        return IpcError{fmt::format("unable to create ipc socket: {}", std::strerror(errno))};
+    }
+
+    if(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        auto error = IpcError{fmt::format("unable to connect to {}: {}", path, std::strerror(errno))};
+        close(fd);
+        return error;
+    }
+
+    return IpcClient{fd};
+}
@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <entrys/Entry.hpp>
+#include <fmt/core.h>
+#include <g3log/g3log.hpp>
+#include <ipc/BinaryProtocol.hpp>
+#include <ipc/IpcError.hpp>
+#include <ipc/IpcServer.hpp>
+#include <lookup/LookupManager.hpp>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <utils/ByteView.hpp>
+#include <utils/Opt.hpp>
+#include <utils/Result.hpp>
+#include <variant>
+#include <vector>
+
+using forge::ipc::IpcServer;
+using forge::ipc::IpcError;
+using forge::ipc::Opcode;
+using forge::ipc::Status;
+using forge::ipc::Request;
+using forge::ipc::RequestHandler;
+using forge::lookup::LookupManager;
+using forge::utils::ByteView;
+
+namespace {
+
+//the threads check for a stop request after this timeout
+constexpr timeval SOCKET_TIMEOUT{0, 200000};
+constexpr std::size_t READ_SIZE = 64 * 1024;
+
+auto isTimeout(int error)
+    -> bool
+{
+    return error == EAGAIN
+        || error == EWOULDBLOCK
+        || error == EINTR;
+}
+
+auto writeAll(int connection, const std::byte* data, std::size_t size)
+    -> bool
+{
+    while(size > 0) {
+        auto sent = send(connection, data, size, MSG_NOSIGNAL);
+        if(sent < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        data += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+
+    return true;
+}
+
+//the encoded value of the entry if it has the given type
+template<class EntryType>
+auto encodeValueOf(const forge::lookup::EntryInfo& info)
+    -> forge::utils::Opt<std::vector<std::byte>>
+{
+    if(const auto* entry = std::get_if<EntryType>(&info.entry)) {
+        return forge::ipc::encodeValue(entry->getValue());
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+auto forge::ipc::makeLookupHandler(const LookupManager& lookup)
+    -> RequestHandler
+{
+    return [&lookup](const Request& request,
+                     std::vector<std::byte>& output) {
+        auto respond = [&](Status status,
+                           std::int64_t block_height,
+                           ByteView payload) {
+            writeResponse(output,
+                          request.id,
+                          status,
+                          block_height,
+                          payload);
+        };
+
+        //the batch versions are used, because they return
+        //the block height together with the result
+        auto lookup_info = [&](auto&& to_payload) {
+            std::vector<core::EntryKey> keys{request.payload.toVector()};
+            auto batch = lookup.lookupMany(keys);
+            auto payload = batch.results.front()
+                               .flatMap(to_payload);
+
+            if(!payload) {
+                respond(Status::NotFound, batch.block_height, {});
+                return;
+            }
+
+            respond(Status::Ok, batch.block_height, payload.getValue());
+        };
+
+        switch(request.opcode) {
+        case Opcode::LookupUMValue:
+            lookup_info(encodeValueOf<core::UMEntry>);
+            return;
+
+        case Opcode::LookupUniqueValue:
+            lookup_info(encodeValueOf<core::UniqueEntry>);
+            return;
+
+        case Opcode::LookupOwner:
+            lookup_info([](const lookup::EntryInfo& info)
+                            -> utils::Opt<std::vector<std::byte>> {
+                const auto* begin = reinterpret_cast<const std::byte*>(info.owner.data());
+                return std::vector<std::byte>(begin, begin + info.owner.size());
+            });
+            return;
+
+        case Opcode::LookupActivationBlock:
+            lookup_info([](const lookup::EntryInfo& info)
+                            -> utils::Opt<std::vector<std::byte>> {
+                return encodeInteger(static_cast<std::uint64_t>(info.activation_block));
+            });
+            return;
+
+        case Opcode::GetBalanceOf: {
+            auto pair_opt = parseBalanceRequest(request.payload);
+            if(!pair_opt) {
+                respond(Status::BadRequest, lookup.getLookupBlockHeight(), {});
+                return;
+            }
+
+            auto [owner, token] = pair_opt.getValue();
+            std::vector<std::pair<std::string, core::EntryKey>> pairs;
+            pairs.emplace_back(std::string{owner}, token.toVector());
+
+            auto batch = lookup.getBalances(pairs);
+            respond(Status::Ok,
+                    batch.block_height,
+                    encodeInteger(batch.results.front()));
+            return;
+        }
+
+        case Opcode::GetSupplyOfUtilityToken: {
+            auto supply = lookup.getSupplyOfToken(request.payload.toVector());
+            respond(Status::Ok,
+                    lookup.getLookupBlockHeight(),
+                    encodeInteger(supply));
+            return;
+        }
+        }
+
+        respond(Status::UnknownOpcode, lookup.getLookupBlockHeight(), {});
+    };
+}
+
+IpcServer::IpcServer(RequestHandler handler,
+                     std::size_t max_connections)
+    : handler_(std::move(handler)),
+      max_connections_(max_connections) {}
+
+IpcServer::~IpcServer()
+{
+    stop();
+}
+
+auto IpcServer::start(const std::string& path)
+    -> utils::Result<void, IpcError>
+{
+    if(running_.load()) {
+        return IpcError{"ipc server is already running"};
+    }
+
+    auto error = [this](auto&& what) {
+        auto message = fmt::format("{}: {}", what, std::strerror(errno));
+        close(socket_);
+        socket_ = -1;
+        return IpcError{std::move(message)};
+    };
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return IpcError{fmt::format("invalid ipc socket path {}", path)};
+    }
+    std::copy(std::begin(path), std::end(path), address.sun_path);
+
+    socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(socket_ < 0) {
+        return error("unable to create ipc socket");
+    }
+
+    if(setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &SOCKET_TIMEOUT, sizeof(SOCKET_TIMEOUT)) < 0) {
+        return error("unable to configure ipc socket");
+    }
+
+    //a previous run could have left the socket file behind
+    unlink(path.c_str());
+
+    if(bind(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        return error(fmt::format("unable to bind ipc socket to {}", path));
+    }
+
+    if(listen(socket_, SOMAXCONN) < 0) {
+        return error("unable to listen on ipc socket");
+    }
+
+    path_ = path;
+    running_.store(true);
+    acceptor_ = std::thread{[this] {
+        acceptConnections();
+    }};
+
+    LOG(INFO) << fmt::format("ipc server listening on {}", path_);
+
+    return {};
+}
+
+auto IpcServer::stop()
+    -> void
+{
+    running_.store(false);
+
+    if(acceptor_.joinable()) {
+        acceptor_.join();
+    }
+
+    for(auto& session : sessions_) {
+        session->thread.join();
+    }
+    sessions_.clear();
+
+    if(socket_ >= 0) {
+        close(socket_);
+        socket_ = -1;
+        unlink(path_.c_str());
+    }
+}
+
+auto IpcServer::acceptConnections()
+    -> void
+{
+    while(running_.load()) {
+        auto connection = accept(socket_, nullptr, nullptr);
+        if(connection < 0) {
+            if(isTimeout(errno) || errno == ECONNABORTED) {
+                reapSessions();
+                continue;
+            }
+            LOG(WARNING) << "ipc server stopped accepting: " << std::strerror(errno);
+            return;
+        }
+
+        reapSessions();
+        if(sessions_.size() >= max_connections_) {
+            close(connection);
+            continue;
+        }
+
+        setsockopt(connection,
+                   SOL_SOCKET,
+                   SO_RCVTIMEO,
+                   &SOCKET_TIMEOUT,
+                   sizeof(SOCKET_TIMEOUT));
+
+        auto& session = sessions_.emplace_back(std::make_unique<Session>());
+        session->thread = std::thread{[this, connection, &done = session->done] {
+            handleConnection(connection);
+            close(connection);
+            done.store(true);
+        }};
+    }
+}
+
+auto IpcServer::handleConnection(int connection)
+    -> void
+{
+    std::vector<std::byte> input;
+    std::vector<std::byte> output;
+    std::size_t received_size = 0;
+
+    while(running_.load()) {
+        input.resize(received_size + READ_SIZE);
+        auto received = recv(connection,
+                             input.data() + received_size,
+                             READ_SIZE,
+                             0);
+
+        if(received < 0 && isTimeout(errno)) {
+            continue;
+        }
+        if(received <= 0) {
+            return;
+        }
+
+        received_size += static_cast<std::size_t>(received);
+
+        //answer all complete requests, an incomplete
+        //one stays in the buffer until the next read
+        ByteView buffer{input.data(), received_size};
+        std::size_t consumed = 0;
+
+        while(true) {
+            auto remaining = buffer.subview(consumed);
+            auto size_opt = peekFrameSize(remaining);
+            if(!size_opt) {
+                break;
+            }
+
+            auto frame_size = size_opt.getValue();
+            if(frame_size > MAX_FRAME_SIZE) {
+                LOG(WARNING) << "closing ipc connection sending a frame of " << frame_size << " bytes";
+                return;
+            }
+            if(remaining.size() < frame_size) {
+                break;
+            }
+
+            auto request_opt = parseRequest(remaining.subview(LENGTH_PREFIX_SIZE,
+                                                              frame_size - LENGTH_PREFIX_SIZE));
+            if(!request_opt) {
+                return;
+            }
+
+            handler_(request_opt.getValue(), output);
+            consumed += frame_size;
+        }
+
+        if(!output.empty()) {
+            if(!writeAll(connection, output.data(), output.size())) {
+                return;
+            }
+            output.clear();
+        }
+
+        std::copy(std::begin(input) + consumed,
+                  std::begin(input) + received_size,
+                  std::begin(input));
+        received_size -= consumed;
+    }
+}
+
+auto IpcServer::reapSessions()
+    -> void
+{
+    sessions_.remove_if([](const auto& session) {
+        if(!session->done.load()) {
+            return false;
+        }
+
+        session->thread.join();
+        return true;
+    });
+}
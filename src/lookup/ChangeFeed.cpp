@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <lookup/ChangeFeed.hpp>
+#include <mutex>
+#include <utility>
+#include <utils/Opt.hpp>
+
+using forge::lookup::ChangeFeed;
+using forge::lookup::ChangesSince;
+using forge::lookup::BlockChanges;
+using forge::utils::Opt;
+
+auto BlockChanges::empty() const
+    -> bool
+{
+    return created.empty()
+        && updated.empty()
+        && transferred.empty()
+        && renewed.empty()
+        && deleted.empty()
+        && balance_changes.empty();
+}
+
+ChangeFeed::ChangeFeed(std::int64_t block_height,
+                       std::size_t capacity)
+    : capacity_(std::max<std::size_t>(capacity, 1)),
+      block_height_(block_height),
+      retained_since_(block_height) {}
+
+auto ChangeFeed::push(BlockChanges&& changes)
+    -> void
+{
+    {
+        std::unique_lock lock{mtx_};
+        block_height_ = changes.block_height;
+
+        if(!changes.empty()) {
+            if(blocks_.size() == capacity_) {
+                retained_since_ = blocks_.front().block_height;
+                blocks_.pop_front();
+            }
+
+            blocks_.emplace_back(std::move(changes));
+        }
+    }
+
+    block_arrived_.notify_all();
+}
+
+auto ChangeFeed::reset(std::int64_t block_height)
+    -> void
+{
+    {
+        std::unique_lock lock{mtx_};
+        blocks_.clear();
+        block_height_ = block_height;
+        retained_since_ = block_height;
+    }
+
+    block_arrived_.notify_all();
+}
+
+auto ChangeFeed::getChangesSince(std::int64_t block_height) const
+    -> Opt<ChangesSince>
+{
+    std::unique_lock lock{mtx_};
+    return collectSince(block_height);
+}
+
+auto ChangeFeed::waitForChangesSince(std::int64_t block_height,
+                                     std::chrono::milliseconds timeout) const
+    -> Opt<ChangesSince>
+{
+    std::unique_lock lock{mtx_};
+    block_arrived_.wait_for(lock,
+                            timeout,
+                            [&] {
+                                return block_height_ > block_height
+                                    || retained_since_ > block_height;
+                            });
+
+    return collectSince(block_height);
+}
+
+auto ChangeFeed::getRetainedSince() const
+    -> std::int64_t
+{
+    std::unique_lock lock{mtx_};
+    return retained_since_;
+}
+
+auto ChangeFeed::collectSince(std::int64_t block_height) const
+    -> Opt<ChangesSince>
+{
+    if(block_height < retained_since_) {
+        return std::nullopt;
+    }
+
+    //the blocks are ordered by their height
+    auto first = std::upper_bound(std::begin(blocks_),
+                                  std::end(blocks_),
+                                  block_height,
+                                  [](auto height, const auto& changes) {
+                                      return height < changes.block_height;
+                                  });
+
+    return ChangesSince{block_height_,
+                        std::vector<BlockChanges>(first, std::end(blocks_))};
+}
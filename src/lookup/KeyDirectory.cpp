@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <lookup/KeyDirectory.hpp>
+#include <utils/Opt.hpp>
+#include <vector>
+
+using forge::lookup::KeyDirectory;
+using forge::lookup::EntryKind;
+using forge::utils::Opt;
+
+namespace {
+
+//number of bits per key, 16 bits and 7 probes
+//give a false positive rate below 0.1%
+constexpr std::size_t BITS_PER_KEY = 16;
+constexpr std::size_t NUMBER_OF_PROBES = 7;
+constexpr std::size_t MIN_FILTER_BITS = std::size_t{1} << 14;
+
+auto filterBitsFor(std::size_t expected_keys)
+    -> std::size_t
+{
+    auto bits = MIN_FILTER_BITS;
+    while(bits < expected_keys * BITS_PER_KEY) {
+        bits <<= 1;
+    }
+    return bits;
+}
+
+//fnv-1a for the first hash and a splitmix finalizer
+//for the second one, probes are derived via double hashing
+auto hashKey(const std::vector<std::byte>& key)
+    -> std::pair<std::uint64_t, std::uint64_t>
+{
+    std::uint64_t h = 0xcbf29ce484222325;
+    for(auto b : key) {
+        h ^= std::to_integer<std::uint64_t>(b);
+        h *= 0x100000001b3;
+    }
+
+    auto h2 = h + 0x9e3779b97f4a7c15;
+    h2 = (h2 ^ (h2 >> 30)) * 0xbf58476d1ce4e5b9;
+    h2 = (h2 ^ (h2 >> 27)) * 0x94d049bb133111eb;
+    h2 = h2 ^ (h2 >> 31);
+
+    return {h, h2 | 1};
+}
+
+} // namespace
+
+
+KeyDirectory::KeyDirectory(std::size_t expected_keys)
+    : filter_(filterBitsFor(expected_keys) / 64, 0),
+      filter_mask_(filterBitsFor(expected_keys) - 1),
+      filter_keys_(0) {}
+
+auto KeyDirectory::update(const std::vector<std::byte>& key,
+                          Opt<EntryKind> kind)
+    -> void
+{
+    if(!kind) {
+        directory_.erase(key);
+
+        //too many erased keys make the filter useless,
+        //so it gets rebuilt from the remaining keys
+        if(filter_keys_ > 2 * directory_.size()
+           && filter_keys_ > (MIN_FILTER_BITS / BITS_PER_KEY)) {
+            rebuildFilter(directory_.size());
+        }
+        return;
+    }
+
+    auto [iter, inserted] = directory_.insert({key, kind.getValue()});
+    if(!inserted) {
+        iter->second = kind.getValue();
+        return;
+    }
+
+    if((filter_keys_ + 1) * BITS_PER_KEY > filter_mask_ + 1) {
+        rebuildFilter(2 * directory_.size());
+        return;
+    }
+
+    setBits(key);
+}
+
+auto KeyDirectory::find(const std::vector<std::byte>& key) const
+    -> Opt<EntryKind>
+{
+    if(!mayContain(key)) {
+        return std::nullopt;
+    }
+
+    if(auto iter = directory_.find(key);
+       iter != directory_.end()) {
+        return iter->second;
+    }
+
+    return std::nullopt;
+}
+
+auto KeyDirectory::contains(const std::vector<std::byte>& key) const
+    -> bool
+{
+    return find(key).hasValue();
+}
+
+auto KeyDirectory::mayContain(const std::vector<std::byte>& key) const
+    -> bool
+{
+    auto [h1, h2] = hashKey(key);
+
+    for(std::size_t i = 0; i < NUMBER_OF_PROBES; i++) {
+        auto bit = (h1 + i * h2) & filter_mask_;
+        if((filter_[bit / 64] & (std::uint64_t{1} << (bit % 64))) == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+auto KeyDirectory::eraseKind(EntryKind kind)
+    -> void
+{
+    auto iter = directory_.begin();
+    while(iter != directory_.end()) {
+        if(iter->second == kind) {
+            iter = directory_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    rebuildFilter(directory_.size());
+}
+
+auto KeyDirectory::clear()
+    -> void
+{
+    directory_.clear();
+    std::fill(std::begin(filter_),
+              std::end(filter_),
+              0);
+    filter_keys_ = 0;
+}
+
+auto KeyDirectory::size() const
+    -> std::size_t
+{
+    return directory_.size();
+}
+
+auto KeyDirectory::setBits(const std::vector<std::byte>& key)
+    -> void
+{
+    auto [h1, h2] = hashKey(key);
+
+    for(std::size_t i = 0; i < NUMBER_OF_PROBES; i++) {
+        auto bit = (h1 + i * h2) & filter_mask_;
+        filter_[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    }
+
+    filter_keys_++;
+}
+
+auto KeyDirectory::rebuildFilter(std::size_t expected_keys)
+    -> void
+{
+    auto bits = filterBitsFor(expected_keys);
+
+    filter_.assign(bits / 64, 0);
+    filter_mask_ = bits - 1;
+    filter_keys_ = 0;
+
+    for(const auto& [key, _] : directory_) {
+        setBits(key);
+    }
+}
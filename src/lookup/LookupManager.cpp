@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <chrono>
 #include <core/Coin.hpp>
 #include <core/Transaction.hpp>
 #include <client/ReadOnlyClientBase.hpp>
@@ -9,16 +10,29 @@
 #include <functional>
 #include <g3log/g3log.hpp>
 #include <iterator>
+#include <lookup/ChangeFeed.hpp>
+#include <lookup/KeyDirectory.hpp>
 #include <lookup/LookupManager.hpp>
 #include <lookup/UMEntryLookup.hpp>
 #include <memory>
+#include <memory_resource>
+#include <metrics/Metrics.hpp>
+#include <mutex>
+#include <set>
 #include <shared_mutex>
+#include <string>
+#include <utils/Algorithm.hpp>
 #include <utils/Opt.hpp>
 #include <utils/Overload.hpp>
 #include <utils/Result.hpp>
+#include <utility>
 
 using forge::lookup::LookupManager;
 using forge::lookup::LookupError;
+using forge::lookup::EntryKind;
+using forge::lookup::EntryInfo;
+using forge::lookup::BlockChanges;
+using forge::lookup::ChangeFeed;
 using forge::core::EntryKey;
 using forge::core::UMEntryValue;
 using forge::core::UMEntryOperation;
@@ -29,19 +43,236 @@ using forge::utils::Result;
 using forge::utils::traverse;
 using forge::client::ReadOnlyClientBase;
 
+namespace {
+//initial size of the per block arena, blocks needing more
+//memory for their temporaries fall back to the heap
+constexpr std::size_t BLOCK_ARENA_SIZE = 256 * 1024;
+
+struct LookupMetrics
+{
+    forge::metrics::Histogram& read_lock_wait;
+    forge::metrics::Histogram& write_lock_wait;
+    forge::metrics::Histogram& fetch_phase;
+    forge::metrics::Histogram& filter_phase;
+    forge::metrics::Histogram& apply_phase;
+    forge::metrics::Counter& processed_blocks;
+    forge::metrics::Gauge& block_height;
+    forge::metrics::Gauge& um_entrys;
+    forge::metrics::Gauge& unique_entrys;
+    forge::metrics::Gauge& utility_tokens;
+};
+
+auto lookupMetrics()
+    -> LookupMetrics&
+{
+    auto& registry = forge::metrics::getRegistry();
+
+    auto lock_wait = [&](const char* mode) -> auto& {
+        return registry.histogram("forge_lookup_lock_wait_seconds",
+                                  "Time waited for the lookup lock while another thread held it",
+                                  {{"mode", mode}});
+    };
+    auto phase = [&](const char* name) -> auto& {
+        return registry.histogram("forge_block_phase_duration_seconds",
+                                  "Duration of the phases of processing a block",
+                                  {{"phase", name}});
+    };
+    auto entrys = [&](const char* kind) -> auto& {
+        return registry.gauge("forge_lookup_entrys",
+                              "Number of entrys in the lookup",
+                              {{"kind", kind}});
+    };
+
+    static LookupMetrics metrics{
+        lock_wait("read"),
+        lock_wait("write"),
+        phase("fetch"),
+        phase("filter"),
+        phase("apply"),
+        registry.counter("forge_processed_blocks_total",
+                         "Blocks processed by the lookup"),
+        registry.gauge("forge_lookup_block_height",
+                       "Height of the last block processed by the lookup"),
+        entrys("umentry"),
+        entrys("uniqueentry"),
+        entrys("utilitytoken")};
+
+    return metrics;
+}
+
+template<class Lock>
+auto lockAndRecordWait(Lock&& lock,
+                       forge::metrics::Histogram& wait)
+    -> Lock
+{
+    //uncontended locks are not recorded, so readers do not
+    //all write to the same counters of the histogram
+    if(!lock.try_lock()) {
+        forge::metrics::ScopedTimer timer{wait};
+        lock.lock();
+    }
+
+    return std::move(lock);
+}
+} // namespace
+
+namespace {
+
+auto keyOf(const forge::core::UMEntry& entry)
+    -> const forge::core::EntryKey&
+{
+    return entry.getKey();
+}
+
+auto keyOf(const forge::core::UniqueEntry& entry)
+    -> const forge::core::EntryKey&
+{
+    return entry.getKey();
+}
+
+auto keyOf(const forge::core::UtilityToken& token)
+    -> const forge::core::EntryKey&
+{
+    return token.getId();
+}
+
+//collects the results of the owners in order, fetch returns at most
+//the given number of results of one owner after the given key
+template<class T, class Fetch>
+auto listPage(std::vector<std::string> owners,
+              const forge::utils::Opt<forge::lookup::ListPosition>& after,
+              std::size_t limit,
+              std::int64_t block_height,
+              Fetch&& fetch)
+    -> forge::lookup::Page<T>
+{
+    std::sort(std::begin(owners), std::end(owners));
+    owners.erase(std::unique(std::begin(owners), std::end(owners)),
+                 std::end(owners));
+
+    auto owner_iter = after.hasValue()
+        ? std::lower_bound(std::begin(owners),
+                           std::end(owners),
+                           after.getValue().owner)
+        : std::begin(owners);
+
+    forge::lookup::Page<T> page{block_height, {}, std::nullopt};
+    const std::string* last_owner = nullptr;
+
+    for(; owner_iter != std::end(owners); ++owner_iter) {
+        const auto& owner = *owner_iter;
+
+        //only the owner of the position continues after its key
+        forge::utils::Opt<std::vector<std::byte>> after_key;
+        if(after.hasValue() && after.getValue().owner == owner) {
+            after_key = after.getValue().key;
+        }
+
+        //one more than needed tells if another page follows
+        auto results = fetch(owner, after_key, limit + 1 - page.results.size());
+
+        for(auto& result : results) {
+            if(page.results.size() == limit) {
+                page.next = forge::lookup::ListPosition{*last_owner,
+                                                        keyOf(page.results.back())};
+                return page;
+            }
+
+            page.results.emplace_back(std::move(result));
+            last_owner = &owner;
+        }
+    }
+
+    return page;
+}
+
+//values of entrys of different kinds never compare equal
+auto haveSameValue(const forge::core::Entry& lhs,
+                   const forge::core::Entry& rhs)
+    -> bool
+{
+    return std::visit(
+        forge::utils::overload{
+            [](const forge::core::UMEntry& l, const forge::core::UMEntry& r) {
+                return l.getValue() == r.getValue();
+            },
+            [](const forge::core::UniqueEntry& l, const forge::core::UniqueEntry& r) {
+                return l.getValue() == r.getValue();
+            },
+            [](const auto&, const auto&) {
+                return false;
+            }},
+        lhs,
+        rhs);
+}
+
+//owner and token pairs whose balance the operations can change,
+//the balances are not filled in
+template<class Ops>
+auto touchedBalances(const Ops& ops)
+    -> std::vector<forge::lookup::BalanceChange>
+{
+    std::set<std::pair<std::string, forge::core::EntryKey>> pairs;
+    for(const auto& op : ops) {
+        const auto& token = forge::core::getUtilitToken(op).getId();
+        pairs.emplace(forge::core::getCreator(op), token);
+
+        if(const auto* transfer = std::get_if<forge::core::UtilityTokenOwnershipTransferOp>(&op)) {
+            pairs.emplace(transfer->getReciever(), token);
+        }
+    }
+
+    std::vector<forge::lookup::BalanceChange> changes;
+    changes.reserve(pairs.size());
+    for(const auto& [owner, token] : pairs) {
+        changes.push_back(forge::lookup::BalanceChange{owner, token, 0, 0});
+    }
+
+    return changes;
+}
+
+} // namespace
+
 LookupManager::LookupManager(std::unique_ptr<client::ReadOnlyClientBase>&& client)
     : client_(std::move(client)),
       rw_mtx_(std::make_unique<std::shared_mutex>()),
       um_entry_lookup_(this, getStartingBlock(client_->getCoin())),
       unique_entry_lookup_(this, getStartingBlock(client_->getCoin())),
-      utility_token_lookup_(this, core::getStartingBlock(client_->getCoin()))
+      utility_token_lookup_(this, core::getStartingBlock(client_->getCoin())),
+      lookup_block_height_(core::getStartingBlock(client_->getCoin())),
+      change_feed_(std::make_unique<ChangeFeed>(lookup_block_height_)),
+      block_arena_buffer_(BLOCK_ARENA_SIZE)
 {}
 
+auto LookupManager::readLock() const
+    -> std::shared_lock<std::shared_mutex>
+{
+    return lockAndRecordWait(std::shared_lock{*rw_mtx_, std::defer_lock},
+                             lookupMetrics().read_lock_wait);
+}
+
+auto LookupManager::writeLock()
+    -> std::unique_lock<std::shared_mutex>
+{
+    return lockAndRecordWait(std::unique_lock{*rw_mtx_, std::defer_lock},
+                             lookupMetrics().write_lock_wait);
+}
+
+auto LookupManager::updateSizeMetrics() const
+    -> void
+{
+    auto& metrics = lookupMetrics();
+    metrics.block_height.set(lookup_block_height_);
+    metrics.um_entrys.set(static_cast<std::int64_t>(um_entry_lookup_.size()));
+    metrics.unique_entrys.set(static_cast<std::int64_t>(unique_entry_lookup_.size()));
+    metrics.utility_tokens.set(utility_token_lookup_.getNumberOfTokens());
+}
+
 auto LookupManager::updateLookup()
     -> utils::Result<bool, ManagerError>
 {
     //aquire writer lock
-    std::unique_lock lock{*rw_mtx_};
+    auto lock = writeLock();
     const auto maturity = getMaturity(client_->getCoin());
 
     return client_->getBlockCount()
@@ -91,9 +322,13 @@ auto LookupManager::updateLookup()
 auto LookupManager::rebuildLookup()
     -> utils::Result<void, ManagerError>
 {
-    std::unique_lock lock{*rw_mtx_};
+    auto lock = writeLock();
     um_entry_lookup_.clear();
     unique_entry_lookup_.clear();
+    key_directory_.eraseKind(EntryKind::UMEntry);
+    key_directory_.eraseKind(EntryKind::UniqueEntry);
+    change_feed_->reset(lookup_block_height_);
+    updateSizeMetrics();
     lock.unlock();
 
     if(auto res = updateLookup();
@@ -107,14 +342,14 @@ auto LookupManager::rebuildLookup()
 auto LookupManager::lookupUMValue(const core::EntryKey& key) const
     -> utils::Opt<std::reference_wrapper<const core::UMEntryValue>>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
     return um_entry_lookup_.lookup(key);
 }
 
 auto LookupManager::lookupUniqueValue(const core::EntryKey& key) const
     -> utils::Opt<std::reference_wrapper<const core::UniqueEntryValue>>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
     return unique_entry_lookup_.lookup(key);
 }
 
@@ -122,48 +357,190 @@ auto LookupManager::lookupUniqueValue(const core::EntryKey& key) const
 auto LookupManager::lookup(const core::EntryKey& key) const
     -> utils::Opt<core::Entry>
 {
-    if(auto um_value = lookupUMValue(key);
-       um_value) {
-        auto value = um_value.getValue().get();
-        return core::Entry{
-            core::UMEntry{key,
-                          std::move(value)}};
-    }
-    if(auto unique_value = lookupUniqueValue(key);
-       unique_value) {
-        auto value = unique_value.getValue().get();
-        return core::Entry{
-            core::UniqueEntry{key,
-                              std::move(value)}};
+    auto lock = readLock();
+
+    //the directory tells us in which lookup the key lives,
+    //most non existing keys are rejected by its bloom filter
+    auto kind_opt = key_directory_.find(key);
+    if(!kind_opt) {
+        return std::nullopt;
     }
 
-    return std::nullopt;
+    switch(kind_opt.getValue()) {
+    case EntryKind::UMEntry:
+        return um_entry_lookup_.lookup(key)
+            .map([&key](auto value) {
+                return core::Entry{
+                    core::UMEntry{key,
+                                  value.get()}};
+            });
+    case EntryKind::UniqueEntry:
+        return unique_entry_lookup_.lookup(key)
+            .map([&key](auto value) {
+                return core::Entry{
+                    core::UniqueEntry{key,
+                                      value.get()}};
+            });
+    default:
+        return std::nullopt;
+    }
 }
 
 auto LookupManager::lookupOwner(const core::EntryKey& key) const
     -> utils::Opt<std::reference_wrapper<const std::string>>
 {
-    std::shared_lock lock{*rw_mtx_};
-    auto um_owner_opt = um_entry_lookup_.lookupOwner(key);
+    auto lock = readLock();
 
-    if(um_owner_opt) {
-        return um_owner_opt;
+    auto kind_opt = key_directory_.find(key);
+    if(!kind_opt) {
+        return std::nullopt;
     }
 
-    return unique_entry_lookup_.lookupOwner(key);
+    switch(kind_opt.getValue()) {
+    case EntryKind::UMEntry:
+        return um_entry_lookup_.lookupOwner(key);
+    case EntryKind::UniqueEntry:
+        return unique_entry_lookup_.lookupOwner(key);
+    default:
+        return std::nullopt;
+    }
 }
 
 auto LookupManager::lookupActivationBlock(const core::EntryKey& key) const
     -> utils::Opt<std::reference_wrapper<const std::int64_t>>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
+
+    auto kind_opt = key_directory_.find(key);
+    if(!kind_opt) {
+        return std::nullopt;
+    }
+
+    switch(kind_opt.getValue()) {
+    case EntryKind::UMEntry:
+        return um_entry_lookup_.lookupActivationBlock(key);
+    case EntryKind::UniqueEntry:
+        return unique_entry_lookup_.lookupActivationBlock(key);
+    default:
+        return std::nullopt;
+    }
+}
+
+auto LookupManager::lookupMany(const std::vector<core::EntryKey>& keys) const
+    -> BatchResult<utils::Opt<EntryInfo>>
+{
+    auto lock = readLock();
+
+    BatchResult<utils::Opt<EntryInfo>> batch{lookup_block_height_, {}};
+    batch.results.reserve(keys.size());
+
+    for(const auto& key : keys) {
+        batch.results.emplace_back(lookupEntryInfo(key));
+    }
+
+    return batch;
+}
+
+auto LookupManager::lookupOwners(const std::vector<core::EntryKey>& keys) const
+    -> BatchResult<utils::Opt<std::string>>
+{
+    auto lock = readLock();
+
+    BatchResult<utils::Opt<std::string>> batch{lookup_block_height_, {}};
+    batch.results.reserve(keys.size());
+
+    for(const auto& key : keys) {
+        auto owner_opt = key_directory_.find(key).flatMap(
+            [&](auto kind) -> utils::Opt<std::reference_wrapper<const std::string>> {
+                switch(kind) {
+                case EntryKind::UMEntry:
+                    return um_entry_lookup_.lookupOwner(key);
+                case EntryKind::UniqueEntry:
+                    return unique_entry_lookup_.lookupOwner(key);
+                default:
+                    return std::nullopt;
+                }
+            });
+
+        batch.results.emplace_back(owner_opt.map([](auto owner) {
+            return std::string{owner.get()};
+        }));
+    }
+
+    return batch;
+}
+
+auto LookupManager::getBalances(const std::vector<std::pair<std::string, core::EntryKey>>& owner_token_pairs) const
+    -> BatchResult<std::uint64_t>
+{
+    auto lock = readLock();
+
+    BatchResult<std::uint64_t> batch{lookup_block_height_, {}};
+    batch.results.reserve(owner_token_pairs.size());
+
+    for(const auto& [owner, token] : owner_token_pairs) {
+        batch.results.emplace_back(
+            utility_token_lookup_.getAvailableBalanceOf(owner, token));
+    }
+
+    return batch;
+}
+
+auto LookupManager::lookupEntryInfo(const core::EntryKey& key) const
+    -> utils::Opt<EntryInfo>
+{
+    auto kind_opt = key_directory_.find(key);
+    if(!kind_opt) {
+        return std::nullopt;
+    }
+
+    //collects owner and activation block of the entry
+    //from the lookup the key lives in
+    auto collect = [&key](const auto& lookup, auto&& entry)
+        -> utils::Opt<EntryInfo> {
+        auto owner_opt = lookup.lookupOwner(key);
+        auto block_opt = lookup.lookupActivationBlock(key);
+        if(!owner_opt || !block_opt) {
+            return std::nullopt;
+        }
 
-    auto um_block_op = um_entry_lookup_.lookupActivationBlock(key);
-    if(um_block_op) {
-        return um_block_op;
+        return EntryInfo{core::Entry{std::move(entry)},
+                         owner_opt.getValue().get(),
+                         block_opt.getValue().get()};
+    };
+
+    switch(kind_opt.getValue()) {
+    case EntryKind::UMEntry:
+        return um_entry_lookup_.lookup(key)
+            .flatMap([&](auto value) {
+                return collect(um_entry_lookup_,
+                               core::UMEntry{key, value.get()});
+            });
+    case EntryKind::UniqueEntry:
+        return unique_entry_lookup_.lookup(key)
+            .flatMap([&](auto value) {
+                return collect(unique_entry_lookup_,
+                               core::UniqueEntry{key, value.get()});
+            });
+    default:
+        return std::nullopt;
     }
+}
 
-    return unique_entry_lookup_.lookupActivationBlock(key);
+auto LookupManager::refreshKeyDirectory(const std::vector<core::EntryKey>& keys)
+    -> void
+{
+    for(const auto& key : keys) {
+        if(unique_entry_lookup_.lookup(key)) {
+            key_directory_.update(key, EntryKind::UniqueEntry);
+        } else if(um_entry_lookup_.lookup(key)) {
+            key_directory_.update(key, EntryKind::UMEntry);
+        } else if(utility_token_lookup_.getSupplyOfToken(key) > 0) {
+            key_directory_.update(key, EntryKind::UtilityToken);
+        } else {
+            key_directory_.update(key, std::nullopt);
+        }
+    }
 }
 
 
@@ -274,34 +651,117 @@ auto LookupManager::processBlock(core::Block&& block)
 {
     auto block_height = block.getHeight();
     auto block_hash = std::move(block.getHash());
+    auto& metrics = lookupMetrics();
+    auto phase_start = std::chrono::steady_clock::now();
+
+    //only keep the transactions which can contain a forge operation,
+    //all others are dropped while their json is decoded
+    std::vector<core::ForgeCandidate> candidates;
+    for(auto&& txid : block.getTxids()) {
+        auto candidate_res = client_->getForgeCandidate(std::move(txid));
+        if(!candidate_res) {
+            return ManagerError{std::move(candidate_res.getError())};
+        }
 
-    //traverse all txids to transactions
-    auto txs_res =
-        traverse(
-            std::move(block.getTxids()),
-            [this](auto txid) {
-                return client_
-                    ->getTransaction(std::move(txid))
-                    .mapError([](auto error) {
-                        return ManagerError{std::move(error)};
-                    });
-            });
-
-    //check if an error occured
-    if(!txs_res) {
-        auto error = txs_res.getError();
-        return ManagerError{std::move(error)};
+        if(auto candidate_opt = std::move(candidate_res.getValue());
+           candidate_opt) {
+            candidates.emplace_back(std::move(candidate_opt.getValue()));
+        }
     }
 
-    //extract transactions
-    auto transactions = txs_res.getValue();
+    //all temporaries of parsing and filtering the block are allocated
+    //from this arena and released at once when the block was applied
+    std::pmr::monotonic_buffer_resource arena{block_arena_buffer_.data(),
+                                              block_arena_buffer_.size()};
+
+    //records the duration since the end of the last phase
+    auto end_phase = [&](auto& histogram) {
+        auto now = std::chrono::steady_clock::now();
+        histogram.observe(now - phase_start);
+        phase_start = now;
+    };
+
+    end_phase(metrics.fetch_phase);
+
     auto [um_ops, unique_ops, utility_ops] =
-        parseAndFilter(std::move(transactions),
-                       block_height);
+        parseAndFilter(std::move(candidates),
+                       block_height,
+                       &arena);
+    end_phase(metrics.filter_phase);
+
+    //remember which keys the operations touch, so that only
+    //those need to be reclassified in the key directory
+    auto um_keys =
+        utils::transform(um_ops,
+                         [](const auto& op) {
+                             return core::getEntryKey(op);
+                         });
+    auto unique_keys =
+        utils::transform(unique_ops,
+                         [](const auto& op) {
+                             return core::getEntryKey(op);
+                         });
+    auto utility_keys =
+        utils::transform(utility_ops,
+                         [](const auto& op) {
+                             return core::getUtilitToken(op).getId();
+                         });
+
+    //state of the touched entrys and balances before the block,
+    //to report what the block actually changed
+    auto entry_keys = um_keys;
+    entry_keys.insert(std::end(entry_keys),
+                      std::begin(unique_keys),
+                      std::end(unique_keys));
+    std::sort(std::begin(entry_keys), std::end(entry_keys));
+    entry_keys.erase(std::unique(std::begin(entry_keys), std::end(entry_keys)),
+                     std::end(entry_keys));
+
+    auto entrys_before =
+        utils::transform(entry_keys,
+                         [this](const auto& key) {
+                             return lookupEntryInfo(key);
+                         });
+
+    auto balance_changes = touchedBalances(utility_ops);
+    for(auto& change : balance_changes) {
+        change.old_balance =
+            utility_token_lookup_.getAvailableBalanceOf(change.owner,
+                                                        change.token);
+    }
 
-    um_entry_lookup_.executeOperations(std::move(um_ops));
-    unique_entry_lookup_.executeOperations(std::move(unique_ops));
-    utility_token_lookup_.executeOperations(std::move(utility_ops));
+    //the directory is refreshed after every lookup, because the
+    //following lookups check reserved keys through it
+    um_entry_lookup_.executeOperations(std::move(um_ops), &arena);
+    refreshKeyDirectory(um_keys);
+    unique_entry_lookup_.executeOperations(std::move(unique_ops), &arena);
+    refreshKeyDirectory(unique_keys);
+    utility_token_lookup_.executeOperations(std::move(utility_ops), &arena);
+    refreshKeyDirectory(utility_keys);
+
+    for(auto* keys : {&um_keys, &unique_keys, &utility_keys}) {
+        touched_keys_.insert(std::end(touched_keys_),
+                             std::make_move_iterator(std::begin(*keys)),
+                             std::make_move_iterator(std::end(*keys)));
+    }
+
+    BlockChanges changes{block_height, {}, {}, {}, {}, {}, {}};
+    collectEntryChanges(entry_keys, entrys_before, changes);
+
+    for(auto& change : balance_changes) {
+        change.new_balance =
+            utility_token_lookup_.getAvailableBalanceOf(change.owner,
+                                                        change.token);
+        if(change.new_balance != change.old_balance) {
+            changes.balance_changes.emplace_back(std::move(change));
+        }
+    }
+
+    change_feed_->push(std::move(changes));
+
+    end_phase(metrics.apply_phase);
+    metrics.processed_blocks.increment();
+    updateSizeMetrics();
 
     //add blockhash to the processed blocks
     block_hashes_.push_back(std::move(block_hash));
@@ -309,6 +769,41 @@ auto LookupManager::processBlock(core::Block&& block)
     return {};
 }
 
+auto LookupManager::collectEntryChanges(const std::vector<core::EntryKey>& keys,
+                                        const std::vector<utils::Opt<EntryInfo>>& before,
+                                        BlockChanges& changes) const
+    -> void
+{
+    for(std::size_t i = 0; i < keys.size(); i++) {
+        const auto& key = keys[i];
+        const auto& old_opt = before[i];
+        auto new_opt = lookupEntryInfo(key);
+
+        if(!old_opt && !new_opt) {
+            continue;
+        }
+        if(!old_opt) {
+            changes.created.emplace_back(key);
+            continue;
+        }
+        if(!new_opt) {
+            changes.deleted.emplace_back(key);
+            continue;
+        }
+
+        const auto& old_info = old_opt.getValue();
+        const auto& new_info = new_opt.getValue();
+
+        if(old_info.owner != new_info.owner) {
+            changes.transferred.emplace_back(key);
+        } else if(!haveSameValue(old_info.entry, new_info.entry)) {
+            changes.updated.emplace_back(key);
+        } else if(old_info.activation_block != new_info.activation_block) {
+            changes.renewed.emplace_back(key);
+        }
+    }
+}
+
 auto LookupManager::lookupIsValid() const
     -> utils::Result<bool, client::ClientError>
 {
@@ -327,7 +822,7 @@ auto LookupManager::getLastValidBlockHeight() const
 {
     auto starting_block = getStartingBlock(client_->getCoin());
 
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
     for(auto&& hash : block_hashes_) {
         if(auto res = client_->getBlockHash(++starting_block);
            res) {
@@ -342,10 +837,24 @@ auto LookupManager::getLastValidBlockHeight() const
     return starting_block;
 }
 
+auto LookupManager::getLookupBlockHeight() const
+    -> std::int64_t
+{
+    auto lock = readLock();
+    return lookup_block_height_;
+}
+
+auto LookupManager::takeTouchedKeys()
+    -> std::vector<core::EntryKey>
+{
+    auto lock = writeLock();
+    return std::exchange(touched_keys_, {});
+}
+
 auto LookupManager::getUMEntrysOfOwner(const std::string& owner) const
     -> std::vector<core::UMEntry>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
     return um_entry_lookup_.getUMEntrysOfOwner(owner);
 }
 
@@ -353,22 +862,91 @@ auto LookupManager::getUMEntrysOfOwner(const std::string& owner) const
 auto LookupManager::getUniqueEntrysOfOwner(const std::string& owner) const
     -> std::vector<core::UniqueEntry>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
     return unique_entry_lookup_.getUniqueEntrysOfOwner(owner);
 }
 
 auto LookupManager::getUtilityTokensOfOwner(const std::string& owner) const
     -> std::vector<core::UtilityToken>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
     return utility_token_lookup_.getUtilityTokensOfOwner(owner);
 }
 
+auto LookupManager::getUMEntrysOfOwners(const std::set<std::string>& owners) const
+    -> std::vector<core::UMEntry>
+{
+    auto lock = readLock();
+    return um_entry_lookup_.getUMEntrysOfOwners(owners);
+}
+
+auto LookupManager::getUniqueEntrysOfOwners(const std::set<std::string>& owners) const
+    -> std::vector<core::UniqueEntry>
+{
+    auto lock = readLock();
+    return unique_entry_lookup_.getUniqueEntrysOfOwners(owners);
+}
+
+auto LookupManager::getUtilityTokensOfOwners(const std::set<std::string>& owners) const
+    -> std::vector<core::UtilityToken>
+{
+    auto lock = readLock();
+    return utility_token_lookup_.getUtilityTokensOfOwners(owners);
+}
+
+auto LookupManager::getUMEntrysOfOwners(std::vector<std::string> owners,
+                                        const utils::Opt<ListPosition>& after,
+                                        std::size_t limit) const
+    -> Page<core::UMEntry>
+{
+    auto lock = readLock();
+    return listPage<core::UMEntry>(
+        std::move(owners),
+        after,
+        limit,
+        lookup_block_height_,
+        [this](const auto& owner, const auto& after_key, auto count) {
+            return um_entry_lookup_.getUMEntrysOfOwner(owner, after_key, count);
+        });
+}
+
+auto LookupManager::getUniqueEntrysOfOwners(std::vector<std::string> owners,
+                                            const utils::Opt<ListPosition>& after,
+                                            std::size_t limit) const
+    -> Page<core::UniqueEntry>
+{
+    auto lock = readLock();
+    return listPage<core::UniqueEntry>(
+        std::move(owners),
+        after,
+        limit,
+        lookup_block_height_,
+        [this](const auto& owner, const auto& after_key, auto count) {
+            return unique_entry_lookup_.getUniqueEntrysOfOwner(owner, after_key, count);
+        });
+}
+
+auto LookupManager::getUtilityTokensOfOwners(std::vector<std::string> owners,
+                                             const utils::Opt<ListPosition>& after,
+                                             std::size_t limit) const
+    -> Page<core::UtilityToken>
+{
+    auto lock = readLock();
+    return listPage<core::UtilityToken>(
+        std::move(owners),
+        after,
+        limit,
+        lookup_block_height_,
+        [this](const auto& owner, const auto& after_key, auto count) {
+            return utility_token_lookup_.getUtilityTokensOfOwner(owner, after_key, count);
+        });
+}
+
 auto LookupManager::getUtilityTokenCreditOf(const std::string& owner,
                                             const std::vector<std::byte>& token) const
     -> std::uint64_t
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
     return utility_token_lookup_.getAvailableBalanceOf(owner,
                                                        token);
 }
@@ -376,14 +954,14 @@ auto LookupManager::getUtilityTokenCreditOf(const std::string& owner,
 auto LookupManager::getSupplyOfToken(const std::vector<std::byte>& token) const
     -> std::uint64_t
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
     return utility_token_lookup_.getSupplyOfToken(token);
 }
 
 auto LookupManager::getNumberOfExisitingTokens() const
     -> std::int64_t
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = readLock();
     return utility_token_lookup_.getNumberOfTokens();
 }
 
@@ -423,11 +1001,9 @@ auto LookupManager::getEntrysOfOwner(const std::string& owner) const
 auto LookupManager::isReserverdEntryKey(const std::vector<std::byte>& key) const
     -> bool
 {
-    auto unique_opt = unique_entry_lookup_.lookup(key);
-    auto um_opt = um_entry_lookup_.lookup(key);
-    auto utility_token_opt = utility_token_lookup_.getSupplyOfToken(key);
-
-    return unique_opt || um_opt || utility_token_opt;
+    //no lock is aquired here, because this is called
+    //while processing blocks under the writer lock
+    return key_directory_.contains(key);
 }
 
 auto forge::lookup::generateMessage(ManagerError&& error)
@@ -447,6 +1023,12 @@ auto forge::lookup::generateMessage(ManagerError&& error)
                       std::move(error));
 }
 
+auto LookupManager::getChangeFeed() const
+    -> const ChangeFeed&
+{
+    return *change_feed_;
+}
+
 auto LookupManager::getClient() const
     -> const client::ReadOnlyClientBase&
 {
@@ -460,14 +1042,15 @@ auto LookupManager::getCoin() const
 }
 
 
-auto LookupManager::extractUMEntryOperations(const std::vector<core::Transaction>& txs,
-                                             std::int64_t block_height)
-    -> std::vector<core::UMEntryOperation>
+auto LookupManager::extractUMEntryOperations(const std::vector<core::ForgeCandidate>& candidates,
+                                             std::int64_t block_height,
+                                             std::pmr::memory_resource* resource)
+    -> std::pmr::vector<core::UMEntryOperation>
 {
-    std::vector<core::UMEntryOperation> um_ops;
+    std::pmr::vector<core::UMEntryOperation> um_ops{resource};
 
-    for(const auto& tx : txs) {
-        auto um_res = core::parseTransactionToUMEntry(tx, block_height, client_.get());
+    for(const auto& candidate : candidates) {
+        auto um_res = core::parseForgeCandidateToUMEntry(candidate, block_height, client_.get());
         if(!um_res) {
             //getting an error instead of an Opt indicates a wallet error
             LOG(WARNING) << um_res.getError().what();
@@ -486,14 +1069,15 @@ auto LookupManager::extractUMEntryOperations(const std::vector<core::Transaction
     return um_ops;
 }
 
-auto LookupManager::extractUniqueEntryOperations(const std::vector<core::Transaction>& txs,
-                                                 std::int64_t block_height)
-    -> std::vector<core::UniqueEntryOperation>
+auto LookupManager::extractUniqueEntryOperations(const std::vector<core::ForgeCandidate>& candidates,
+                                                 std::int64_t block_height,
+                                                 std::pmr::memory_resource* resource)
+    -> std::pmr::vector<core::UniqueEntryOperation>
 {
-    std::vector<core::UniqueEntryOperation> unique_ops;
+    std::pmr::vector<core::UniqueEntryOperation> unique_ops{resource};
 
-    for(const auto& tx : txs) {
-        auto unique_res = core::parseTransactionToUniqueEntry(tx, block_height, client_.get());
+    for(const auto& candidate : candidates) {
+        auto unique_res = core::parseForgeCandidateToUniqueEntry(candidate, block_height, client_.get());
         if(!unique_res) {
             //getting an error instead of an Opt indicates a wallet error
             LOG(WARNING) << unique_res.getError().what();
@@ -512,13 +1096,14 @@ auto LookupManager::extractUniqueEntryOperations(const std::vector<core::Transac
     return unique_ops;
 }
 
-auto LookupManager::extractUtilityTokenOperations(const std::vector<core::Transaction>& txs,
-                                                  std::int64_t block_height)
-    -> std::vector<core::UtilityTokenOperation>
+auto LookupManager::extractUtilityTokenOperations(const std::vector<core::ForgeCandidate>& candidates,
+                                                  std::int64_t block_height,
+                                                  std::pmr::memory_resource* resource)
+    -> std::pmr::vector<core::UtilityTokenOperation>
 {
-    std::vector<core::UtilityTokenOperation> utility_ops;
-    for(const auto& tx : txs) {
-        auto utility_res = core::parseTransactionToUtilityTokenOp(tx, block_height, client_.get());
+    std::pmr::vector<core::UtilityTokenOperation> utility_ops{resource};
+    for(const auto& candidate : candidates) {
+        auto utility_res = core::parseForgeCandidateToUtilityTokenOp(candidate, block_height, client_.get());
         if(!utility_res) {
             //getting an error instead of an Opt indicates a wallet error
             LOG(WARNING) << utility_res.getError().what();
@@ -537,65 +1122,57 @@ auto LookupManager::extractUtilityTokenOperations(const std::vector<core::Transa
     return utility_ops;
 }
 
-auto LookupManager::parseAndFilter(std::vector<core::Transaction>&& txs,
-                                   std::int64_t block_height)
+auto LookupManager::parseAndFilter(std::vector<core::ForgeCandidate>&& candidates,
+                                   std::int64_t block_height,
+                                   std::pmr::memory_resource* resource)
     -> std::tuple<std::vector<core::UMEntryOperation>,
                   std::vector<core::UniqueEntryOperation>,
                   std::vector<core::UtilityTokenOperation>>
 {
-    std::map<EntryKey, std::vector<core::EntryCreationOp>> creation_map;
+    std::pmr::map<EntryKey, std::pmr::vector<core::EntryCreationOp>> creation_map{resource};
 
     std::vector<core::UMEntryOperation> um_ops;
     std::vector<core::UniqueEntryOperation> unique_ops;
     std::vector<core::UtilityTokenOperation> utility_ops;
 
-    auto raw_um_ops = extractUMEntryOperations(txs, block_height);
-    auto raw_unique_ops = extractUniqueEntryOperations(txs, block_height);
-    auto raw_utility_ops = extractUtilityTokenOperations(txs, block_height);
+    auto raw_um_ops = extractUMEntryOperations(candidates, block_height, resource);
+    auto raw_unique_ops = extractUniqueEntryOperations(candidates, block_height, resource);
+    auto raw_utility_ops = extractUtilityTokenOperations(candidates, block_height, resource);
 
-    for(auto um_op : std::move(raw_um_ops)) {
+    for(auto&& um_op : raw_um_ops) {
         if(std::holds_alternative<core::UMEntryCreationOp>(um_op)) {
             auto creation = std::get<core::UMEntryCreationOp>(std::move(um_op));
-            auto key = creation.getEntryKey();
-            auto [iter, inserted] = creation_map.insert({std::move(key), {creation}});
-            if(!inserted) {
-                iter->second.emplace_back(std::move(creation));
-            }
+            auto [iter, _] = creation_map.try_emplace(creation.getEntryKey());
+            iter->second.emplace_back(std::move(creation));
             continue;
         }
 
         um_ops.emplace_back(std::move(um_op));
     }
 
-    for(auto unique_op : std::move(raw_unique_ops)) {
+    for(auto&& unique_op : raw_unique_ops) {
         if(std::holds_alternative<core::UniqueEntryCreationOp>(unique_op)) {
             auto creation = std::get<core::UniqueEntryCreationOp>(std::move(unique_op));
-            auto key = creation.getEntryKey();
-            auto [iter, inserted] = creation_map.insert({std::move(key), {creation}});
-            if(!inserted) {
-                iter->second.emplace_back(std::move(creation));
-            }
+            auto [iter, _] = creation_map.try_emplace(creation.getEntryKey());
+            iter->second.emplace_back(std::move(creation));
             continue;
         }
 
         unique_ops.emplace_back(std::move(unique_op));
     }
 
-    for(auto utility_op : std::move(raw_utility_ops)) {
+    for(auto&& utility_op : raw_utility_ops) {
         if(std::holds_alternative<core::UtilityTokenCreationOp>(utility_op)) {
             auto creation = std::get<core::UtilityTokenCreationOp>(std::move(utility_op));
-            auto key = creation.getUtilityToken().getId();
-            auto [iter, inserted] = creation_map.insert({std::move(key), {creation}});
-            if(!inserted) {
-                iter->second.emplace_back(std::move(creation));
-            }
+            auto [iter, _] = creation_map.try_emplace(creation.getUtilityToken().getId());
+            iter->second.emplace_back(std::move(creation));
             continue;
         }
 
         utility_ops.emplace_back(std::move(utility_op));
     }
 
-    for(auto [_, creations] : std::move(creation_map)) {
+    for(auto&& [_, creations] : creation_map) {
 
         if(creations.empty()) {
             continue;
@@ -3,8 +3,10 @@
 #include <entrys/umentry/UMEntryOperation.hpp>
 #include <functional>
 #include <g3log/g3log.hpp>
+#include <limits>
 #include <lookup/LookupManager.hpp>
 #include <lookup/UMEntryLookup.hpp>
+#include <memory_resource>
 #include <unordered_map>
 #include <utils/Algorithm.hpp>
 #include <utils/Opt.hpp>
@@ -31,10 +33,11 @@ UMEntryLookup::UMEntryLookup(const LookupManager* const manager,
       start_block_(start_block){};
 
 
-auto UMEntryLookup::executeOperations(std::vector<UMEntryOperation>&& ops)
+auto UMEntryLookup::executeOperations(std::vector<UMEntryOperation>&& ops,
+                                      std::pmr::memory_resource* resource)
     -> void
 {
-    ops = filterNonRelevantOperations(std::move(ops));
+    ops = filterNonRelevantOperations(std::move(ops), resource);
 
     for(auto&& op : ops) {
         std::visit(*this,
@@ -161,6 +164,7 @@ auto UMEntryLookup::removeUMEntrysOlderThan(std::int64_t diff)
     //uhhhggg
     for(; iter != end_iter;) {
         if(predicate(iter)) {
+            owner_index_.erase(std::pair{std::get<1>(iter->second), iter->first});
             lookup_map_.erase(iter++);
         } else {
             ++iter;
@@ -210,7 +214,8 @@ auto UMEntryLookup::isCurrentlyValid(const UMEntryOperation& op) const
         .valueOr(false);
 }
 
-auto UMEntryLookup::filterNonRelevantOperations(std::vector<UMEntryOperation>&& ops) const
+auto UMEntryLookup::filterNonRelevantOperations(std::vector<UMEntryOperation>&& ops,
+                                                std::pmr::memory_resource* resource) const
     -> std::vector<UMEntryOperation>
 {
     //erase non valid operations
@@ -222,37 +227,30 @@ auto UMEntryLookup::filterNonRelevantOperations(std::vector<UMEntryOperation>&&
                        }),
         ops.end());
 
-    std::map<core::EntryKey,
-             std::vector<UMEntryOperation>>
-        bucket_map;
+    //the buckets only hold indices into ops and refer to the keys
+    //inside of ops, which is not modified until all buckets are evaluated
+    std::pmr::map<std::reference_wrapper<const EntryKey>,
+                  std::pmr::vector<std::size_t>,
+                  std::less<EntryKey>>
+        bucket_map{resource};
 
     //fill map with operations
-    for(auto&& op : ops) {
-        auto key = std::visit(
-            [](const auto& op)
-                -> const EntryKey& {
-                return op.getEntryKey();
-            },
-            op);
-
-        if(auto iter = bucket_map.find(key);
-           iter != bucket_map.end()) {
-            iter->second.push_back(std::move(op));
-        } else {
-            bucket_map.insert({key, {std::move(op)}});
-        }
+    for(std::size_t i = 0; i < ops.size(); i++) {
+        const auto& key = core::getEntryKey(ops[i]);
+        auto [iter, _] = bucket_map.try_emplace(std::cref(key));
+        iter->second.push_back(i);
     }
 
-    std::vector<UMEntryOperation> relevant_ops;
-    for(auto&& [_, operations] : bucket_map) {
+    std::pmr::vector<std::size_t> relevant_indices{resource};
+    for(const auto& [_, indices] : bucket_map) {
         //its save to asume that there is a max element, because those
         //vectors cannot be empty
         auto max_iter =
-            std::max_element(std::begin(operations),
-                             std::end(operations),
-                             [](const auto& lhs, const auto& rhs) {
-                                 auto lhs_value = getValue(lhs);
-                                 auto rhs_value = getValue(rhs);
+            std::max_element(std::cbegin(indices),
+                             std::cend(indices),
+                             [&ops](auto lhs, auto rhs) {
+                                 auto lhs_value = getValue(ops[lhs]);
+                                 auto rhs_value = getValue(ops[rhs]);
 
                                  return lhs_value < rhs_value;
                              });
@@ -262,37 +260,69 @@ auto UMEntryLookup::filterNonRelevantOperations(std::vector<UMEntryOperation>&&
         //we dont execute any operation of them because
         //it would be ambiguous
         auto number_of_ops_with_max_burn =
-            std::count_if(std::cbegin(operations),
-                          std::cend(operations),
-                          [&max_iter](const auto& op) {
-                              return getValue(op) >= getValue(*max_iter);
+            std::count_if(std::cbegin(indices),
+                          std::cend(indices),
+                          [&ops, &max_iter](auto idx) {
+                              return getValue(ops[idx]) >= getValue(ops[*max_iter]);
                           });
 
         if(number_of_ops_with_max_burn == 1) {
-            relevant_ops.emplace_back(std::move(*max_iter));
+            relevant_indices.push_back(*max_iter);
         }
     }
 
+    std::vector<UMEntryOperation> relevant_ops;
+    relevant_ops.reserve(relevant_indices.size());
+    for(auto idx : relevant_indices) {
+        relevant_ops.emplace_back(std::move(ops[idx]));
+    }
+
     return relevant_ops;
 }
 
 auto UMEntryLookup::getUMEntrysOfOwner(const std::string& owner) const
     -> std::vector<core::UMEntry>
+{
+    return getUMEntrysOfOwner(owner,
+                              std::nullopt,
+                              std::numeric_limits<std::size_t>::max());
+}
+
+auto UMEntryLookup::getUMEntrysOfOwners(const std::set<std::string>& owners) const
+    -> std::vector<core::UMEntry>
 {
     std::vector<core::UMEntry> ret_vec;
-    utils::transform_if(
-        std::cbegin(lookup_map_),
-        std::cend(lookup_map_),
-        std::back_inserter(ret_vec),
-        [](const auto& value) {
-            return UMEntry{value.first,
-                           std::get<0>(value.second)};
-        },
-        [&owner](const auto& value) {
-            const auto& value_owner = std::get<1>(value.second);
 
-            return value_owner == owner;
-        });
+    //every owner is a range of the index, so only
+    //the entrys of the owners are visited
+    for(const auto& owner : owners) {
+        auto iter = owner_index_.lower_bound(std::pair{owner, EntryKey{}});
+        for(; iter != std::end(owner_index_) && iter->first == owner; ++iter) {
+            const auto& key = iter->second;
+            ret_vec.emplace_back(key, std::get<0>(lookup_map_.at(key)));
+        }
+    }
+
+    return ret_vec;
+}
+
+auto UMEntryLookup::getUMEntrysOfOwner(const std::string& owner,
+                                       const utils::Opt<EntryKey>& after,
+                                       std::size_t limit) const
+    -> std::vector<core::UMEntry>
+{
+    auto iter = after.hasValue()
+        ? owner_index_.upper_bound(std::pair{owner, after.getValue()})
+        : owner_index_.lower_bound(std::pair{owner, EntryKey{}});
+
+    std::vector<core::UMEntry> ret_vec;
+    for(; iter != std::end(owner_index_)
+        && iter->first == owner
+        && ret_vec.size() < limit;
+        ++iter) {
+        const auto& key = iter->second;
+        ret_vec.emplace_back(key, std::get<0>(lookup_map_.at(key)));
+    }
 
     return ret_vec;
 }
@@ -309,6 +339,7 @@ auto UMEntryLookup::operator()(UMEntryCreationOp&& op)
     //add it
     if(auto lookup_opt = lookup(key);
        !lookup_opt) {
+        owner_index_.emplace(owner, key);
         auto value_tuple = std::make_tuple(std::move(value),
                                            std::move(owner),
                                            std::move(block));
@@ -355,13 +386,17 @@ auto UMEntryLookup::operator()(UMEntryOwnershipTransferOp&& op)
     lookupUMEntry(key)
         .onValue([&new_owner,
                   &old_owner,
-                  &value](auto entry) {
+                  &value,
+                  &key,
+                  this](auto entry) {
             auto [looked_value_ref,
                   looked_owner_ref,
                   _] = std::move(entry);
 
             if(looked_value_ref.get() == value
                && looked_owner_ref.get() == old_owner) {
+                owner_index_.erase(std::pair{old_owner, key});
+                owner_index_.emplace(new_owner, key);
                 looked_owner_ref.get() = new_owner;
             }
         });
@@ -409,6 +444,7 @@ auto UMEntryLookup::operator()(UMEntryDeletionOp&& op)
 
             if(looked_owner_ref.get() == owner
                && looked_value_ref.get() == value) {
+                owner_index_.erase(std::pair{owner, key});
                 lookup_map_.erase(key);
             }
         });
@@ -426,5 +462,12 @@ auto UMEntryLookup::clear()
     -> void
 {
     lookup_map_.clear();
+    owner_index_.clear();
     block_height_ = start_block_;
 }
+
+auto UMEntryLookup::size() const
+    -> std::size_t
+{
+    return lookup_map_.size();
+}
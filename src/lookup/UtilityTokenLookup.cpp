@@ -10,8 +10,12 @@
 #include <g3log/g3log.hpp>
 #include <iterator>
 #include <limits>
+#include <memory_resource>
 #include <lookup/UtilityTokenLookup.hpp>
 #include <numeric>
+#include <set>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utils/Overload.hpp>
@@ -30,13 +34,14 @@ UtilityTokenLookup::UtilityTokenLookup(const LookupManager* const manager,
       block_height_(start_block),
       start_block_(start_block) {}
 
-auto UtilityTokenLookup::executeOperations(std::vector<UtilityTokenOperation>&& ops)
+auto UtilityTokenLookup::executeOperations(std::vector<UtilityTokenOperation>&& ops,
+                                           std::pmr::memory_resource* resource)
     -> void
 {
-    auto filtered = filterNonRelevantOperations(std::move(ops));
-    for(auto&& op : filtered) {
+    auto relevant_indices = filterNonRelevantOperations(ops, resource);
+    for(auto idx : relevant_indices) {
         std::visit(*this,
-                   std::move(op));
+                   std::move(ops[idx]));
     }
 }
 
@@ -79,16 +84,36 @@ auto UtilityTokenLookup::clear()
 
 auto UtilityTokenLookup::getUtilityTokensOfOwner(std::string_view owner) const
     -> std::vector<UtilityToken>
+{
+    return getUtilityTokensOfOwner(owner,
+                                   std::nullopt,
+                                   std::numeric_limits<std::size_t>::max());
+}
+
+auto UtilityTokenLookup::getUtilityTokensOfOwners(const std::set<std::string>& owners) const
+    -> std::vector<UtilityToken>
 {
     std::vector<UtilityToken> ret_vec;
+    if(owners.empty()) {
+        return ret_vec;
+    }
 
+    //one walk over the tokens, checking the smaller one of
+    //the accounts of a token and the given owners
     for(const auto& [token, accounts] : utility_account_lookup_) {
-        for(const auto& [creditor, credit] : accounts) {
-            if(creditor == owner) {
-                UtilityToken utility_token{token,
-                                           credit};
+        if(accounts.size() < owners.size()) {
+            for(const auto& [owner, balance] : accounts) {
+                if(owners.count(owner) > 0) {
+                    ret_vec.emplace_back(token, balance);
+                }
+            }
+            continue;
+        }
 
-                ret_vec.emplace_back(std::move(utility_token));
+        for(const auto& owner : owners) {
+            if(auto account = accounts.find(owner);
+               account != std::end(accounts)) {
+                ret_vec.emplace_back(token, account->second);
             }
         }
     }
@@ -96,6 +121,33 @@ auto UtilityTokenLookup::getUtilityTokensOfOwner(std::string_view owner) const
     return ret_vec;
 }
 
+auto UtilityTokenLookup::getUtilityTokensOfOwner(std::string_view owner,
+                                                 const utils::Opt<std::vector<std::byte>>& after,
+                                                 std::size_t limit) const
+    -> std::vector<UtilityToken>
+{
+    auto iter = after.hasValue()
+        ? utility_account_lookup_.upper_bound(after.getValue())
+        : std::begin(utility_account_lookup_);
+
+    //the accounts are hashed, so only the token ids
+    //need to be walked and not every account
+    const std::string owner_str{owner};
+
+    std::vector<UtilityToken> ret_vec;
+    for(; iter != std::end(utility_account_lookup_)
+        && ret_vec.size() < limit;
+        ++iter) {
+        const auto& [token, accounts] = *iter;
+        if(auto account = accounts.find(owner_str);
+           account != std::end(accounts)) {
+            ret_vec.emplace_back(token, account->second);
+        }
+    }
+
+    return ret_vec;
+}
+
 auto UtilityTokenLookup::getNumberOfTokens() const
     -> std::int64_t
 {
@@ -179,46 +231,54 @@ auto UtilityTokenLookup::operator()(UtilityTokenDeletionOp&& op)
     }
 }
 
-auto UtilityTokenLookup::filterNonRelevantOperations(std::vector<UtilityTokenOperation>&& ops) const
-    -> std::vector<UtilityTokenOperation>
+auto UtilityTokenLookup::filterNonRelevantOperations(const std::vector<UtilityTokenOperation>& ops,
+                                                     std::pmr::memory_resource* resource) const
+    -> OperationIndices
 {
-    auto grouped = groupOperationsByToken(std::move(ops));
-    std::vector<UtilityTokenOperation> relevant_ops;
-
-    for(auto&& [id, operations] : grouped) {
-        auto rel_ops = filterOperationsPerToken(id,
-                                                std::move(operations));
-        std::move(std::begin(rel_ops),
-                  std::end(rel_ops),
-                  std::back_inserter(relevant_ops));
+    auto grouped = groupOperationsByToken(ops, resource);
+    OperationIndices relevant_indices{resource};
+
+    for(const auto& [id, indices] : grouped) {
+        auto rel_indices = filterOperationsPerToken(id,
+                                                    ops,
+                                                    indices);
+        relevant_indices.insert(std::end(relevant_indices),
+                                std::begin(rel_indices),
+                                std::end(rel_indices));
     }
 
-    return relevant_ops;
+    return relevant_indices;
 }
 
 auto UtilityTokenLookup::filterOperationsPerToken(const std::vector<std::byte>& token_id,
-                                                  std::vector<UtilityTokenOperation>&& ops) const
-    -> std::vector<UtilityTokenOperation>
+                                                  const std::vector<UtilityTokenOperation>& ops,
+                                                  const OperationIndices& indices) const
+    -> OperationIndices
 {
-    std::vector<UtilityTokenCreationOp> creations;
-    std::vector<UtilityTokenOperation> changing_ops;
-
-    for(auto&& op : ops) {
-        std::visit(
-            utils::overload{
-                [&](UtilityTokenCreationOp&& creation) {
-                    if(creation.getAmount() != 0) {
-                        creations.emplace_back(std::move(creation));
-                    }
-                },
-                [&](auto change) {
-                    if(change.getAmount() != 0) {
-                        changing_ops.emplace_back(std::move(change));
-                    }
-                }},
-            std::move(op));
+    auto* resource = indices.get_allocator().resource();
+    OperationIndices creations{resource};
+    OperationIndices changing_ops{resource};
+
+    for(auto idx : indices) {
+        if(getAmount(ops[idx]) == 0) {
+            continue;
+        }
+
+        if(std::holds_alternative<UtilityTokenCreationOp>(ops[idx])) {
+            creations.push_back(idx);
+        } else {
+            changing_ops.push_back(idx);
+        }
     }
 
+    const auto burn_value_of = [&ops](auto idx) {
+        return std::visit(
+            [](const auto& op) {
+                return op.getBurnValue();
+            },
+            ops[idx]);
+    };
+
     //creations are only valid if the token does not already exist
     //on the other hand deletions and transfers are only valid
     //it the token already exists
@@ -231,12 +291,12 @@ auto UtilityTokenLookup::filterOperationsPerToken(const std::vector<std::byte>&
             std::max_element(
                 std::cbegin(creations),
                 std::cend(creations),
-                [](const auto& lhs, const auto& rhs) {
-                    return lhs.getBurnValue() < rhs.getBurnValue();
+                [&](auto lhs, auto rhs) {
+                    return burn_value_of(lhs) < burn_value_of(rhs);
                 });
 
         if(max_iter == std::cend(creations)) {
-            return {};
+            return OperationIndices{resource};
         }
 
         //if there are two or more operations
@@ -246,53 +306,56 @@ auto UtilityTokenLookup::filterOperationsPerToken(const std::vector<std::byte>&
         auto number_of_ops_with_max_burn =
             std::count_if(std::cbegin(creations),
                           std::cend(creations),
-                          [&max_iter](const auto& op) {
-                              return op.getBurnValue() >= max_iter->getBurnValue();
+                          [&](auto idx) {
+                              return burn_value_of(idx) >= burn_value_of(*max_iter);
                           });
 
         if(number_of_ops_with_max_burn > 1) {
-            return {};
+            return OperationIndices{resource};
         }
 
-        return {std::move(*max_iter)};
+        return OperationIndices{{*max_iter}, resource};
     }
 
     //group operations by creator
-    auto grouped = groupOperationsByCreator(std::move(changing_ops));
+    auto grouped = groupOperationsByCreator(ops, changing_ops);
 
-    std::vector<UtilityTokenOperation> ret_ops;
-    for(auto&& [creator, operations] : grouped) {
-        auto valid_ops =
+    OperationIndices ret_indices{resource};
+    for(auto&& [_, creator_indices] : grouped) {
+        const auto& creator = core::getCreator(ops[creator_indices.front()]);
+        auto valid_indices =
             extractRelevantOperations(creator,
                                       token_id,
-                                      std::move(operations));
-        std::move(std::begin(valid_ops),
-                  std::end(valid_ops),
-                  std::back_inserter(ret_ops));
+                                      ops,
+                                      std::move(creator_indices));
+        ret_indices.insert(std::end(ret_indices),
+                           std::begin(valid_indices),
+                           std::end(valid_indices));
     }
 
-    return ret_ops;
+    return ret_indices;
 }
 
 auto UtilityTokenLookup::extractRelevantOperations(const std::string& creator,
                                                    const std::vector<std::byte>& token,
-                                                   std::vector<core::UtilityTokenOperation>&& ops) const
-    -> std::vector<core::UtilityTokenOperation>
+                                                   const std::vector<core::UtilityTokenOperation>& ops,
+                                                   OperationIndices&& indices) const
+    -> OperationIndices
 {
     //sort by burn value
     //the operations with the highes burnvalue have the highest prioritys
-    std::sort(std::begin(ops),
-              std::end(ops),
-              [](const auto& lhs_v, const auto& rhs_v) {
+    std::sort(std::begin(indices),
+              std::end(indices),
+              [&ops](auto lhs_idx, auto rhs_idx) {
                   return std::visit(
                       [](const auto& lhs, const auto& rhs) {
                           return lhs.getBurnValue() > rhs.getBurnValue();
                       },
-                      lhs_v,
-                      rhs_v);
+                      ops[lhs_idx],
+                      ops[rhs_idx]);
               });
 
-    std::vector<UtilityTokenOperation> ret_vec;
+    OperationIndices ret_indices{indices.get_allocator()};
     std::uint64_t used{0};
     auto available_balance = getAvailableBalanceOf(creator, token);
 
@@ -303,19 +366,15 @@ auto UtilityTokenLookup::extractRelevantOperations(const std::string& creator,
     //2. the operation does not overflow the used amount of token
     //if one of those two things happen the valid operations until
     //one of those events happend will be returned
-    for(auto&& op : ops) {
-        auto new_added = std::visit(
-            [](const auto& operation) {
-                return operation.getAmount();
-            },
-            op);
+    for(auto idx : indices) {
+        auto new_added = getAmount(ops[idx]);
 
         //if a user trys to overflow his used amount
         //the operation which will overflow the amount
         //will be ignored and only the operations
         //until the overflow occurs will be executed
         if(!isSaveAddition(used, new_added)) {
-            return ret_vec;
+            return ret_indices;
         }
         //otherwise check if the the user has enough credit to perform
         //the operation and if so add it to the return vector
@@ -327,67 +386,48 @@ auto UtilityTokenLookup::extractRelevantOperations(const std::string& creator,
             break;
         }
 
-        ret_vec.emplace_back(std::move(op));
+        ret_indices.push_back(idx);
     }
 
-    return ret_vec;
+    return ret_indices;
 }
 
 
-auto UtilityTokenLookup::groupOperationsByToken(std::vector<UtilityTokenOperation>&& ops) const
-    -> std::map<std::vector<std::byte>,
-                std::vector<UtilityTokenOperation>>
+auto UtilityTokenLookup::groupOperationsByToken(const std::vector<UtilityTokenOperation>& ops,
+                                                std::pmr::memory_resource* resource) const
+    -> std::pmr::map<std::reference_wrapper<const std::vector<std::byte>>,
+                     OperationIndices,
+                     std::less<std::vector<std::byte>>>
 {
-    std::map<std::vector<std::byte>,
-             std::vector<UtilityTokenOperation>>
-        operations;
-
-    for(auto&& op : ops) {
-        std::visit(
-            [&](const auto& operation) {
-                const auto& token_id = operation.getUtilityToken().getId();
-                auto iter = operations.find(token_id);
-                if(iter != operations.end()) {
-                    iter
-                        ->second
-                        .emplace_back(std::move(operation));
-                } else {
-                    std::vector<UtilityTokenOperation> tmp_op{std::move(operation)};
-                    operations.emplace(token_id,
-                                       tmp_op);
-                }
-            },
-            std::move(op));
+    //the keys refer to the token ids inside of ops
+    std::pmr::map<std::reference_wrapper<const std::vector<std::byte>>,
+                  OperationIndices,
+                  std::less<std::vector<std::byte>>>
+        operations{resource};
+
+    for(std::size_t i = 0; i < ops.size(); i++) {
+        const auto& token_id = core::getUtilitToken(ops[i]).getId();
+        auto [iter, _] = operations.try_emplace(std::cref(token_id));
+        iter->second.push_back(i);
     }
 
     return operations;
 }
 
-auto UtilityTokenLookup::groupOperationsByCreator(std::vector<core::UtilityTokenOperation>&& ops) const
-    -> std::unordered_map<std::string,
-                          std::vector<UtilityTokenOperation>>
+auto UtilityTokenLookup::groupOperationsByCreator(const std::vector<core::UtilityTokenOperation>& ops,
+                                                  const OperationIndices& indices) const
+    -> std::pmr::unordered_map<std::string_view,
+                               OperationIndices>
 {
-    std::unordered_map<std::string,
-                       std::vector<UtilityTokenOperation>>
-        operations;
-
-    for(auto&& op : ops) {
-        std::visit(
-            [&](const auto& operation) {
-                const auto& creator = operation.getCreator();
-                auto iter = operations.find(creator);
-                if(iter != operations.end()) {
-                    iter
-                        ->second
-                        .emplace_back(std::move(operation));
-                } else {
-                    auto creator_copy = creator;
-                    UtilityTokenOperation tmp_op{std::move(operation)};
-                    operations.emplace(creator_copy,
-                                       std::vector{std::move(tmp_op)});
-                }
-            },
-            std::move(op));
+    //the keys refer to the creators inside of ops
+    std::pmr::unordered_map<std::string_view,
+                            OperationIndices>
+        operations{indices.get_allocator()};
+
+    for(auto idx : indices) {
+        std::string_view creator = core::getCreator(ops[idx]);
+        auto [iter, _] = operations.try_emplace(creator);
+        iter->second.push_back(idx);
     }
 
     return operations;
@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <metrics/Metrics.hpp>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+using forge::metrics::Counter;
+using forge::metrics::Gauge;
+using forge::metrics::Histogram;
+using forge::metrics::ScopedTimer;
+using forge::metrics::Registry;
+using forge::metrics::Labels;
+
+namespace {
+
+auto escapeLabelValue(const std::string& value)
+    -> std::string
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+
+    for(auto c : value) {
+        switch(c) {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+//{name="value",...} or an empty string if there are no labels,
+//extra is appended as last label if it is not empty
+auto formatLabels(const Labels& labels,
+                  const std::string& extra = {})
+    -> std::string
+{
+    if(labels.empty() && extra.empty()) {
+        return {};
+    }
+
+    std::string formatted = "{";
+    for(const auto& [name, value] : labels) {
+        if(formatted.size() > 1) {
+            formatted += ',';
+        }
+        formatted += fmt::format("{}=\"{}\"", name, escapeLabelValue(value));
+    }
+
+    if(!extra.empty()) {
+        if(formatted.size() > 1) {
+            formatted += ',';
+        }
+        formatted += extra;
+    }
+
+    formatted += '}';
+    return formatted;
+}
+
+auto appendHeader(std::string& out,
+                  const std::string& name,
+                  const std::string& help,
+                  const char* type)
+    -> void
+{
+    out += fmt::format("# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+}
+
+} // namespace
+
+auto Counter::increment(std::uint64_t value)
+    -> void
+{
+    value_.fetch_add(value, std::memory_order_relaxed);
+}
+
+auto Counter::get() const
+    -> std::uint64_t
+{
+    return value_.load(std::memory_order_relaxed);
+}
+
+auto Gauge::set(std::int64_t value)
+    -> void
+{
+    value_.store(value, std::memory_order_relaxed);
+}
+
+auto Gauge::add(std::int64_t value)
+    -> void
+{
+    value_.fetch_add(value, std::memory_order_relaxed);
+}
+
+auto Gauge::get() const
+    -> std::int64_t
+{
+    return value_.load(std::memory_order_relaxed);
+}
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds_(std::move(bounds))
+{
+    std::sort(std::begin(bounds_), std::end(bounds_));
+
+    bounds_ns_.reserve(bounds_.size());
+    for(auto bound : bounds_) {
+        bounds_ns_.push_back(static_cast<std::int64_t>(bound * 1e9));
+    }
+
+    buckets_ = std::make_unique<std::atomic_uint64_t[]>(bounds_.size() + 1);
+    for(std::size_t i = 0; i <= bounds_.size(); i++) {
+        buckets_[i].store(0);
+    }
+}
+
+auto Histogram::observe(std::chrono::nanoseconds duration)
+    -> void
+{
+    auto ns = std::max<std::int64_t>(duration.count(), 0);
+
+    auto bucket = std::lower_bound(std::begin(bounds_ns_),
+                                   std::end(bounds_ns_),
+                                   ns);
+    auto index = static_cast<std::size_t>(std::distance(std::begin(bounds_ns_), bucket));
+
+    buckets_[index].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(static_cast<std::uint64_t>(ns), std::memory_order_relaxed);
+}
+
+auto Histogram::getBounds() const
+    -> const std::vector<double>&
+{
+    return bounds_;
+}
+
+auto Histogram::getBucketCounts() const
+    -> std::vector<std::uint64_t>
+{
+    std::vector<std::uint64_t> counts;
+    counts.reserve(bounds_.size() + 1);
+    for(std::size_t i = 0; i <= bounds_.size(); i++) {
+        counts.push_back(buckets_[i].load(std::memory_order_relaxed));
+    }
+
+    return counts;
+}
+
+auto Histogram::getCount() const
+    -> std::uint64_t
+{
+    return count_.load(std::memory_order_relaxed);
+}
+
+auto Histogram::getSum() const
+    -> double
+{
+    return static_cast<double>(sum_ns_.load(std::memory_order_relaxed)) / 1e9;
+}
+
+ScopedTimer::ScopedTimer(Histogram& histogram)
+    : histogram_(histogram),
+      start_(std::chrono::steady_clock::now()) {}
+
+ScopedTimer::~ScopedTimer()
+{
+    histogram_.observe(std::chrono::steady_clock::now() - start_);
+}
+
+auto forge::metrics::defaultLatencyBounds()
+    -> std::vector<double>
+{
+    return {0.00005, 0.0001, 0.00025, 0.0005,
+            0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+            0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+}
+
+template<class T, class Factory>
+auto Registry::getOrCreate(std::map<std::string, Family<T>>& families,
+                           std::shared_mutex& mtx,
+                           const std::string& name,
+                           const std::string& help,
+                           const Labels& labels,
+                           Factory&& create)
+    -> T&
+{
+    {
+        std::shared_lock lock{mtx};
+        if(auto family = families.find(name);
+           family != std::end(families)) {
+            if(auto series = family->second.series.find(labels);
+               series != std::end(family->second.series)) {
+                return *series->second;
+            }
+        }
+    }
+
+    std::unique_lock lock{mtx};
+    auto& family = families[name];
+    if(family.help.empty()) {
+        family.help = help;
+    }
+
+    auto& series = family.series[labels];
+    if(!series) {
+        series = create();
+    }
+
+    return *series;
+}
+
+auto Registry::counter(const std::string& name,
+                       const std::string& help,
+                       const Labels& labels)
+    -> Counter&
+{
+    return getOrCreate(counters_, mtx_, name, help, labels, [] {
+        return std::make_unique<Counter>();
+    });
+}
+
+auto Registry::gauge(const std::string& name,
+                     const std::string& help,
+                     const Labels& labels)
+    -> Gauge&
+{
+    return getOrCreate(gauges_, mtx_, name, help, labels, [] {
+        return std::make_unique<Gauge>();
+    });
+}
+
+auto Registry::histogram(const std::string& name,
+                         const std::string& help,
+                         const Labels& labels,
+                         std::vector<double> bounds)
+    -> Histogram&
+{
+    return getOrCreate(histograms_, mtx_, name, help, labels, [&] {
+        return std::make_unique<Histogram>(std::move(bounds));
+    });
+}
+
+auto Registry::render() const
+    -> std::string
+{
+    std::shared_lock lock{mtx_};
+    std::string out;
+
+    for(const auto& [name, family] : counters_) {
+        appendHeader(out, name, family.help, "counter");
+        for(const auto& [labels, counter] : family.series) {
+            out += fmt::format("{}{} {}\n", name, formatLabels(labels), counter->get());
+        }
+    }
+
+    for(const auto& [name, family] : gauges_) {
+        appendHeader(out, name, family.help, "gauge");
+        for(const auto& [labels, gauge] : family.series) {
+            out += fmt::format("{}{} {}\n", name, formatLabels(labels), gauge->get());
+        }
+    }
+
+    for(const auto& [name, family] : histograms_) {
+        appendHeader(out, name, family.help, "histogram");
+        for(const auto& [labels, histogram] : family.series) {
+            const auto& bounds = histogram->getBounds();
+            auto counts = histogram->getBucketCounts();
+
+            //buckets are cumulative in the exposition format
+            std::uint64_t cumulative = 0;
+            for(std::size_t i = 0; i < bounds.size(); i++) {
+                cumulative += counts[i];
+                out += fmt::format("{}_bucket{} {}\n",
+                                   name,
+                                   formatLabels(labels, fmt::format("le=\"{}\"", bounds[i])),
+                                   cumulative);
+            }
+            cumulative += counts.back();
+            out += fmt::format("{}_bucket{} {}\n",
+                               name,
+                               formatLabels(labels, "le=\"+Inf\""),
+                               cumulative);
+
+            out += fmt::format("{}_sum{} {}\n", name, formatLabels(labels), histogram->getSum());
+            out += fmt::format("{}_count{} {}\n", name, formatLabels(labels), cumulative);
+        }
+    }
+
+    return out;
+}
+
+auto forge::metrics::getRegistry()
+    -> Registry&
+{
+    static Registry registry;
+    return registry;
+}
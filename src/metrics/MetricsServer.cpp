@@ -0,0 +1,213 @@
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fmt/core.h>
+#include <g3log/g3log.hpp>
+#include <metrics/Metrics.hpp>
+#include <metrics/MetricsError.hpp>
+#include <metrics/MetricsServer.hpp>
+#include <netinet/in.h>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <utils/Result.hpp>
+
+using forge::metrics::MetricsServer;
+using forge::metrics::MetricsError;
+using forge::metrics::Registry;
+
+namespace {
+
+//the acceptor checks for a stop request after this timeout
+constexpr timeval SOCKET_TIMEOUT{0, 200000};
+//scrapers send small requests, everything above is rejected
+constexpr std::size_t MAX_REQUEST_SIZE = 8 * 1024;
+
+auto isTimeout(int error)
+    -> bool
+{
+    return error == EAGAIN
+        || error == EWOULDBLOCK
+        || error == EINTR;
+}
+
+auto writeAll(int connection, std::string_view data)
+    -> void
+{
+    while(!data.empty()) {
+        auto sent = send(connection, data.data(), data.size(), MSG_NOSIGNAL);
+        if(sent < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        data.remove_prefix(static_cast<std::size_t>(sent));
+    }
+}
+
+auto makeResponse(std::string_view status,
+                  std::string_view body)
+    -> std::string
+{
+    return fmt::format("HTTP/1.1 {}\r\n"
+                       "Content-Type: text/plain; version=0.0.4\r\n"
+                       "Content-Length: {}\r\n"
+                       "Connection: close\r\n"
+                       "\r\n"
+                       "{}",
+                       status,
+                       body.size(),
+                       body);
+}
+
+} // namespace
+
+MetricsServer::MetricsServer(const Registry& registry)
+    : registry_(registry) {}
+
+MetricsServer::~MetricsServer()
+{
+    stop();
+}
+
+auto MetricsServer::start(std::uint16_t port)
+    -> utils::Result<void, MetricsError>
+{
+    if(running_.load()) {
+        return MetricsError{"metrics server is already running"};
+    }
+
+    auto error = [this](auto&& what) {
+        auto message = fmt::format("{}: {}", what, std::strerror(errno));
+        close(socket_);
+        socket_ = -1;
+        return MetricsError{std::move(message)};
+    };
+
+    socket_ = socket(AF_INET, SOCK_STREAM, 0);
+    if(socket_ < 0) {
+        return error("unable to create metrics socket");
+    }
+
+    int reuse = 1;
+    if(setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0
+       || setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &SOCKET_TIMEOUT, sizeof(SOCKET_TIMEOUT)) < 0) {
+        return error("unable to configure metrics socket");
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+
+    if(bind(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        return error(fmt::format("unable to bind metrics socket to port {}", port));
+    }
+
+    if(listen(socket_, SOMAXCONN) < 0) {
+        return error("unable to listen on metrics socket");
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(socket_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    running_.store(true);
+    acceptor_ = std::thread{[this] {
+        acceptConnections();
+    }};
+
+    LOG(INFO) << fmt::format("metrics server listening on 127.0.0.1:{}", port_);
+
+    return {};
+}
+
+auto MetricsServer::stop()
+    -> void
+{
+    running_.store(false);
+
+    if(acceptor_.joinable()) {
+        acceptor_.join();
+    }
+
+    if(socket_ >= 0) {
+        close(socket_);
+        socket_ = -1;
+    }
+}
+
+auto MetricsServer::getPort() const
+    -> std::uint16_t
+{
+    return port_;
+}
+
+auto MetricsServer::acceptConnections()
+    -> void
+{
+    while(running_.load()) {
+        auto connection = accept(socket_, nullptr, nullptr);
+        if(connection < 0) {
+            if(isTimeout(errno) || errno == ECONNABORTED) {
+                continue;
+            }
+            LOG(WARNING) << "metrics server stopped accepting: " << std::strerror(errno);
+            return;
+        }
+
+        setsockopt(connection,
+                   SOL_SOCKET,
+                   SO_RCVTIMEO,
+                   &SOCKET_TIMEOUT,
+                   sizeof(SOCKET_TIMEOUT));
+
+        handleConnection(connection);
+        close(connection);
+    }
+}
+
+auto MetricsServer::handleConnection(int connection)
+    -> void
+{
+    //only the request line matters, so the headers are read
+    //until their end and the body of the request is ignored
+    std::string request;
+    char buffer[1024];
+
+    while(request.find("\r\n\r\n") == std::string::npos) {
+        auto received = recv(connection, buffer, sizeof(buffer), 0);
+        if(received < 0 && errno == EINTR) {
+            continue;
+        }
+        if(received <= 0) {
+            return;
+        }
+
+        request.append(buffer, static_cast<std::size_t>(received));
+        if(request.size() > MAX_REQUEST_SIZE) {
+            writeAll(connection, makeResponse("431 Request Header Fields Too Large", ""));
+            return;
+        }
+    }
+
+    std::string_view line{request.data(), request.find("\r\n")};
+    if(line.substr(0, 4) != "GET ") {
+        writeAll(connection, makeResponse("405 Method Not Allowed", ""));
+        return;
+    }
+
+    auto target = line.substr(4, line.find(' ', 4) - 4);
+    if(target != "/metrics" && target != "/") {
+        writeAll(connection, makeResponse("404 Not Found", ""));
+        return;
+    }
+
+    writeAll(connection, makeResponse("200 OK", registry_.render()));
+}
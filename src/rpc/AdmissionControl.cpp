@@ -0,0 +1,406 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <fmt/core.h>
+#include <iterator>
+#include <metrics/Metrics.hpp>
+#include <mutex>
+#include <rpc/AdmissionControl.hpp>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+using forge::rpc::AdmissionController;
+using forge::rpc::AdmissionLimits;
+using forge::rpc::AdmissionRejected;
+using forge::rpc::NoWaitScope;
+using forge::rpc::Priority;
+using forge::rpc::PriorityStats;
+using forge::rpc::NUMBER_OF_PRIORITIES;
+
+namespace {
+
+thread_local bool no_wait = false;
+
+auto indexOf(Priority priority)
+    -> std::size_t
+{
+    return static_cast<std::size_t>(priority);
+}
+
+//0 means no limit
+auto belowLimit(std::size_t value, std::size_t limit)
+    -> bool
+{
+    return limit == 0 || value < limit;
+}
+
+auto rejections(Priority priority, const char* reason)
+    -> forge::metrics::Counter&
+{
+    return forge::metrics::getRegistry()
+        .counter("forge_rpc_admission_rejected_total",
+                 "Rpc requests which were not admitted",
+                 {{"class", std::string{forge::rpc::priorityToString(priority)}},
+                  {"reason", reason}});
+}
+
+} // namespace
+
+auto forge::rpc::priorityToString(Priority priority)
+    -> std::string_view
+{
+    switch(priority) {
+    case Priority::Lookup:
+        return "lookup";
+    case Priority::WalletRead:
+        return "walletread";
+    case Priority::WalletWrite:
+        return "walletwrite";
+    }
+
+    return "unknown";
+}
+
+auto forge::rpc::priorityOf(std::string_view method)
+    -> Priority
+{
+    static const std::unordered_set<std::string_view> lookups{
+        "lookupumvalue",
+        "lookupuniquevalue",
+        "lookupowner",
+        "lookupactivationblock",
+        "lookupmany",
+        "lookupallentrysof",
+        "lookupallentrysofpaged",
+        "checkvalidity",
+        "getlastvalidblockheight",
+        "getbalanceof",
+        "getbalances",
+        "getutilitytokensof",
+        "getutilitytokensofpaged",
+        "getsupplyofutilitytoken"};
+
+    static const std::unordered_set<std::string_view> wallet_reads{
+        "getownedumentrys",
+        "getwatchonlyumentrys",
+        "getallwatchedumentrys",
+        "getallwatchedumentryspaged",
+        "getowneduniqueentrys",
+        "getwatchonlyuniqueentrys",
+        "getallwatcheduniqueentrys",
+        "getallwatcheduniqueentryspaged",
+        "getwatchedaddresses",
+        "getownedaddresses",
+        "ownesaddress",
+        "getownedutilitytokens",
+        "getwatchonlyutilitytokens",
+        "getallwatchedutilitytokens",
+        "getallwatchedutilitytokenspaged",
+        "submitjob"};
+
+    if(lookups.count(method) > 0) {
+        return Priority::Lookup;
+    }
+    if(wallet_reads.count(method) > 0) {
+        return Priority::WalletRead;
+    }
+
+    return Priority::WalletWrite;
+}
+
+auto forge::rpc::isAdmissionExempt(std::string_view method)
+    -> bool
+{
+    return method == "shutdown"
+        || method == "getresponsecachestats"
+        || method == "getadmissionstats"
+        || method == "getjobstatus";
+}
+
+auto forge::rpc::isLongPoll(std::string_view method)
+    -> bool
+{
+    return method == "getchangessince"
+        || method == "waitjob";
+}
+
+NoWaitScope::NoWaitScope()
+    : was_active_(std::exchange(no_wait, true)) {}
+
+NoWaitScope::~NoWaitScope()
+{
+    no_wait = was_active_;
+}
+
+auto NoWaitScope::isActive()
+    -> bool
+{
+    return no_wait;
+}
+
+AdmissionController::Permit::Permit(AdmissionController* controller,
+                                    Priority priority,
+                                    std::string method)
+    : controller_(controller),
+      priority_(priority),
+      method_(std::move(method)) {}
+
+AdmissionController::Permit::Permit(Permit&& other) noexcept
+    : controller_(std::exchange(other.controller_, nullptr)),
+      priority_(other.priority_),
+      method_(std::move(other.method_)) {}
+
+AdmissionController::Permit::~Permit()
+{
+    if(controller_ != nullptr) {
+        controller_->release(priority_, method_);
+    }
+}
+
+AdmissionController::AdmissionController(AdmissionLimits limits)
+    : limits_(std::move(limits)) {}
+
+auto AdmissionController::admit(std::string_view method)
+    -> Permit
+{
+    if(isLongPoll(method)) {
+        return admitLongPoll(method);
+    }
+
+    auto priority = priorityOf(method);
+    auto& stats = stats_[indexOf(priority)];
+    auto deadline = std::chrono::steady_clock::now() + limits_.queue_timeout;
+
+    std::unique_lock lock{mtx_};
+
+    //the request is queued behind all requests of the same
+    //or a higher priority
+    auto position = [&] {
+        return std::find_if(std::begin(queue_),
+                            std::end(queue_),
+                            [&](const auto* waiter) {
+                                return waiter->priority > priority;
+                            });
+    };
+
+    //nobody queued before the request could start, so it takes the slot
+    //without queueing, which is the common case when not under load
+    if(canStart(priority, method)
+       && std::none_of(std::begin(queue_),
+                       position(),
+                       [&](const auto* waiter) {
+                           return canStart(waiter->priority, waiter->method);
+                       })) {
+        return start(priority, method);
+    }
+
+    if(no_wait) {
+        stats.rejected++;
+        rejections(priority, "nowait").increment();
+        throw AdmissionRejected{
+            fmt::format("server overloaded, no free slot for {}", method)};
+    }
+
+    if(queue_.size() >= limits_.max_queued && !shedFor(priority)) {
+        stats.rejected++;
+        rejections(priority, "queuefull").increment();
+        throw AdmissionRejected{
+            fmt::format("server overloaded, {} requests are already waiting",
+                        queue_.size())};
+    }
+
+    //shedding could have removed the waiter the position pointed to
+    Waiter waiter{priority, method, false};
+    auto iter = queue_.insert(position(), &waiter);
+    stats.queued++;
+
+    auto admitted = slot_freed_.wait_until(lock, deadline, [&] {
+        return waiter.shed
+            || (canStart(priority, method) && isNext(iter));
+    });
+
+    if(waiter.shed) {
+        //the waiter was already removed from the queue
+        throw AdmissionRejected{"server overloaded, request was dropped for a more important one"};
+    }
+
+    queue_.erase(iter);
+    stats.queued--;
+
+    if(!admitted) {
+        stats.timed_out++;
+        rejections(priority, "timeout").increment();
+
+        //the next waiter could be able to start now
+        slot_freed_.notify_all();
+        throw AdmissionRejected{
+            fmt::format("server overloaded, no slot for {} within {}ms",
+                        method,
+                        limits_.queue_timeout.count())};
+    }
+
+    return start(priority, method);
+}
+
+auto AdmissionController::admitJob(std::string_view method)
+    -> Permit
+{
+    if(isLongPoll(method)) {
+        return admitLongPoll(method);
+    }
+
+    auto priority = priorityOf(method);
+
+    std::unique_lock lock{mtx_};
+    slot_freed_.wait(lock, [&] {
+        return canStart(priority, method)
+            && isNext(std::cend(queue_));
+    });
+
+    return start(priority, method);
+}
+
+auto AdmissionController::getStats() const
+    -> std::array<PriorityStats, NUMBER_OF_PRIORITIES>
+{
+    std::unique_lock lock{mtx_};
+    return stats_;
+}
+
+auto AdmissionController::getLongPolls() const
+    -> std::size_t
+{
+    std::unique_lock lock{mtx_};
+    return long_polls_;
+}
+
+auto AdmissionController::getLimits() const
+    -> const AdmissionLimits&
+{
+    return limits_;
+}
+
+auto AdmissionController::canStart(Priority priority,
+                                   std::string_view method) const
+    -> bool
+{
+    if(!belowLimit(in_flight_, limits_.max_concurrent)) {
+        return false;
+    }
+
+    if(!belowLimit(stats_[indexOf(priority)].in_flight,
+                   limits_.class_limits[indexOf(priority)])) {
+        return false;
+    }
+
+    auto limit = limits_.method_limits.find(method);
+    if(limit == std::end(limits_.method_limits)) {
+        return true;
+    }
+
+    auto running = method_in_flight_.find(method);
+    return running == std::end(method_in_flight_)
+        || running->second < limit->second;
+}
+
+auto AdmissionController::isNext(std::list<Waiter*>::const_iterator waiter) const
+    -> bool
+{
+    return std::none_of(std::cbegin(queue_),
+                        waiter,
+                        [&](const auto* other) {
+                            return canStart(other->priority, other->method);
+                        });
+}
+
+auto AdmissionController::admitLongPoll(std::string_view method)
+    -> Permit
+{
+    auto priority = priorityOf(method);
+
+    std::unique_lock lock{mtx_};
+
+    //a long-poll holds the thread it runs on until it times out, so too
+    //many of them would leave no threads for the other requests
+    if(!belowLimit(long_polls_, limits_.max_long_polls)) {
+        rejections(priority, "longpolls").increment();
+        throw AdmissionRejected{
+            fmt::format("server overloaded, {} long-polls are already waiting",
+                        long_polls_)};
+    }
+
+    long_polls_++;
+
+    return Permit{this, priority, std::string{method}};
+}
+
+auto AdmissionController::shedFor(Priority priority)
+    -> bool
+{
+    //the queue is ordered, so the newest waiter
+    //of the lowest priority is the last one
+    if(queue_.empty() || queue_.back()->priority <= priority) {
+        return false;
+    }
+
+    auto* victim = queue_.back();
+    queue_.pop_back();
+
+    auto& stats = stats_[indexOf(victim->priority)];
+    stats.queued--;
+    stats.shed++;
+    rejections(victim->priority, "shed").increment();
+
+    victim->shed = true;
+    slot_freed_.notify_all();
+
+    return true;
+}
+
+auto AdmissionController::start(Priority priority,
+                                std::string_view method)
+    -> Permit
+{
+    auto& stats = stats_[indexOf(priority)];
+    stats.in_flight++;
+    stats.admitted++;
+    in_flight_++;
+
+    //only methods with a limit are counted
+    if(limits_.method_limits.count(method) > 0) {
+        auto running = method_in_flight_.find(method);
+        if(running == std::end(method_in_flight_)) {
+            running = method_in_flight_.emplace(std::string{method}, 0).first;
+        }
+        running->second++;
+    }
+
+    return Permit{this, priority, std::string{method}};
+}
+
+auto AdmissionController::release(Priority priority,
+                                  const std::string& method)
+    -> void
+{
+    if(isLongPoll(method)) {
+        std::unique_lock lock{mtx_};
+        long_polls_--;
+        return;
+    }
+
+    {
+        std::unique_lock lock{mtx_};
+        stats_[indexOf(priority)].in_flight--;
+        in_flight_--;
+
+        if(auto running = method_in_flight_.find(method);
+           running != std::end(method_in_flight_)) {
+            running->second--;
+        }
+    }
+
+    slot_freed_.notify_all();
+}
@@ -0,0 +1,727 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fmt/core.h>
+#include <g3log/g3log.hpp>
+#include <iterator>
+#include <netinet/in.h>
+#include <rpc/AdmissionControl.hpp>
+#include <rpc/EpollHttpServer.hpp>
+#include <string>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unordered_set>
+#include <utils/Opt.hpp>
+#include <utils/WorkerPool.hpp>
+#include <vector>
+
+using forge::rpc::EpollHttpServer;
+using forge::rpc::HttpRequest;
+using forge::rpc::HttpParseStatus;
+
+namespace {
+
+//epoll ids of the non connection file descriptors
+constexpr std::uint64_t LISTEN_ID = 0;
+constexpr std::uint64_t WAKEUP_ID = 1;
+constexpr std::uint64_t FIRST_CONNECTION_ID = 2;
+
+constexpr std::size_t MAX_EVENTS = 64;
+constexpr std::size_t READ_SIZE = 64 * 1024;
+constexpr std::size_t MAX_HEADER_SIZE = 8 * 1024;
+constexpr std::size_t MAX_BODY_SIZE = 16 * 1024 * 1024;
+
+//the io threads check for a stop request after this timeout
+constexpr int EPOLL_TIMEOUT_MS = 200;
+
+auto equalsIgnoreCase(std::string_view lhs, std::string_view rhs)
+    -> bool
+{
+    return std::equal(lhs.begin(), lhs.end(),
+                      rhs.begin(), rhs.end(),
+                      [](char l, char r) {
+                          return std::tolower(static_cast<unsigned char>(l))
+                              == std::tolower(static_cast<unsigned char>(r));
+                      });
+}
+
+auto trim(std::string_view str)
+    -> std::string_view
+{
+    while(!str.empty() && (str.front() == ' ' || str.front() == '\t')) {
+        str.remove_prefix(1);
+    }
+    while(!str.empty() && (str.back() == ' ' || str.back() == '\t')) {
+        str.remove_suffix(1);
+    }
+    return str;
+}
+
+auto statusText(int status)
+    -> std::string_view
+{
+    switch(status) {
+    case 200:
+        return "OK";
+    case 400:
+        return "Bad Request";
+    case 405:
+        return "Method Not Allowed";
+    case 413:
+        return "Payload Too Large";
+    case 501:
+        return "Not Implemented";
+    case 503:
+        return "Service Unavailable";
+    default:
+        return "Internal Server Error";
+    }
+}
+
+auto appendHttpResponse(std::string& output,
+                        int status,
+                        std::string_view body,
+                        bool keep_alive)
+    -> void
+{
+    output += fmt::format("HTTP/1.1 {} {}\r\n"
+                          "Content-Type: application/json\r\n"
+                          "Content-Length: {}\r\n"
+                          "Connection: {}\r\n\r\n",
+                          status,
+                          statusText(status),
+                          body.size(),
+                          keep_alive ? "keep-alive" : "close");
+    output.append(body);
+}
+
+auto toHttpStatus(HttpParseStatus status)
+    -> int
+{
+    switch(status) {
+    case HttpParseStatus::MethodNotAllowed:
+        return 405;
+    case HttpParseStatus::PayloadTooLarge:
+        return 413;
+    case HttpParseStatus::NotImplemented:
+        return 501;
+    default:
+        return 400;
+    }
+}
+
+} // namespace
+
+auto forge::rpc::parseHttpRequest(std::string_view buffer,
+                                  std::size_t max_body_size)
+    -> HttpRequest
+{
+    auto fail = [](HttpParseStatus status) {
+        return HttpRequest{status, {}, {}, false, 0};
+    };
+
+    auto header_end = buffer.find("\r\n\r\n");
+    if(header_end == std::string_view::npos) {
+        return buffer.size() > MAX_HEADER_SIZE
+            ? fail(HttpParseStatus::PayloadTooLarge)
+            : fail(HttpParseStatus::Incomplete);
+    }
+
+    auto header = buffer.substr(0, header_end);
+    auto line_end = header.find("\r\n");
+    auto request_line = header.substr(0, line_end);
+
+    auto method_end = request_line.find(' ');
+    auto version_start = request_line.rfind(' ');
+    if(method_end == std::string_view::npos || version_start == method_end) {
+        return fail(HttpParseStatus::BadRequest);
+    }
+
+    auto version = request_line.substr(version_start + 1);
+    if(version != "HTTP/1.1" && version != "HTTP/1.0") {
+        return fail(HttpParseStatus::BadRequest);
+    }
+
+    if(request_line.substr(0, method_end) != "POST") {
+        return fail(HttpParseStatus::MethodNotAllowed);
+    }
+
+    //http/1.0 closes connections unless asked otherwise
+    auto keep_alive = version == "HTTP/1.1";
+    utils::Opt<std::size_t> content_length;
+
+    while(line_end != std::string_view::npos) {
+        header.remove_prefix(line_end + 2);
+        line_end = header.find("\r\n");
+        auto line = header.substr(0, line_end);
+
+        auto colon = line.find(':');
+        if(colon == std::string_view::npos) {
+            return fail(HttpParseStatus::BadRequest);
+        }
+
+        auto name = trim(line.substr(0, colon));
+        auto value = trim(line.substr(colon + 1));
+
+        if(equalsIgnoreCase(name, "content-length")) {
+            std::size_t length = 0;
+            if(value.empty() || value.size() > 18) {
+                return fail(HttpParseStatus::BadRequest);
+            }
+            for(auto c : value) {
+                if(c < '0' || c > '9') {
+                    return fail(HttpParseStatus::BadRequest);
+                }
+                length = length * 10 + static_cast<std::size_t>(c - '0');
+            }
+            content_length = length;
+        } else if(equalsIgnoreCase(name, "transfer-encoding")) {
+            return fail(HttpParseStatus::NotImplemented);
+        } else if(equalsIgnoreCase(name, "connection")) {
+            if(equalsIgnoreCase(value, "close")) {
+                keep_alive = false;
+            } else if(equalsIgnoreCase(value, "keep-alive")) {
+                keep_alive = true;
+            }
+        }
+    }
+
+    if(!content_length) {
+        return fail(HttpParseStatus::BadRequest);
+    }
+
+    auto body_size = content_length.getValue();
+    if(body_size > max_body_size) {
+        return fail(HttpParseStatus::PayloadTooLarge);
+    }
+
+    auto body_start = header_end + 4;
+    if(buffer.size() - body_start < body_size) {
+        return fail(HttpParseStatus::Incomplete);
+    }
+
+    auto target_start = method_end + 1;
+    auto target = request_line.substr(target_start, version_start - target_start);
+
+    return HttpRequest{HttpParseStatus::Complete,
+                       target,
+                       buffer.substr(body_start, body_size),
+                       keep_alive,
+                       body_start + body_size};
+}
+
+auto forge::rpc::extractRpcMethod(std::string_view body)
+    -> utils::Opt<std::string_view>
+{
+    constexpr std::string_view whitespace{" \t\r\n"};
+
+    auto start = body.find_first_not_of(whitespace);
+    if(start == std::string_view::npos || body[start] != '{') {
+        return std::nullopt;
+    }
+
+    //the first "method" member is taken, even if it is nested in
+    //the params. this only decides where the request is executed
+    auto member = body.find(R"("method")");
+    if(member == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    auto colon = body.find_first_not_of(whitespace, member + 8);
+    if(colon == std::string_view::npos || body[colon] != ':') {
+        return std::nullopt;
+    }
+
+    auto quote = body.find_first_not_of(whitespace, colon + 1);
+    if(quote == std::string_view::npos || body[quote] != '"') {
+        return std::nullopt;
+    }
+
+    auto end = body.find('"', quote + 1);
+    if(end == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    return body.substr(quote + 1, end - quote - 1);
+}
+
+auto forge::rpc::isInlineRpcMethod(std::string_view method)
+    -> bool
+{
+    //methods which never talk to the node
+    static const std::unordered_set<std::string_view> inline_methods{
+        "lookupumvalue",
+        "lookupuniquevalue",
+        "lookupowner",
+        "lookupactivationblock",
+        "lookupmany",
+        "lookupallentrysof",
+        "lookupallentrysofpaged",
+        "getresponsecachestats",
+        "getownedumentrys",
+        "getwatchonlyumentrys",
+        "getallwatchedumentrys",
+        "getallwatchedumentryspaged",
+        "getowneduniqueentrys",
+        "getwatchonlyuniqueentrys",
+        "getallwatcheduniqueentrys",
+        "getallwatcheduniqueentryspaged",
+        "getwatchedaddresses",
+        "getownedaddresses",
+        "ownesaddress",
+        "getbalanceof",
+        "getbalances",
+        "getutilitytokensof",
+        "getutilitytokensofpaged",
+        "getsupplyofutilitytoken",
+        "getownedutilitytokens",
+        "getwatchonlyutilitytokens",
+        "getallwatchedutilitytokens",
+        "getallwatchedutilitytokenspaged"};
+
+    return inline_methods.count(method) > 0;
+}
+
+EpollHttpServer::EpollHttpServer(std::uint16_t port,
+                                 std::size_t number_of_io_threads,
+                                 std::size_t number_of_workers,
+                                 std::size_t max_queued_requests,
+                                 InlinePredicate runs_inline)
+    : port_(port),
+      number_of_io_threads_(std::max<std::size_t>(number_of_io_threads, 1)),
+      number_of_workers_(std::max<std::size_t>(number_of_workers, 1)),
+      max_queued_requests_(max_queued_requests),
+      runs_inline_(std::move(runs_inline)) {}
+
+EpollHttpServer::~EpollHttpServer()
+{
+    StopListening();
+}
+
+auto EpollHttpServer::StartListening()
+    -> bool
+{
+    if(running_.load()) {
+        return false;
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if(listen_fd_ < 0) {
+        LOG(WARNING) << "unable to create rpc socket: " << std::strerror(errno);
+        return false;
+    }
+
+    int enable = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port_);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if(bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+       || listen(listen_fd_, SOMAXCONN) < 0) {
+        LOG(WARNING) << "unable to listen on rpc port " << port_ << ": " << std::strerror(errno);
+        closeAll();
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    for(std::size_t i = 0; i < number_of_io_threads_; i++) {
+        auto io = std::make_unique<IoThread>();
+        io->epoll_fd = epoll_create1(0);
+        io->wakeup_fd = eventfd(0, EFD_NONBLOCK);
+        if(io->epoll_fd < 0 || io->wakeup_fd < 0) {
+            LOG(WARNING) << "unable to create rpc event loop: " << std::strerror(errno);
+            io_threads_.push_back(std::move(io));
+            closeAll();
+            return false;
+        }
+
+        //every io thread waits on the listening socket,
+        //the kernel wakes only one of them per connection
+        epoll_event listen_event{};
+        listen_event.events = EPOLLIN | EPOLLEXCLUSIVE;
+        listen_event.data.u64 = LISTEN_ID;
+        epoll_ctl(io->epoll_fd, EPOLL_CTL_ADD, listen_fd_, &listen_event);
+
+        epoll_event wakeup_event{};
+        wakeup_event.events = EPOLLIN;
+        wakeup_event.data.u64 = WAKEUP_ID;
+        epoll_ctl(io->epoll_fd, EPOLL_CTL_ADD, io->wakeup_fd, &wakeup_event);
+
+        io_threads_.push_back(std::move(io));
+    }
+
+    workers_ = std::make_unique<utils::WorkerPool>(number_of_workers_,
+                                                   max_queued_requests_);
+
+    running_.store(true);
+    for(auto& io : io_threads_) {
+        io->thread = std::thread{[this, &io = *io] {
+            runIoThread(io);
+        }};
+    }
+
+    return true;
+}
+
+auto EpollHttpServer::StopListening()
+    -> bool
+{
+    running_.store(false);
+
+    //running jobs still post their results,
+    //so the workers are stopped first
+    if(workers_) {
+        workers_->stop();
+    }
+
+    for(auto& io : io_threads_) {
+        if(io->thread.joinable()) {
+            io->thread.join();
+        }
+    }
+
+    closeAll();
+
+    return true;
+}
+
+auto EpollHttpServer::getPort() const
+    -> std::uint16_t
+{
+    return port_;
+}
+
+auto EpollHttpServer::SetUrlHandler(const std::string& url,
+                                    jsonrpc::IClientConnectionHandler* handler)
+    -> void
+{
+    url_handlers_[url] = handler;
+}
+
+auto EpollHttpServer::runIoThread(IoThread& io)
+    -> void
+{
+    std::array<epoll_event, MAX_EVENTS> events;
+
+    //requests handled inline are rejected if they do not get a slot at
+    //once, waiting for one would stall all connections of the thread
+    NoWaitScope no_wait;
+
+    while(running_.load()) {
+        auto number_of_events = epoll_wait(io.epoll_fd,
+                                           events.data(),
+                                           events.size(),
+                                           EPOLL_TIMEOUT_MS);
+
+        for(int i = 0; i < number_of_events; i++) {
+            auto id = events[i].data.u64;
+
+            if(id == LISTEN_ID) {
+                acceptConnections(io);
+                continue;
+            }
+
+            if(id == WAKEUP_ID) {
+                std::uint64_t counter;
+                while(read(io.wakeup_fd, &counter, sizeof(counter)) > 0) {}
+                processCompletions(io);
+                continue;
+            }
+
+            auto iter = io.connections.find(id);
+            if(iter == io.connections.end()) {
+                continue;
+            }
+
+            auto& connection = iter->second;
+
+            //with a hangup in both directions nothing can be delivered anymore
+            if((events[i].events & (EPOLLERR | EPOLLHUP)) != 0) {
+                closeConnection(io, id);
+                continue;
+            }
+
+            if((events[i].events & EPOLLOUT) != 0) {
+                flush(io, id, connection);
+                if(io.connections.count(id) == 0) {
+                    continue;
+                }
+            }
+
+            if((events[i].events & (EPOLLIN | EPOLLRDHUP)) != 0) {
+                readFrom(io, id, connection);
+            }
+        }
+    }
+}
+
+auto EpollHttpServer::acceptConnections(IoThread& io)
+    -> void
+{
+    while(true) {
+        auto fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK);
+        if(fd < 0) {
+            return;
+        }
+
+        auto id = FIRST_CONNECTION_ID + next_connection_id_++;
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = id;
+        if(epoll_ctl(io.epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+
+        Connection connection{fd, {}, {}};
+        connection.events = event.events;
+        io.connections.emplace(id, std::move(connection));
+    }
+}
+
+auto EpollHttpServer::readFrom(IoThread& io,
+                               std::uint64_t id,
+                               Connection& connection)
+    -> void
+{
+    auto offset = connection.input.size();
+    connection.input.resize(offset + READ_SIZE);
+
+    auto received = recv(connection.fd,
+                         connection.input.data() + offset,
+                         READ_SIZE,
+                         0);
+
+    if(received < 0) {
+        connection.input.resize(offset);
+        if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            closeConnection(io, id);
+        }
+        return;
+    }
+
+    //the peer will not send anything else, but still
+    //gets the responses which are pending
+    if(received == 0) {
+        connection.input.resize(offset);
+        connection.peer_closed = true;
+        connection.close_after_write = true;
+        flush(io, id, connection);
+        return;
+    }
+
+    connection.input.resize(offset + static_cast<std::size_t>(received));
+
+    processRequests(io, id, connection);
+}
+
+auto EpollHttpServer::processRequests(IoThread& io,
+                                      std::uint64_t id,
+                                      Connection& connection)
+    -> void
+{
+    std::size_t consumed = 0;
+
+    //pipelined requests are answered in order, so nothing after
+    //a request which is processed by a worker is touched until
+    //its response was written
+    while(!connection.waiting_for_worker && !connection.close_after_write) {
+        auto request = parseHttpRequest(std::string_view{connection.input}.substr(consumed),
+                                        MAX_BODY_SIZE);
+
+        if(request.status == HttpParseStatus::Incomplete) {
+            break;
+        }
+
+        if(request.status != HttpParseStatus::Complete) {
+            appendHttpResponse(connection.output, toHttpStatus(request.status), "", false);
+            connection.close_after_write = true;
+            break;
+        }
+
+        consumed += request.size;
+        connection.close_after_write = !request.keep_alive;
+
+        auto method = extractRpcMethod(request.body);
+        auto runs_inline = method.hasValue()
+            ? runs_inline_(method.getValue())
+            : false;
+
+        if(runs_inline) {
+            std::string response;
+            handle(request.target, std::string{request.body}, response);
+            appendHttpResponse(connection.output, 200, response, request.keep_alive);
+            continue;
+        }
+
+        auto submitted = workers_->trySubmit(
+            [this, &io, id, target = std::string{request.target}, body = std::string{request.body}] {
+                std::string response;
+                handle(target, body, response);
+
+                {
+                    std::unique_lock lock{io.completed_mtx};
+                    io.completed.emplace_back(id, std::move(response));
+                }
+
+                std::uint64_t one = 1;
+                write(io.wakeup_fd, &one, sizeof(one));
+            });
+
+        if(submitted) {
+            connection.waiting_for_worker = true;
+        } else {
+            appendHttpResponse(connection.output, 503, "", request.keep_alive);
+        }
+    }
+
+    connection.input.erase(0, consumed);
+
+    flush(io, id, connection);
+}
+
+auto EpollHttpServer::processCompletions(IoThread& io)
+    -> void
+{
+    std::vector<std::pair<std::uint64_t, std::string>> completed;
+    {
+        std::unique_lock lock{io.completed_mtx};
+        completed.swap(io.completed);
+    }
+
+    for(auto& [id, response] : completed) {
+        auto iter = io.connections.find(id);
+        if(iter == io.connections.end()) {
+            continue;
+        }
+
+        auto& connection = iter->second;
+        appendHttpResponse(connection.output,
+                           200,
+                           response,
+                           !connection.close_after_write);
+        connection.waiting_for_worker = false;
+
+        //continue with the requests which were pipelined behind
+        processRequests(io, id, connection);
+    }
+}
+
+auto EpollHttpServer::flush(IoThread& io,
+                            std::uint64_t id,
+                            Connection& connection)
+    -> void
+{
+    while(connection.output_offset < connection.output.size()) {
+        auto sent = send(connection.fd,
+                         connection.output.data() + connection.output_offset,
+                         connection.output.size() - connection.output_offset,
+                         MSG_NOSIGNAL);
+
+        if(sent < 0) {
+            if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                break;
+            }
+            closeConnection(io, id);
+            return;
+        }
+
+        connection.output_offset += static_cast<std::size_t>(sent);
+    }
+
+    auto drained = connection.output_offset == connection.output.size();
+    if(drained) {
+        connection.output.clear();
+        connection.output_offset = 0;
+
+        if(connection.close_after_write && !connection.waiting_for_worker) {
+            closeConnection(io, id);
+            return;
+        }
+    }
+
+    //only wait for writability while output is pending and stop reading
+    //from peers which closed their side. while a worker owns the connection
+    //nothing is parsed, so nothing is read either, otherwise pipelined
+    //input would be buffered without the size limits of the parser.
+    //reading continues once the worker completed
+    auto reads = !connection.peer_closed && !connection.waiting_for_worker;
+    std::uint32_t events = (reads ? EPOLLIN | EPOLLRDHUP : 0u)
+        | (drained ? 0u : EPOLLOUT);
+
+    if(events != connection.events) {
+        epoll_event event{};
+        event.events = events;
+        event.data.u64 = id;
+        epoll_ctl(io.epoll_fd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.events = events;
+    }
+}
+
+auto EpollHttpServer::closeConnection(IoThread& io,
+                                      std::uint64_t id)
+    -> void
+{
+    auto iter = io.connections.find(id);
+    if(iter == io.connections.end()) {
+        return;
+    }
+
+    epoll_ctl(io.epoll_fd, EPOLL_CTL_DEL, iter->second.fd, nullptr);
+    close(iter->second.fd);
+    io.connections.erase(iter);
+}
+
+auto EpollHttpServer::closeAll()
+    -> void
+{
+    for(auto& io : io_threads_) {
+        for(auto& [id, connection] : io->connections) {
+            close(connection.fd);
+        }
+        io->connections.clear();
+
+        if(io->epoll_fd >= 0) {
+            close(io->epoll_fd);
+        }
+        if(io->wakeup_fd >= 0) {
+            close(io->wakeup_fd);
+        }
+    }
+    io_threads_.clear();
+
+    if(listen_fd_ >= 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+    }
+
+    workers_.reset();
+}
+
+auto EpollHttpServer::handle(std::string_view target,
+                             const std::string& request,
+                             std::string& response)
+    -> void
+{
+    if(auto route = url_handlers_.find(std::string{target});
+       route != std::end(url_handlers_)) {
+        route->second->HandleRequest(request, response);
+        return;
+    }
+
+    ProcessRequest(request, response);
+}
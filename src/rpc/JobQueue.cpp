@@ -0,0 +1,153 @@
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <fmt/core.h>
+#include <functional>
+#include <json/value.h>
+#include <mutex>
+#include <rpc/JobQueue.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <utils/Opt.hpp>
+
+using forge::rpc::JobQueue;
+using forge::rpc::JobState;
+using forge::rpc::JobStatus;
+
+auto forge::rpc::jobStateToString(JobState state)
+    -> std::string_view
+{
+    switch(state) {
+    case JobState::Queued:
+        return "queued";
+    case JobState::Running:
+        return "running";
+    case JobState::Done:
+        return "done";
+    case JobState::Failed:
+        return "failed";
+    }
+
+    return "unknown";
+}
+
+JobQueue::JobQueue(std::size_t number_of_workers,
+                   std::size_t max_queued_jobs,
+                   std::size_t max_finished_jobs)
+    : max_finished_jobs_(max_finished_jobs),
+      pool_(number_of_workers, max_queued_jobs) {}
+
+auto JobQueue::submit(std::string method,
+                      std::function<Json::Value()> job)
+    -> utils::Opt<std::string>
+{
+    std::string id;
+    {
+        std::unique_lock lock{mtx_};
+        id = fmt::format("{:016x}", next_id_++);
+        jobs_.emplace(id, JobStatus{id, std::move(method), JobState::Queued, {}, {}});
+    }
+
+    auto submitted = pool_.trySubmit([this, id, job = std::move(job)] {
+        run(id, job);
+    });
+
+    if(!submitted) {
+        std::unique_lock lock{mtx_};
+        jobs_.erase(id);
+        return std::nullopt;
+    }
+
+    return id;
+}
+
+auto JobQueue::getStatus(const std::string& id) const
+    -> utils::Opt<JobStatus>
+{
+    std::unique_lock lock{mtx_};
+    if(auto iter = jobs_.find(id);
+       iter != std::end(jobs_)) {
+        return iter->second;
+    }
+
+    return std::nullopt;
+}
+
+auto JobQueue::waitFor(const std::string& id,
+                       std::chrono::milliseconds timeout) const
+    -> utils::Opt<JobStatus>
+{
+    std::unique_lock lock{mtx_};
+    job_finished_.wait_for(lock, timeout, [&] {
+        auto iter = jobs_.find(id);
+        return iter == std::end(jobs_) || isFinished(iter->second);
+    });
+
+    if(auto iter = jobs_.find(id);
+       iter != std::end(jobs_)) {
+        return iter->second;
+    }
+
+    return std::nullopt;
+}
+
+auto JobQueue::getNumberOfQueuedJobs() const
+    -> std::size_t
+{
+    return pool_.getNumberOfQueuedJobs();
+}
+
+auto JobQueue::stop()
+    -> void
+{
+    pool_.stop();
+}
+
+auto JobQueue::run(const std::string& id,
+                   const std::function<Json::Value()>& job)
+    -> void
+{
+    {
+        std::unique_lock lock{mtx_};
+        jobs_.at(id).state = JobState::Running;
+    }
+
+    try {
+        finish(id, JobState::Done, job(), {});
+    } catch(const std::exception& e) {
+        finish(id, JobState::Failed, {}, e.what());
+    } catch(...) {
+        finish(id, JobState::Failed, {}, "unknown error");
+    }
+}
+
+auto JobQueue::finish(const std::string& id,
+                      JobState state,
+                      Json::Value result,
+                      std::string error)
+    -> void
+{
+    {
+        std::unique_lock lock{mtx_};
+        auto& status = jobs_.at(id);
+        status.state = state;
+        status.result = std::move(result);
+        status.error = std::move(error);
+
+        finished_.push_back(id);
+        while(finished_.size() > max_finished_jobs_) {
+            jobs_.erase(finished_.front());
+            finished_.pop_front();
+        }
+    }
+
+    job_finished_.notify_all();
+}
+
+auto JobQueue::isFinished(const JobStatus& status)
+    -> bool
+{
+    return status.state == JobState::Done
+        || status.state == JobState::Failed;
+}
@@ -1,19 +1,33 @@
+#include <algorithm>
 #include <chrono>
+#include <core/Hex.hpp>
 #include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/Entry.hpp>
 #include <entrys/token/UtilityToken.hpp>
 #include <fmt/core.h>
 #include <fmt/format.h>
 #include <g3log/g3log.hpp>
+#include <iterator>
 #include <jsonrpccpp/server.h>
 #include <jsonrpccpp/server/connectors/httpserver.h>
 #include <lookup/LookupManager.hpp>
+#include <metrics/Metrics.hpp>
 #include <mutex>
-#include <numeric>
+#include <rpc/AdmissionControl.hpp>
+#include <rpc/JobQueue.hpp>
+#include <rpc/JsonArray.hpp>
 #include <rpc/JsonRpcServer.hpp>
+#include <stdexcept>
+#include <string>
 #include <thread>
-#include <utils/Algorithm.hpp>
+#include <unordered_map>
+#include <utility>
+#include <utils/Opt.hpp>
 #include <utils/Overload.hpp>
 #include <variant>
+#include <vector>
 #include <wallet/ReadOnlyWallet.hpp>
 #include <wallet/ReadWriteWallet.hpp>
 
@@ -27,36 +41,474 @@ using forge::core::ByteArray;
 using forge::wallet::ReadWriteWallet;
 using forge::wallet::ReadOnlyWallet;
 using forge::lookup::LookupManager;
+using forge::rpc::toJsonArray;
+using forge::rpc::AdmissionController;
+using forge::rpc::AdmissionRejected;
+using forge::rpc::PriorityStats;
+using forge::rpc::JobStatus;
+using forge::rpc::jobStateToString;
+using forge::rpc::Priority;
+using forge::rpc::NUMBER_OF_PRIORITIES;
+using forge::rpc::priorityToString;
 using jsonrpc::JsonRpcException;
 
+namespace {
+
+constexpr int MAX_PAGE_SIZE = 10000;
+constexpr int MAX_CHANGES_TIMEOUT = 60;
+constexpr int MAX_JOB_WAIT_TIMEOUT = 60;
+//the node wallet handles one write after another for the most
+//part, so a few workers are enough to keep it busy
+constexpr std::size_t MAX_FINISHED_JOBS = 10000;
+
+auto toJson(const forge::lookup::BlockChanges& changes)
+    -> Json::Value
+{
+    auto keys_to_json = [](const auto& keys) {
+        return toJsonArray(keys,
+                           [](const auto& key) {
+                               return Json::Value{forge::core::toHexString(key)};
+                           });
+    };
+
+    Json::Value ret;
+    ret["height"] = static_cast<Json::Int64>(changes.block_height);
+    ret["created"] = keys_to_json(changes.created);
+    ret["updated"] = keys_to_json(changes.updated);
+    ret["transferred"] = keys_to_json(changes.transferred);
+    ret["renewed"] = keys_to_json(changes.renewed);
+    ret["deleted"] = keys_to_json(changes.deleted);
+    ret["balancechanges"] =
+        toJsonArray(changes.balance_changes,
+                    [](const auto& change) {
+                        Json::Value json;
+                        json["owner"] = change.owner;
+                        json["token"] = forge::core::toHexString(change.token);
+                        json["oldbalance"] = std::to_string(change.old_balance);
+                        json["newbalance"] = std::to_string(change.new_balance);
+                        return json;
+                    });
+
+    return ret;
+}
+
+//cursors are the hex encoding of the block height of the page,
+//the length of the owner, the owner and the key of the last result
+auto encodeCursor(std::int64_t block_height,
+                  const forge::lookup::ListPosition& position)
+    -> std::string
+{
+    std::vector<std::byte> bytes;
+    bytes.reserve(9 + position.owner.size() + position.key.size());
+
+    for(int shift = 56; shift >= 0; shift -= 8) {
+        bytes.push_back(static_cast<std::byte>((static_cast<std::uint64_t>(block_height) >> shift) & 0xFF));
+    }
+
+    bytes.push_back(static_cast<std::byte>(position.owner.size()));
+    for(auto c : position.owner) {
+        bytes.push_back(static_cast<std::byte>(c));
+    }
+    bytes.insert(std::end(bytes),
+                 std::begin(position.key),
+                 std::end(position.key));
+
+    return forge::core::hexEncode(bytes.data(), bytes.size());
+}
+
+auto decodeCursor(const std::string& cursor)
+    -> forge::utils::Opt<std::pair<std::int64_t, forge::lookup::ListPosition>>
+{
+    std::vector<std::byte> bytes(cursor.size() / 2);
+    if(!forge::core::hexDecode(cursor, bytes.data()) || bytes.size() < 9) {
+        return std::nullopt;
+    }
+
+    std::uint64_t block_height = 0;
+    for(std::size_t i = 0; i < 8; i++) {
+        block_height = (block_height << 8) | std::to_integer<std::uint64_t>(bytes[i]);
+    }
+
+    auto owner_size = std::to_integer<std::size_t>(bytes[8]);
+    if(bytes.size() < 9 + owner_size) {
+        return std::nullopt;
+    }
+
+    const auto* owner_begin = reinterpret_cast<const char*>(bytes.data() + 9);
+    forge::lookup::ListPosition position{
+        std::string(owner_begin, owner_size),
+        std::vector<std::byte>(std::begin(bytes) + 9 + owner_size, std::end(bytes))};
+
+    return std::pair{static_cast<std::int64_t>(block_height), std::move(position)};
+}
+
+auto clampLimit(int limit)
+    -> std::size_t
+{
+    return static_cast<std::size_t>(std::clamp(limit, 1, MAX_PAGE_SIZE));
+}
+
+//lists one page of the owners, the page needs to be from the
+//same block as the cursor, otherwise the listing could skip or
+//repeat results
+template<class Lister>
+auto listPaged(const std::string& cursor,
+               int limit,
+               std::vector<std::string> owners,
+               Lister&& list)
+    -> Json::Value
+{
+    forge::utils::Opt<std::pair<std::int64_t, forge::lookup::ListPosition>> decoded;
+    if(!cursor.empty()) {
+        decoded = decodeCursor(cursor);
+        if(!decoded) {
+            throw JsonRpcException{"invalid cursor"};
+        }
+    }
+
+    auto after = decoded.map([](auto pair) {
+        return std::move(pair.second);
+    });
+
+    auto page = list(std::move(owners), after, clampLimit(limit));
+
+    if(decoded && decoded.getValue().first != page.block_height) {
+        throw JsonRpcException{
+            fmt::format("cursor belongs to block {}, but the lookup is at block {}, restart the listing",
+                        decoded.getValue().first,
+                        page.block_height)};
+    }
+
+    Json::Value ret;
+    ret["height"] = static_cast<Json::Int64>(page.block_height);
+    ret["results"] = toJsonArray(page.results);
+    ret["cursor"] = page.next
+                        .map([&](const auto& next) {
+                            return encodeCursor(page.block_height, next);
+                        })
+                        .valueOr(std::string{});
+
+    return ret;
+}
+
+struct MethodMetrics
+{
+    forge::metrics::Histogram& duration;
+    forge::metrics::Counter& errors;
+};
+
+//the metrics are looked up once per thread and method, so a
+//request neither builds labels nor locks the registry
+auto methodMetrics(const std::string& method)
+    -> MethodMetrics&
+{
+    thread_local std::unordered_map<std::string, MethodMetrics> cache;
+
+    auto iter = cache.find(method);
+    if(iter == std::end(cache)) {
+        auto& registry = forge::metrics::getRegistry();
+        MethodMetrics metrics{
+            registry.histogram("forge_rpc_request_duration_seconds",
+                               "Duration of rpc requests",
+                               {{"method", method}}),
+            registry.counter("forge_rpc_request_errors_total",
+                             "Rpc requests which failed",
+                             {{"method", method}})};
+        iter = cache.emplace(method, metrics).first;
+    }
+
+    return iter->second;
+}
+
+//calls the method and records its duration, and whether it failed
+template<class Call>
+auto timedCall(const std::string& method, Call&& call)
+    -> void
+{
+    auto& metrics = methodMetrics(method);
+    forge::metrics::ScopedTimer timer{metrics.duration};
+
+    try {
+        call();
+    } catch(...) {
+        metrics.errors.increment();
+        throw;
+    }
+}
+
+//nullopt for methods which do not need a slot
+auto admit(AdmissionController& admission, const std::string& method)
+    -> forge::utils::Opt<AdmissionController::Permit>
+{
+    if(forge::rpc::isAdmissionExempt(method)) {
+        return std::nullopt;
+    }
+
+    try {
+        return admission.admit(method);
+    } catch(const AdmissionRejected& e) {
+        throw JsonRpcException{e.what()};
+    }
+}
+
+auto toJson(const PriorityStats& stats, std::size_t limit)
+    -> Json::Value
+{
+    Json::Value json;
+    json["inflight"] = static_cast<Json::UInt64>(stats.in_flight);
+    json["queued"] = static_cast<Json::UInt64>(stats.queued);
+    json["admitted"] = static_cast<Json::UInt64>(stats.admitted);
+    json["rejected"] = static_cast<Json::UInt64>(stats.rejected);
+    json["shed"] = static_cast<Json::UInt64>(stats.shed);
+    json["timedout"] = static_cast<Json::UInt64>(stats.timed_out);
+    json["limit"] = static_cast<Json::UInt64>(limit);
+
+    return json;
+}
+
+auto toJson(const JobStatus& status)
+    -> Json::Value
+{
+    Json::Value json;
+    json["id"] = status.id;
+    json["method"] = status.method;
+    json["state"] = std::string{jobStateToString(status.state)};
+
+    switch(status.state) {
+    case forge::rpc::JobState::Done:
+        json["result"] = status.result;
+        break;
+    case forge::rpc::JobState::Failed:
+        json["error"] = status.error;
+        break;
+    default:
+        break;
+    }
+
+    return json;
+}
+
+//what the key of a job needs to be before the job is accepted
+enum class KeyRule {
+    //the key has to be unused by entrys and tokens
+    Free,
+    //the key has to be used by an entry
+    Exists,
+    //the key has to be used by an entry of the wallet
+    Owned,
+    //the key has to be the id of a token the wallet holds
+    //at least the amount of
+    Held
+};
+
+using Invoker = void (forge::rpc::AbstractJsonRpcStubSever::*)(const Json::Value&,
+                                                               Json::Value&);
+using ParamCheck = bool (Json::Value::*)() const;
+
+//wallet writes which can be run as job, the parameters are
+//the same as the ones of the stub
+struct AsyncMethod
+{
+    Invoker invoke;
+    std::vector<std::pair<std::string, ParamCheck>> params;
+    KeyRule key_rule;
+};
+
+auto getAsyncMethod(const std::string& method)
+    -> const AsyncMethod*
+{
+    using forge::rpc::AbstractJsonRpcStubSever;
+
+    constexpr auto string = &Json::Value::isString;
+    constexpr auto integer = &Json::Value::isIntegral;
+    constexpr auto boolean = &Json::Value::isBool;
+    constexpr auto object = &Json::Value::isObject;
+
+    static const std::unordered_map<std::string, AsyncMethod> methods{
+        {"createnewumentry",
+         {&AbstractJsonRpcStubSever::createnewumentryI,
+          {{"address", string}, {"burnvalue", integer}, {"isstring", boolean}, {"key", string}, {"value", object}},
+          KeyRule::Free}},
+        {"createnewuniqueentry",
+         {&AbstractJsonRpcStubSever::createnewuniqueentryI,
+          {{"address", string}, {"burnvalue", integer}, {"isstring", boolean}, {"key", string}, {"value", object}},
+          KeyRule::Free}},
+        {"updateumentry",
+         {&AbstractJsonRpcStubSever::updateumentryI,
+          {{"burnvalue", integer}, {"isstring", boolean}, {"key", string}, {"value", object}},
+          KeyRule::Owned}},
+        {"renewentry",
+         {&AbstractJsonRpcStubSever::renewentryI,
+          {{"burnvalue", integer}, {"isstring", boolean}, {"key", string}},
+          KeyRule::Owned}},
+        {"deleteentry",
+         {&AbstractJsonRpcStubSever::deleteentryI,
+          {{"burnvalue", integer}, {"isstring", boolean}, {"key", string}},
+          KeyRule::Owned}},
+        {"transferownership",
+         {&AbstractJsonRpcStubSever::transferownershipI,
+          {{"burnvalue", integer}, {"isstring", boolean}, {"key", string}, {"newowner", string}},
+          KeyRule::Owned}},
+        {"paytoentryowner",
+         {&AbstractJsonRpcStubSever::paytoentryownerI,
+          {{"amount", integer}, {"isstring", boolean}, {"key", string}},
+          KeyRule::Exists}},
+        {"createnewutilitytoken",
+         {&AbstractJsonRpcStubSever::createnewutilitytokenI,
+          {{"address", string}, {"burnvalue", integer}, {"isstring", boolean}, {"key", string}, {"supply", string}},
+          KeyRule::Free}},
+        {"sendutilitytokens",
+         {&AbstractJsonRpcStubSever::sendutilitytokensI,
+          {{"amount", string}, {"burnvalue", integer}, {"isstring", boolean}, {"key", string}, {"recipient", string}},
+          KeyRule::Held}},
+        {"burnutilitytokens",
+         {&AbstractJsonRpcStubSever::burnutilitytokensI,
+          {{"amount", string}, {"burnvalue", integer}, {"isstring", boolean}, {"key", string}},
+          KeyRule::Held}}};
+
+    if(auto iter = methods.find(method);
+       iter != std::end(methods)) {
+        return &iter->second;
+    }
+
+    return nullptr;
+}
+
+auto isNumber(const std::string& str)
+    -> bool
+{
+    return !str.empty()
+        && std::all_of(std::begin(str),
+                       std::end(str),
+                       [](auto c) {
+                           return c >= '0' && c <= '9';
+                       });
+}
+
+//the txids of all transactions, or an error listing the failed
+//transactions and the txids of the ones which were sent anyway
+auto splitResultToJson(forge::wallet::SplitOperationResult&& result)
+    -> Json::Value
+{
+    auto txids = toJsonArray(std::move(result.txids),
+                             [](auto&& txid) {
+                                 return Json::Value{std::move(txid)};
+                             });
+
+    if(result.failures.empty()) {
+        return txids;
+    }
+
+    auto failures = toJsonArray(result.failures,
+                                [](const auto& failure) {
+                                    Json::Value json;
+                                    json["address"] = failure.first;
+                                    json["error"] = failure.second.what();
+                                    return json;
+                                });
+
+    auto message = fmt::format("{} of {} transactions failed, first error: {}",
+                               result.failures.size(),
+                               result.failures.size() + txids.size(),
+                               result.failures.front().second.what());
+
+    Json::Value data;
+    data["txids"] = std::move(txids);
+    data["failures"] = std::move(failures);
+
+    throw JsonRpcException{jsonrpc::Errors::ERROR_RPC_INTERNAL_ERROR,
+                           std::move(message),
+                           data};
+}
+
+//wallet the requests of a wallet route are executed with,
+//nullptr for requests to the default wallet of the server
+thread_local JsonRpcServer::Wallet* selected_wallet = nullptr;
+
+//selects a wallet for the current thread until it is destroyed
+class WalletSelection final
+{
+public:
+    explicit WalletSelection(JsonRpcServer::Wallet* wallet)
+        : previous_(std::exchange(selected_wallet, wallet)) {}
+
+    WalletSelection(const WalletSelection&) = delete;
+    WalletSelection(WalletSelection&&) = delete;
+    auto operator=(const WalletSelection&) -> WalletSelection& = delete;
+    auto operator=(WalletSelection&&) -> WalletSelection& = delete;
+
+    ~WalletSelection()
+    {
+        selected_wallet = previous_;
+    }
+
+private:
+    JsonRpcServer::Wallet* previous_;
+};
+
+} // namespace
+
 JsonRpcServer::JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
                              jsonrpc::serverVersion_t type,
-                             wallet::ReadWriteWallet&& wallet)
+                             wallet::ReadWriteWallet&& wallet,
+                             AdmissionLimits admission_limits)
     : AbstractJsonRpcStubSever(connector, type),
-      logic_(std::move(wallet))
+      logic_(std::move(wallet)),
+      admission_(std::move(admission_limits)),
+      handler_(connector.GetHandler()),
+      jobs_(std::make_unique<JobQueue>(admission_.getLimits().job_workers,
+                                       admission_.getLimits().max_queued_jobs,
+                                       MAX_FINISHED_JOBS))
 {
     startUpdaterThread();
 }
 
 JsonRpcServer::JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
                              jsonrpc::serverVersion_t type,
-                             wallet::ReadOnlyWallet&& wallet)
+                             wallet::ReadOnlyWallet&& wallet,
+                             AdmissionLimits admission_limits)
     : AbstractJsonRpcStubSever(connector, type),
-      logic_(std::move(wallet))
+      logic_(std::move(wallet)),
+      admission_(std::move(admission_limits)),
+      handler_(connector.GetHandler())
 {
     startUpdaterThread();
 }
 
 JsonRpcServer::JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
                              jsonrpc::serverVersion_t type,
-                             lookup::LookupManager&& lookup)
+                             lookup::LookupManager&& lookup,
+                             AdmissionLimits admission_limits)
     : AbstractJsonRpcStubSever(connector, type),
-      logic_(std::move(lookup))
+      logic_(std::move(lookup)),
+      admission_(std::move(admission_limits)),
+      handler_(connector.GetHandler())
 {
     startUpdaterThread();
 }
 
 
+auto JsonRpcServer::HandleMethodCall(jsonrpc::Procedure& proc,
+                                     const Json::Value& input,
+                                     Json::Value& output)
+    -> void
+{
+    timedCall(proc.GetProcedureName(), [&] {
+        auto permit = admit(admission_, proc.GetProcedureName());
+        AbstractJsonRpcStubSever::HandleMethodCall(proc, input, output);
+    });
+}
+
+auto JsonRpcServer::HandleNotificationCall(jsonrpc::Procedure& proc,
+                                           const Json::Value& input)
+    -> void
+{
+    timedCall(proc.GetProcedureName(), [&] {
+        auto permit = admit(admission_, proc.GetProcedureName());
+        AbstractJsonRpcStubSever::HandleNotificationCall(proc, input);
+    });
+}
+
 auto JsonRpcServer::updatelookup()
     -> bool
 {
@@ -69,6 +521,7 @@ auto JsonRpcServer::updatelookup()
     indexing_.store(true);
 
     auto res = lookup.updateLookup();
+    invalidateCache();
 
     indexing_.store(false);
 
@@ -91,6 +544,9 @@ auto JsonRpcServer::rebuildlookup()
 
     indexing_.store(true);
     auto res = lookup.rebuildLookup();
+    //every cached result could be stale after a rebuild
+    lookup.takeTouchedKeys();
+    cache_.clear();
     indexing_.store(false);
 
     if(!res) {
@@ -114,17 +570,22 @@ auto JsonRpcServer::lookupumvalue(bool isstring, const std::string& key)
 
     auto& lookup = getLookup();
 
-    auto key_vec = extractEntryKey(isstring, key);
-
-    auto res = lookup.lookupUMValue(key_vec);
-
-    if(!res) {
-        auto error_msg = fmt::format("no entrys with key {} found",
-                                     key);
-        throw JsonRpcException{std::move(error_msg)};
-    }
-
-    return forge::core::umentryValueToJson(res.getValue().get());
+    return cachedLookup(
+               "lookupumvalue",
+               isstring,
+               key,
+               "",
+               [&](const auto& key_vec) {
+                   auto res = lookup.lookupUMValue(key_vec);
+
+                   if(!res) {
+                       auto error_msg = fmt::format("no entrys with key {} found",
+                                                    key);
+                       throw JsonRpcException{std::move(error_msg)};
+                   }
+
+                   return forge::core::umentryValueToJson(res.getValue().get());
+               });
 }
 
 auto JsonRpcServer::lookupuniquevalue(bool isstring, const std::string& key)
@@ -136,17 +597,22 @@ auto JsonRpcServer::lookupuniquevalue(bool isstring, const std::string& key)
 
     auto& lookup = getLookup();
 
-    auto key_vec = extractEntryKey(isstring, key);
-
-    auto res = lookup.lookupUniqueValue(key_vec);
-
-    if(!res) {
-        auto error_msg = fmt::format("no entrys with key {} found",
-                                     key);
-        throw JsonRpcException{std::move(error_msg)};
-    }
-
-    return forge::core::umentryValueToJson(res.getValue().get());
+    return cachedLookup(
+               "lookupuniquevalue",
+               isstring,
+               key,
+               "",
+               [&](const auto& key_vec) {
+                   auto res = lookup.lookupUniqueValue(key_vec);
+
+                   if(!res) {
+                       auto error_msg = fmt::format("no entrys with key {} found",
+                                                    key);
+                       throw JsonRpcException{std::move(error_msg)};
+                   }
+
+                   return forge::core::umentryValueToJson(res.getValue().get());
+               });
 }
 
 auto JsonRpcServer::lookupowner(bool isstring, const std::string& key)
@@ -158,21 +624,55 @@ auto JsonRpcServer::lookupowner(bool isstring, const std::string& key)
 
     auto& lookup = getLookup();
 
-    auto key_vec = extractEntryKey(isstring, key);
-
-    auto res = lookup.lookupOwner(key_vec);
+    return cachedLookup(
+               "lookupowner",
+               isstring,
+               key,
+               "",
+               [&](const auto& key_vec) {
+                   auto res = lookup.lookupOwner(key_vec);
+
+                   if(!res) {
+                       auto error_msg = fmt::format("no entrys with key {} found",
+                                                    key);
+                       throw JsonRpcException{std::move(error_msg)};
+                   }
+
+                   return Json::Value{res.getValue().get()};
+               })
+        .asString();
+}
 
-    if(!res) {
-        auto error_msg = fmt::format("no entrys with key {} found",
-                                     key);
-        throw JsonRpcException{std::move(error_msg)};
+auto JsonRpcServer::lookupactivationblock(bool isstring, const std::string& key)
+    -> int
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
     }
 
-    return res.getValue();
+    auto& lookup = getLookup();
+
+    return cachedLookup(
+               "lookupactivationblock",
+               isstring,
+               key,
+               "",
+               [&](const auto& key_vec) {
+                   auto res = lookup.lookupActivationBlock(key_vec);
+
+                   if(!res) {
+                       auto error_msg = fmt::format("no entrys with key {} found",
+                                                    key);
+                       throw JsonRpcException{std::move(error_msg)};
+                   }
+
+                   return Json::Value{static_cast<Json::Int64>(res.getValue().get())};
+               })
+        .asInt();
 }
 
-auto JsonRpcServer::lookupactivationblock(bool isstring, const std::string& key)
-    -> int
+auto JsonRpcServer::lookupmany(bool isstring, const Json::Value& keys)
+    -> Json::Value
 {
     if(indexing_.load()) {
         throw JsonRpcException{"Server is indexing"};
@@ -180,17 +680,52 @@ auto JsonRpcServer::lookupactivationblock(bool isstring, const std::string& key)
 
     auto& lookup = getLookup();
 
-    auto key_vec = extractEntryKey(isstring, key);
+    //keys which cannot be converted get an error entry,
+    //all others are looked up together
+    std::vector<EntryKey> key_vecs;
+    std::vector<utils::Opt<std::string>> errors;
+    key_vecs.reserve(keys.size());
+    errors.reserve(keys.size());
+
+    for(const auto& key : keys) {
+        auto key_opt = extractEntryKeyOpt(isstring, key);
+        if(!key_opt) {
+            errors.emplace_back("could not convert given key into vector of byte");
+            continue;
+        }
 
-    auto res = lookup.lookupActivationBlock(key_vec);
+        key_vecs.emplace_back(std::move(key_opt.getValue()));
+        errors.emplace_back(std::nullopt);
+    }
 
-    if(!res) {
-        auto error_msg = fmt::format("no entrys with key {} found",
-                                     key);
-        throw JsonRpcException{std::move(error_msg)};
+    auto batch = lookup.lookupMany(key_vecs);
+
+    Json::Value results{Json::arrayValue};
+    auto info_iter = std::begin(batch.results);
+    for(Json::ArrayIndex i = 0; i < keys.size(); i++) {
+        Json::Value result;
+        if(errors[i]) {
+            result["key"] = keys[i];
+            result["error"] = errors[i].getValue();
+        } else if(auto& info_opt = *info_iter++; !info_opt) {
+            result["key"] = keys[i];
+            result["error"] = fmt::format("no entrys with key {} found",
+                                          keys[i].asString());
+        } else {
+            auto& info = info_opt.getValue();
+            result = core::entryToJson(info.entry);
+            result["owner"] = std::move(info.owner);
+            result["activationblock"] = static_cast<Json::Int64>(info.activation_block);
+        }
+
+        results.append(std::move(result));
     }
 
-    return res.getValue();
+    Json::Value ret;
+    ret["height"] = static_cast<Json::Int64>(batch.block_height);
+    ret["results"] = std::move(results);
+
+    return ret;
 }
 
 auto JsonRpcServer::checkvalidity()
@@ -230,6 +765,156 @@ auto JsonRpcServer::getlastvalidblockheight()
     return res.getValue();
 }
 
+auto JsonRpcServer::getresponsecachestats()
+    -> Json::Value
+{
+    auto hits = cache_.getHits();
+    auto misses = cache_.getMisses();
+    auto requests = hits + misses;
+
+    Json::Value stats;
+    stats["hits"] = static_cast<Json::UInt64>(hits);
+    stats["misses"] = static_cast<Json::UInt64>(misses);
+    stats["hitrate"] = requests == 0
+        ? 0.0
+        : static_cast<double>(hits) / static_cast<double>(requests);
+    stats["entries"] = static_cast<Json::UInt64>(cache_.size());
+
+    return stats;
+}
+
+auto JsonRpcServer::getadmissionstats()
+    -> Json::Value
+{
+    auto stats = admission_.getStats();
+    const auto& limits = admission_.getLimits();
+
+    Json::Value ret;
+    for(std::size_t i = 0; i < NUMBER_OF_PRIORITIES; i++) {
+        auto name = std::string{priorityToString(static_cast<Priority>(i))};
+        ret[name] = toJson(stats[i], limits.class_limits[i]);
+    }
+
+    ret["maxconcurrent"] = static_cast<Json::UInt64>(limits.max_concurrent);
+    ret["maxqueued"] = static_cast<Json::UInt64>(limits.max_queued);
+    ret["queuetimeoutms"] = static_cast<Json::Int64>(limits.queue_timeout.count());
+    ret["longpolls"] = static_cast<Json::UInt64>(admission_.getLongPolls());
+    ret["maxlongpolls"] = static_cast<Json::UInt64>(limits.max_long_polls);
+
+    Json::Value method_limits{Json::objectValue};
+    for(const auto& [method, limit] : limits.method_limits) {
+        method_limits[method] = static_cast<Json::UInt64>(limit);
+    }
+    ret["methodlimits"] = std::move(method_limits);
+
+    return ret;
+}
+
+auto JsonRpcServer::submitjob(const std::string& method,
+                              const Json::Value& params)
+    -> std::string
+{
+    const auto* async = getAsyncMethod(method);
+    if(async == nullptr) {
+        throw JsonRpcException{fmt::format("method {} cannot be run as job", method)};
+    }
+
+    for(const auto& [name, check] : async->params) {
+        if(!params.isMember(name) || !(params[name].*check)()) {
+            auto error = fmt::format("parameter {} of method {} is missing or has the wrong type",
+                                     name,
+                                     method);
+            throw JsonRpcException{std::move(error)};
+        }
+    }
+
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    validateJob(method, params);
+
+    //the job runs with the wallet the request was sent to and
+    //is admitted like the method, so it counts against its limits,
+    //but waits for its slot as long as it takes
+    auto id_opt = getJobQueue().submit(method, [this, method, params, invoke = async->invoke, wallet = selected_wallet] {
+        WalletSelection selection{wallet};
+        Json::Value response;
+        try {
+            timedCall(method, [&] {
+                auto permit = admission_.admitJob(method);
+                (this->*invoke)(params, response);
+            });
+        } catch(const JsonRpcException& e) {
+            //the job only reports the message, not the rpc error code
+            throw std::runtime_error{e.GetMessage()};
+        }
+
+        return response;
+    });
+
+    if(!id_opt) {
+        throw JsonRpcException{"server overloaded, too many jobs are already waiting"};
+    }
+
+    return std::move(id_opt.getValue());
+}
+
+auto JsonRpcServer::getjobstatus(const std::string& id)
+    -> Json::Value
+{
+    auto status_opt = getJobQueue().getStatus(id);
+    if(!status_opt) {
+        throw JsonRpcException{fmt::format("unknown job {}", id)};
+    }
+
+    return toJson(status_opt.getValue());
+}
+
+auto JsonRpcServer::waitjob(const std::string& id, int timeout)
+    -> Json::Value
+{
+    auto seconds = std::clamp(timeout, 0, MAX_JOB_WAIT_TIMEOUT);
+
+    auto status_opt = getJobQueue().waitFor(id, std::chrono::seconds{seconds});
+    if(!status_opt) {
+        throw JsonRpcException{fmt::format("unknown job {}", id)};
+    }
+
+    return toJson(status_opt.getValue());
+}
+
+auto JsonRpcServer::getchangessince(int height, int timeout)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    const auto& feed = getLookup().getChangeFeed();
+    auto seconds = std::clamp(timeout, 0, MAX_CHANGES_TIMEOUT);
+
+    auto changes_opt = feed.waitForChangesSince(height, std::chrono::seconds{seconds});
+    if(!changes_opt) {
+        auto error = fmt::format("changes since block {} are no longer available, "
+                                 "resync from block {} or later",
+                                 height,
+                                 feed.getRetainedSince());
+        throw JsonRpcException{std::move(error)};
+    }
+
+    const auto& changes = changes_opt.getValue();
+
+    Json::Value ret;
+    ret["height"] = static_cast<Json::Int64>(changes.block_height);
+    ret["blocks"] = toJsonArray(changes.blocks,
+                                [](const auto& block) {
+                                    return toJson(block);
+                                });
+
+    return ret;
+}
+
 auto JsonRpcServer::lookupallentrysof(const std::string& owner)
     -> Json::Value
 {
@@ -241,23 +926,26 @@ auto JsonRpcServer::lookupallentrysof(const std::string& owner)
 
     auto entrys = lookup.getUMEntrysOfOwner(owner);
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
+    return toJsonArray(entrys);
+}
+
+auto JsonRpcServer::lookupallentrysofpaged(const std::string& cursor,
+                                           int limit,
+                                           const std::string& owner)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
 
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
+    const auto& lookup = getLookup();
 
-    return ret_json;
+    return listPaged(cursor,
+                     limit,
+                     {owner},
+                     [&](auto owners, const auto& after, auto count) {
+                         return lookup.getUMEntrysOfOwners(std::move(owners), after, count);
+                     });
 }
 
 auto JsonRpcServer::addwatchonlyaddress(const std::string& address)
@@ -293,23 +981,7 @@ auto JsonRpcServer::getownedumentrys()
     auto& wallet = getReadOnlyWallet();
     auto entrys = wallet.getOwnedUMEntrys();
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
-
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
-
-    return ret_json;
+    return toJsonArray(entrys);
 }
 
 auto JsonRpcServer::getwatchonlyumentrys()
@@ -322,23 +994,7 @@ auto JsonRpcServer::getwatchonlyumentrys()
     auto& wallet = getReadOnlyWallet();
     auto entrys = wallet.getWatchOnlyUMEntrys();
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
-
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
-
-    return ret_json;
+    return toJsonArray(entrys);
 }
 
 auto JsonRpcServer::getallwatchedumentrys()
@@ -351,23 +1007,25 @@ auto JsonRpcServer::getallwatchedumentrys()
     auto& wallet = getReadOnlyWallet();
     auto entrys = wallet.getAllWatchedUMEntrys();
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
+    return toJsonArray(entrys);
+}
 
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
+auto JsonRpcServer::getallwatchedumentryspaged(const std::string& cursor,
+                                               int limit)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    const auto& lookup = getReadOnlyWallet().getLookup();
 
-    return ret_json;
+    return listPaged(cursor,
+                     limit,
+                     getAllWalletAddresses(),
+                     [&](auto owners, const auto& after, auto count) {
+                         return lookup.getUMEntrysOfOwners(std::move(owners), after, count);
+                     });
 }
 
 auto JsonRpcServer::getowneduniqueentrys()
@@ -380,23 +1038,7 @@ auto JsonRpcServer::getowneduniqueentrys()
     const auto& wallet = getReadOnlyWallet();
     auto entrys = wallet.getOwnedUniqueEntrys();
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
-
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
-
-    return ret_json;
+    return toJsonArray(entrys);
 }
 
 auto JsonRpcServer::getwatchonlyuniqueentrys()
@@ -409,23 +1051,7 @@ auto JsonRpcServer::getwatchonlyuniqueentrys()
     const auto& wallet = getReadOnlyWallet();
     auto entrys = wallet.getWatchOnlyUniqueEntrys();
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
-
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
-
-    return ret_json;
+    return toJsonArray(entrys);
 }
 
 auto JsonRpcServer::getallwatcheduniqueentrys()
@@ -438,23 +1064,25 @@ auto JsonRpcServer::getallwatcheduniqueentrys()
     const auto& wallet = getReadOnlyWallet();
     auto entrys = wallet.getAllWatchedUniqueEntrys();
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
+    return toJsonArray(entrys);
+}
+
+auto JsonRpcServer::getallwatcheduniqueentryspaged(const std::string& cursor,
+                                                   int limit)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
 
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
+    const auto& lookup = getReadOnlyWallet().getLookup();
 
-    return ret_json;
+    return listPaged(cursor,
+                     limit,
+                     getAllWalletAddresses(),
+                     [&](auto owners, const auto& after, auto count) {
+                         return lookup.getUniqueEntrysOfOwners(std::move(owners), after, count);
+                     });
 }
 
 auto JsonRpcServer::getwatchedaddresses()
@@ -462,32 +1090,20 @@ auto JsonRpcServer::getwatchedaddresses()
 {
     const auto& wallet = getReadOnlyWallet();
     const auto& addresses = wallet.getWatchedAddresses();
-    auto ret_json =
-        std::accumulate(std::begin(addresses),
-                        std::end(addresses),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, const auto& entry) {
-                            init.append(entry);
-                            return init;
-                        });
-
-    return ret_json;
+    return toJsonArray(addresses,
+                       [](const auto& address) {
+                           return Json::Value{address};
+                       });
 }
 auto JsonRpcServer::getownedaddresses()
     -> Json::Value
 {
     const auto& wallet = getReadOnlyWallet();
     const auto& addresses = wallet.getOwnedAddresses();
-    auto ret_json =
-        std::accumulate(std::begin(addresses),
-                        std::end(addresses),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, const auto& entry) {
-                            init.append(entry);
-                            return init;
-                        });
-
-    return ret_json;
+    return toJsonArray(addresses,
+                       [](const auto& address) {
+                           return Json::Value{address};
+                       });
 }
 
 auto JsonRpcServer::ownesaddress(const std::string& address)
@@ -700,6 +1316,65 @@ auto JsonRpcServer::paytoentryowner(int amount,
     return res.getValue();
 }
 
+auto JsonRpcServer::paytoentryowners(bool isstring,
+                                     const Json::Value& payments)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    auto& wallet = getReadWriteWallet();
+
+    //payments which cannot be decoded get an error entry,
+    //all others are paid together
+    std::vector<std::pair<EntryKey, std::int64_t>> decoded;
+    std::vector<utils::Opt<std::string>> errors;
+    decoded.reserve(payments.size());
+    errors.reserve(payments.size());
+
+    for(const auto& payment : payments) {
+        if(!payment.isObject()
+           || !payment["amount"].isIntegral()) {
+            errors.emplace_back("payment needs a key and an integral amount");
+            continue;
+        }
+
+        auto key_opt = extractEntryKeyOpt(isstring, payment["key"]);
+        if(!key_opt) {
+            errors.emplace_back("could not convert given key into vector of byte");
+            continue;
+        }
+
+        decoded.emplace_back(std::move(key_opt.getValue()),
+                             payment["amount"].asInt64());
+        errors.emplace_back(std::nullopt);
+    }
+
+    auto paid = wallet.payToEntryOwners(decoded);
+
+    Json::Value results{Json::arrayValue};
+    auto paid_iter = std::begin(paid);
+    for(Json::ArrayIndex i = 0; i < payments.size(); i++) {
+        Json::Value result;
+        result["key"] = payments[i].isObject()
+            ? payments[i]["key"]
+            : Json::Value{};
+
+        if(errors[i]) {
+            result["error"] = errors[i].getValue();
+        } else if(auto& res = *paid_iter++; !res) {
+            result["error"] = res.getError().what();
+        } else {
+            result["txid"] = res.getValue();
+        }
+
+        results.append(std::move(result));
+    }
+
+    return results;
+}
+
 auto JsonRpcServer::getownedutilitytokens()
     -> Json::Value
 {
@@ -711,23 +1386,7 @@ auto JsonRpcServer::getownedutilitytokens()
 
     auto entrys = wallet.getOwnedUtilityTokens();
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
-
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
-
-    return ret_json;
+    return toJsonArray(entrys);
 }
 
 auto JsonRpcServer::getwatchonlyutilitytokens()
@@ -741,23 +1400,7 @@ auto JsonRpcServer::getwatchonlyutilitytokens()
 
     auto entrys = wallet.getWatchOnlyUtilityTokens();
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
-
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
-
-    return ret_json;
+    return toJsonArray(entrys);
 }
 
 auto JsonRpcServer::getallwatchedutilitytokens()
@@ -770,23 +1413,25 @@ auto JsonRpcServer::getallwatchedutilitytokens()
     const auto& wallet = getReadWriteWallet();
     auto entrys = wallet.getAllWatchedUtilityTokens();
 
-    auto json_entrys =
-        utils::transform_into_vector(std::make_move_iterator(std::begin(entrys)),
-                                      std::make_move_iterator(std::end(entrys)),
-                                      [](auto entry) {
-                                          return entry.toJson();
-                                      });
+    return toJsonArray(entrys);
+}
 
-    auto ret_json =
-        std::accumulate(std::make_move_iterator(std::begin(json_entrys)),
-                        std::make_move_iterator(std::end(json_entrys)),
-                        Json::Value{Json::ValueType::arrayValue},
-                        [](auto init, auto entry) {
-                            init.append(std::move(entry));
-                            return init;
-                        });
+auto JsonRpcServer::getallwatchedutilitytokenspaged(const std::string& cursor,
+                                                    int limit)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    const auto& lookup = getReadOnlyWallet().getLookup();
 
-    return ret_json;
+    return listPaged(cursor,
+                     limit,
+                     getAllWalletAddresses(),
+                     [&](auto owners, const auto& after, auto count) {
+                         return lookup.getUtilityTokensOfOwners(std::move(owners), after, count);
+                     });
 }
 
 auto JsonRpcServer::getutilitytokensof(const std::string& owner)
@@ -799,24 +1444,26 @@ auto JsonRpcServer::getutilitytokensof(const std::string& owner)
     const auto& lookup = getLookup();
     auto tokens = lookup.getUtilityTokensOfOwner(owner);
 
-    auto json_entrys =
-        utils::transform_into_vector(
-            std::make_move_iterator(std::begin(tokens)),
-            std::make_move_iterator(std::end(tokens)),
-            [](auto entry) {
-                return entry.toJson();
-            });
+    return toJsonArray(tokens);
+}
 
-    auto ret_json =
-        std::accumulate(
-            std::make_move_iterator(std::begin(json_entrys)),
-            std::make_move_iterator(std::end(json_entrys)),
-            Json::Value{Json::ValueType::arrayValue},
-            [](auto init, auto entry) {
-                init.append(std::move(entry));
-                return init;
-            });
-    return ret_json;
+auto JsonRpcServer::getutilitytokensofpaged(const std::string& cursor,
+                                            int limit,
+                                            const std::string& owner)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    const auto& lookup = getLookup();
+
+    return listPaged(cursor,
+                     limit,
+                     {owner},
+                     [&](auto owners, const auto& after, auto count) {
+                         return lookup.getUtilityTokensOfOwners(std::move(owners), after, count);
+                     });
 }
 
 auto JsonRpcServer::getbalanceof(bool isstring,
@@ -830,13 +1477,79 @@ auto JsonRpcServer::getbalanceof(bool isstring,
 
     const auto& lookup = getLookup();
 
-    auto key_vec = extractEntryKey(isstring, token);
+    return cachedLookup(
+               "getbalanceof",
+               isstring,
+               token,
+               owner,
+               [&](const auto& key_vec) {
+                   auto balance =
+                       lookup.getUtilityTokenCreditOf(owner,
+                                                      key_vec);
+
+                   return Json::Value{fmt::format("{}", balance)};
+               })
+        .asString();
+}
 
-    auto balance =
-        lookup.getUtilityTokenCreditOf(owner,
-                                       key_vec);
+auto JsonRpcServer::getbalances(bool isstring, const Json::Value& pairs)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    const auto& lookup = getLookup();
+
+    //pairs which are malformed get an error entry,
+    //all others are computed together
+    std::vector<std::pair<std::string, EntryKey>> owner_token_pairs;
+    std::vector<utils::Opt<std::string>> errors;
+    owner_token_pairs.reserve(pairs.size());
+    errors.reserve(pairs.size());
+
+    for(const auto& pair : pairs) {
+        if(!pair.isObject() || !pair["owner"].isString()) {
+            errors.emplace_back("pair needs to contain an owner and a token");
+            continue;
+        }
+
+        auto token_opt = extractEntryKeyOpt(isstring, pair["token"]);
+        if(!token_opt) {
+            errors.emplace_back("could not convert given token into vector of byte");
+            continue;
+        }
+
+        owner_token_pairs.emplace_back(pair["owner"].asString(),
+                                       std::move(token_opt.getValue()));
+        errors.emplace_back(std::nullopt);
+    }
+
+    auto batch = lookup.getBalances(owner_token_pairs);
+
+    Json::Value results{Json::arrayValue};
+    auto balance_iter = std::begin(batch.results);
+    for(Json::ArrayIndex i = 0; i < pairs.size(); i++) {
+        Json::Value result;
+        if(pairs[i].isObject()) {
+            result["owner"] = pairs[i]["owner"];
+            result["token"] = pairs[i]["token"];
+        }
+
+        if(errors[i]) {
+            result["error"] = errors[i].getValue();
+        } else {
+            result["balance"] = fmt::format("{}", *balance_iter++);
+        }
 
-    return fmt::format("{}", balance);
+        results.append(std::move(result));
+    }
+
+    Json::Value ret;
+    ret["height"] = static_cast<Json::Int64>(batch.block_height);
+    ret["results"] = std::move(results);
+
+    return ret;
 }
 
 auto JsonRpcServer::getsupplyofutilitytoken(bool isstring,
@@ -921,16 +1634,7 @@ auto JsonRpcServer::sendutilitytokens(const std::string& amount_str,
         throw JsonRpcException(res.getError().what());
     }
 
-    auto txids = res.getValue();
-
-    return std::accumulate(
-        std::make_move_iterator(std::begin(txids)),
-        std::make_move_iterator(std::end(txids)),
-        Json::Value{Json::ValueType::arrayValue},
-        [](auto init, auto entry) {
-            init.append(std::move(entry));
-            return init;
-        });
+    return splitResultToJson(std::move(res.getValue()));
 }
 
 auto JsonRpcServer::burnutilitytokens(const std::string& amount_str,
@@ -951,16 +1655,7 @@ auto JsonRpcServer::burnutilitytokens(const std::string& amount_str,
         throw JsonRpcException(res.getError().what());
     }
 
-    auto txids = res.getValue();
-
-    return std::accumulate(
-        std::make_move_iterator(std::begin(txids)),
-        std::make_move_iterator(std::end(txids)),
-        Json::Value{Json::ValueType::arrayValue},
-        [](auto init, auto entry) {
-            init.append(std::move(entry));
-            return init;
-        });
+    return splitResultToJson(std::move(res.getValue()));
 }
 
 auto JsonRpcServer::hasShutdownRequest() const
@@ -989,6 +1684,15 @@ auto JsonRpcServer::getLookup()
 auto JsonRpcServer::getReadOnlyWallet()
     -> wallet::ReadOnlyWallet&
 {
+    if(selected_wallet != nullptr) {
+        return std::visit(
+            [](auto& wallet)
+                -> ReadOnlyWallet& {
+                return wallet;
+            },
+            *selected_wallet);
+    }
+
     if(std::holds_alternative<LookupManager>(logic_)) {
         auto error = fmt::format("rpc server unable to perform this operation in mode {}", getMode());
         throw JsonRpcException(std::move(error));
@@ -1005,6 +1709,15 @@ auto JsonRpcServer::getReadOnlyWallet()
 auto JsonRpcServer::getReadWriteWallet()
     -> wallet::ReadWriteWallet&
 {
+    if(selected_wallet != nullptr) {
+        auto* wallet = std::get_if<ReadWriteWallet>(selected_wallet);
+        if(wallet == nullptr) {
+            throw JsonRpcException{"rpc server unable to perform this operation with a readonly wallet"};
+        }
+
+        return *wallet;
+    }
+
     if(!std::holds_alternative<ReadWriteWallet>(logic_)) {
         auto error =
             fmt::format("rpc server unable to perform this operation in mode {}",
@@ -1018,6 +1731,12 @@ auto JsonRpcServer::getReadWriteWallet()
 auto JsonRpcServer::getMode() const
     -> std::string
 {
+    if(selected_wallet != nullptr) {
+        return std::holds_alternative<ReadWriteWallet>(*selected_wallet)
+            ? "readwrite"
+            : "readonly";
+    }
+
     return std::visit(
         utils::overload{
             [](const LookupManager& /*unused*/) {
@@ -1048,6 +1767,167 @@ auto JsonRpcServer::extractEntryKey(bool isstring,
     return vec_opt.getValue();
 }
 
+auto JsonRpcServer::extractEntryKeyOpt(bool isstring,
+                                       const Json::Value& key)
+    -> utils::Opt<core::EntryKey>
+{
+    if(!key.isString()) {
+        return std::nullopt;
+    }
+
+    if(isstring) {
+        return core::stringToASCIIByteVec(key.asString());
+    }
+
+    return core::stringToByteVec(key.asString());
+}
+
+template<class Func>
+auto JsonRpcServer::cachedLookup(std::string_view method,
+                                 bool isstring,
+                                 const std::string& key,
+                                 const std::string& extra,
+                                 Func&& compute)
+    -> Json::Value
+{
+    //the key is length prefixed, so key and extra cannot run into each other
+    std::string request;
+    request.reserve(method.size() + key.size() + extra.size() + 24);
+    request.append(method);
+    request.push_back(isstring ? '1' : '0');
+    request.append(std::to_string(key.size()));
+    request.push_back(':');
+    request.append(key);
+    request.append(extra);
+
+    if(auto cached = cache_.find(request)) {
+        return std::move(cached.getValue());
+    }
+
+    //read the epoch before computing the result, so a result computed
+    //from a lookup which was updated in the meantime is not cached
+    auto epoch = cache_.getEpoch();
+    auto key_vec = extractEntryKey(isstring, key);
+    auto result = compute(key_vec);
+
+    cache_.insert(request, key_vec, result, epoch);
+
+    return result;
+}
+
+auto JsonRpcServer::invalidateCache()
+    -> void
+{
+    auto keys = getLookup().takeTouchedKeys();
+    if(!keys.empty()) {
+        cache_.invalidate(keys);
+    }
+}
+
+auto JsonRpcServer::validateJob(const std::string& method,
+                                const Json::Value& params)
+    -> void
+{
+    auto& wallet = getReadWriteWallet();
+    const auto& async = *getAsyncMethod(method);
+
+    if(params.isMember("address")) {
+        auto address = params["address"].asString();
+        if(!address.empty() && !wallet.ownesAddress(address)) {
+            throw JsonRpcException{fmt::format("it seems that you aren't the owner of the address {}",
+                                               address)};
+        }
+    }
+
+    for(const auto* amount : {"amount", "supply"}) {
+        if(params.isMember(amount)
+           && params[amount].isString()
+           && !isNumber(params[amount].asString())) {
+            throw JsonRpcException{fmt::format("{} has to be a positive number", amount)};
+        }
+    }
+
+    auto key = extractEntryKey(params["isstring"].asBool(),
+                               params["key"].asString());
+    const auto& lookup = getLookup();
+
+    if(async.key_rule == KeyRule::Held) {
+        if(lookup.getSupplyOfToken(key) == 0) {
+            throw JsonRpcException{fmt::format("unable to lookup the token: {}",
+                                               core::toHexString(key))};
+        }
+
+        auto amount = std::stoull(params["amount"].asString());
+        std::uint64_t held{0};
+        for(const auto& address : wallet.getOwnedAddresses()) {
+            held += lookup.getUtilityTokenCreditOf(address, key);
+        }
+
+        if(held < amount) {
+            auto error = fmt::format("insufficient funds of token {}, needed: {}, available: {}",
+                                     core::toHexString(key),
+                                     amount,
+                                     held);
+            throw JsonRpcException{std::move(error)};
+        }
+        return;
+    }
+
+    auto owner = lookup
+                     .lookupOwner(key)
+                     .map([](auto owner) {
+                         return std::string{owner.get()};
+                     });
+
+    if(async.key_rule == KeyRule::Free) {
+        if(owner || lookup.getSupplyOfToken(key) > 0) {
+            throw JsonRpcException{fmt::format("key {} is already used",
+                                               core::toHexString(key))};
+        }
+        return;
+    }
+
+    if(!owner) {
+        throw JsonRpcException{fmt::format("unable to lookup the entry key: {}",
+                                           core::toHexString(key))};
+    }
+
+    if(async.key_rule == KeyRule::Owned && !wallet.ownesAddress(owner.getValue())) {
+        auto error = fmt::format("it seems that you aren't the owner of "
+                                 "entry {} which is currently owned by {}",
+                                 core::toHexString(key),
+                                 owner.getValue());
+        throw JsonRpcException{std::move(error)};
+    }
+}
+
+auto JsonRpcServer::getJobQueue()
+    -> JobQueue&
+{
+    if(!jobs_) {
+        throw JsonRpcException{"rpc server unable to run jobs without a read write wallet"};
+    }
+
+    return *jobs_;
+}
+
+auto JsonRpcServer::getAllWalletAddresses()
+    -> std::vector<std::string>
+{
+    const auto& wallet = getReadOnlyWallet();
+    const auto& owned = wallet.getOwnedAddresses();
+    const auto& watched = wallet.getWatchedAddresses();
+
+    std::vector<std::string> addresses;
+    std::set_union(std::begin(owned),
+                   std::end(owned),
+                   std::begin(watched),
+                   std::end(watched),
+                   std::back_inserter(addresses));
+
+    return addresses;
+}
+
 auto JsonRpcServer::startUpdaterThread()
     -> void
 {
@@ -1063,13 +1943,102 @@ auto JsonRpcServer::startUpdaterThread()
 
                 indexing_.store(true);
                 lookup.updateLookup();
+                invalidateCache();
                 indexing_.store(false);
+
+                maintainOutputPools();
+
                 std::unique_lock lock{mtx};
                 shutdown_requested_.wait_for(lock, sleeptime);
             }
         }};
 }
 
+auto JsonRpcServer::maintainOutputPools()
+    -> void
+{
+    auto maintain = [](ReadWriteWallet& wallet, std::string_view name) {
+        wallet.maintainOutputPool()
+            .onValue([&](auto created) {
+                if(created > 0) {
+                    LOG(INFO) << fmt::format("created {} outputs for the output pool of wallet {}",
+                                             created,
+                                             name);
+                }
+            })
+            .onError([&](const auto& error) {
+                LOG(WARNING) << fmt::format("unable to maintain the output pool of wallet {}: {}",
+                                            name,
+                                            error.what());
+            });
+    };
+
+    if(auto* wallet = std::get_if<ReadWriteWallet>(&logic_);
+       wallet != nullptr) {
+        maintain(*wallet, "default");
+    }
+
+    //maintaining a pool asks the node several times, so the wallets are
+    //collected first and the map is not locked meanwhile. routes are
+    //never removed, so the wallets outlive the loop
+    std::vector<std::pair<std::string, ReadWriteWallet*>> wallets;
+    {
+        std::unique_lock lock{wallets_mtx_};
+        for(auto& [name, route] : wallets_) {
+            if(auto* wallet = std::get_if<ReadWriteWallet>(&route->getWallet());
+               wallet != nullptr) {
+                wallets.emplace_back(name, wallet);
+            }
+        }
+    }
+
+    for(auto& [name, wallet] : wallets) {
+        maintain(*wallet, name);
+    }
+}
+
+auto JsonRpcServer::addWallet(std::string name,
+                              Wallet&& wallet)
+    -> jsonrpc::IClientConnectionHandler&
+{
+    auto writes = std::holds_alternative<ReadWriteWallet>(wallet);
+    auto route = std::make_unique<WalletRoute>(*handler_, std::move(wallet));
+
+    //wallets are added before the server listens,
+    //so no request can read the queue yet
+    if(writes && !jobs_) {
+        jobs_ = std::make_unique<JobQueue>(admission_.getLimits().job_workers,
+                                           admission_.getLimits().max_queued_jobs,
+                                           MAX_FINISHED_JOBS);
+    }
+
+    //a route can already be registered at the connector,
+    //so it is never replaced
+    std::unique_lock lock{wallets_mtx_};
+    auto iter = wallets_.emplace(std::move(name), std::move(route)).first;
+
+    return *iter->second;
+}
+
+JsonRpcServer::WalletRoute::WalletRoute(jsonrpc::IClientConnectionHandler& server,
+                                        Wallet&& wallet)
+    : server_(server),
+      wallet_(std::move(wallet)) {}
+
+auto JsonRpcServer::WalletRoute::HandleRequest(const std::string& request,
+                                               std::string& response)
+    -> void
+{
+    WalletSelection selection{&wallet_};
+    server_.HandleRequest(request, response);
+}
+
+auto JsonRpcServer::WalletRoute::getWallet()
+    -> Wallet&
+{
+    return wallet_;
+}
+
 JsonRpcServer::~JsonRpcServer()
 {
     should_shutdown_ = true;
@@ -0,0 +1,130 @@
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <json/value.h>
+#include <metrics/Metrics.hpp>
+#include <mutex>
+#include <rpc/ResponseCache.hpp>
+#include <shared_mutex>
+#include <string>
+#include <utils/Opt.hpp>
+#include <vector>
+
+using forge::rpc::ResponseCache;
+using forge::core::EntryKey;
+
+namespace {
+
+auto cacheRequests(const char* result)
+    -> forge::metrics::Counter&
+{
+    return forge::metrics::getRegistry()
+        .counter("forge_response_cache_requests_total",
+                 "Lookups answered by the response cache",
+                 {{"result", result}});
+}
+
+} // namespace
+
+ResponseCache::ResponseCache(std::size_t max_entries)
+    : max_entries_(max_entries) {}
+
+auto ResponseCache::getEpoch() const
+    -> std::uint64_t
+{
+    std::shared_lock lock{mtx_};
+    return epoch_;
+}
+
+auto ResponseCache::find(const std::string& request) const
+    -> utils::Opt<Json::Value>
+{
+    std::shared_lock lock{mtx_};
+
+    if(auto iter = results_.find(request);
+       iter != results_.end()) {
+        static auto& hits = cacheRequests("hit");
+        hits_++;
+        hits.increment();
+        return iter->second;
+    }
+
+    static auto& misses = cacheRequests("miss");
+    misses_++;
+    misses.increment();
+    return std::nullopt;
+}
+
+auto ResponseCache::insert(const std::string& request,
+                           const EntryKey& key,
+                           Json::Value result,
+                           std::uint64_t epoch)
+    -> void
+{
+    std::unique_lock lock{mtx_};
+
+    if(epoch != epoch_) {
+        return;
+    }
+
+    //the cache only grows until the next block for keys nobody
+    //touches, so dropping everything when full is good enough
+    if(results_.size() >= max_entries_) {
+        results_.clear();
+        dependencies_.clear();
+    }
+
+    if(results_.emplace(request, std::move(result)).second) {
+        dependencies_[key].push_back(request);
+    }
+}
+
+auto ResponseCache::invalidate(const std::vector<EntryKey>& keys)
+    -> void
+{
+    std::unique_lock lock{mtx_};
+
+    epoch_++;
+
+    for(const auto& key : keys) {
+        auto iter = dependencies_.find(key);
+        if(iter == dependencies_.end()) {
+            continue;
+        }
+
+        for(const auto& request : iter->second) {
+            results_.erase(request);
+        }
+
+        dependencies_.erase(iter);
+    }
+}
+
+auto ResponseCache::clear()
+    -> void
+{
+    std::unique_lock lock{mtx_};
+
+    epoch_++;
+    results_.clear();
+    dependencies_.clear();
+}
+
+auto ResponseCache::size() const
+    -> std::size_t
+{
+    std::shared_lock lock{mtx_};
+    return results_.size();
+}
+
+auto ResponseCache::getHits() const
+    -> std::uint64_t
+{
+    return hits_.load();
+}
+
+auto ResponseCache::getMisses() const
+    -> std::uint64_t
+{
+    return misses_.load();
+}
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <utils/Opt.hpp>
+#include <vector>
+#include <wallet/OutputPool.hpp>
+#include <wallet/UtxoSet.hpp>
+
+using forge::wallet::OutputPool;
+using forge::wallet::OutputPoolConfig;
+
+namespace {
+
+//blocks a funding transaction can take to be mined
+//before its output is given up
+constexpr std::int64_t FUNDING_GRACE_BLOCKS = 10;
+
+} // namespace
+
+OutputPool::OutputPool(OutputPoolConfig config)
+    : config_(std::move(config)) {}
+
+auto OutputPool::getConfig() const
+    -> const OutputPoolConfig&
+{
+    return config_;
+}
+
+auto OutputPool::add(const std::vector<std::string>& addresses,
+                     std::int64_t block_height)
+    -> void
+{
+    std::unique_lock lock{mtx_};
+    for(const auto& address : addresses) {
+        pooled_.push_back(Pooled{address, block_height, std::nullopt, false});
+    }
+}
+
+auto OutputPool::arrived(const UtxoSet& utxos) const
+    -> std::vector<core::Unspent>
+{
+    std::unique_lock lock{mtx_};
+
+    std::vector<core::Unspent> outputs;
+    for(const auto& pooled : pooled_) {
+        if(pooled.output) {
+            continue;
+        }
+
+        if(auto output = utxos.select(pooled.address, 1, 0)) {
+            outputs.push_back(std::move(output.getValue()));
+        }
+    }
+
+    return outputs;
+}
+
+auto OutputPool::hold(core::Unspent output)
+    -> void
+{
+    std::unique_lock lock{mtx_};
+    auto iter = std::find_if(std::begin(pooled_),
+                             std::end(pooled_),
+                             [&](const auto& pooled) {
+                                 return !pooled.output
+                                     && pooled.address == output.getAddress();
+                             });
+
+    if(iter != std::end(pooled_)) {
+        iter->output = std::move(output);
+    }
+}
+
+auto OutputPool::prune(const UtxoSet& utxos,
+                       std::int64_t block_height,
+                       std::int64_t maturity)
+    -> std::size_t
+{
+    std::unique_lock lock{mtx_};
+    auto old_size = pooled_.size();
+
+    auto end = std::remove_if(std::begin(pooled_),
+                              std::end(pooled_),
+                              [&](const auto& pooled) {
+                                  return !pooled.output
+                                      && block_height > pooled.funded_at + maturity + FUNDING_GRACE_BLOCKS
+                                      && !utxos.select(pooled.address, 1, 0);
+                              });
+    pooled_.erase(end, std::end(pooled_));
+
+    return old_size - pooled_.size();
+}
+
+auto OutputPool::reserve(std::int64_t needed,
+                         std::int64_t min_change)
+    -> utils::Opt<std::string>
+{
+    std::unique_lock lock{mtx_};
+
+    auto iter = std::find_if(std::begin(pooled_),
+                             std::end(pooled_),
+                             [&](const auto& pooled) {
+                                 if(!pooled.output || pooled.reserved) {
+                                     return false;
+                                 }
+
+                                 auto value = pooled.output.getValue().getValue();
+                                 return value == needed || value >= needed + min_change;
+                             });
+
+    if(iter == std::end(pooled_)) {
+        return std::nullopt;
+    }
+
+    iter->reserved = true;
+
+    return iter->address;
+}
+
+auto OutputPool::take(const std::string& address)
+    -> utils::Opt<core::Unspent>
+{
+    std::unique_lock lock{mtx_};
+
+    auto iter = std::find_if(std::begin(pooled_),
+                             std::end(pooled_),
+                             [&](const auto& pooled) {
+                                 return pooled.reserved
+                                     && pooled.address == address;
+                             });
+
+    if(iter == std::end(pooled_)) {
+        return std::nullopt;
+    }
+
+    auto output = std::move(iter->output);
+    pooled_.erase(iter);
+
+    return output;
+}
+
+auto OutputPool::keepUnfunded(std::vector<std::string> addresses)
+    -> void
+{
+    std::unique_lock lock{mtx_};
+    std::move(std::begin(addresses),
+              std::end(addresses),
+              std::back_inserter(unfunded_));
+}
+
+auto OutputPool::takeUnfunded(std::size_t count)
+    -> std::vector<std::string>
+{
+    std::unique_lock lock{mtx_};
+    count = std::min(count, unfunded_.size());
+
+    std::vector<std::string> addresses{std::make_move_iterator(std::end(unfunded_) - count),
+                                       std::make_move_iterator(std::end(unfunded_))};
+    unfunded_.resize(unfunded_.size() - count);
+
+    return addresses;
+}
+
+auto OutputPool::missing() const
+    -> std::size_t
+{
+    std::unique_lock lock{mtx_};
+    return config_.target > pooled_.size()
+        ? config_.target - pooled_.size()
+        : 0;
+}
+
+auto OutputPool::size() const
+    -> std::size_t
+{
+    std::unique_lock lock{mtx_};
+    return pooled_.size();
+}
+
+auto OutputPool::numberOfHeld() const
+    -> std::size_t
+{
+    std::unique_lock lock{mtx_};
+    return std::count_if(std::begin(pooled_),
+                         std::end(pooled_),
+                         [](const auto& pooled) {
+                             return pooled.output.hasValue();
+                         });
+}
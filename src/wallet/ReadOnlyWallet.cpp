@@ -1,6 +1,9 @@
+#include <client/ReadOnlyClientBase.hpp>
 #include <lookup/LookupManager.hpp>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 #include <wallet/ReadOnlyWallet.hpp>
@@ -10,11 +13,13 @@ using forge::wallet::ReadOnlyWallet;
 using forge::core::UMEntry;
 
 
-ReadOnlyWallet::ReadOnlyWallet(std::unique_ptr<lookup::LookupManager>&& lookup)
-    : lookup_(std::move(lookup))
+ReadOnlyWallet::ReadOnlyWallet(std::shared_ptr<lookup::LookupManager> lookup,
+                               std::unique_ptr<client::ReadOnlyClientBase> reader)
+    : addresses_mtx_(std::make_unique<std::shared_mutex>()),
+      lookup_(std::move(lookup)),
+      reader_(std::move(reader))
 {
-    lookup_
-        ->getClient()
+    getReader()
         .getAddresses()
         .onValue([this](auto addresses) {
             for(auto&& addr : addresses) {
@@ -23,50 +28,49 @@ ReadOnlyWallet::ReadOnlyWallet(std::unique_ptr<lookup::LookupManager>&& lookup)
         });
 }
 
+auto ReadOnlyWallet::getReader() const
+    -> const client::ReadOnlyClientBase&
+{
+    if(reader_) {
+        return *reader_;
+    }
+
+    return lookup_->getClient();
+}
+
 auto ReadOnlyWallet::addWatchOnlyAddress(std::string adr)
     -> void
 {
+    std::unique_lock lock{*addresses_mtx_};
     watched_addresses_.insert(std::move(adr));
 }
 
 auto ReadOnlyWallet::deleteWatchOnlyAddress(const std::string& adr)
     -> void
 {
+    std::unique_lock lock{*addresses_mtx_};
     watched_addresses_.erase(adr);
 }
 
 auto ReadOnlyWallet::addNewOwnedAddress(std::string adr)
     -> void
 {
+    std::unique_lock lock{*addresses_mtx_};
     owned_addresses_.insert(std::move(adr));
 }
 
 auto ReadOnlyWallet::getOwnedUMEntrys() const
     -> std::vector<UMEntry>
 {
-    std::vector<UMEntry> ret_vec;
-    for(auto&& addr : owned_addresses_) {
-        auto new_entrys = lookup_->getUMEntrysOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
-
-    return ret_vec;
+    std::shared_lock lock{*addresses_mtx_};
+    return lookup_->getUMEntrysOfOwners(owned_addresses_);
 }
 
 auto ReadOnlyWallet::getWatchOnlyUMEntrys() const
     -> std::vector<UMEntry>
 {
-    std::vector<UMEntry> ret_vec;
-    for(auto&& addr : watched_addresses_) {
-        auto new_entrys = lookup_->getUMEntrysOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
-
-    return ret_vec;
+    std::shared_lock lock{*addresses_mtx_};
+    return lookup_->getUMEntrysOfOwners(watched_addresses_);
 }
 
 auto ReadOnlyWallet::getAllWatchedUMEntrys() const
@@ -85,29 +89,15 @@ auto ReadOnlyWallet::getAllWatchedUMEntrys() const
 auto ReadOnlyWallet::getOwnedUniqueEntrys() const
     -> std::vector<core::UniqueEntry>
 {
-    std::vector<core::UniqueEntry> ret_vec;
-    for(auto&& addr : owned_addresses_) {
-        auto new_entrys = lookup_->getUniqueEntrysOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
-
-    return ret_vec;
+    std::shared_lock lock{*addresses_mtx_};
+    return lookup_->getUniqueEntrysOfOwners(owned_addresses_);
 }
 
 auto ReadOnlyWallet::getWatchOnlyUniqueEntrys() const
     -> std::vector<core::UniqueEntry>
 {
-    std::vector<core::UniqueEntry> ret_vec;
-    for(auto&& addr : watched_addresses_) {
-        auto new_entrys = lookup_->getUniqueEntrysOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
-
-    return ret_vec;
+    std::shared_lock lock{*addresses_mtx_};
+    return lookup_->getUniqueEntrysOfOwners(watched_addresses_);
 }
 
 auto ReadOnlyWallet::getAllWatchedUniqueEntrys() const
@@ -126,29 +116,15 @@ auto ReadOnlyWallet::getAllWatchedUniqueEntrys() const
 auto ReadOnlyWallet::getOwnedUtilityTokens() const
     -> std::vector<core::UtilityToken>
 {
-    std::vector<core::UtilityToken> ret_vec;
-    for(auto&& addr : owned_addresses_) {
-        auto new_entrys = lookup_->getUtilityTokensOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
-
-    return ret_vec;
+    std::shared_lock lock{*addresses_mtx_};
+    return lookup_->getUtilityTokensOfOwners(owned_addresses_);
 }
 
 auto ReadOnlyWallet::getWatchOnlyUtilityTokens() const
     -> std::vector<core::UtilityToken>
 {
-    std::vector<core::UtilityToken> ret_vec;
-    for(auto&& addr : watched_addresses_) {
-        auto new_entrys = lookup_->getUtilityTokensOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
-
-    return ret_vec;
+    std::shared_lock lock{*addresses_mtx_};
+    return lookup_->getUtilityTokensOfOwners(watched_addresses_);
 }
 
 auto ReadOnlyWallet::getAllWatchedUtilityTokens() const
@@ -165,20 +141,23 @@ auto ReadOnlyWallet::getAllWatchedUtilityTokens() const
 }
 
 auto ReadOnlyWallet::getWatchedAddresses() const
-    -> const std::set<std::string>&
+    -> std::set<std::string>
 {
+    std::shared_lock lock{*addresses_mtx_};
     return watched_addresses_;
 }
 
 auto ReadOnlyWallet::getOwnedAddresses() const
-    -> const std::set<std::string>&
+    -> std::set<std::string>
 {
+    std::shared_lock lock{*addresses_mtx_};
     return owned_addresses_;
 }
 
 auto ReadOnlyWallet::ownesAddress(const std::string& addr) const
     -> bool
 {
+    std::shared_lock lock{*addresses_mtx_};
     return owned_addresses_.find(addr) != owned_addresses_.end();
 }
 
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <core/Coin.hpp>
 #include <core/Transaction.hpp>
+#include <cstddef>
 #include <entrys/Entry.hpp>
 #include <entrys/EntryOperation.hpp>
 #include <entrys/token/UtilityTokenOwnershipTransferOp.hpp>
@@ -8,23 +10,33 @@
 #include <entrys/umentry/UMEntryRenewalOp.hpp>
 #include <fmt/core.h>
 #include <fmt/format.h>
+#include <g3log/g3log.hpp>
+#include <limits>
 #include <lookup/LookupManager.hpp>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <utils/Algorithm.hpp>
 #include <utils/Opt.hpp>
 #include <vector>
+#include <wallet/OutputPool.hpp>
 #include <wallet/ReadOnlyWallet.hpp>
 #include <wallet/ReadWriteWallet.hpp>
+#include <wallet/UtxoSet.hpp>
 #include <wallet/WalletError.hpp>
 
 using forge::wallet::ReadOnlyWallet;
 using forge::wallet::ReadWriteWallet;
 using forge::wallet::WalletError;
+using forge::wallet::UtxoSet;
+using forge::wallet::OutputPool;
+using forge::wallet::OutputPoolConfig;
 using forge::core::UMEntry;
 using forge::core::UtilityToken;
 using forge::core::UniqueEntry;
 using forge::core::getDefaultTxFee;
+using forge::core::getMaturity;
 using forge::core::getMinimumTxAmount;
 using forge::core::toHexString;
 using forge::core::EntryKey;
@@ -33,10 +45,25 @@ using forge::core::createUMEntryCreationOpMetadata;
 using forge::core::createUMEntryUpdateOpMetadata;
 using forge::utils::Result;
 
-ReadWriteWallet::ReadWriteWallet(std::unique_ptr<lookup::LookupManager>&& lookup,
-                                 std::unique_ptr<client::WriteOnlyClientBase>&& client)
-    : ReadOnlyWallet(std::move(lookup)),
-      client_(std::move(client)) {}
+namespace {
+
+//burns of one operation which are sent to the node at the same time
+constexpr std::size_t MAX_PARALLEL_BURNS = 8;
+//outputs of one payment transaction, an output takes 34 bytes, so the
+//outputs stay far below the size limit of standard transactions
+constexpr std::size_t MAX_PAYMENT_OUTPUTS = 250;
+
+} // namespace
+
+ReadWriteWallet::ReadWriteWallet(std::shared_ptr<lookup::LookupManager> lookup,
+                                 std::unique_ptr<client::WriteOnlyClientBase>&& client,
+                                 OutputPoolConfig pool_config,
+                                 std::unique_ptr<client::ReadOnlyClientBase> reader)
+    : ReadOnlyWallet(std::move(lookup),
+                     std::move(reader)),
+      client_(std::move(client)),
+      utxos_(std::make_unique<UtxoSet>()),
+      pool_(std::make_unique<OutputPool>(std::move(pool_config))) {}
 
 
 auto ReadWriteWallet::createNewUMEntry(core::EntryKey key,
@@ -44,14 +71,7 @@ auto ReadWriteWallet::createNewUMEntry(core::EntryKey key,
                                        std::int64_t burn_amount)
     -> Result<std::string, WalletError>
 {
-    return client_
-        ->generateNewAddress() //generate new address
-        .mapError([](auto error) {
-            return WalletError{std::move(error.what())};
-        })
-        .onValue([this](auto address) {
-            addNewOwnedAddress(std::move(address));
-        })
+    return getAddressForNewEntry(burn_amount)
         .flatMap([&](auto address) {
             return createNewUMEntry(std::move(key),
                                     std::move(value),
@@ -127,14 +147,7 @@ auto ReadWriteWallet::createNewUniqueEntry(core::EntryKey key,
                                            std::int64_t burn_amount)
     -> Result<std::string, WalletError>
 {
-    return client_
-        ->generateNewAddress() //generate new address
-        .mapError([](auto error) {
-            return WalletError{std::move(error.what())};
-        })
-        .onValue([this](auto address) {
-            addNewOwnedAddress(std::move(address));
-        })
+    return getAddressForNewEntry(burn_amount)
         .flatMap([&](auto address) {
             return createNewUniqueEntry(std::move(key),
                                         std::move(value),
@@ -149,14 +162,7 @@ auto ReadWriteWallet::createNewUtilityToken(core::EntryKey id,
                                             std::int64_t burn_amount)
     -> utils::Result<std::string, WalletError>
 {
-    return client_
-        ->generateNewAddress() //generate new address
-        .mapError([](auto error) {
-            return WalletError{std::move(error.what())};
-        })
-        .onValue([this](auto address) {
-            addNewOwnedAddress(std::move(address));
-        })
+    return getAddressForNewEntry(burn_amount)
         .flatMap([&](auto address) {
             return createNewUtilityToken(std::move(id),
                                          supply,
@@ -343,58 +349,72 @@ auto ReadWriteWallet::transferUtilityTokens(core::EntryKey id,
                                             std::string new_owner,
                                             std::uint64_t amount,
                                             std::int64_t burn_amount)
-    -> utils::Result<std::vector<std::string>,
+    -> utils::Result<SplitOperationResult,
                       WalletError>
 {
-    auto send_list_res = getUtilityTokenSendVector(id,
-                                                   amount);
-
-    if(!send_list_res) {
-        return send_list_res.getError();
-    }
-    auto send_list = std::move(send_list_res.getValue());
-
-    return utils::traverse(
-        std::move(send_list),
-        [&](auto triple) {
-            auto [address, used] = std::move(triple);
-            UtilityToken token{id, used};
-            auto metadata =
-                createUtilityTokenOwnershipTransferOpMetadata(std::move(token));
-            return burn(address,
-                        new_owner,
-                        burn_amount,
-                        std::move(metadata));
+    return getUtilityTokenSendVector(id, amount)
+        .map([&](const auto& send_list) {
+            return burnParts(send_list,
+                             [&](const auto& address, auto used) {
+                                 UtilityToken token{id, used};
+                                 auto metadata =
+                                     createUtilityTokenOwnershipTransferOpMetadata(std::move(token));
+                                 return burn(address,
+                                             new_owner,
+                                             burn_amount,
+                                             std::move(metadata));
+                             });
         });
 }
 
 auto ReadWriteWallet::deleteUtilityTokens(core::EntryKey id,
                                           std::uint64_t amount,
                                           std::int64_t burn_amount)
-    -> utils::Result<std::vector<std::string>,
+    -> utils::Result<SplitOperationResult,
                       WalletError>
 {
-    auto send_list_res = getUtilityTokenSendVector(id,
-                                                   amount);
-
-    if(!send_list_res) {
-        return send_list_res.getError();
-    }
-    auto send_list = std::move(send_list_res.getValue());
-
-    return utils::traverse(
-        std::move(send_list),
-        [&](auto triple) {
-            auto [address, used] = std::move(triple);
-            UtilityToken token{id, used};
-            auto metadata =
-                createUtilityTokenDeletionOpMetadata(std::move(token));
-            return burn(address,
-                        burn_amount,
-                        std::move(metadata));
+    return getUtilityTokenSendVector(id, amount)
+        .map([&](const auto& send_list) {
+            return burnParts(send_list,
+                             [&](const auto& address, auto used) {
+                                 UtilityToken token{id, used};
+                                 auto metadata =
+                                     createUtilityTokenDeletionOpMetadata(std::move(token));
+                                 return burn(address,
+                                             burn_amount,
+                                             std::move(metadata));
+                             });
         });
 }
 
+auto ReadWriteWallet::burnParts(const std::vector<std::pair<std::string, std::uint64_t>>& parts,
+                                const std::function<utils::Result<std::string, WalletError>(const std::string&,
+                                                                                            std::uint64_t)>& burn_part)
+    -> SplitOperationResult
+{
+    //the outputs used by the burns are leased, so the burns of
+    //the different addresses cannot get in the way of each other.
+    //the node client uses a connection of its own for every call
+    auto results = utils::parallel_transform(parts,
+                                             MAX_PARALLEL_BURNS,
+                                             [&](const auto& part) {
+                                                 return burn_part(part.first,
+                                                                  part.second);
+                                             });
+
+    SplitOperationResult split;
+    for(std::size_t i = 0; i < parts.size(); i++) {
+        if(results[i]) {
+            split.txids.push_back(std::move(results[i].getValue()));
+        } else {
+            split.failures.emplace_back(parts[i].first,
+                                        std::move(results[i].getError()));
+        }
+    }
+
+    return split;
+}
+
 auto ReadWriteWallet::getUtilityTokenSendVector(const std::vector<std::byte>& token,
                                                 std::uint64_t desired_amount)
     -> utils::Result<
@@ -408,6 +428,7 @@ auto ReadWriteWallet::getUtilityTokenSendVector(const std::vector<std::byte>& to
         owned_token_balances;
 
     std::uint64_t covered{0};
+    std::shared_lock lock{*addresses_mtx_};
     for(auto&& address : owned_addresses_) {
         auto balance = lookup_->getUtilityTokenCreditOf(address,
                                                         token);
@@ -416,6 +437,7 @@ auto ReadWriteWallet::getUtilityTokenSendVector(const std::vector<std::byte>& to
             auto used = std::min(balance, desired_amount - covered);
             owned_token_balances.emplace_back(address,
                                               used);
+            covered += used;
         }
 
         if(covered == desired_amount) {
@@ -459,6 +481,115 @@ auto ReadWriteWallet::payToEntryOwner(core::EntryKey key,
         });
 }
 
+auto ReadWriteWallet::payToEntryOwners(const std::vector<std::pair<core::EntryKey, std::int64_t>>& payments)
+    -> std::vector<utils::Result<std::string, WalletError>>
+{
+    std::vector<core::EntryKey> keys;
+    keys.reserve(payments.size());
+    for(const auto& [key, amount] : payments) {
+        keys.push_back(key);
+    }
+
+    auto owners = lookup_->lookupOwners(keys).results;
+
+    //amounts are added up per owner, the owners keep the
+    //order in which they were first seen
+    std::vector<std::pair<std::string, std::int64_t>> totals;
+    std::unordered_map<std::string, std::size_t> owner_indices;
+    std::vector<utils::Opt<std::size_t>> owner_of_payment;
+    owner_of_payment.reserve(payments.size());
+    //reasons why payments are not made
+    std::vector<utils::Opt<WalletError>> rejections(payments.size());
+
+    for(std::size_t i = 0; i < payments.size(); i++) {
+        const auto& [key, amount] = payments[i];
+        owner_of_payment.emplace_back(std::nullopt);
+
+        if(!owners[i]) {
+            rejections[i] = WalletError{
+                fmt::format("unable to lookup the entry key: {}",
+                            toHexString(key))};
+            continue;
+        }
+
+        if(amount <= 0) {
+            rejections[i] = WalletError{
+                fmt::format("amount {} is not positive",
+                            amount)};
+            continue;
+        }
+
+        auto& owner = owners[i].getValue();
+        auto [iter, inserted] = owner_indices.emplace(owner, totals.size());
+        if(inserted) {
+            totals.emplace_back(owner, 0);
+        }
+
+        //a payment which would overflow the total of its
+        //owner is rejected, the others are still made
+        auto& total = totals[iter->second].second;
+        if(amount > std::numeric_limits<std::int64_t>::max() - total) {
+            rejections[i] = WalletError{
+                fmt::format("payment of {} to {} exceeds the maximum total amount",
+                            amount,
+                            owner)};
+            continue;
+        }
+
+        total += amount;
+        owner_of_payment.back() = iter->second;
+    }
+
+    //owners whose total is below the minimum get an error instead of a txid
+    auto min_amount = getMinimumTxAmount(lookup_->getCoin());
+    std::vector<utils::Opt<utils::Result<std::string, WalletError>>> owner_results(totals.size());
+    std::vector<std::size_t> payable;
+    for(std::size_t i = 0; i < totals.size(); i++) {
+        if(totals[i].second < min_amount) {
+            owner_results[i] = utils::Result<std::string, WalletError>{
+                WalletError{
+                    fmt::format("payment of {} to {} is below the minimum of {}",
+                                totals[i].second,
+                                totals[i].first,
+                                min_amount)}};
+        } else {
+            payable.push_back(i);
+        }
+    }
+
+    for(std::size_t begin = 0; begin < payable.size(); begin += MAX_PAYMENT_OUTPUTS) {
+        auto end = std::min(begin + MAX_PAYMENT_OUTPUTS, payable.size());
+
+        std::vector<std::pair<std::string, std::int64_t>> outputs;
+        outputs.reserve(end - begin);
+        for(auto i = begin; i < end; i++) {
+            outputs.push_back(totals[payable[i]]);
+        }
+
+        auto res = client_
+                       ->sendToMany(std::move(outputs))
+                       .mapError([](auto error) {
+                           return WalletError{std::move(error.what())};
+                       });
+
+        for(auto i = begin; i < end; i++) {
+            owner_results[payable[i]] = res;
+        }
+    }
+
+    std::vector<utils::Result<std::string, WalletError>> results;
+    results.reserve(payments.size());
+    for(std::size_t i = 0; i < payments.size(); i++) {
+        if(owner_of_payment[i]) {
+            results.push_back(owner_results[owner_of_payment[i].getValue()].getValue());
+        } else {
+            results.emplace_back(std::move(rejections[i].getValue()));
+        }
+    }
+
+    return results;
+}
+
 auto ReadWriteWallet::createEntryOwnerPairFromKey(core::EntryKey key)
     -> utils::Result<std::pair<core::Entry,
                                 std::string>,
@@ -523,6 +654,195 @@ auto ReadWriteWallet::createRenewableEntryOwnerPairFromKey(core::EntryKey key)
                      std::move(owner)};
 }
 
+auto ReadWriteWallet::maintainOutputPool()
+    -> utils::Result<std::size_t, WalletError>
+{
+    const auto& config = pool_->getConfig();
+    if(config.target == 0) {
+        return std::size_t{0};
+    }
+
+    if(!syncUnspent()) {
+        return WalletError{"unable to read the unspent outputs of the wallet"};
+    }
+
+    auto coin = lookup_->getCoin();
+    auto height = lookup_->getLookupBlockHeight();
+
+    //the node would use the arrived outputs to fund other
+    //transactions, an output which cannot be locked yet is
+    //tried again with the next call
+    for(auto& output : pool_->arrived(*utxos_)) {
+        if(client_->lockOutput(output.getTxid(), output.getVoutIdx())) {
+            pool_->hold(std::move(output));
+        }
+    }
+
+    if(auto dropped = pool_->prune(*utxos_, height, getMaturity(coin));
+       dropped > 0) {
+        LOG(WARNING) << fmt::format("dropped {} outputs of the output pool which never matured",
+                                    dropped);
+    }
+
+    //a pool output pays the burn, the fee and the
+    //minimal output the change goes to
+    auto value = config.burn_amount
+        + getDefaultTxFee(coin)
+        + getMinimumTxAmount(coin);
+
+    auto missing = std::min(pool_->missing(), MAX_PAYMENT_OUTPUTS);
+
+    //addresses of a funding transaction which failed
+    //are used first, instead of generating new ones
+    auto addresses = pool_->takeUnfunded(missing);
+    addresses.reserve(missing);
+
+    while(addresses.size() < missing) {
+        auto address_res = client_->generateNewAddress();
+        if(!address_res) {
+            pool_->keepUnfunded(std::move(addresses));
+            return WalletError{std::move(address_res.getError().what())};
+        }
+
+        addresses.push_back(std::move(address_res.getValue()));
+    }
+
+    if(addresses.empty()) {
+        return std::size_t{0};
+    }
+
+    std::vector<std::pair<std::string, std::int64_t>> outputs;
+    outputs.reserve(addresses.size());
+    for(const auto& address : addresses) {
+        outputs.emplace_back(address, value);
+    }
+
+    return client_
+        ->sendToMany(std::move(outputs))
+        .mapError([&](auto error) {
+            pool_->keepUnfunded(std::move(addresses));
+            return WalletError{std::move(error.what())};
+        })
+        .map([&](auto /*unused*/) {
+            pool_->add(addresses, height);
+            return addresses.size();
+        });
+}
+
+auto ReadWriteWallet::getOutputPool() const
+    -> const OutputPool&
+{
+    return *pool_;
+}
+
+auto ReadWriteWallet::getAddressForNewEntry(std::int64_t burn_amount)
+    -> utils::Result<std::string, WalletError>
+{
+    auto coin = lookup_->getCoin();
+
+    //a matured pool output can be burned right away, so
+    //the entry is created from the address holding it.
+    //the output stays locked until the burn takes it
+    if(burn_amount <= pool_->getConfig().burn_amount) {
+        auto reserved = pool_->reserve(burn_amount + getDefaultTxFee(coin),
+                                       getMinimumTxAmount(coin));
+        if(reserved) {
+            addNewOwnedAddress(reserved.getValue());
+            return std::move(reserved.getValue());
+        }
+    }
+
+    return client_
+        ->generateNewAddress() //generate new address
+        .mapError([](auto error) {
+            return WalletError{std::move(error.what())};
+        })
+        .onValue([this](auto address) {
+            addNewOwnedAddress(std::move(address));
+        });
+}
+
+auto ReadWriteWallet::syncUnspent()
+    -> bool
+{
+    //outputs only become spendable with new blocks, so
+    //the node is asked at most once per block
+    auto height = lookup_->getLookupBlockHeight();
+    if(auto synced = utxos_->getBlockHeight();
+       synced && synced.getValue() == height) {
+        return true;
+    }
+
+    auto unspents_res = getReader().getUnspent();
+    if(!unspents_res) {
+        return false;
+    }
+
+    utxos_->reset(std::move(unspents_res.getValue()), height);
+    return true;
+}
+
+auto ReadWriteWallet::leaseFundingOutput(const std::string& address,
+                                         std::int64_t needed)
+    -> utils::Opt<UtxoSet::Lease>
+{
+    //a reserved pool output of the address is still locked,
+    //so it is leased without locking it again
+    if(auto pooled = pool_->take(address)) {
+        return utxos_->addLeased(std::move(pooled.getValue()));
+    }
+
+    if(!syncUnspent()) {
+        return std::nullopt;
+    }
+
+    auto lease = utxos_->lease(address,
+                               needed,
+                               getMinimumTxAmount(lookup_->getCoin()));
+    if(!lease) {
+        return std::nullopt;
+    }
+
+    //the node wallet funds the operations without an output of their own,
+    //so the output is locked before the lease is handed out, otherwise the
+    //node could spend it for one of them. an output which cannot be locked
+    //is given back and not used
+    const auto& unspent = lease.getValue().getUnspent();
+    if(!client_->lockOutput(unspent.getTxid(), unspent.getVoutIdx())) {
+        return std::nullopt;
+    }
+
+    return lease;
+}
+
+auto ReadWriteWallet::writeLeasedTx(UtxoSet::Lease lease,
+                                    std::vector<std::byte> metadata,
+                                    std::int64_t burn_value,
+                                    std::vector<std::pair<std::string, std::int64_t>> outputs)
+    -> utils::Result<std::string, WalletError>
+{
+    const auto& unspent = lease.getUnspent();
+
+    return client_
+        ->writeTxToBlockchain(unspent.getTxid(),
+                              unspent.getVoutIdx(),
+                              std::move(metadata),
+                              burn_value,
+                              std::move(outputs))
+        .onValue([&](const auto& /*unused*/) {
+            lease.spend();
+        })
+        .onError([&](const auto& /*unused*/) {
+            //the output could already be spent or be invalid,
+            //so it is not offered to the next operation again
+            client_->unlockOutput(unspent.getTxid(), unspent.getVoutIdx());
+            lease.drop();
+        })
+        .mapError([](auto error) {
+            return WalletError{std::move(error.what())};
+        });
+}
+
 auto ReadWriteWallet::burn(const std::string& address,
                            std::int64_t burn_amount,
                            std::vector<std::byte> metadata)
@@ -530,6 +850,32 @@ auto ReadWriteWallet::burn(const std::string& address,
 {
     auto default_fee = getDefaultTxFee(getLookup().getCoin());
 
+    //spend an output the address already holds, so the
+    //operation needs one transaction instead of two
+    if(auto lease = leaseFundingOutput(address, burn_amount + default_fee);
+       lease) {
+        auto change = lease.getValue().getUnspent().getValue()
+            - (burn_amount + default_fee);
+
+        std::vector<std::pair<std::string, std::int64_t>> outputs;
+        if(change > 0) {
+            outputs.emplace_back(address, change);
+        }
+
+        auto txid_res = writeLeasedTx(std::move(lease.getValue()),
+                                      metadata,
+                                      burn_amount,
+                                      std::move(outputs));
+        if(txid_res) {
+            addNewOwnedAddress(address);
+            return txid_res;
+        }
+
+        LOG(WARNING) << fmt::format("unable to spend an output of {}, funding a new one: {}",
+                                    address,
+                                    txid_res.getError().what());
+    }
+
     return client_
         //send the needed amount to the address
         ->sendToAddress(burn_amount
@@ -564,6 +910,34 @@ auto ReadWriteWallet::burn(const std::string& owner,
     -> utils::Result<std::string, WalletError>
 {
     auto coin = getLookup().getCoin();
+    auto needed = burn_amount
+        + getMinimumTxAmount(coin)
+        + getDefaultTxFee(coin);
+
+    //the new owner has to be the first output, the change
+    //goes back to the owner
+    if(auto lease = leaseFundingOutput(owner, needed);
+       lease) {
+        auto change = lease.getValue().getUnspent().getValue() - needed;
+
+        std::vector<std::pair<std::string, std::int64_t>> outputs{
+            {new_owner, getMinimumTxAmount(coin)}};
+        if(change > 0) {
+            outputs.emplace_back(owner, change);
+        }
+
+        auto txid_res = writeLeasedTx(std::move(lease.getValue()),
+                                      metadata,
+                                      burn_amount,
+                                      std::move(outputs));
+        if(txid_res) {
+            return txid_res;
+        }
+
+        LOG(WARNING) << fmt::format("unable to spend an output of {}, funding a new one: {}",
+                                    owner,
+                                    txid_res.getError().what());
+    }
 
     return client_
         //send +minTxAmount because this will be send to the new owner address
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <utils/Opt.hpp>
+#include <vector>
+#include <wallet/UtxoSet.hpp>
+
+using forge::wallet::UtxoSet;
+
+UtxoSet::Lease::Lease(UtxoSet* set,
+                      core::Unspent unspent)
+    : set_(set),
+      unspent_(std::move(unspent)) {}
+
+UtxoSet::Lease::Lease(Lease&& other) noexcept
+    : set_(std::exchange(other.set_, nullptr)),
+      unspent_(std::move(other.unspent_)) {}
+
+UtxoSet::Lease::~Lease()
+{
+    if(set_ != nullptr) {
+        set_->release(unspent_);
+    }
+}
+
+auto UtxoSet::Lease::getUnspent() const
+    -> const core::Unspent&
+{
+    return unspent_;
+}
+
+auto UtxoSet::Lease::spend()
+    -> void
+{
+    if(set_ != nullptr) {
+        set_->spend(unspent_.getTxid(), unspent_.getVoutIdx());
+        set_ = nullptr;
+    }
+}
+
+auto UtxoSet::Lease::drop()
+    -> void
+{
+    if(set_ != nullptr) {
+        set_->spend(unspent_.getTxid(), unspent_.getVoutIdx());
+        set_ = nullptr;
+    }
+}
+
+auto UtxoSet::reset(std::vector<core::Unspent> unspents,
+                    std::int64_t block_height)
+    -> void
+{
+    std::unique_lock lock{mtx_};
+    by_address_.clear();
+    by_outpoint_.clear();
+
+    for(auto& unspent : unspents) {
+        insert(std::move(unspent));
+    }
+
+    block_height_ = block_height;
+}
+
+auto UtxoSet::addLeased(core::Unspent unspent)
+    -> Lease
+{
+    std::unique_lock lock{mtx_};
+    leased_.emplace(unspent.getTxid(), unspent.getVoutIdx());
+    insert(unspent);
+
+    return Lease{this, std::move(unspent)};
+}
+
+auto UtxoSet::getBlockHeight() const
+    -> utils::Opt<std::int64_t>
+{
+    std::unique_lock lock{mtx_};
+    return block_height_;
+}
+
+auto UtxoSet::spend(const std::string& txid,
+                    std::int64_t vout_idx)
+    -> bool
+{
+    std::unique_lock lock{mtx_};
+    leased_.erase(Outpoint{txid, vout_idx});
+
+    auto entry = by_outpoint_.find(Outpoint{txid, vout_idx});
+    if(entry == std::end(by_outpoint_)) {
+        return false;
+    }
+
+    auto& [address, iter] = entry->second;
+    auto outputs = by_address_.find(address);
+    outputs->second.erase(iter);
+    if(outputs->second.empty()) {
+        by_address_.erase(outputs);
+    }
+
+    by_outpoint_.erase(entry);
+    return true;
+}
+
+auto UtxoSet::select(const std::string& address,
+                     std::int64_t needed,
+                     std::int64_t min_change) const
+    -> utils::Opt<core::Unspent>
+{
+    std::unique_lock lock{mtx_};
+    if(const auto* unspent = findFitting(address, needed, min_change);
+       unspent != nullptr) {
+        return *unspent;
+    }
+
+    return std::nullopt;
+}
+
+auto UtxoSet::lease(const std::string& address,
+                    std::int64_t needed,
+                    std::int64_t min_change)
+    -> utils::Opt<Lease>
+{
+    std::unique_lock lock{mtx_};
+    const auto* unspent = findFitting(address, needed, min_change);
+    if(unspent == nullptr) {
+        return std::nullopt;
+    }
+
+    leased_.emplace(unspent->getTxid(), unspent->getVoutIdx());
+    return Lease{this, *unspent};
+}
+
+auto UtxoSet::size() const
+    -> std::size_t
+{
+    std::unique_lock lock{mtx_};
+    return by_outpoint_.size();
+}
+
+auto UtxoSet::numberOfLeased() const
+    -> std::size_t
+{
+    std::unique_lock lock{mtx_};
+    return leased_.size();
+}
+
+auto UtxoSet::insert(core::Unspent unspent)
+    -> void
+{
+    Outpoint outpoint{unspent.getTxid(), unspent.getVoutIdx()};
+    if(by_outpoint_.count(outpoint) > 0) {
+        return;
+    }
+
+    auto address = unspent.getAddress();
+    auto value = unspent.getValue();
+
+    auto iter = by_address_[address].emplace(value, std::move(unspent));
+    by_outpoint_.emplace(std::move(outpoint),
+                         std::pair{std::move(address), iter});
+}
+
+auto UtxoSet::findFitting(const std::string& address,
+                          std::int64_t needed,
+                          std::int64_t min_change) const
+    -> const core::Unspent*
+{
+    auto outputs = by_address_.find(address);
+    if(outputs == std::end(by_address_)) {
+        return nullptr;
+    }
+
+    auto is_free = [this](const auto& entry) {
+        const auto& unspent = entry.second;
+        return leased_.count(Outpoint{unspent.getTxid(), unspent.getVoutIdx()}) == 0;
+    };
+
+    //an output which is used completely needs no change,
+    //otherwise the change has to be at least min_change
+    const auto& by_value = outputs->second;
+    auto [first, last] = by_value.equal_range(needed);
+    if(auto exact = std::find_if(first, last, is_free);
+       exact != last) {
+        return &exact->second;
+    }
+
+    if(auto fitting = std::find_if(by_value.lower_bound(needed + min_change),
+                                   std::end(by_value),
+                                   is_free);
+       fitting != std::end(by_value)) {
+        return &fitting->second;
+    }
+
+    return nullptr;
+}
+
+auto UtxoSet::release(const core::Unspent& unspent)
+    -> void
+{
+    std::unique_lock lock{mtx_};
+    leased_.erase(Outpoint{unspent.getTxid(), unspent.getVoutIdx()});
+}
@@ -0,0 +1,228 @@
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <rpc/AdmissionControl.hpp>
+#include <rpc/JobQueue.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using forge::rpc::AdmissionController;
+using forge::rpc::AdmissionLimits;
+using forge::rpc::AdmissionRejected;
+using forge::rpc::JobQueue;
+using forge::rpc::JobState;
+using forge::rpc::NoWaitScope;
+using forge::rpc::Priority;
+using forge::rpc::priorityOf;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto limitsOf(std::size_t max_concurrent,
+              std::size_t max_queued,
+              std::chrono::milliseconds queue_timeout)
+    -> AdmissionLimits
+{
+    AdmissionLimits limits;
+    limits.max_concurrent = max_concurrent;
+    limits.class_limits = {0, 0, 0};
+    limits.max_queued = max_queued;
+    limits.queue_timeout = queue_timeout;
+    return limits;
+}
+
+auto waitForQueued(const AdmissionController& controller,
+                   Priority priority,
+                   std::size_t queued)
+    -> void
+{
+    auto index = static_cast<std::size_t>(priority);
+    while(controller.getStats()[index].queued != queued) {
+        std::this_thread::sleep_for(1ms);
+    }
+}
+
+} // namespace
+
+TEST(AdmissionControlTest, PriorityOfTest)
+{
+    EXPECT_EQ(priorityOf("lookupowner"), Priority::Lookup);
+    EXPECT_EQ(priorityOf("getbalances"), Priority::Lookup);
+    EXPECT_EQ(priorityOf("getownedumentrys"), Priority::WalletRead);
+    EXPECT_EQ(priorityOf("createnewumentry"), Priority::WalletWrite);
+    EXPECT_EQ(priorityOf("rebuildlookup"), Priority::WalletWrite);
+    EXPECT_EQ(priorityOf("someunknownmethod"), Priority::WalletWrite);
+}
+
+TEST(AdmissionControlTest, TimeoutTest)
+{
+    AdmissionController controller{limitsOf(1, 10, 20ms)};
+
+    auto permit = controller.admit("lookupowner");
+    EXPECT_THROW(controller.admit("lookupowner"), AdmissionRejected);
+
+    auto stats = controller.getStats()[0];
+    EXPECT_EQ(stats.in_flight, 1);
+    EXPECT_EQ(stats.queued, 0);
+    EXPECT_EQ(stats.admitted, 1);
+    EXPECT_EQ(stats.timed_out, 1);
+}
+
+TEST(AdmissionControlTest, NoWaitTest)
+{
+    AdmissionController controller{limitsOf(1, 10, 5s)};
+
+    auto permit = controller.admit("lookupowner");
+
+    {
+        NoWaitScope no_wait;
+        EXPECT_TRUE(NoWaitScope::isActive());
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_THROW(controller.admit("lookupowner"), AdmissionRejected);
+        EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+    }
+
+    EXPECT_FALSE(NoWaitScope::isActive());
+
+    auto stats = controller.getStats()[0];
+    EXPECT_EQ(stats.rejected, 1);
+    EXPECT_EQ(stats.queued, 0);
+    EXPECT_EQ(stats.timed_out, 0);
+}
+
+TEST(AdmissionControlTest, LongPollLimitTest)
+{
+    auto limits = limitsOf(1, 10, 20ms);
+    limits.max_long_polls = 2;
+    AdmissionController controller{std::move(limits)};
+
+    //long-polls do not take a slot
+    auto permit = controller.admit("lookupowner");
+
+    {
+        auto first = controller.admit("getchangessince");
+        auto second = controller.admit("waitjob");
+        EXPECT_EQ(controller.getLongPolls(), 2);
+        EXPECT_THROW(controller.admit("getchangessince"), AdmissionRejected);
+    }
+
+    EXPECT_EQ(controller.getLongPolls(), 0);
+    auto third = controller.admit("getchangessince");
+    EXPECT_EQ(controller.getLongPolls(), 1);
+    EXPECT_EQ(controller.getStats()[0].in_flight, 1);
+}
+
+TEST(AdmissionControlTest, MethodLimitTest)
+{
+    auto limits = limitsOf(0, 10, 20ms);
+    limits.method_limits = {{"rebuildlookup", 1}};
+    AdmissionController controller{std::move(limits)};
+
+    {
+        auto permit = controller.admit("rebuildlookup");
+        EXPECT_THROW(controller.admit("rebuildlookup"), AdmissionRejected);
+        EXPECT_NO_THROW(controller.admit("createnewumentry"));
+    }
+
+    //the slot was given back with the permit
+    EXPECT_NO_THROW(controller.admit("rebuildlookup"));
+}
+
+TEST(AdmissionControlTest, HigherPriorityFirstTest)
+{
+    AdmissionController controller{limitsOf(1, 10, 5s)};
+
+    std::mutex mtx;
+    std::vector<std::string> order;
+    auto run = [&](const std::string& method) {
+        auto permit = controller.admit(method);
+        std::unique_lock lock{mtx};
+        order.push_back(method);
+    };
+
+    auto permit = std::make_unique<AdmissionController::Permit>(controller.admit("lookupowner"));
+
+    std::thread writer{run, "createnewumentry"};
+    waitForQueued(controller, Priority::WalletWrite, 1);
+    std::thread reader{run, "getownedumentrys"};
+    waitForQueued(controller, Priority::WalletRead, 1);
+    std::thread lookup{run, "lookupowner"};
+    waitForQueued(controller, Priority::Lookup, 1);
+
+    permit.reset();
+    writer.join();
+    reader.join();
+    lookup.join();
+
+    std::vector<std::string> expected{"lookupowner",
+                                      "getownedumentrys",
+                                      "createnewumentry"};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(AdmissionControlTest, ShedTest)
+{
+    AdmissionController controller{limitsOf(1, 1, 5s)};
+
+    auto permit = std::make_unique<AdmissionController::Permit>(controller.admit("lookupowner"));
+
+    bool shed = false;
+    std::thread writer{[&] {
+        try {
+            controller.admit("createnewumentry");
+        } catch(const AdmissionRejected&) {
+            shed = true;
+        }
+    }};
+    waitForQueued(controller, Priority::WalletWrite, 1);
+
+    //the lookup takes the place of the queued write
+    std::thread lookup{[&] {
+        controller.admit("lookupowner");
+    }};
+    writer.join();
+    EXPECT_TRUE(shed);
+
+    //the queue is full, so a request of the
+    //same priority is rejected right away
+    EXPECT_THROW(controller.admit("lookupmany"), AdmissionRejected);
+
+    permit.reset();
+    lookup.join();
+
+    auto stats = controller.getStats();
+    EXPECT_EQ(stats[0].admitted, 2);
+    EXPECT_EQ(stats[0].rejected, 1);
+    EXPECT_EQ(stats[2].shed, 1);
+    EXPECT_EQ(stats[2].queued, 0);
+}
+
+TEST(AdmissionControlTest, JobWaitsWithoutDeadlineTest)
+{
+    auto limits = limitsOf(0, 10, 20ms);
+    limits.class_limits = {0, 0, 2};
+    AdmissionController controller{std::move(limits)};
+    JobQueue jobs{1, 10, 10};
+
+    auto first = std::make_unique<AdmissionController::Permit>(controller.admit("createnewumentry"));
+    auto second = controller.admit("createnewumentry");
+    EXPECT_THROW(controller.admit("createnewumentry"), AdmissionRejected);
+
+    auto id = jobs.submit("createnewumentry", [&] {
+                      auto permit = controller.admitJob("createnewumentry");
+                      return Json::Value{true};
+                  })
+                  .getValue();
+
+    //the job waits far longer than a request would
+    auto status = jobs.waitFor(id, 200ms).getValue();
+    EXPECT_EQ(status.state, JobState::Running);
+
+    first.reset();
+    status = jobs.waitFor(id, 5s).getValue();
+    EXPECT_EQ(status.state, JobState::Done);
+    EXPECT_EQ(controller.getStats()[2].timed_out, 1);
+}
@@ -0,0 +1,52 @@
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <utils/Algorithm.hpp>
+#include <vector>
+
+using forge::utils::parallel_transform;
+using namespace std::chrono_literals;
+
+TEST(AlgorithmTest, ParallelTransformKeepsOrderTest)
+{
+    std::vector<int> input(100);
+    for(int i = 0; i < 100; i++) {
+        input[i] = i;
+    }
+
+    std::atomic_int running{0};
+    std::atomic_int max_running{0};
+
+    auto output = parallel_transform(input, 4, [&](int i) {
+        auto now = ++running;
+        auto max = max_running.load();
+        while(now > max && !max_running.compare_exchange_weak(max, now)) {}
+
+        std::this_thread::sleep_for(1ms);
+        running--;
+        return i * 2;
+    });
+
+    ASSERT_EQ(output.size(), input.size());
+    for(int i = 0; i < 100; i++) {
+        EXPECT_EQ(output[i], i * 2);
+    }
+
+    EXPECT_LE(max_running.load(), 4);
+    EXPECT_TRUE(parallel_transform(std::vector<int>{}, 4, [](int i) { return i; }).empty());
+}
+
+TEST(AlgorithmTest, ParallelTransformRethrowsTest)
+{
+    std::vector<int> input{1, 2, 3, 4};
+
+    EXPECT_THROW(parallel_transform(input, 2, [](int i) {
+                     if(i == 3) {
+                         throw std::runtime_error{"three"};
+                     }
+                     return i;
+                 }),
+                 std::runtime_error);
+}
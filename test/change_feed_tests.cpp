@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <lookup/ChangeFeed.hpp>
+#include <thread>
+#include <vector>
+
+using forge::lookup::BlockChanges;
+using forge::lookup::ChangeFeed;
+
+namespace {
+auto changesWithKey(std::int64_t height)
+    -> BlockChanges
+{
+    BlockChanges changes{height, {}, {}, {}, {}, {}, {}};
+    changes.created.push_back({static_cast<std::byte>(height & 0xFF)});
+    return changes;
+}
+} // namespace
+
+TEST(ChangeFeedTest, ChangesSinceTest)
+{
+    ChangeFeed feed{10};
+
+    feed.push(changesWithKey(11));
+    feed.push(BlockChanges{12, {}, {}, {}, {}, {}, {}});
+    feed.push(changesWithKey(13));
+
+    auto all = feed.getChangesSince(10);
+    ASSERT_TRUE(all);
+    EXPECT_EQ(all.getValue().block_height, 13);
+
+    //empty blocks are left out
+    ASSERT_EQ(all.getValue().blocks.size(), 2);
+    EXPECT_EQ(all.getValue().blocks[0].block_height, 11);
+    EXPECT_EQ(all.getValue().blocks[1].block_height, 13);
+
+    auto newer = feed.getChangesSince(11);
+    ASSERT_TRUE(newer);
+    ASSERT_EQ(newer.getValue().blocks.size(), 1);
+    EXPECT_EQ(newer.getValue().blocks[0].block_height, 13);
+
+    auto none = feed.getChangesSince(13);
+    ASSERT_TRUE(none);
+    EXPECT_TRUE(none.getValue().blocks.empty());
+
+    //the feed only knows blocks after its start
+    EXPECT_FALSE(feed.getChangesSince(9));
+}
+
+TEST(ChangeFeedTest, DropsOldestBlocksTest)
+{
+    ChangeFeed feed{0, 3};
+
+    for(std::int64_t height = 1; height <= 5; height++) {
+        feed.push(changesWithKey(height));
+    }
+
+    EXPECT_EQ(feed.getRetainedSince(), 2);
+    EXPECT_FALSE(feed.getChangesSince(1));
+
+    auto retained = feed.getChangesSince(2);
+    ASSERT_TRUE(retained);
+    ASSERT_EQ(retained.getValue().blocks.size(), 3);
+    EXPECT_EQ(retained.getValue().blocks.front().block_height, 3);
+
+    //consumers have to resync after a reset
+    feed.reset(5);
+    EXPECT_FALSE(feed.getChangesSince(4));
+    ASSERT_TRUE(feed.getChangesSince(5));
+    EXPECT_TRUE(feed.getChangesSince(5).getValue().blocks.empty());
+}
+
+TEST(ChangeFeedTest, WaitForChangesTest)
+{
+    using namespace std::chrono_literals;
+
+    ChangeFeed feed{10};
+
+    //nothing arrives before the timeout
+    auto start = std::chrono::steady_clock::now();
+    auto timed_out = feed.waitForChangesSince(10, 50ms);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 50ms);
+    ASSERT_TRUE(timed_out);
+    EXPECT_TRUE(timed_out.getValue().blocks.empty());
+
+    std::thread producer{[&] {
+        std::this_thread::sleep_for(20ms);
+        feed.push(changesWithKey(11));
+    }};
+
+    auto changes = feed.waitForChangesSince(10, 10s);
+    producer.join();
+
+    ASSERT_TRUE(changes);
+    EXPECT_EQ(changes.getValue().block_height, 11);
+    ASSERT_EQ(changes.getValue().blocks.size(), 1);
+}
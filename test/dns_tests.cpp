@@ -0,0 +1,333 @@
+#include <arpa/inet.h>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <dns/DnsMessage.hpp>
+#include <dns/DnsResponder.hpp>
+#include <dns/DnsServer.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <gtest/gtest.h>
+#include <map>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <utils/Opt.hpp>
+#include <vector>
+
+using namespace forge::core;
+using namespace forge::dns;
+
+namespace {
+
+auto buildQuery(const std::string& name,
+                std::uint16_t qtype,
+                std::uint16_t id = 0x1234)
+    -> std::vector<std::byte>
+{
+    std::vector<std::byte> packet{
+        static_cast<std::byte>(id >> 8),
+        static_cast<std::byte>(id),
+        std::byte{0x01}, //recursion desired
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x01}, //one question
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x00},
+        std::byte{0x00}};
+
+    std::size_t label_start = 0;
+    while(label_start <= name.size()) {
+        auto label_end = name.find('.', label_start);
+        if(label_end == std::string::npos) {
+            label_end = name.size();
+        }
+
+        packet.push_back(static_cast<std::byte>(label_end - label_start));
+        for(auto i = label_start; i < label_end; i++) {
+            packet.push_back(static_cast<std::byte>(name[i]));
+        }
+
+        label_start = label_end + 1;
+    }
+
+    packet.push_back(std::byte{0x00});
+    packet.push_back(static_cast<std::byte>(qtype >> 8));
+    packet.push_back(static_cast<std::byte>(qtype));
+    packet.push_back(std::byte{0x00});
+    packet.push_back(std::byte{0x01});
+
+    return packet;
+}
+
+auto getRcode(const std::vector<std::byte>& response)
+    -> int
+{
+    return std::to_integer<int>(response[3] & std::byte{0x0F});
+}
+
+auto getAnswerCount(const std::vector<std::byte>& response)
+    -> int
+{
+    return std::to_integer<int>(response[6]) << 8
+        | std::to_integer<int>(response[7]);
+}
+
+auto connectTcp(std::uint16_t port)
+    -> int
+{
+    auto fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+
+    timeval timeout{1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    return fd;
+}
+
+class DnsResponderTest : public ::testing::Test
+{
+protected:
+    DnsResponderTest()
+        : responder_(
+            [this](const EntryKey& key) -> forge::utils::Opt<UMEntryValue> {
+                lookups_++;
+                auto iter = values_.find(key);
+                if(iter == values_.end()) {
+                    return std::nullopt;
+                }
+                return iter->second;
+            },
+            300) {}
+
+    auto addValue(const std::string& name, UMEntryValue value)
+        -> void
+    {
+        values_.emplace(stringToASCIIByteVec(name), std::move(value));
+    }
+
+    std::map<EntryKey, UMEntryValue> values_;
+    int lookups_ = 0;
+    DnsResponder responder_;
+    std::vector<std::byte> response_;
+};
+
+} // namespace
+
+TEST(DnsMessageTest, ParseQuery)
+{
+    auto packet = buildQuery("Some.Forge", TYPE_AAAA);
+    auto query_opt = parseDnsQuery(packet);
+
+    ASSERT_TRUE(query_opt);
+    auto& query = query_opt.getValue();
+    EXPECT_EQ(query.id, 0x1234);
+    EXPECT_TRUE(query.recursion_desired);
+    EXPECT_EQ(query.name, "some.forge");
+    EXPECT_EQ(query.qtype, TYPE_AAAA);
+    EXPECT_EQ(query.qclass, CLASS_IN);
+    EXPECT_EQ(query.question_end, packet.size());
+}
+
+TEST(DnsMessageTest, ParseQueryInvalid)
+{
+    auto packet = buildQuery("some.forge", TYPE_A);
+
+    //truncated question
+    EXPECT_FALSE(parseDnsQuery(forge::utils::ByteView{packet.data(), packet.size() - 1}));
+
+    //a response instead of a query
+    auto response = packet;
+    response[2] |= std::byte{0x80};
+    EXPECT_FALSE(parseDnsQuery(response));
+
+    //compression pointer in the question
+    auto pointer = packet;
+    pointer[12] = std::byte{0xC0};
+    EXPECT_FALSE(parseDnsQuery(pointer));
+
+    //header only
+    EXPECT_FALSE(parseDnsQuery(forge::utils::ByteView{packet.data(), 12}));
+}
+
+TEST_F(DnsResponderTest, AnswersA)
+{
+    addValue("some.forge",
+             IPv4Value{std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1}});
+
+    auto packet = buildQuery("some.forge", TYPE_A);
+    ASSERT_TRUE(responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_));
+
+    EXPECT_EQ(response_[0], std::byte{0x12});
+    EXPECT_EQ(response_[1], std::byte{0x34});
+    //response, authoritative, recursion desired
+    EXPECT_EQ(response_[2], std::byte{0x85});
+    EXPECT_EQ(getRcode(response_), 0);
+    EXPECT_EQ(getAnswerCount(response_), 1);
+
+    //question is echoed, the record points to it
+    EXPECT_TRUE(std::equal(packet.begin() + DNS_HEADER_SIZE,
+                           packet.end(),
+                           response_.begin() + DNS_HEADER_SIZE));
+    EXPECT_EQ(response_.size(), packet.size() + 16);
+    EXPECT_EQ(response_[packet.size()], std::byte{0xC0});
+    EXPECT_EQ(response_[packet.size() + 1], std::byte{0x0C});
+
+    std::vector<std::byte> rdata(response_.end() - 4, response_.end());
+    EXPECT_EQ(rdata, (std::vector<std::byte>{std::byte{10}, std::byte{0}, std::byte{0}, std::byte{1}}));
+}
+
+TEST_F(DnsResponderTest, NoDataAndNameError)
+{
+    addValue("six.forge", IPv6Value{});
+
+    auto packet = buildQuery("six.forge", TYPE_A);
+    ASSERT_TRUE(responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_));
+    EXPECT_EQ(getRcode(response_), 0);
+    EXPECT_EQ(getAnswerCount(response_), 0);
+
+    packet = buildQuery("six.forge", TYPE_AAAA);
+    ASSERT_TRUE(responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_));
+    EXPECT_EQ(getAnswerCount(response_), 1);
+
+    packet = buildQuery("unknown.forge", TYPE_A);
+    ASSERT_TRUE(responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_));
+    EXPECT_EQ(getRcode(response_), 3);
+    EXPECT_EQ(getAnswerCount(response_), 0);
+}
+
+TEST_F(DnsResponderTest, TxtIsSplitAndTruncated)
+{
+    addValue("txt.forge", ByteArray(300, std::byte{'a'}));
+
+    auto packet = buildQuery("txt.forge", TYPE_TXT);
+    ASSERT_TRUE(responder_.respond(packet, 10, MAX_TCP_RESPONSE_SIZE, response_));
+    EXPECT_EQ(getAnswerCount(response_), 1);
+    //two character strings of 255 and 45 bytes
+    EXPECT_EQ(response_.size(), packet.size() + 12 + 302);
+    EXPECT_EQ(response_[packet.size() + 12], std::byte{255});
+    EXPECT_EQ(response_[packet.size() + 12 + 256], std::byte{45});
+
+    ASSERT_TRUE(responder_.respond(packet, 10, 100, response_));
+    EXPECT_EQ(response_[2] & std::byte{0x02}, std::byte{0x02});
+    EXPECT_EQ(getAnswerCount(response_), 0);
+    EXPECT_EQ(response_.size(), packet.size());
+}
+
+TEST_F(DnsResponderTest, CacheIsDroppedOnNewBlock)
+{
+    addValue("some.forge", IPv4Value{});
+
+    auto packet = buildQuery("some.forge", TYPE_A);
+    responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_);
+    responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_);
+    EXPECT_EQ(lookups_, 1);
+    EXPECT_EQ(responder_.getCacheHits(), 1u);
+
+    //the id of a cached answer is the one of the query
+    packet = buildQuery("some.forge", TYPE_A, 0xABCD);
+    responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_);
+    EXPECT_EQ(response_[0], std::byte{0xAB});
+    EXPECT_EQ(response_[1], std::byte{0xCD});
+
+    values_.clear();
+    responder_.respond(packet, 11, MAX_UDP_RESPONSE_SIZE, response_);
+    EXPECT_EQ(lookups_, 2);
+    EXPECT_EQ(getRcode(response_), 3);
+}
+
+TEST_F(DnsResponderTest, CacheSeparatesClasses)
+{
+    addValue("some.forge", IPv4Value{});
+
+    auto packet = buildQuery("some.forge", TYPE_A);
+    responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_);
+    EXPECT_EQ(getAnswerCount(response_), 1);
+
+    //a chaos query for the same name is refused and
+    //does not poison the answer of the internet class
+    auto chaos = packet;
+    chaos.back() = std::byte{0x03};
+    responder_.respond(chaos, 10, MAX_UDP_RESPONSE_SIZE, response_);
+    EXPECT_EQ(getRcode(response_), 5);
+    EXPECT_EQ(getAnswerCount(response_), 0);
+
+    responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_);
+    EXPECT_EQ(getRcode(response_), 0);
+    EXPECT_EQ(getAnswerCount(response_), 1);
+    EXPECT_EQ(responder_.getCacheHits(), 1u);
+
+    responder_.respond(chaos, 10, MAX_UDP_RESPONSE_SIZE, response_);
+    EXPECT_EQ(getRcode(response_), 5);
+    EXPECT_EQ(responder_.getCacheHits(), 2u);
+}
+
+TEST_F(DnsResponderTest, MalformedQueries)
+{
+    auto packet = buildQuery("some.forge", TYPE_A);
+    packet.resize(packet.size() - 2);
+
+    ASSERT_TRUE(responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_));
+    EXPECT_EQ(response_.size(), DNS_HEADER_SIZE);
+    EXPECT_EQ(getRcode(response_), 1);
+
+    //other opcodes than query are not implemented
+    packet = buildQuery("some.forge", TYPE_A);
+    packet[2] |= std::byte{0x10};
+    ASSERT_TRUE(responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_));
+    EXPECT_EQ(getRcode(response_), 4);
+
+    //responses and runts are dropped
+    packet[2] |= std::byte{0x80};
+    EXPECT_FALSE(responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_));
+    packet.resize(4);
+    EXPECT_FALSE(responder_.respond(packet, 10, MAX_UDP_RESPONSE_SIZE, response_));
+}
+
+TEST(DnsServerTest, TcpConnectionsAreServedConcurrently)
+{
+    DnsServer server{
+        [](const EntryKey&) -> forge::utils::Opt<UMEntryValue> {
+            return UMEntryValue{IPv4Value{}};
+        },
+        [] {
+            return std::int64_t{10};
+        },
+        300};
+    ASSERT_TRUE(server.start("127.0.0.1", 0, 1));
+
+    //a peer which sent only half of a length prefix
+    //does not keep the others from being answered
+    auto idle = connectTcp(server.getPort());
+    std::byte half{0x00};
+    send(idle, &half, 1, 0);
+
+    auto active = connectTcp(server.getPort());
+    auto query = buildQuery("some.forge", TYPE_A);
+    std::vector<std::byte> message{static_cast<std::byte>(query.size() >> 8),
+                                   static_cast<std::byte>(query.size())};
+    message.insert(message.end(), query.begin(), query.end());
+
+    for(int i = 0; i < 2; i++) {
+        ASSERT_EQ(send(active, message.data(), message.size(), 0),
+                  static_cast<ssize_t>(message.size()));
+
+        std::vector<std::byte> response(2 + query.size() + 16);
+        ASSERT_EQ(recv(active, response.data(), response.size(), MSG_WAITALL),
+                  static_cast<ssize_t>(response.size()));
+        EXPECT_EQ(response[1], static_cast<std::byte>(query.size() + 16));
+    }
+
+    close(active);
+    close(idle);
+    server.stop();
+}
@@ -186,3 +186,79 @@ TEST(UMEntryLookupTest, BasicUMEntryUpdateTest)
     EXPECT_EQ(UMEntryValue{expected2},
               lookup.lookup(second_key).getValue().get());
 }
+
+TEST(UMEntryLookupTest, PagedUMEntrysOfOwnerTest)
+{
+    std::string owner = "oLupzckPUYtGydsBisL86zcwsBweJm1dSM";
+    std::string other = "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W";
+
+    std::vector<UMEntryOperation> ops;
+    for(auto key : {"04", "01", "03", "05", "02"}) {
+        ops.emplace_back(createOp("6a00c6dc7501010400000000" + std::string{key},
+                                  std::string{owner},
+                                  10,
+                                  10));
+    }
+    ops.emplace_back(createOp("6a00c6dc750101040000000006",
+                              std::string{other},
+                              10,
+                              10));
+
+    UMEntryLookup lookup{nullptr, 0};
+    lookup.executeOperations(std::move(ops));
+
+    auto key_of = [](const std::string& hex) {
+        return stringToByteVec(hex).getValue();
+    };
+
+    //pages are ordered by key and continue after the given key
+    auto first = lookup.getUMEntrysOfOwner(owner, std::nullopt, 2);
+    ASSERT_EQ(first.size(), 2);
+    EXPECT_EQ(first[0].getKey(), key_of("0000000001"));
+    EXPECT_EQ(first[1].getKey(), key_of("0000000002"));
+
+    auto second = lookup.getUMEntrysOfOwner(owner, first.back().getKey(), 2);
+    ASSERT_EQ(second.size(), 2);
+    EXPECT_EQ(second[0].getKey(), key_of("0000000003"));
+    EXPECT_EQ(second[1].getKey(), key_of("0000000004"));
+
+    auto last = lookup.getUMEntrysOfOwner(owner, second.back().getKey(), 2);
+    ASSERT_EQ(last.size(), 1);
+    EXPECT_EQ(last[0].getKey(), key_of("0000000005"));
+
+    EXPECT_TRUE(lookup.getUMEntrysOfOwner(owner, last.back().getKey(), 2).empty());
+
+    //the owner index follows transfers and deletions
+    auto metadata = extractMetadata("6a00c6dc750104040000000003").getValue();
+    ops.clear();
+    ops.emplace_back(parseMetadataToUMEntryOp(metadata,
+                                              11,
+                                              std::string{owner},
+                                              10,
+                                              std::string{other})
+                         .getValue());
+    ops.emplace_back(createOp("6a00c6dc750110040000000001",
+                              std::string{owner},
+                              11,
+                              10));
+    lookup.executeOperations(std::move(ops));
+
+    auto owned = lookup.getUMEntrysOfOwner(owner);
+    ASSERT_EQ(owned.size(), 3);
+    EXPECT_EQ(owned[0].getKey(), key_of("0000000002"));
+    EXPECT_EQ(owned[1].getKey(), key_of("0000000004"));
+    EXPECT_EQ(owned[2].getKey(), key_of("0000000005"));
+
+    //entrys of several owners are ordered by owner and key
+    auto all = lookup.getUMEntrysOfOwners({owner, other});
+    ASSERT_EQ(all.size(), 5);
+    EXPECT_EQ(all[0].getKey(), key_of("0000000002"));
+    EXPECT_EQ(all[2].getKey(), key_of("0000000005"));
+    EXPECT_EQ(all[3].getKey(), key_of("0000000003"));
+    EXPECT_EQ(all[4].getKey(), key_of("0000000006"));
+
+    auto others = lookup.getUMEntrysOfOwner(other);
+    ASSERT_EQ(others.size(), 2);
+    EXPECT_EQ(others[0].getKey(), key_of("0000000003"));
+    EXPECT_EQ(others[1].getKey(), key_of("0000000006"));
+}
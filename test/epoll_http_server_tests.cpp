@@ -0,0 +1,292 @@
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <jsonrpccpp/server/iclientconnectionhandler.h>
+#include <netinet/in.h>
+#include <rpc/EpollHttpServer.hpp>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+using forge::rpc::EpollHttpServer;
+using forge::rpc::HttpParseStatus;
+using forge::rpc::parseHttpRequest;
+using forge::rpc::extractRpcMethod;
+using forge::rpc::isInlineRpcMethod;
+
+namespace {
+
+auto makeRequest(const std::string& body,
+                 const std::string& url = "/")
+    -> std::string
+{
+    return "POST " + url + " HTTP/1.1\r\n"
+           "Content-Type: application/json\r\n"
+           "Content-Length: "
+        + std::to_string(body.size())
+        + "\r\n\r\n"
+        + body;
+}
+
+//answers every request with its body, slow requests take a while
+class EchoHandler : public jsonrpc::IClientConnectionHandler
+{
+public:
+    void HandleRequest(const std::string& request, std::string& response) override
+    {
+        if(request.find("slow") != std::string::npos) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        }
+        response = request;
+    }
+};
+
+//answers every request with its body once it is released
+class BlockingHandler : public jsonrpc::IClientConnectionHandler
+{
+public:
+    void HandleRequest(const std::string& request, std::string& response) override
+    {
+        while(!released.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        response = request;
+    }
+
+    std::atomic_bool released{false};
+};
+
+//answers every request with a fixed response
+class ConstantHandler : public jsonrpc::IClientConnectionHandler
+{
+public:
+    explicit ConstantHandler(std::string response)
+        : response_(std::move(response)) {}
+
+    void HandleRequest(const std::string& /*unused*/, std::string& response) override
+    {
+        response = response_;
+    }
+
+private:
+    std::string response_;
+};
+
+auto connectTo(std::uint16_t port)
+    -> int
+{
+    auto fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+
+    return fd;
+}
+
+auto receiveUntil(int fd, const std::string& end)
+    -> std::string
+{
+    std::string received;
+    char buffer[4096];
+    while(received.find(end) == std::string::npos) {
+        auto n = recv(fd, buffer, sizeof(buffer), 0);
+        if(n <= 0) {
+            break;
+        }
+        received.append(buffer, static_cast<std::size_t>(n));
+    }
+    return received;
+}
+
+} // namespace
+
+TEST(EpollHttpServerTest, ParseCompleteRequest)
+{
+    auto buffer = makeRequest(R"({"method":"lookupowner"})") + "POST";
+    auto request = parseHttpRequest(buffer, 1024);
+
+    EXPECT_EQ(request.status, HttpParseStatus::Complete);
+    EXPECT_EQ(request.target, "/");
+    EXPECT_EQ(request.body, R"({"method":"lookupowner"})");
+    EXPECT_TRUE(request.keep_alive);
+    EXPECT_EQ(request.size, buffer.size() - 4);
+}
+
+TEST(EpollHttpServerTest, ParseIncompleteRequest)
+{
+    auto buffer = makeRequest(R"({"method":"lookupowner"})");
+
+    EXPECT_EQ(parseHttpRequest(buffer.substr(0, 20), 1024).status,
+              HttpParseStatus::Incomplete);
+    EXPECT_EQ(parseHttpRequest(buffer.substr(0, buffer.size() - 1), 1024).status,
+              HttpParseStatus::Incomplete);
+}
+
+TEST(EpollHttpServerTest, ParseInvalidRequests)
+{
+    EXPECT_EQ(parseHttpRequest("GET / HTTP/1.1\r\nContent-Length: 0\r\n\r\n", 1024).status,
+              HttpParseStatus::MethodNotAllowed);
+    EXPECT_EQ(parseHttpRequest("POST / HTTP/1.1\r\n\r\n", 1024).status,
+              HttpParseStatus::BadRequest);
+    EXPECT_EQ(parseHttpRequest("POST / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n", 1024).status,
+              HttpParseStatus::BadRequest);
+    EXPECT_EQ(parseHttpRequest("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n", 1024).status,
+              HttpParseStatus::NotImplemented);
+    EXPECT_EQ(parseHttpRequest(makeRequest(std::string(2048, 'a')), 1024).status,
+              HttpParseStatus::PayloadTooLarge);
+}
+
+TEST(EpollHttpServerTest, ParseConnectionHeader)
+{
+    auto close = parseHttpRequest("POST / HTTP/1.1\r\nconnection: Close\r\ncontent-length: 0\r\n\r\n", 1024);
+    EXPECT_EQ(close.status, HttpParseStatus::Complete);
+    EXPECT_FALSE(close.keep_alive);
+
+    auto http10 = parseHttpRequest("POST / HTTP/1.0\r\nContent-Length: 0\r\n\r\n", 1024);
+    EXPECT_EQ(http10.status, HttpParseStatus::Complete);
+    EXPECT_FALSE(http10.keep_alive);
+}
+
+TEST(EpollHttpServerTest, ExtractRpcMethod)
+{
+    auto method = extractRpcMethod(R"( {"jsonrpc":"2.0", "method" : "lookupowner", "id":1})");
+    ASSERT_TRUE(method);
+    EXPECT_EQ(method.getValue(), "lookupowner");
+
+    EXPECT_FALSE(extractRpcMethod(R"([{"method":"lookupowner"}])"));
+    EXPECT_FALSE(extractRpcMethod(R"({"id":1})"));
+    EXPECT_FALSE(extractRpcMethod(R"({"method":1})"));
+
+    EXPECT_TRUE(isInlineRpcMethod("lookupowner"));
+    EXPECT_FALSE(isInlineRpcMethod("createnewumentry"));
+    EXPECT_FALSE(isInlineRpcMethod("updatelookup"));
+}
+
+TEST(EpollHttpServerTest, PipelinedResponsesKeepTheirOrder)
+{
+    EchoHandler handler;
+    EpollHttpServer server{0, 2, 2, 16, [](auto method) {
+                               return method == "fast";
+                           }};
+    server.SetHandler(&handler);
+    ASSERT_TRUE(server.StartListening());
+
+    auto fd = connectTo(server.getPort());
+
+    //the slow request runs on the worker pool, the fast one inline,
+    //but the fast response still has to come second
+    auto requests = makeRequest(R"({"method":"slow"})")
+        + makeRequest(R"({"method":"fast"})");
+    send(fd, requests.data(), requests.size(), 0);
+
+    auto received = receiveUntil(fd, R"({"method":"fast"})");
+    auto slow = received.find(R"({"method":"slow"})");
+    auto fast = received.find(R"({"method":"fast"})");
+
+    EXPECT_NE(slow, std::string::npos);
+    EXPECT_NE(fast, std::string::npos);
+    EXPECT_LT(slow, fast);
+
+    close(fd);
+    server.StopListening();
+}
+
+TEST(EpollHttpServerTest, RejectsRequestsIfTheQueueIsFull)
+{
+    EchoHandler handler;
+    EpollHttpServer server{0, 1, 1, 0, [](auto) {
+                               return false;
+                           }};
+    server.SetHandler(&handler);
+    ASSERT_TRUE(server.StartListening());
+
+    auto fd = connectTo(server.getPort());
+
+    auto request = makeRequest(R"({"method":"slow"})");
+    send(fd, request.data(), request.size(), 0);
+
+    auto received = receiveUntil(fd, "\r\n\r\n");
+    EXPECT_EQ(received.rfind("HTTP/1.1 503", 0), 0u);
+
+    close(fd);
+    server.StopListening();
+}
+
+TEST(EpollHttpServerTest, RoutesRequestsByUrl)
+{
+    EchoHandler handler;
+    ConstantHandler alice{"alice"};
+    EpollHttpServer server{0, 1, 1, 16, [](auto method) {
+                               return method == "fast";
+                           }};
+    server.SetHandler(&handler);
+    server.SetUrlHandler("/wallet/alice", &alice);
+    ASSERT_TRUE(server.StartListening());
+
+    auto fd = connectTo(server.getPort());
+
+    //inline and worker requests are both routed,
+    //unknown urls go to the handler of the connector
+    auto requests = makeRequest(R"({"method":"fast"})", "/wallet/alice")
+        + makeRequest(R"({"method":"slow"})", "/wallet/alice")
+        + makeRequest(R"({"method":"last"})", "/wallet/bob");
+    send(fd, requests.data(), requests.size(), 0);
+
+    auto received = receiveUntil(fd, R"({"method":"last"})");
+    EXPECT_EQ(received.find(R"({"method":"fast"})"), std::string::npos);
+    EXPECT_EQ(received.find(R"({"method":"slow"})"), std::string::npos);
+
+    auto first = received.find("alice");
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_NE(received.find("alice", first + 5), std::string::npos);
+
+    close(fd);
+    server.StopListening();
+}
+
+TEST(EpollHttpServerTest, DoesNotReadBehindAWorkerRequest)
+{
+    BlockingHandler handler;
+    EpollHttpServer server{0, 1, 1, 16, [](auto) {
+                               return false;
+                           }};
+    server.SetHandler(&handler);
+    ASSERT_TRUE(server.StartListening());
+
+    auto fd = connectTo(server.getPort());
+    auto request = makeRequest(R"({"method":"slow"})");
+    send(fd, request.data(), request.size(), 0);
+
+    //the server stops reading while the worker owns the connection,
+    //so only the socket buffers take the pipelined payload
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    const std::size_t payload_size = 64 * 1024 * 1024;
+    const std::string chunk(64 * 1024, 'x');
+    std::size_t sent = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{2};
+    while(sent < payload_size && std::chrono::steady_clock::now() < deadline) {
+        auto n = send(fd, chunk.data(), chunk.size(), MSG_NOSIGNAL);
+        if(n > 0) {
+            sent += static_cast<std::size_t>(n);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    }
+    EXPECT_LT(sent, payload_size / 2);
+
+    handler.released = true;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+
+    auto received = receiveUntil(fd, R"({"method":"slow"})");
+    EXPECT_NE(received.find(R"({"method":"slow"})"), std::string::npos);
+
+    close(fd);
+    server.StopListening();
+}
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <client/ClientError.hpp>
+#include <client/ReadOnlyClientBase.hpp>
+#include <client/WriteOnlyClientBase.hpp>
+#include <core/Block.hpp>
+#include <core/Coin.hpp>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <utils/Opt.hpp>
+#include <vector>
+
+//state of a node wallet shared by the fake clients, so tests
+//can run wallets without a node. like listunspent, unspent
+//outputs which are locked are not reported
+struct FakeNode
+{
+    using Outpoint = std::pair<std::string, std::int64_t>;
+    using Outputs = std::vector<std::pair<std::string, std::int64_t>>;
+
+    mutable std::mutex mtx;
+    std::int64_t height = 0;
+    std::vector<std::string> addresses;
+    std::vector<forge::core::Unspent> unspents;
+    std::set<Outpoint> locked;
+
+    //every spent output given to writeTxToBlockchain
+    std::vector<Outpoint> written;
+    //writes whose output was not locked
+    std::size_t written_unlocked = 0;
+    //address and amount of every sendToAddress
+    std::vector<std::pair<std::string, std::int64_t>> sent;
+    //outputs of every sendToMany
+    std::vector<Outputs> sent_to_many;
+
+    //forge operations by txid, the txids of the operations of
+    //every block and the address which sent each operation
+    std::map<std::string, forge::core::ForgeCandidate> candidates;
+    std::map<std::int64_t, std::vector<std::string>> blocks;
+    std::map<std::string, std::string> senders;
+
+    bool fail_writes = false;
+    bool fail_locks = false;
+    bool fail_sends = false;
+    std::size_t next_id = 0;
+
+    auto nextId(const std::string& prefix)
+        -> std::string
+    {
+        return prefix + std::to_string(next_id++);
+    }
+
+    //mines a block containing an operation sent by the address
+    auto mine(const std::string& sender,
+              std::vector<std::byte> metadata,
+              std::int64_t burn_value,
+              forge::utils::Opt<std::string> new_owner = std::nullopt)
+        -> void
+    {
+        std::unique_lock lock{mtx};
+        auto txid = nextId("op");
+        auto input = nextId("input");
+        senders.emplace(input, sender);
+        blocks[++height].push_back(txid);
+        candidates.emplace(txid,
+                           forge::core::ForgeCandidate{std::string{txid},
+                                                       forge::core::TxIn{std::move(input), 0},
+                                                       burn_value,
+                                                       std::move(metadata),
+                                                       std::move(new_owner)});
+    }
+};
+
+class FakeReadOnlyClient final : public forge::client::ReadOnlyClientBase
+{
+public:
+    explicit FakeReadOnlyClient(std::shared_ptr<FakeNode> node)
+        : ReadOnlyClientBase(forge::core::Coin::tOdin),
+          node_(std::move(node)) {}
+
+    auto getNewestBlock() const
+        -> forge::utils::Result<forge::core::Block, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto getTransaction(std::string /*txid*/) const
+        -> forge::utils::Result<forge::core::Transaction, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto getForgeCandidate(std::string txid) const
+        -> forge::utils::Result<forge::utils::Opt<forge::core::ForgeCandidate>,
+                                forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        if(auto iter = node_->candidates.find(txid);
+           iter != node_->candidates.end()) {
+            return forge::utils::Opt<forge::core::ForgeCandidate>{iter->second};
+        }
+
+        return forge::utils::Opt<forge::core::ForgeCandidate>{};
+    }
+
+    auto resolveTxIn(forge::core::TxIn vin) const
+        -> forge::utils::Result<forge::core::TxOut, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        if(auto iter = node_->senders.find(vin.getTxid());
+           iter != node_->senders.end()) {
+            return forge::core::TxOut{0, "", {iter->second}};
+        }
+
+        return forge::client::ClientError{"unknown input"};
+    }
+
+    auto getBlockCount() const
+        -> forge::utils::Result<std::int64_t, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        return node_->height;
+    }
+
+    auto getBlockHash(std::int64_t index) const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        return std::to_string(index);
+    }
+
+    auto getBlock(std::string hash) const
+        -> forge::utils::Result<forge::core::Block, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        auto height = std::stoll(hash);
+        auto txids = node_->blocks[height];
+        return forge::core::Block{std::move(txids), height, 0, std::move(hash)};
+    }
+
+    auto getUnspent() const
+        -> forge::utils::Result<std::vector<forge::core::Unspent>,
+                                forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+
+        std::vector<forge::core::Unspent> unspents;
+        for(const auto& unspent : node_->unspents) {
+            if(node_->locked.count({unspent.getTxid(), unspent.getVoutIdx()}) == 0) {
+                unspents.push_back(unspent);
+            }
+        }
+
+        return unspents;
+    }
+
+    auto getOutputValue(std::string /*txid*/,
+                        std::int64_t /*index*/) const
+        -> forge::utils::Result<std::int64_t, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto getAddresses() const
+        -> forge::utils::Result<std::vector<std::string>,
+                                forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        return node_->addresses;
+    }
+
+    auto isMainnet() const
+        -> forge::utils::Result<bool, forge::client::ClientError> override
+    {
+        return false;
+    }
+
+private:
+    std::shared_ptr<FakeNode> node_;
+};
+
+class FakeWriteClient final : public forge::client::WriteOnlyClientBase
+{
+public:
+    explicit FakeWriteClient(std::shared_ptr<FakeNode> node)
+        : node_(std::move(node)) {}
+
+    auto writeTxToBlockchain(std::string txid_input,
+                             std::int64_t index,
+                             std::vector<std::byte> /*metadata*/,
+                             std::int64_t /*burn_value*/,
+                             FakeNode::Outputs /*outputs*/) const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        node_->written.emplace_back(txid_input, index);
+        if(node_->locked.count({txid_input, index}) == 0) {
+            node_->written_unlocked++;
+        }
+
+        if(node_->fail_writes) {
+            return forge::client::ClientError{"transaction was rejected"};
+        }
+
+        spend(txid_input, index);
+        return node_->nextId("tx");
+    }
+
+    auto generateRawTx(std::string /*input_txid*/,
+                       std::int64_t /*index*/,
+                       std::vector<std::byte> /*metadata*/,
+                       std::int64_t /*burn_value*/,
+                       FakeNode::Outputs /*outputs*/) const
+        -> forge::utils::Result<std::vector<std::byte>, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto signRawTx(std::vector<std::byte> /*tx*/) const
+        -> forge::utils::Result<std::vector<std::byte>, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto sendRawTx(std::vector<std::byte> /*tx*/) const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto decodeTxidOfRawTx(const std::vector<std::byte>& /*tx*/) const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto lockOutput(std::string txid,
+                    std::int64_t index) const
+        -> forge::utils::Result<void, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        if(node_->fail_locks) {
+            return forge::client::ClientError{"unable to lock the output"};
+        }
+
+        node_->locked.emplace(std::move(txid), index);
+        return {};
+    }
+
+    auto unlockOutput(std::string txid,
+                      std::int64_t index) const
+        -> forge::utils::Result<void, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        node_->locked.erase({std::move(txid), index});
+        return {};
+    }
+
+    auto generateNewAddress() const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        auto address = node_->nextId("address");
+        node_->addresses.push_back(address);
+        return address;
+    }
+
+    auto sendToAddress(std::int64_t amount,
+                       std::string address) const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        node_->sent.emplace_back(std::move(address), amount);
+        return node_->nextId("tx");
+    }
+
+    auto sendToMany(FakeNode::Outputs amounts) const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        if(node_->fail_sends) {
+            return forge::client::ClientError{"insufficient funds"};
+        }
+
+        node_->sent_to_many.push_back(std::move(amounts));
+        return node_->nextId("tx");
+    }
+
+    auto burnAmount(std::int64_t /*amount*/,
+                    std::vector<std::byte> /*metadata*/) const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        return node_->nextId("tx");
+    }
+
+    auto burnAmount(std::string /*txid*/,
+                    std::int64_t /*index*/,
+                    std::int64_t /*amount*/,
+                    std::vector<std::byte> /*metadata*/,
+                    std::string /*change_address*/) const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        return node_->nextId("tx");
+    }
+
+    auto burnOutput(std::string /*txid*/,
+                    std::int64_t /*index*/,
+                    std::vector<std::byte> /*metadata*/) const
+        -> forge::utils::Result<std::string, forge::client::ClientError> override
+    {
+        std::unique_lock lock{node_->mtx};
+        return node_->nextId("tx");
+    }
+
+    auto getVOutIdxByAmountAndAddress(std::string /*txid*/,
+                                      std::int64_t /*amount*/,
+                                      std::string /*address*/) const
+        -> forge::utils::Result<std::int64_t, forge::client::ClientError> override
+    {
+        return std::int64_t{0};
+    }
+
+private:
+    //does not lock, the caller needs to hold the lock of the node
+    auto spend(const std::string& txid,
+               std::int64_t index) const
+        -> void
+    {
+        auto& unspents = node_->unspents;
+        for(auto iter = unspents.begin(); iter != unspents.end(); ++iter) {
+            if(iter->getTxid() == txid && iter->getVoutIdx() == index) {
+                unspents.erase(iter);
+                break;
+            }
+        }
+        node_->locked.erase({txid, index});
+    }
+
+    std::shared_ptr<FakeNode> node_;
+};
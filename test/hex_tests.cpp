@@ -0,0 +1,92 @@
+#include <core/Hex.hpp>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace forge::core;
+
+namespace {
+auto makeBytes(std::size_t size)
+    -> std::vector<std::byte>
+{
+    std::vector<std::byte> bytes(size);
+    for(std::size_t i = 0; i < size; i++) {
+        bytes[i] = static_cast<std::byte>((i * 37 + 11) & 0xFF);
+    }
+    return bytes;
+}
+} // namespace
+
+TEST(HexTest, EncodeMatchesScalarTest)
+{
+    //sizes around the register widths check the vectorised
+    //blocks as well as the scalar tails
+    for(std::size_t size = 0; size < 200; size++) {
+        auto bytes = makeBytes(size);
+
+        std::string scalar(2 * size, '\0');
+        hexEncodeScalar(bytes.data(), size, scalar.data());
+
+        EXPECT_EQ(hexEncode(bytes.data(), size), scalar);
+        EXPECT_EQ(toHexString(bytes), scalar);
+    }
+
+    std::vector<std::byte> all_bytes;
+    for(int i = 0; i < 256; i++) {
+        all_bytes.push_back(static_cast<std::byte>(i));
+    }
+    auto hex = toHexString(all_bytes);
+    EXPECT_EQ(hex.substr(0, 8), "00010203");
+    EXPECT_EQ(hex.substr(hex.size() - 8), "fcfdfeff");
+}
+
+TEST(HexTest, RoundTripTest)
+{
+    for(std::size_t size = 0; size < 200; size++) {
+        auto bytes = makeBytes(size);
+        auto hex = hexEncode(bytes.data(), size);
+
+        std::vector<std::byte> decoded(size);
+        ASSERT_TRUE(hexDecode(hex, decoded.data()));
+        EXPECT_EQ(decoded, bytes);
+
+        EXPECT_EQ(stringToByteVec(hex).getValue(), bytes);
+    }
+}
+
+TEST(HexTest, UpperCaseTest)
+{
+    auto lower = std::string{"deadbeefc6dc75aabbccddeeff00112233445566778899abcdefABCDEF0123456789"};
+    auto upper = lower;
+    for(auto& c : upper) {
+        c = static_cast<char>(std::toupper(c));
+    }
+
+    EXPECT_EQ(stringToByteVec(lower).getValue(),
+              stringToByteVec(upper).getValue());
+}
+
+TEST(HexTest, InvalidCharacterTest)
+{
+    auto bytes = makeBytes(100);
+    auto hex = hexEncode(bytes.data(), bytes.size());
+
+    //every position has to be checked, in the vectorised
+    //blocks and in the scalar tail
+    for(auto invalid : std::string{"gG/:@`xz \xff"}) {
+        for(std::size_t i = 0; i < hex.size(); i++) {
+            auto broken = hex;
+            broken[i] = invalid;
+            EXPECT_FALSE(stringToByteVec(broken));
+        }
+    }
+
+    EXPECT_FALSE(stringToByteVec("abc"));
+    EXPECT_FALSE(extractMetadata("6a00abc"));
+    EXPECT_FALSE(extractMetadata("6b00abcd"));
+    EXPECT_TRUE(extractMetadata("6a00"));
+    EXPECT_EQ(extractMetadata("6a00c6dc75").getValue(),
+              stringToByteVec("c6dc75").getValue());
+}
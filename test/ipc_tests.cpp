@@ -0,0 +1,207 @@
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <gtest/gtest.h>
+#include <ipc/BinaryProtocol.hpp>
+#include <ipc/IpcClient.hpp>
+#include <ipc/IpcServer.hpp>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace forge::core;
+using namespace forge::ipc;
+using forge::utils::ByteView;
+
+namespace {
+
+auto socketPath()
+    -> std::string
+{
+    return "/tmp/forge_ipc_test_" + std::to_string(getpid()) + ".sock";
+}
+
+//owners are the keys, "missing" does not exist
+//and balances are the length of the owner
+auto testHandler(const Request& request,
+                 std::vector<std::byte>& output)
+    -> void
+{
+    auto missing = stringToASCIIByteVec("missing");
+
+    switch(request.opcode) {
+    case Opcode::LookupOwner:
+        if(request.payload == ByteView{missing}) {
+            writeResponse(output, request.id, Status::NotFound, 42, {});
+            return;
+        }
+        writeResponse(output, request.id, Status::Ok, 42, request.payload);
+        return;
+
+    case Opcode::LookupUMValue:
+        writeResponse(output,
+                      request.id,
+                      Status::Ok,
+                      42,
+                      encodeValue(IPv4Value{std::byte{1},
+                                            std::byte{2},
+                                            std::byte{3},
+                                            std::byte{4}}));
+        return;
+
+    case Opcode::GetBalanceOf: {
+        auto [owner, token] = parseBalanceRequest(request.payload).getValue();
+        writeResponse(output, request.id, Status::Ok, 42, encodeInteger(owner.size()));
+        return;
+    }
+
+    default:
+        writeResponse(output, request.id, Status::UnknownOpcode, 42, {});
+    }
+}
+
+} // namespace
+
+TEST(IpcTest, RequestRoundTrip)
+{
+    auto key = stringToASCIIByteVec("somekey");
+
+    std::vector<std::byte> buffer;
+    writeRequest(buffer, 7, Opcode::LookupOwner, key);
+
+    auto size_opt = peekFrameSize(buffer);
+    ASSERT_TRUE(size_opt);
+    EXPECT_EQ(size_opt.getValue(), buffer.size());
+
+    auto request_opt = parseRequest(ByteView{buffer}.subview(LENGTH_PREFIX_SIZE));
+    ASSERT_TRUE(request_opt);
+
+    auto request = request_opt.getValue();
+    EXPECT_EQ(request.id, 7u);
+    EXPECT_EQ(request.opcode, Opcode::LookupOwner);
+    EXPECT_EQ(request.payload, ByteView{key});
+
+    EXPECT_FALSE(peekFrameSize(ByteView{buffer}.subview(0, 3)));
+    EXPECT_FALSE(parseRequest(ByteView{buffer}.subview(LENGTH_PREFIX_SIZE, 4)));
+}
+
+TEST(IpcTest, ResponseRoundTrip)
+{
+    std::vector<std::byte> buffer;
+    writeResponse(buffer, 3, Status::Ok, 1234567, encodeInteger(99));
+
+    auto response_opt = parseResponse(ByteView{buffer}.subview(LENGTH_PREFIX_SIZE));
+    ASSERT_TRUE(response_opt);
+
+    auto response = response_opt.getValue();
+    EXPECT_EQ(response.id, 3u);
+    EXPECT_EQ(response.status, Status::Ok);
+    EXPECT_EQ(response.block_height, 1234567);
+    EXPECT_EQ(parseInteger(response.payload).getValue(), 99u);
+}
+
+TEST(IpcTest, ValueRoundTrip)
+{
+    std::vector<UMEntryValue> values{
+        IPv4Value{std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}},
+        IPv6Value{},
+        ByteArray{std::byte{5}, std::byte{6}},
+        NoneValue{}};
+
+    for(const auto& value : values) {
+        auto parsed = parseValue(encodeValue(value));
+        ASSERT_TRUE(parsed);
+        EXPECT_TRUE(parsed.getValue() == value);
+    }
+
+    //ipv4 values need exactly four bytes
+    std::vector<std::byte> malformed{IPv4_VALUE_FLAG, std::byte{1}};
+    EXPECT_FALSE(parseValue(malformed));
+    EXPECT_FALSE(parseValue(ByteView{}));
+}
+
+TEST(IpcTest, BalanceRequestRoundTrip)
+{
+    auto token = stringToASCIIByteVec("token");
+    auto payload = encodeBalanceRequest("owner", token);
+    ASSERT_TRUE(payload);
+
+    auto parsed = parseBalanceRequest(payload.getValue());
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(parsed.getValue().first, "owner");
+    EXPECT_EQ(parsed.getValue().second, ByteView{token});
+
+    EXPECT_FALSE(encodeBalanceRequest(std::string(256, 'a'), token));
+}
+
+TEST(IpcTest, ClientServerLookups)
+{
+    auto path = socketPath();
+
+    IpcServer server{testHandler};
+    ASSERT_TRUE(server.start(path));
+
+    auto client_res = make_ipc_client(path);
+    ASSERT_TRUE(client_res);
+    auto& client = client_res.getValue();
+
+    auto owner = client.lookupOwner(stringToASCIIByteVec("someowner"));
+    ASSERT_TRUE(owner);
+    ASSERT_TRUE(owner.getValue());
+    EXPECT_EQ(owner.getValue().getValue(), "someowner");
+    EXPECT_EQ(client.getBlockHeight(), 42);
+
+    auto missing = client.lookupOwner(stringToASCIIByteVec("missing"));
+    ASSERT_TRUE(missing);
+    EXPECT_FALSE(missing.getValue());
+
+    auto value = client.lookupUMValue(stringToASCIIByteVec("somekey"));
+    ASSERT_TRUE(value);
+    ASSERT_TRUE(value.getValue());
+    EXPECT_TRUE(std::holds_alternative<IPv4Value>(value.getValue().getValue()));
+
+    auto balance = client.getBalanceOf("owner", stringToASCIIByteVec("token"));
+    ASSERT_TRUE(balance);
+    EXPECT_EQ(balance.getValue(), 5u);
+
+    //the test handler does not know the opcode
+    EXPECT_FALSE(client.getSupplyOfUtilityToken(stringToASCIIByteVec("token")));
+
+    server.stop();
+}
+
+TEST(IpcTest, PipelinedLookupsKeepTheirOrder)
+{
+    auto path = socketPath();
+
+    IpcServer server{testHandler};
+    ASSERT_TRUE(server.start(path));
+
+    auto client_res = make_ipc_client(path);
+    ASSERT_TRUE(client_res);
+    auto& client = client_res.getValue();
+
+    //more keys than the client keeps in flight at once
+    std::vector<EntryKey> keys;
+    for(std::size_t i = 0; i < 1000; i++) {
+        keys.emplace_back(i == 500
+                              ? stringToASCIIByteVec("missing")
+                              : stringToASCIIByteVec("owner" + std::to_string(i)));
+    }
+
+    auto owners = client.lookupOwners(keys);
+    ASSERT_TRUE(owners);
+    ASSERT_EQ(owners.getValue().size(), keys.size());
+
+    for(std::size_t i = 0; i < keys.size(); i++) {
+        if(i == 500) {
+            EXPECT_FALSE(owners.getValue()[i]);
+            continue;
+        }
+        ASSERT_TRUE(owners.getValue()[i]);
+        EXPECT_EQ(owners.getValue()[i].getValue(), "owner" + std::to_string(i));
+    }
+
+    server.stop();
+}
@@ -0,0 +1,110 @@
+#include <chrono>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <json/value.h>
+#include <mutex>
+#include <rpc/JobQueue.hpp>
+#include <stdexcept>
+#include <string>
+
+using forge::rpc::JobQueue;
+using forge::rpc::JobState;
+using namespace std::chrono_literals;
+
+TEST(JobQueueTest, DoneAndFailedTest)
+{
+    JobQueue queue{2, 10, 10};
+
+    auto done = queue.submit("createnewumentry", [] {
+        return Json::Value{"sometxid"};
+    });
+    auto failed = queue.submit("renewentry", []() -> Json::Value {
+        throw std::runtime_error{"not enough coins"};
+    });
+    ASSERT_TRUE(done);
+    ASSERT_TRUE(failed);
+    EXPECT_NE(done.getValue(), failed.getValue());
+
+    auto status = queue.waitFor(done.getValue(), 5s);
+    ASSERT_TRUE(status);
+    EXPECT_EQ(status.getValue().state, JobState::Done);
+    EXPECT_EQ(status.getValue().method, "createnewumentry");
+    EXPECT_EQ(status.getValue().result.asString(), "sometxid");
+
+    status = queue.waitFor(failed.getValue(), 5s);
+    ASSERT_TRUE(status);
+    EXPECT_EQ(status.getValue().state, JobState::Failed);
+    EXPECT_EQ(status.getValue().error, "not enough coins");
+
+    EXPECT_FALSE(queue.getStatus("unknown"));
+}
+
+TEST(JobQueueTest, BoundedQueueTest)
+{
+    JobQueue queue{1, 1, 10};
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool started = false;
+    bool released = false;
+
+    auto blocking = queue.submit("createnewumentry", [&] {
+        std::unique_lock lock{mtx};
+        started = true;
+        cv.notify_all();
+        cv.wait(lock, [&] { return released; });
+        return Json::Value{"first"};
+    });
+    ASSERT_TRUE(blocking);
+
+    {
+        std::unique_lock lock{mtx};
+        cv.wait(lock, [&] { return started; });
+    }
+
+    auto queued = queue.submit("createnewumentry", [] {
+        return Json::Value{"second"};
+    });
+    ASSERT_TRUE(queued);
+    EXPECT_EQ(queue.getStatus(blocking.getValue()).getValue().state, JobState::Running);
+    EXPECT_EQ(queue.getStatus(queued.getValue()).getValue().state, JobState::Queued);
+
+    //the worker is busy and the queue is full
+    EXPECT_FALSE(queue.submit("createnewumentry", [] {
+        return Json::Value{"third"};
+    }));
+
+    //a job which is still running is returned after the timeout
+    EXPECT_EQ(queue.waitFor(queued.getValue(), 10ms).getValue().state, JobState::Queued);
+
+    {
+        std::unique_lock lock{mtx};
+        released = true;
+    }
+    cv.notify_all();
+
+    auto status = queue.waitFor(queued.getValue(), 5s);
+    ASSERT_TRUE(status);
+    EXPECT_EQ(status.getValue().result.asString(), "second");
+}
+
+TEST(JobQueueTest, DropOldFinishedJobsTest)
+{
+    JobQueue queue{1, 10, 1};
+
+    auto first = queue.submit("renewentry", [] {
+        return Json::Value{"first"};
+    });
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(queue.waitFor(first.getValue(), 5s));
+
+    auto second = queue.submit("renewentry", [] {
+        return Json::Value{"second"};
+    });
+    ASSERT_TRUE(second);
+    ASSERT_TRUE(queue.waitFor(second.getValue(), 5s));
+
+    //only the newest finished job is remembered
+    EXPECT_FALSE(queue.getStatus(first.getValue()));
+    EXPECT_TRUE(queue.getStatus(second.getValue()));
+}
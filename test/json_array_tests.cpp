@@ -0,0 +1,46 @@
+#include <core/Transaction.hpp>
+#include <entrys/token/UtilityToken.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <gtest/gtest.h>
+#include <json/value.h>
+#include <rpc/JsonArray.hpp>
+#include <string>
+#include <vector>
+
+using namespace forge::core;
+using forge::rpc::toJsonArray;
+
+TEST(JsonArrayTest, ElementsKeepTheirOrder)
+{
+    std::vector<UMEntry> entrys{
+        UMEntry{stringToByteVec("deadbeef").getValue(),
+                IPv4Value{std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}}},
+        UMEntry{stringToByteVec("aa").getValue(),
+                NoneValue{}}};
+
+    auto json = toJsonArray(entrys);
+
+    ASSERT_TRUE(json.isArray());
+    ASSERT_EQ(json.size(), 2);
+    EXPECT_EQ(json[0], entrys[0].toJson());
+    EXPECT_EQ(json[1], entrys[1].toJson());
+
+    //an empty range is still an array
+    auto empty = toJsonArray(std::vector<UtilityToken>{});
+    EXPECT_TRUE(empty.isArray());
+    EXPECT_EQ(empty.size(), 0);
+}
+
+TEST(JsonArrayTest, ConvertsWithTheGivenFunction)
+{
+    std::vector<std::string> strings{"plain", "quote\"back\\slash"};
+
+    auto json = toJsonArray(std::move(strings),
+                            [](auto&& str) {
+                                return Json::Value{std::move(str)};
+                            });
+
+    ASSERT_EQ(json.size(), 2);
+    EXPECT_EQ(json[0].asString(), "plain");
+    EXPECT_EQ(json[1].asString(), "quote\"back\\slash");
+}
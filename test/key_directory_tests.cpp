@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <lookup/KeyDirectory.hpp>
+#include <vector>
+
+using forge::lookup::EntryKind;
+using forge::lookup::KeyDirectory;
+
+namespace {
+auto makeKey(std::size_t i)
+    -> std::vector<std::byte>
+{
+    return {static_cast<std::byte>(i & 0xFF),
+            static_cast<std::byte>((i >> 8) & 0xFF),
+            static_cast<std::byte>((i >> 16) & 0xFF),
+            std::byte{0x42}};
+}
+} // namespace
+
+TEST(KeyDirectoryTest, UpdateAndFindTest)
+{
+    KeyDirectory directory;
+
+    directory.update(makeKey(1), EntryKind::UMEntry);
+    directory.update(makeKey(2), EntryKind::UniqueEntry);
+    directory.update(makeKey(3), EntryKind::UtilityToken);
+
+    EXPECT_EQ(directory.find(makeKey(1)).getValue(), EntryKind::UMEntry);
+    EXPECT_EQ(directory.find(makeKey(2)).getValue(), EntryKind::UniqueEntry);
+    EXPECT_EQ(directory.find(makeKey(3)).getValue(), EntryKind::UtilityToken);
+    EXPECT_FALSE(directory.contains(makeKey(4)));
+    EXPECT_EQ(directory.size(), 3);
+
+    directory.update(makeKey(1), EntryKind::UniqueEntry);
+    EXPECT_EQ(directory.find(makeKey(1)).getValue(), EntryKind::UniqueEntry);
+
+    directory.update(makeKey(2), std::nullopt);
+    EXPECT_FALSE(directory.contains(makeKey(2)));
+    EXPECT_EQ(directory.size(), 2);
+}
+
+TEST(KeyDirectoryTest, GrowingFilterTest)
+{
+    KeyDirectory directory{16};
+
+    for(std::size_t i = 0; i < 20000; i++) {
+        directory.update(makeKey(i), EntryKind::UMEntry);
+    }
+
+    //the filter never gives false negatives,
+    //even after it was resized multiple times
+    for(std::size_t i = 0; i < 20000; i++) {
+        EXPECT_TRUE(directory.mayContain(makeKey(i)));
+        EXPECT_TRUE(directory.contains(makeKey(i)));
+    }
+
+    std::size_t false_positives = 0;
+    for(std::size_t i = 20000; i < 40000; i++) {
+        if(directory.mayContain(makeKey(i))) {
+            false_positives++;
+        }
+        EXPECT_FALSE(directory.contains(makeKey(i)));
+    }
+
+    EXPECT_LT(false_positives, 200);
+}
+
+TEST(KeyDirectoryTest, EraseKindTest)
+{
+    KeyDirectory directory;
+
+    for(std::size_t i = 0; i < 100; i++) {
+        directory.update(makeKey(i),
+                         i % 2 == 0
+                             ? EntryKind::UMEntry
+                             : EntryKind::UtilityToken);
+    }
+
+    directory.eraseKind(EntryKind::UMEntry);
+
+    EXPECT_EQ(directory.size(), 50);
+    for(std::size_t i = 0; i < 100; i++) {
+        EXPECT_EQ(directory.contains(makeKey(i)), i % 2 != 0);
+    }
+
+    directory.clear();
+    EXPECT_EQ(directory.size(), 0);
+    EXPECT_FALSE(directory.mayContain(makeKey(1)));
+}
@@ -0,0 +1,125 @@
+#include <arpa/inet.h>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <metrics/Metrics.hpp>
+#include <metrics/MetricsServer.hpp>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using forge::metrics::Histogram;
+using forge::metrics::MetricsServer;
+using forge::metrics::Registry;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto scrape(std::uint16_t port, const std::string& target)
+    -> std::string
+{
+    auto fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+
+    if(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return {};
+    }
+
+    auto request = "GET " + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+
+    std::string response;
+    char buffer[4096];
+    while(true) {
+        auto received = recv(fd, buffer, sizeof(buffer), 0);
+        if(received <= 0) {
+            break;
+        }
+        response.append(buffer, static_cast<std::size_t>(received));
+    }
+
+    close(fd);
+    return response;
+}
+
+} // namespace
+
+TEST(MetricsTest, SameSeriesIsReturnedTest)
+{
+    Registry registry;
+
+    auto& counter = registry.counter("requests_total", "requests", {{"method", "a"}});
+    counter.increment();
+    registry.counter("requests_total", "requests", {{"method", "a"}}).increment(2);
+    registry.counter("requests_total", "requests", {{"method", "b"}}).increment();
+
+    EXPECT_EQ(counter.get(), 3);
+
+    auto& gauge = registry.gauge("height", "height");
+    gauge.set(10);
+    gauge.add(-3);
+    EXPECT_EQ(registry.gauge("height", "height").get(), 7);
+}
+
+TEST(MetricsTest, HistogramBucketsTest)
+{
+    Histogram histogram{{0.001, 0.01, 0.1}};
+
+    histogram.observe(500us);
+    histogram.observe(1ms);
+    histogram.observe(5ms);
+    histogram.observe(1s);
+
+    //a bucket counts the observations up to and including its bound
+    std::vector<std::uint64_t> expected{2, 1, 0, 1};
+    EXPECT_EQ(histogram.getBucketCounts(), expected);
+    EXPECT_EQ(histogram.getCount(), 4);
+    EXPECT_NEAR(histogram.getSum(), 1.0065, 1e-9);
+}
+
+TEST(MetricsTest, RenderTest)
+{
+    Registry registry;
+
+    registry.counter("requests_total", "Handled requests", {{"method", "say \"hi\""}}).increment(5);
+    registry.gauge("height", "Block height").set(42);
+    auto& histogram = registry.histogram("duration_seconds", "Durations", {}, {0.1, 1});
+    histogram.observe(50ms);
+    histogram.observe(2s);
+
+    auto text = registry.render();
+
+    EXPECT_NE(text.find("# TYPE requests_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("requests_total{method=\"say \\\"hi\\\"\"} 5\n"), std::string::npos);
+    EXPECT_NE(text.find("# HELP height Block height\n"), std::string::npos);
+    EXPECT_NE(text.find("height 42\n"), std::string::npos);
+    EXPECT_NE(text.find("duration_seconds_bucket{le=\"0.1\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("duration_seconds_bucket{le=\"1\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("duration_seconds_bucket{le=\"+Inf\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("duration_seconds_count 2\n"), std::string::npos);
+}
+
+TEST(MetricsTest, ServerScrapeTest)
+{
+    Registry registry;
+    registry.counter("scraped_total", "test counter").increment(7);
+
+    MetricsServer server{registry};
+    ASSERT_TRUE(server.start(0));
+    ASSERT_NE(server.getPort(), 0);
+
+    auto response = scrape(server.getPort(), "/metrics");
+    EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), 0);
+    EXPECT_NE(response.find("scraped_total 7\n"), std::string::npos);
+
+    EXPECT_EQ(scrape(server.getPort(), "/other").find("HTTP/1.1 404"), 0);
+
+    server.stop();
+}
@@ -0,0 +1,108 @@
+#include <core/Transaction.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <wallet/OutputPool.hpp>
+#include <wallet/UtxoSet.hpp>
+
+using forge::core::Unspent;
+using forge::wallet::OutputPool;
+using forge::wallet::OutputPoolConfig;
+using forge::wallet::UtxoSet;
+
+namespace {
+
+const std::string first = "oLupzckPUYtGydsBisL86zcwsBweJm1dSM";
+const std::string second = "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W";
+const std::string third = "oZ9P3ugmgbf2EBjgXoAd7ctV2gXUbm6ke3";
+
+} // namespace
+
+TEST(OutputPoolTest, TakeTest)
+{
+    OutputPool pool{OutputPoolConfig{3, 1000}};
+    EXPECT_EQ(pool.missing(), 3);
+
+    pool.add({first, second, third}, 100);
+    EXPECT_EQ(pool.missing(), 0);
+
+    //the output of the first address did not arrive yet
+    UtxoSet utxos;
+    utxos.reset({Unspent{1200, 0, 20, second, "bb"},
+                 Unspent{1100, 1, 20, third, "bb"}},
+                120);
+
+    auto arrived = pool.arrived(utxos);
+    ASSERT_EQ(arrived.size(), 2);
+    EXPECT_FALSE(pool.reserve(1100, 100));
+
+    pool.hold(arrived[0]);
+    pool.hold(arrived[1]);
+    EXPECT_EQ(pool.numberOfHeld(), 2);
+    EXPECT_TRUE(pool.arrived(utxos).empty());
+
+    //too small for the needed value
+    EXPECT_FALSE(pool.reserve(1150, 100));
+
+    auto reserved = pool.reserve(1100, 100);
+    ASSERT_TRUE(reserved);
+    EXPECT_EQ(reserved.getValue(), second);
+
+    //a reserved output is kept until it is taken
+    EXPECT_EQ(pool.size(), 3);
+    EXPECT_FALSE(pool.take(third));
+
+    auto taken = pool.take(second);
+    ASSERT_TRUE(taken);
+    EXPECT_EQ(taken.getValue().getTxid(), "bb");
+    EXPECT_EQ(pool.size(), 2);
+    EXPECT_EQ(pool.missing(), 1);
+
+    //the output of the third address is used completely
+    reserved = pool.reserve(1100, 100);
+    ASSERT_TRUE(reserved);
+    EXPECT_EQ(reserved.getValue(), third);
+    EXPECT_FALSE(pool.reserve(1100, 100));
+    EXPECT_TRUE(pool.take(third));
+}
+
+TEST(OutputPoolTest, PruneTest)
+{
+    OutputPool pool{OutputPoolConfig{3, 1000}};
+    pool.add({first, second}, 100);
+    pool.add({third}, 110);
+
+    UtxoSet utxos;
+    utxos.reset({Unspent{1200, 0, 20, second, "bb"}}, 125);
+
+    //the outputs could still be mined
+    EXPECT_EQ(pool.prune(utxos, 125, 20), 0);
+
+    //a held output is kept even though the node
+    //does not report it anymore
+    pool.hold(pool.arrived(utxos).front());
+    utxos.reset({}, 135);
+
+    //the output of the first address should have matured
+    //long ago, the one of the third could still come
+    EXPECT_EQ(pool.prune(utxos, 135, 20), 1);
+    EXPECT_EQ(pool.size(), 2);
+
+    auto reserved = pool.reserve(1100, 100);
+    ASSERT_TRUE(reserved);
+    EXPECT_EQ(reserved.getValue(), second);
+}
+
+TEST(OutputPoolTest, UnfundedAddressesAreKept)
+{
+    OutputPool pool{OutputPoolConfig{3, 1000}};
+    pool.keepUnfunded({first, second});
+
+    auto addresses = pool.takeUnfunded(3);
+    EXPECT_EQ(addresses.size(), 2);
+    EXPECT_TRUE(pool.takeUnfunded(3).empty());
+
+    pool.keepUnfunded(std::move(addresses));
+    EXPECT_EQ(pool.takeUnfunded(1).size(), 1);
+    EXPECT_EQ(pool.takeUnfunded(1).size(), 1);
+}
@@ -0,0 +1,111 @@
+#include <core/Coin.hpp>
+#include <core/Hex.hpp>
+#include <core/RawTransaction.hpp>
+#include <core/Sha256.hpp>
+#include <core/Transaction.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using forge::core::Coin;
+using forge::core::addressToOutputScript;
+using forge::core::computeTxid;
+using forge::core::decodeBase58Check;
+using forge::core::hexEncode;
+using forge::core::serializeRawTx;
+using forge::core::sha256;
+using forge::core::stringToASCIIByteVec;
+using forge::core::stringToByteVec;
+using forge::core::toHexString;
+
+namespace {
+
+//transaction e3341a46d00b3b83628a8ec36d070ab76209641630c08a4c4604c1747c474a2b
+//of the odin mainnet, spending one output into one OP_RETURN output
+constexpr auto SIGNED_TX =
+    "0100000001367c91c1792e00788464532e627b78ed7b77c19f09e89f1ca95e8a3ee4b0ac1d00"
+    "0000006a473044022023026160d7f28027b7b10f5ca799247aa915a3db7d7e0ae689578506c6"
+    "b7e16f0220651aeefa5b40471380099b997a0985810bbc400e435894a04cb723e809d6d68601"
+    "210286ad513d3ce85e153bc0ab3bd93b833370bc4778c404826ac8a6226ff0ac54d4ffffffff"
+    "01802b530b00000000196a17416c7069706f723a20547261707320617265206761792100000000";
+
+//the same transaction before it was signed
+constexpr auto UNSIGNED_TX =
+    "0100000001367c91c1792e00788464532e627b78ed7b77c19f09e89f1ca95e8a3ee4b0ac1d00"
+    "00000000ffffffff"
+    "01802b530b00000000196a17416c7069706f723a20547261707320617265206761792100000000";
+
+auto hashToHex(const std::string& str)
+    -> std::string
+{
+    auto digest = sha256(stringToASCIIByteVec(str));
+    return hexEncode(digest.data(), digest.size());
+}
+
+} // namespace
+
+TEST(RawTransactionTest, Sha256Test)
+{
+    EXPECT_EQ(hashToHex(""),
+              "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(hashToHex("abc"),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    //56 bytes do not leave room for the length in the first padding block
+    EXPECT_EQ(hashToHex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    EXPECT_EQ(hashToHex(std::string(1000, 'a')),
+              "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3");
+}
+
+TEST(RawTransactionTest, ComputeTxidTest)
+{
+    auto tx = stringToByteVec(SIGNED_TX).getValue();
+
+    EXPECT_EQ(computeTxid(tx),
+              "e3341a46d00b3b83628a8ec36d070ab76209641630c08a4c4604c1747c474a2b");
+}
+
+TEST(RawTransactionTest, AddressToOutputScriptTest)
+{
+    auto script = addressToOutputScript("oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkTT", Coin::Odin);
+    ASSERT_TRUE(script);
+    EXPECT_EQ(toHexString(script.getValue()),
+              "76a9145ba5a8804cccd22aa947fc25503aac765582c24288ac");
+
+    //broken checksum, invalid character and unknown prefix
+    EXPECT_FALSE(decodeBase58Check("oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkTU"));
+    EXPECT_FALSE(decodeBase58Check("oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkT0"));
+    EXPECT_FALSE(addressToOutputScript("oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkTT", Coin::tOdin));
+}
+
+TEST(RawTransactionTest, SerializeRawTxTest)
+{
+    auto metadata = stringToByteVec("416c7069706f723a205472617073206172652067617921").getValue();
+
+    auto tx = serializeRawTx("1dacb0e43e8a5ea91c9fe8099fc1777bed787b622e53648478002e79c1917c36",
+                             0,
+                             metadata,
+                             190000000,
+                             {},
+                             Coin::Odin);
+
+    ASSERT_TRUE(tx);
+    EXPECT_EQ(toHexString(tx.getValue()), UNSIGNED_TX);
+
+    //value outputs come before the OP_RETURN output
+    auto with_outputs = serializeRawTx("1dacb0e43e8a5ea91c9fe8099fc1777bed787b622e53648478002e79c1917c36",
+                                       2,
+                                       metadata,
+                                       1000,
+                                       {{"oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkTT", 10000}},
+                                       Coin::Odin);
+
+    ASSERT_TRUE(with_outputs);
+    EXPECT_EQ(toHexString(with_outputs.getValue()),
+              "0100000001367c91c1792e00788464532e627b78ed7b77c19f09e89f1ca95e8a3ee4b0ac1d"
+              "0200000000ffffffff02"
+              "10270000000000001976a9145ba5a8804cccd22aa947fc25503aac765582c24288ac"
+              "e803000000000000196a17416c7069706f723a20547261707320617265206761792100000000");
+
+    EXPECT_FALSE(serializeRawTx("1dac", 0, metadata, 1000, {}, Coin::Odin));
+}
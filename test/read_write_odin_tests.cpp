@@ -189,6 +189,23 @@ TEST(ReadWriteOdinClientTest, processSendToAddressResponseInvalid)
     ASSERT_TRUE(res2.hasError());
 }
 
+TEST(ReadWriteOdinClientTest, processSendManyResponse)
+{
+    //sendmany answers like sendtoaddress with a single txid
+    auto file1 = readFile("send_to_address_valid1.json");
+    auto res1 = forge::client::odin::processSendManyResponse(parseString(file1),
+                                                             3);
+
+    ASSERT_TRUE(res1.hasValue());
+    EXPECT_EQ(res1.getValue(), "6a14e96a93444c92a7db9accfc4e4675af6ea4c2a74676a025109df614640635");
+
+    auto file2 = readFile("send_to_address_invalid1.json");
+    auto res2 = forge::client::odin::processSendManyResponse(parseString(file2),
+                                                             3);
+
+    ASSERT_TRUE(res2.hasError());
+}
+
 TEST(ReadWriteOdinClientTest, processGetVOutIdxByAmountAndAddressResponseValid)
 {
     using forge::core::stringToByteVec;
@@ -0,0 +1,349 @@
+#include "fake_clients.hpp"
+#include <algorithm>
+#include <core/Coin.hpp>
+#include <core/Transaction.hpp>
+#include <cstdint>
+#include <entrys/token/UtilityToken.hpp>
+#include <entrys/token/UtilityTokenCreationOp.hpp>
+#include <entrys/token/UtilityTokenOwnershipTransferOp.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <entrys/umentry/UMEntryCreationOp.hpp>
+#include <limits>
+#include <gtest/gtest.h>
+#include <lookup/LookupManager.hpp>
+#include <memory>
+#include <string>
+#include <utils/Opt.hpp>
+#include <vector>
+#include <wallet/OutputPool.hpp>
+#include <wallet/ReadOnlyWallet.hpp>
+#include <wallet/ReadWriteWallet.hpp>
+
+using forge::core::Coin;
+using forge::core::createUMEntryCreationOpMetadata;
+using forge::core::createUtilityTokenCreationOpMetadata;
+using forge::core::createUtilityTokenOwnershipTransferOpMetadata;
+using forge::core::getDefaultTxFee;
+using forge::core::getMaturity;
+using forge::core::getStartingBlock;
+using forge::core::NoneValue;
+using forge::core::getMinimumTxAmount;
+using forge::core::stringToASCIIByteVec;
+using forge::core::UMEntry;
+using forge::core::Unspent;
+using forge::core::UtilityToken;
+using forge::lookup::LookupManager;
+using forge::wallet::OutputPoolConfig;
+using forge::wallet::ReadOnlyWallet;
+using forge::wallet::ReadWriteWallet;
+
+namespace {
+
+auto makeLookup(const std::shared_ptr<FakeNode>& node)
+    -> std::shared_ptr<LookupManager>
+{
+    return std::make_shared<LookupManager>(std::make_unique<FakeReadOnlyClient>(node));
+}
+
+auto makeWallet(const std::shared_ptr<FakeNode>& node,
+                std::shared_ptr<LookupManager> lookup,
+                OutputPoolConfig pool_config = {})
+    -> ReadWriteWallet
+{
+    return ReadWriteWallet{std::move(lookup),
+                           std::make_unique<FakeWriteClient>(node),
+                           pool_config};
+}
+
+auto makeWallet(const std::shared_ptr<FakeNode>& node,
+                OutputPoolConfig pool_config = {})
+    -> ReadWriteWallet
+{
+    return makeWallet(node, makeLookup(node), pool_config);
+}
+
+//mines the operation and enough blocks after
+//it, so the lookup processes the operation
+auto mineMature(const std::shared_ptr<FakeNode>& node,
+                LookupManager& lookup,
+                const std::string& sender,
+                std::vector<std::byte> metadata,
+                forge::utils::Opt<std::string> new_owner = std::nullopt)
+    -> void
+{
+    node->mine(sender, std::move(metadata), 1000, std::move(new_owner));
+    node->height += getMaturity(Coin::tOdin);
+    ASSERT_TRUE(lookup.updateLookup());
+}
+
+auto createEntry(const std::shared_ptr<FakeNode>& node,
+                 LookupManager& lookup,
+                 const std::string& owner,
+                 const std::string& key)
+    -> void
+{
+    mineMature(node,
+               lookup,
+               owner,
+               createUMEntryCreationOpMetadata(UMEntry{stringToASCIIByteVec(key), NoneValue{}}));
+}
+
+} // namespace
+
+TEST(ReadWriteWalletTest, LeasedOutputsAreLocked)
+{
+    auto node = std::make_shared<FakeNode>();
+    node->addresses = {"owner"};
+    node->unspents.emplace_back(1000 + getDefaultTxFee(Coin::tOdin), 0, 20, "owner", "funding");
+    node->unspents.emplace_back(1000 + getDefaultTxFee(Coin::tOdin), 1, 20, "owner", "funding");
+    node->fail_locks = true;
+
+    auto wallet = makeWallet(node);
+
+    //an output which cannot be locked is not spent directly
+    auto res = wallet.createNewUMEntry(stringToASCIIByteVec("first"),
+                                       NoneValue{},
+                                       "owner",
+                                       1000);
+    ASSERT_TRUE(res);
+    EXPECT_TRUE(node->written.empty());
+    EXPECT_EQ(node->sent.size(), 1);
+
+    node->fail_locks = false;
+    res = wallet.createNewUMEntry(stringToASCIIByteVec("second"),
+                                  NoneValue{},
+                                  "owner",
+                                  1000);
+    ASSERT_TRUE(res);
+    EXPECT_EQ(node->written.size(), 1);
+    EXPECT_EQ(node->written_unlocked, 0);
+    EXPECT_EQ(node->sent.size(), 1);
+}
+
+TEST(ReadWriteWalletTest, FailedLeasedWriteFallsBackToFunding)
+{
+    auto node = std::make_shared<FakeNode>();
+    node->addresses = {"owner"};
+    node->unspents.emplace_back(1000 + getDefaultTxFee(Coin::tOdin), 0, 20, "owner", "funding");
+    node->fail_writes = true;
+
+    auto wallet = makeWallet(node);
+
+    //the output of the address is tried first, the
+    //operation is still sent with a funded output
+    auto res = wallet.createNewUMEntry(stringToASCIIByteVec("first"),
+                                       NoneValue{},
+                                       "owner",
+                                       1000);
+    ASSERT_TRUE(res);
+    EXPECT_EQ(node->written.size(), 1);
+    EXPECT_EQ(node->sent.size(), 1);
+    EXPECT_TRUE(node->locked.empty());
+
+    //the output is not offered again before the next block
+    res = wallet.createNewUMEntry(stringToASCIIByteVec("second"),
+                                  NoneValue{},
+                                  "owner",
+                                  1000);
+    ASSERT_TRUE(res);
+    EXPECT_EQ(node->written.size(), 1);
+    EXPECT_EQ(node->sent.size(), 2);
+}
+
+TEST(ReadWriteWalletTest, TokensAreSentFromAsManyAddressesAsNeeded)
+{
+    auto node = std::make_shared<FakeNode>();
+    node->addresses = {"first", "second"};
+    node->height = getStartingBlock(Coin::tOdin);
+
+    auto lookup = makeLookup(node);
+    auto id = stringToASCIIByteVec("token");
+    mineMature(node,
+               *lookup,
+               "first",
+               createUtilityTokenCreationOpMetadata(UtilityToken{id, 5}));
+    mineMature(node,
+               *lookup,
+               "first",
+               createUtilityTokenOwnershipTransferOpMetadata(UtilityToken{id, 2}),
+               std::string{"second"});
+    ASSERT_EQ(lookup->getUtilityTokenCreditOf("first", id), 3);
+    ASSERT_EQ(lookup->getUtilityTokenCreditOf("second", id), 2);
+
+    auto wallet = makeWallet(node, lookup);
+
+    //only a part of the balance of the second address is used
+    auto res = wallet.transferUtilityTokens(id, "recipient", 4, 1000);
+    ASSERT_TRUE(res);
+    EXPECT_EQ(res.getValue().txids.size(), 2);
+    EXPECT_TRUE(res.getValue().failures.empty());
+
+    res = wallet.transferUtilityTokens(id, "recipient", 6, 1000);
+    EXPECT_FALSE(res);
+}
+
+TEST(ReadWriteWalletTest, PaymentsAreAddedUpPerOwner)
+{
+    auto node = std::make_shared<FakeNode>();
+    node->height = getStartingBlock(Coin::tOdin);
+
+    auto lookup = makeLookup(node);
+    createEntry(node, *lookup, "first", "alpha");
+    createEntry(node, *lookup, "first", "bravo");
+    createEntry(node, *lookup, "second", "charlie");
+    createEntry(node, *lookup, "third", "delta");
+
+    auto wallet = makeWallet(node, lookup);
+
+    auto min = getMinimumTxAmount(Coin::tOdin);
+    auto max = std::numeric_limits<std::int64_t>::max();
+    auto results = wallet.payToEntryOwners({{stringToASCIIByteVec("alpha"), min},
+                                            {stringToASCIIByteVec("bravo"), min},
+                                            {stringToASCIIByteVec("charlie"), min - 1},
+                                            {stringToASCIIByteVec("unknown"), min},
+                                            {stringToASCIIByteVec("delta"), max},
+                                            {stringToASCIIByteVec("delta"), 1}});
+    ASSERT_EQ(results.size(), 6);
+
+    //both payments to the first owner are made with one output
+    ASSERT_EQ(node->sent_to_many.size(), 1);
+    FakeNode::Outputs expected{{"first", 2 * min}, {"third", max}};
+    EXPECT_EQ(node->sent_to_many.front(), expected);
+    EXPECT_TRUE(results[0]);
+    EXPECT_TRUE(results[1]);
+    EXPECT_TRUE(results[4]);
+
+    //below the minimum
+    EXPECT_FALSE(results[2]);
+    EXPECT_FALSE(results[3]);
+    //would overflow the total of the owner
+    EXPECT_FALSE(results[5]);
+}
+
+TEST(ReadWriteWalletTest, PaymentsAreSplitIntoChunks)
+{
+    auto node = std::make_shared<FakeNode>();
+    node->height = getStartingBlock(Coin::tOdin);
+
+    auto lookup = makeLookup(node);
+    std::vector<std::pair<forge::core::EntryKey, std::int64_t>> payments;
+    for(int i = 0; i < 251; i++) {
+        auto key = "entry" + std::to_string(i);
+        createEntry(node, *lookup, "owner" + std::to_string(i), key);
+        payments.emplace_back(stringToASCIIByteVec(key),
+                              getMinimumTxAmount(Coin::tOdin));
+    }
+
+    auto wallet = makeWallet(node, lookup);
+    auto results = wallet.payToEntryOwners(payments);
+
+    ASSERT_EQ(node->sent_to_many.size(), 2);
+    EXPECT_EQ(node->sent_to_many[0].size(), 250);
+    EXPECT_EQ(node->sent_to_many[1].size(), 1);
+
+    ASSERT_EQ(results.size(), 251);
+    ASSERT_TRUE(results[0] && results[249] && results[250]);
+    EXPECT_EQ(results[0].getValue(), results[249].getValue());
+    EXPECT_NE(results[249].getValue(), results[250].getValue());
+}
+
+TEST(ReadWriteWalletTest, PoolOutputsAreLockedUntilTaken)
+{
+    auto node = std::make_shared<FakeNode>();
+    node->height = getStartingBlock(Coin::tOdin) + getMaturity(Coin::tOdin);
+
+    auto lookup = makeLookup(node);
+    auto wallet = makeWallet(node, lookup, OutputPoolConfig{2, 1000});
+
+    auto res = wallet.maintainOutputPool();
+    ASSERT_TRUE(res);
+    EXPECT_EQ(res.getValue(), 2);
+    ASSERT_EQ(node->sent_to_many.size(), 1);
+
+    //the funding transaction is mined with the next block
+    std::int64_t vout = 0;
+    for(const auto& [address, value] : node->sent_to_many.front()) {
+        node->unspents.emplace_back(value, vout++, 1, address, "funding");
+    }
+    node->height++;
+    ASSERT_TRUE(lookup->updateLookup());
+
+    res = wallet.maintainOutputPool();
+    ASSERT_TRUE(res);
+    EXPECT_EQ(res.getValue(), 0);
+    EXPECT_EQ(node->locked.size(), 2);
+    EXPECT_EQ(wallet.getOutputPool().numberOfHeld(), 2);
+
+    //the pool output is spent directly and stays locked, so
+    //it does not have to be locked again
+    node->fail_locks = true;
+    auto created = wallet.createNewUMEntry(stringToASCIIByteVec("first"),
+                                           NoneValue{},
+                                           1000);
+    ASSERT_TRUE(created);
+    ASSERT_EQ(node->written.size(), 1);
+    EXPECT_EQ(node->written.front().first, "funding");
+    EXPECT_EQ(node->written_unlocked, 0);
+    EXPECT_TRUE(node->sent.empty());
+    EXPECT_EQ(node->locked.size(), 1);
+    EXPECT_EQ(wallet.getOutputPool().size(), 1);
+}
+
+TEST(ReadWriteWalletTest, PoolAddressesAreReusedAfterAFailedFunding)
+{
+    auto node = std::make_shared<FakeNode>();
+    node->fail_sends = true;
+
+    auto wallet = makeWallet(node, OutputPoolConfig{2, 1000});
+
+    EXPECT_FALSE(wallet.maintainOutputPool());
+    EXPECT_EQ(node->addresses.size(), 2);
+    EXPECT_EQ(wallet.getOutputPool().size(), 0);
+
+    node->fail_sends = false;
+    auto res = wallet.maintainOutputPool();
+    ASSERT_TRUE(res);
+    EXPECT_EQ(res.getValue(), 2);
+    EXPECT_EQ(node->addresses.size(), 2);
+    ASSERT_EQ(node->sent_to_many.size(), 1);
+    for(const auto& [address, value] : node->sent_to_many.front()) {
+        EXPECT_NE(std::find(node->addresses.begin(), node->addresses.end(), address),
+                  node->addresses.end());
+    }
+}
+
+TEST(ReadWriteWalletTest, WalletsUseTheirOwnNodeWallet)
+{
+    //the lookup reads the chain through the default node wallet
+    auto node = std::make_shared<FakeNode>();
+    node->addresses = {"default"};
+    node->unspents.emplace_back(1000 + getDefaultTxFee(Coin::tOdin), 0, 20, "default", "funding");
+
+    auto other = std::make_shared<FakeNode>();
+    other->addresses = {"other"};
+    other->unspents.emplace_back(1000 + getDefaultTxFee(Coin::tOdin), 0, 20, "other", "funding");
+
+    auto lookup = makeLookup(node);
+    auto wallet = makeWallet(node, lookup);
+    ReadWriteWallet named{lookup,
+                          std::make_unique<FakeWriteClient>(other),
+                          OutputPoolConfig{},
+                          std::make_unique<FakeReadOnlyClient>(other)};
+    ReadOnlyWallet watching{lookup, std::make_unique<FakeReadOnlyClient>(other)};
+
+    EXPECT_TRUE(wallet.ownesAddress("default"));
+    EXPECT_FALSE(wallet.ownesAddress("other"));
+    EXPECT_TRUE(named.ownesAddress("other"));
+    EXPECT_FALSE(named.ownesAddress("default"));
+    EXPECT_TRUE(watching.ownesAddress("other"));
+    EXPECT_FALSE(watching.ownesAddress("default"));
+
+    //the output of the default node wallet is not spent by the named wallet
+    auto res = named.createNewUMEntry(stringToASCIIByteVec("named"),
+                                      NoneValue{},
+                                      "other",
+                                      1000);
+    ASSERT_TRUE(res);
+    EXPECT_TRUE(node->written.empty());
+    ASSERT_EQ(other->written.size(), 1);
+}
@@ -0,0 +1,70 @@
+#include <core/Transaction.hpp>
+#include <gtest/gtest.h>
+#include <json/value.h>
+#include <rpc/ResponseCache.hpp>
+#include <string>
+#include <vector>
+
+using namespace forge::core;
+using forge::rpc::ResponseCache;
+
+TEST(ResponseCacheTest, FindAndCount)
+{
+    ResponseCache cache;
+    auto key = stringToASCIIByteVec("somekey");
+
+    EXPECT_FALSE(cache.find("lookupowner"));
+
+    cache.insert("lookupowner", key, Json::Value{"someowner"}, cache.getEpoch());
+
+    auto cached = cache.find("lookupowner");
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(cached.getValue().asString(), "someowner");
+
+    EXPECT_EQ(cache.getHits(), 1u);
+    EXPECT_EQ(cache.getMisses(), 1u);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(ResponseCacheTest, InvalidatesOnlyTouchedKeys)
+{
+    ResponseCache cache;
+    auto key1 = stringToASCIIByteVec("key1");
+    auto key2 = stringToASCIIByteVec("key2");
+
+    cache.insert("lookupowner1", key1, Json::Value{"owner1"}, cache.getEpoch());
+    cache.insert("lookupumvalue1", key1, Json::Value{"value1"}, cache.getEpoch());
+    cache.insert("lookupowner2", key2, Json::Value{"owner2"}, cache.getEpoch());
+
+    cache.invalidate({key1, stringToASCIIByteVec("unknown")});
+
+    EXPECT_FALSE(cache.find("lookupowner1"));
+    EXPECT_FALSE(cache.find("lookupumvalue1"));
+    EXPECT_TRUE(cache.find("lookupowner2"));
+    EXPECT_EQ(cache.size(), 1u);
+
+    cache.clear();
+    EXPECT_FALSE(cache.find("lookupowner2"));
+}
+
+TEST(ResponseCacheTest, DropsResultsOfOldEpochs)
+{
+    ResponseCache cache;
+    auto key = stringToASCIIByteVec("somekey");
+
+    //a block arrives while the result is computed
+    auto epoch = cache.getEpoch();
+    cache.invalidate({});
+    cache.insert("lookupowner", key, Json::Value{"oldowner"}, epoch);
+
+    EXPECT_FALSE(cache.find("lookupowner"));
+
+    //the cache is emptied once it is full
+    ResponseCache small_cache{2};
+    small_cache.insert("a", key, Json::Value{1}, small_cache.getEpoch());
+    small_cache.insert("b", key, Json::Value{2}, small_cache.getEpoch());
+    small_cache.insert("c", key, Json::Value{3}, small_cache.getEpoch());
+
+    EXPECT_EQ(small_cache.size(), 1u);
+    EXPECT_TRUE(small_cache.find("c"));
+}
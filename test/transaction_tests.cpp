@@ -6,6 +6,7 @@
 using forge::core::buildTxIn;
 using forge::core::buildTxOut;
 using forge::core::buildTransaction;
+using forge::core::buildForgeCandidate;
 using forge::core::stringToByteVec;
 using forge::core::extractMetadata;
 using forge::core::metadataStartsWithForgeId;
@@ -134,6 +135,55 @@ TEST(TransactionTest, TransactionParsingValid)
     EXPECT_EQ(tx3.getValue().getOutputs().size(), 1);
 }
 
+TEST(TransactionTest, ForgeCandidateParsing)
+{
+    auto json_str = readFile("tx_forge_valid1.json");
+    auto json = parseString(json_str);
+
+    auto candidate_opt = buildForgeCandidate(json);
+
+    ASSERT_TRUE(candidate_opt);
+
+    const auto& candidate = candidate_opt.getValue();
+
+    EXPECT_EQ(candidate.getTxid(), "5f1d8a3a0e7a4d1b9b8c8f8d35c2a4a1f3c0b6e0d8c7a6b5c4d3e2f1a0b9c8d7");
+    EXPECT_EQ(candidate.getInput().getTxid(), "1dacb0e43e8a5ea91c9fe8099fc1777bed787b622e53648478002e79c1917c36");
+    EXPECT_EQ(candidate.getInput().getVoutIndex(), 1);
+    EXPECT_EQ(candidate.getOpReturnValue(), 50000000);
+    EXPECT_EQ(candidate.getMetadata(), stringToByteVec("c6dc75010401aabbccdddeadbeef").getValue());
+    ASSERT_TRUE(candidate.getNewOwner());
+    EXPECT_EQ(candidate.getNewOwner().getValue(), "ogA4iDjm5H2HjWUmeZykhX4HhtgMAEixGb");
+
+    //the decode mode and the full transaction agree
+    auto tx = buildTransaction(parseString(json_str));
+
+    ASSERT_TRUE(tx);
+
+    auto from_tx = buildForgeCandidate(tx.getValue());
+
+    ASSERT_TRUE(from_tx);
+    EXPECT_EQ(from_tx.getValue().getTxid(), candidate.getTxid());
+    EXPECT_EQ(from_tx.getValue().getInput().getTxid(), candidate.getInput().getTxid());
+    EXPECT_EQ(from_tx.getValue().getOpReturnValue(), candidate.getOpReturnValue());
+    EXPECT_EQ(from_tx.getValue().getMetadata(), candidate.getMetadata());
+    EXPECT_EQ(from_tx.getValue().getNewOwner().getValue(), candidate.getNewOwner().getValue());
+}
+
+TEST(TransactionTest, ForgeCandidateParsingNoCandidate)
+{
+    //no op return, no input and no forge id
+    for(auto file : {"tx_valid1.json", "tx_valid2.json", "tx_valid3.json"}) {
+        auto json = parseString(readFile(file));
+        EXPECT_FALSE(buildForgeCandidate(json));
+
+        auto tx = buildTransaction(std::move(json));
+        ASSERT_TRUE(tx);
+        EXPECT_FALSE(buildForgeCandidate(tx.getValue()));
+    }
+
+    EXPECT_FALSE(buildForgeCandidate(parseString(readFile("txin_valid.json"))));
+}
+
 TEST(TransactionTest, ExtractMetadataValid)
 {
     auto first_valid = extractMetadata("6aa109a924fb7a90f305881fb9c8c5bd024673456af12e3651c27668a6b79707ad");
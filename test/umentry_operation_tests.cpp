@@ -245,3 +245,46 @@ TEST(UMEntryOperationTest, DeletionOpMetadataCreation)
 
     EXPECT_EQ(created_metadata, expected_metadata);
 }
+
+TEST(UMEntryOperationTest, UMEntryOpViewParsing)
+{
+    auto metadata = extractMetadata("6a00c6dc7501010802aabbdeadbeef").getValue();
+
+    auto view_opt = parseMetadataToUMEntryOpView(metadata);
+
+    ASSERT_TRUE(view_opt);
+
+    const auto& view = view_opt.getValue();
+
+    //the view points into the metadata
+    EXPECT_EQ(view.operation_flag, UMENTRY_CREATION_FLAG);
+    EXPECT_EQ(view.entry.key.data(), metadata.data() + 9);
+    EXPECT_EQ(view.entry.key, stringToByteVec("deadbeef").getValue());
+    EXPECT_EQ(view.entry.value, stringToByteVec("aabb").getValue());
+
+    auto op_opt = toUMEntryOp(view, 1000, "owner"s, 10);
+
+    ASSERT_TRUE(op_opt);
+
+    auto creation = std::get<UMEntryCreationOp>(op_opt.getValue());
+    auto expected_value = UMEntryValue{stringToByteVec("aabb").getValue()};
+
+    EXPECT_EQ(creation.getEntryKey(), stringToByteVec("deadbeef").getValue());
+    EXPECT_EQ(creation.getUMEntryValue(), expected_value);
+}
+
+TEST(UMEntryOperationTest, UMEntryOpViewParsingInvalid)
+{
+    //unknown operation flag
+    auto metadata1 = extractMetadata("6a00c6dc75012001aabbccdddeadbeef").getValue();
+    EXPECT_FALSE(parseMetadataToUMEntryOpView(metadata1));
+
+    //byte array longer than the metadata
+    auto metadata2 = extractMetadata("6a00c6dc75010108ffaabbccdd").getValue();
+    EXPECT_FALSE(parseMetadataToUMEntryOpView(metadata2));
+
+    //ownership transfer without a new owner
+    auto metadata3 = extractMetadata("6a00c6dc75010401aabbccdddeadbeef").getValue();
+    auto view = parseMetadataToUMEntryOpView(metadata3).getValue();
+    EXPECT_FALSE(toUMEntryOp(view, 1000, "owner"s, 10));
+}
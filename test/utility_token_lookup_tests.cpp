@@ -390,3 +390,57 @@ TEST(UtilityTokenLookupTest, OverflowTest)
     EXPECT_EQ(available,
               0);
 }
+
+TEST(UtilityTokenLookupTest, TokensOfOwnersTest)
+{
+    UtilityTokenLookup lookup{nullptr, 0};
+
+    std::string owner1 = "oLupzckPUYtGydsBisL86zcwsBweJm1dSM";
+    std::string owner2 = "oHe5FSnZxgs81dyiot1FuSJNuc1mYWYd1Z";
+    std::string owner3 = "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W";
+
+    auto creation_op1 = createOp(
+        "c6dc75" //forge identifier
+        "03" //token type
+        "01" //operation flag
+        "0000000000000003" // amount 3
+        "deadbeef",
+        100,
+        std::string{owner1},
+        10);
+
+    auto creation_op2 = createOp(
+        "c6dc75" //forge identifier
+        "03" //token type
+        "01" //operation flag
+        "0000000000000005" // amount 5
+        "cafe",
+        100,
+        std::string{owner2},
+        10);
+
+    auto creation_op3 = createOp(
+        "c6dc75" //forge identifier
+        "03" //token type
+        "01" //operation flag
+        "0000000000000007" // amount 7
+        "beef",
+        100,
+        std::string{owner3},
+        10);
+
+    lookup.executeOperations({creation_op1,
+                              creation_op2,
+                              creation_op3});
+
+    auto tokens = lookup.getUtilityTokensOfOwners({owner1, owner2});
+
+    //ordered by token id
+    ASSERT_EQ(tokens.size(), 2);
+    EXPECT_EQ(tokens[0].getId(), stringToByteVec("cafe").getValue());
+    EXPECT_EQ(tokens[0].getAttachedAmount(), 5);
+    EXPECT_EQ(tokens[1].getId(), stringToByteVec("deadbeef").getValue());
+    EXPECT_EQ(tokens[1].getAttachedAmount(), 3);
+
+    EXPECT_TRUE(lookup.getUtilityTokensOfOwners({}).empty());
+}
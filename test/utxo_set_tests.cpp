@@ -0,0 +1,135 @@
+#include <core/Transaction.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <wallet/UtxoSet.hpp>
+
+using forge::core::Unspent;
+using forge::wallet::UtxoSet;
+
+namespace {
+
+const std::string owner = "oLupzckPUYtGydsBisL86zcwsBweJm1dSM";
+const std::string other = "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W";
+
+} // namespace
+
+TEST(UtxoSetTest, SelectSmallestFittingOutputTest)
+{
+    UtxoSet set;
+    set.reset({Unspent{5000, 0, 10, owner, "aa"},
+               Unspent{1200, 1, 10, owner, "bb"},
+               Unspent{1010, 0, 10, owner, "cc"},
+               Unspent{1000, 0, 10, other, "dd"}},
+              100);
+
+    //the output of the other address fits exactly but cannot be used,
+    //1010 would leave a change below the minimum
+    auto selected = set.select(owner, 1000, 100);
+    ASSERT_TRUE(selected);
+    EXPECT_EQ(selected.getValue().getTxid(), "bb");
+    EXPECT_EQ(selected.getValue().getVoutIdx(), 1);
+
+    //an output which is used completely needs no change
+    selected = set.select(owner, 1010, 100);
+    ASSERT_TRUE(selected);
+    EXPECT_EQ(selected.getValue().getTxid(), "cc");
+
+    EXPECT_FALSE(set.select(owner, 6000, 100));
+    EXPECT_FALSE(UtxoSet{}.select(owner, 1000, 100));
+}
+
+TEST(UtxoSetTest, SpendTest)
+{
+    UtxoSet set;
+    set.reset({Unspent{1200, 1, 10, owner, "bb"},
+               Unspent{1200, 0, 10, owner, "cc"}},
+              100);
+
+    ASSERT_EQ(set.size(), 2);
+
+    //outputs of the same value are told apart by their outpoint
+    EXPECT_TRUE(set.spend("bb", 1));
+    EXPECT_FALSE(set.spend("bb", 1));
+    EXPECT_FALSE(set.spend("cc", 1));
+    EXPECT_EQ(set.size(), 1);
+
+    auto selected = set.select(owner, 1000, 100);
+    ASSERT_TRUE(selected);
+    EXPECT_EQ(selected.getValue().getTxid(), "cc");
+
+    EXPECT_TRUE(set.spend("cc", 0));
+    EXPECT_FALSE(set.select(owner, 1000, 100));
+}
+
+TEST(UtxoSetTest, ResetTest)
+{
+    UtxoSet set;
+    EXPECT_FALSE(set.getBlockHeight());
+
+    set.reset({Unspent{1200, 1, 10, owner, "bb"}}, 100);
+    ASSERT_TRUE(set.getBlockHeight());
+    EXPECT_EQ(set.getBlockHeight().getValue(), 100);
+
+    //a reset replaces all outputs
+    set.reset({Unspent{3000, 0, 10, other, "ee"}}, 101);
+    EXPECT_EQ(set.getBlockHeight().getValue(), 101);
+    EXPECT_EQ(set.size(), 1);
+    EXPECT_FALSE(set.select(owner, 1000, 100));
+    EXPECT_TRUE(set.select(other, 1000, 100));
+}
+
+TEST(UtxoSetTest, AddLeasedTest)
+{
+    UtxoSet set;
+    set.reset({Unspent{1200, 1, 10, owner, "bb"}}, 100);
+
+    {
+        auto lease = set.addLeased(Unspent{3000, 0, 10, other, "ee"});
+        EXPECT_EQ(lease.getUnspent().getTxid(), "ee");
+        EXPECT_EQ(set.size(), 2);
+        EXPECT_EQ(set.numberOfLeased(), 1);
+        EXPECT_FALSE(set.lease(other, 1000, 100));
+    }
+
+    //an output which is already in the set is not added twice
+    auto lease = set.addLeased(Unspent{1200, 1, 10, owner, "bb"});
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_FALSE(set.lease(owner, 1000, 100));
+    EXPECT_TRUE(set.lease(other, 1000, 100));
+}
+
+TEST(UtxoSetTest, LeaseTest)
+{
+    UtxoSet set;
+    set.reset({Unspent{1200, 1, 10, owner, "bb"},
+               Unspent{1500, 0, 10, owner, "cc"}},
+              100);
+
+    {
+        auto first = set.lease(owner, 1000, 100);
+        ASSERT_TRUE(first);
+        EXPECT_EQ(first.getValue().getUnspent().getTxid(), "bb");
+
+        //a leased output is not handed out again
+        auto second = set.lease(owner, 1000, 100);
+        ASSERT_TRUE(second);
+        EXPECT_EQ(second.getValue().getUnspent().getTxid(), "cc");
+        EXPECT_FALSE(set.lease(owner, 1000, 100));
+        EXPECT_EQ(set.numberOfLeased(), 2);
+
+        second.getValue().spend();
+        EXPECT_EQ(set.numberOfLeased(), 1);
+        EXPECT_EQ(set.size(), 1);
+
+        //leases survive a reset
+        set.reset({Unspent{1200, 1, 10, owner, "bb"}}, 101);
+        EXPECT_FALSE(set.select(owner, 1000, 100));
+    }
+
+    //the lease which was not spent was given back
+    EXPECT_EQ(set.numberOfLeased(), 0);
+    auto selected = set.select(owner, 1000, 100);
+    ASSERT_TRUE(selected);
+    EXPECT_EQ(selected.getValue().getTxid(), "bb");
+}